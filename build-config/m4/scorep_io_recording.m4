@@ -3,7 +3,7 @@
 ##
 ## This file is part of the Score-P software (http://www.score-p.org)
 ##
-## Copyright (c) 2015-2017, 2020, 2023,
+## Copyright (c) 2015-2017, 2020, 2023, 2026,
 ## Technische Universitaet Dresden, Germany
 ##
 ## Copyright (c) 2022,
@@ -27,13 +27,15 @@ dnl ----------------------------------------------------------------------------
 ## _SCOREP_IO_RECORDING_POSIX_CHECK_SYMBOLS( FOUND-SYMBOL-VARIABLE )
 AC_DEFUN([_SCOREP_IO_RECORDING_POSIX_CHECK_SYMBOLS], [
 SCOREP_CHECK_SYMBOLS([POSIX I/O], [], $1,
-           [close,
+           [chdir,
+            close,
             closedir,
             creat,
             creat64,
             dup,
             dup2,
             dup3,
+            fchdir,
             fclose,
             fcntl,
             fdatasync,
@@ -86,6 +88,8 @@ SCOREP_CHECK_SYMBOLS([POSIX I/O], [], $1,
             read,
             readv,
             remove,
+            rename,
+            renameat,
             rewind,
             scanf,
             select,
@@ -9,7 +9,7 @@
 ## Copyright (c) 2009-2012,
 ## Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
 ##
-## Copyright (c) 2009-2013, 2019,
+## Copyright (c) 2009-2013, 2019, 2026,
 ## Technische Universitaet Dresden, Germany
 ##
 ## Copyright (c) 2009-2012,
@@ -37,6 +37,7 @@
 # Defines that are prefixed by HAVE_BACKEND_SCOREP_ need to be communicated to the frontend.
 AC_DEFUN([SCOREP_TIMER],
 [AS_UNSET([scorep_timers])
+AS_UNSET([scorep_timer_keys])
 AS_UNSET([scorep_timer_cppflags])
 AS_UNSET([scorep_timer_ldflags])
 AS_UNSET([scorep_timer_libs])
@@ -65,6 +66,32 @@ AS_CASE([${ac_scorep_platform}],
              ],
     [_SCOREP_TIMER_CHECK([tsc], [_SCOREP_TIMER_TSC], [], [-lm])])
 
+# Fix the timer at build time, if requested. SCOREP_Timer_GetClockTicks()
+# then reads this timer without runtime dispatch.
+AC_ARG_WITH([timer],
+    [AS_HELP_STRING([--with-timer=<timer>],
+        [Fix the measurement timer at build time to one of the detected
+         timers, e.g., 'tsc'. Timestamps are then read inline without
+         runtime dispatch and SCOREP_TIMER accepts only this timer.
+         [no]])],
+    [],
+    [with_timer=no])
+AS_UNSET([scorep_timer_fixed])
+AS_CASE([${with_timer}],
+    [no], [],
+    [yes], [AC_MSG_ERROR([--with-timer requires a timer name, one of: ${scorep_timer_keys}])],
+    [AS_CASE([" ${scorep_timer_keys} "],
+         [*" ${with_timer} "*],
+         [scorep_timer_fixed=${with_timer}
+          scorep_timer_default=${with_timer}
+          AC_DEFINE([HAVE_BACKEND_SCOREP_TIMER_FIXED], [1], [Timer fixed at build time])
+          m4_foreach_w([_scorep_timer], [bgl bgp bgq mingw aix mac tsc gettimeofday clock_gettime],
+              [AS_IF([test "x${with_timer}" = "x]_scorep_timer["],
+                   [AC_DEFINE([HAVE_BACKEND_SCOREP_TIMER_FIXED_]m4_toupper(_scorep_timer), [1],
+                        [Timer ]_scorep_timer[ fixed at build time])])
+              ])],
+         [AC_MSG_ERROR([requested timer '${with_timer}' not available, choose one of: ${scorep_timer_keys}])])])
+
 # Output
 AS_VAR_SET_IF([scorep_timers],
     [AC_DEFINE_UNQUOTED(HAVE_BACKEND_SCOREP_TIMER_DEFAULT, ["${scorep_timer_default}"], [Default timer])
@@ -75,6 +102,8 @@ AS_VAR_SET_IF([scorep_timers],
         [AFS_SUMMARY([Timer LDFLAGS], [${scorep_timer_ldflags}])])
     AS_VAR_SET_IF([scorep_timer_libs],
         [AFS_SUMMARY([Timer LIBS], [${scorep_timer_libs}])])
+    AS_VAR_SET_IF([scorep_timer_fixed],
+        [AFS_SUMMARY([Fixed at build time], [${scorep_timer_fixed}])])
      AFS_SUMMARY_POP([Timer support], [yes, providing ${scorep_timers}])],
     [AC_MSG_FAILURE([no suitable timer detected.])])
 
@@ -119,6 +148,9 @@ m4_ifnblank([$5],
 AS_IF([test "x${have_timer}" = xyes],
     [AC_DEFINE(HAVE_BACKEND_SCOREP_TIMER_[]m4_toupper($1), [1], [Timer $1 available])
     scorep_timer_default=$1
+    AS_VAR_SET_IF([scorep_timer_keys],
+        [scorep_timer_keys="${scorep_timer_keys} $1"],
+        [scorep_timer_keys=$1])
     AS_VAR_SET_IF([scorep_timers],
         [scorep_timers="${scorep_timers}, ${timer_name}"],
         [scorep_timers=${timer_name}])
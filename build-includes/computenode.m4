@@ -6,7 +6,7 @@ dnl
 dnl Copyright (c) 2013-2014, 2024,
 dnl Forschungszentrum Juelich GmbH, Germany
 dnl
-dnl Copyright (c) 2014-2015, 2017,
+dnl Copyright (c) 2014-2015, 2017, 2026,
 dnl Technische Universitaet Dresden, Germany
 dnl
 dnl This software may be modified and distributed under the terms of
@@ -19,6 +19,9 @@ dnl file build-includes/computenode.m4
 AFS_GNU_LINKER
 
 SCOREP_PTHREAD
+AC_SCOREP_COND_HAVE([WORKER_THREADS],
+                    [test "x${scorep_have_pthread}" = x1],
+                    [Defined if the measurement can use worker threads at finalization.])
 
 SCOREP_COMPILER_INSTRUMENTATION_FLAGS
 SCOREP_INSTRUMENTATION_FLAGS
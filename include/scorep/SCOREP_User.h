@@ -1354,6 +1354,25 @@
     @endcode
  */
 
+/**
+    @def SCOREP_TRACE_DUMP()
+    Requests a dump of the trace ring buffers, if tracing runs in flight
+    recorder mode (see SCOREP_TRACING_RING_SIZE). Each location writes its
+    most recent events to the trace the next time its ring buffer is full,
+    instead of dropping them. Otherwise this macro has no effect.
+
+    C/C++ example:
+    @code
+    void foo()
+    {
+      if ( error_detected )
+      {
+        SCOREP_TRACE_DUMP()
+      }
+    }
+    @endcode
+ */
+
 /**@}*/
 /**@}*/
 
@@ -1369,6 +1388,8 @@
 
 #define SCOREP_RECORDING_IS_ON() SCOREP_User_RecordingEnabled()
 
+#define SCOREP_TRACE_DUMP() SCOREP_User_TriggerTraceDump();
+
 #else // SCOREP_USER_ENABLE
 
 /* **************************************************************************************
@@ -1403,6 +1424,7 @@
 #define SCOREP_RECORDING_ON()
 #define SCOREP_RECORDING_OFF()
 #define SCOREP_RECORDING_IS_ON() 0
+#define SCOREP_TRACE_DUMP()
 #define SCOREP_USER_CARTESIAN_TOPOLOGY_CREATE( userTopology, name, ndims )
 #define SCOREP_USER_CARTESIAN_TOPOLOGY_ADD_DIM( userTopology, size, periodic, name )
 #define SCOREP_USER_CARTESIAN_TOPOLOGY_INIT( userTopology )
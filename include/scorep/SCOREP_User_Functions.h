@@ -452,6 +452,16 @@ SCOREP_User_DisableRecording( void );
 bool
 SCOREP_User_RecordingEnabled( void );
 
+/**
+    Requests a dump of the trace ring buffers, if tracing runs in flight
+    recorder mode (see SCOREP_TRACING_RING_SIZE). Otherwise this command has
+    no effect.
+    @note We strongly recommend not to insert calls to this function for instrumentation,
+    but use the SCOREP_TRACE_DUMP macro instead.
+ */
+void
+SCOREP_User_TriggerTraceDump( void );
+
 #ifdef __cplusplus
 } /* extern "C" */
 
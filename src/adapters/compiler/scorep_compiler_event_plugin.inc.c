@@ -1,7 +1,7 @@
 /*
  * This file is part of the Score-P software (http://www.score-p.org)
  *
- * Copyright (c) 2012-2013, 2015-2016, 2020,
+ * Copyright (c) 2012-2013, 2015-2016, 2020, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2022-2024,
@@ -86,3 +86,32 @@ scorep_plugin_exit_region( SCOREP_RegionHandle regionHandle )
     }
     SCOREP_IN_MEASUREMENT_DECREMENT();
 }
+
+#if HAVE( SCOREP_COMPILER_INSTRUMENTATION_XRAY_PLUGIN )
+static SCOREP_ParameterHandle compiler_plugin_control_parameter       = SCOREP_INVALID_PARAMETER;
+static UTILS_Mutex            compiler_plugin_control_parameter_mutex = UTILS_MUTEX_INIT;
+
+void
+scorep_plugin_trigger_control_update( uint64_t update )
+{
+    SCOREP_IN_MEASUREMENT_INCREMENT();
+
+    if ( SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
+    {
+        /* Each thread calls this only once per control update, thus the lock
+         * is uncontended in practice */
+        UTILS_MutexLock( &compiler_plugin_control_parameter_mutex );
+        if ( compiler_plugin_control_parameter == SCOREP_INVALID_PARAMETER )
+        {
+            compiler_plugin_control_parameter =
+                SCOREP_Definitions_NewParameter( "XRay control update",
+                                                 SCOREP_PARAMETER_UINT64 );
+        }
+        SCOREP_ParameterHandle parameter = compiler_plugin_control_parameter;
+        UTILS_MutexUnlock( &compiler_plugin_control_parameter_mutex );
+
+        SCOREP_TriggerParameterUint64( parameter, update );
+    }
+    SCOREP_IN_MEASUREMENT_DECREMENT();
+}
+#endif /* HAVE( SCOREP_COMPILER_INSTRUMENTATION_XRAY_PLUGIN ) */
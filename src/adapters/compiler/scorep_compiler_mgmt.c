@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2013, 2015, 2020,
+ * Copyright (c) 2009-2013, 2015, 2020, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -75,6 +75,29 @@ compiler_subsystem_init( void )
     return SCOREP_SUCCESS;
 }
 
+static void compiler_subsystem_end( void ){
+#if HAVE( SCOREP_COMPILER_INSTRUMENTATION_XRAY_PLUGIN )
+    UTILS_DEBUG_ENTRY();
+    // Stop runtime re-patching before definitions are unified
+    endXRayPlugin();
+    UTILS_DEBUG_EXIT();
+#endif
+}
+
+#if HAVE( SCOREP_COMPILER_INSTRUMENTATION_XRAY_PLUGIN )
+static void
+compiler_subsystem_deactivate_cpu_location( struct SCOREP_Location* location,
+                                            struct SCOREP_Location* parentLocation,
+                                            SCOREP_CPULocationPhase phase )
+{
+    // Close regions left open by runtime unpatching before the thread ends
+    if ( phase == SCOREP_CPU_LOCATION_PHASE_EVENTS )
+    {
+        deactivateXRayPluginLocation();
+    }
+}
+#endif
+
 static void compiler_subsystem_finalize( void ){
 #if HAVE( SCOREP_COMPILER_INSTRUMENTATION_XRAY_PLUGIN )
     UTILS_DEBUG_ENTRY();
@@ -89,5 +112,9 @@ const SCOREP_Subsystem SCOREP_Subsystem_CompilerAdapter =
 {
     .subsystem_name = "COMPILER",
     .subsystem_init = &compiler_subsystem_init,
+    .subsystem_end = &compiler_subsystem_end,
+#if HAVE( SCOREP_COMPILER_INSTRUMENTATION_XRAY_PLUGIN )
+    .subsystem_deactivate_cpu_location = &compiler_subsystem_deactivate_cpu_location,
+#endif
     .subsystem_finalize = &compiler_subsystem_finalize,
 };
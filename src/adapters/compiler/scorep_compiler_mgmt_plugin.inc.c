@@ -1,7 +1,7 @@
 /*
  * This file is part of the Score-P software (http://www.score-p.org)
  *
- * Copyright (c) 2012-2013, 2015-2016, 2020,
+ * Copyright (c) 2012-2013, 2015-2016, 2020, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2015, 2022-2024,
@@ -123,6 +123,29 @@ scorep_compiler_plugin_register_region( const scorep_compiler_region_description
                  regionDescr->name );
 }
 
+#if HAVE( SCOREP_COMPILER_INSTRUMENTATION_XRAY_PLUGIN )
+void
+scorep_compiler_plugin_define_region( const scorep_compiler_region_description* regionDescr )
+{
+    *regionDescr->handle =
+        SCOREP_Definitions_NewRegion( regionDescr->name,
+                                      regionDescr->canonical_name,
+                                      SCOREP_Definitions_NewSourceFile(
+                                          regionDescr->file ),
+                                      regionDescr->begin_lno,
+                                      regionDescr->end_lno,
+                                      SCOREP_PARADIGM_COMPILER,
+                                      SCOREP_REGION_FUNCTION );
+
+    UTILS_DEBUG( "Defined %s:%d-%d:%s: \"%s\"",
+                 regionDescr->file,
+                 regionDescr->begin_lno,
+                 regionDescr->end_lno,
+                 regionDescr->canonical_name,
+                 regionDescr->name );
+}
+#endif /* HAVE( SCOREP_COMPILER_INSTRUMENTATION_XRAY_PLUGIN ) */
+
 static void
 plugin_register_regions( void )
 {
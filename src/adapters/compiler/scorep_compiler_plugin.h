@@ -1,7 +1,7 @@
 /*
  * This file is part of the Score-P software (http://www.score-p.org)
  *
- * Copyright (c) 2012-2013, 2015-2016,
+ * Copyright (c) 2012-2013, 2015-2016, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2024,
@@ -44,6 +44,10 @@ void scorep_compiler_plugin_register_region(const scorep_compiler_region_descrip
 // with config-backend in other files as they are autogenerated by autoconf and don't have include guards
     void scorep_plugin_enter_region( SCOREP_RegionHandle regionHandle );
     void scorep_plugin_exit_region( SCOREP_RegionHandle regionHandle );
+// Records that the location observed the control channel update @a update
+    void scorep_plugin_trigger_control_update( uint64_t update );
+// Defines the region regardless of the runtime filter, used when the control channel includes a filtered function
+    void scorep_compiler_plugin_define_region( const scorep_compiler_region_description *region_descr );
 #endif
 
 #if HAVE(XRAY_PLUGIN_SUPPORT) || HAVE(LLVM_PLUGIN_SUPPORT)
@@ -4,6 +4,7 @@
 #include <utility>
 #include <vector>
 #include <regex>
+#include <algorithm>
 
 #include "scorep_xray_filter_converter.hpp"
 #include "scorep_filter_matching.h"
@@ -11,6 +12,122 @@
 
 namespace XRayPlugin {
 
+    /**
+     * Checks whether a demangled Score-P pattern can only match demangled C++ names, which XRay never sees
+     */
+    static bool isCxxOnlyPattern(const scorep_filter_rule_t *rule) {
+        return !rule->is_mangled && std::string(rule->pattern).find_first_of(":()<>, ") != std::string::npos;
+    }
+
+    /**
+     * Checks whether a rule has to be resolved against the symbols to keep its meaning in XRay. Besides C++-only
+     * patterns, this holds for every demangled INCLUDE rule: A pattern like "foo*" also includes the C++ function
+     * "foo(int)", whose mangled name "_Z3fooi" the converted pattern does not match, thus an EXCLUDE rule before
+     * would remove it in XRay
+     */
+    static bool needsSymbolResolution(const scorep_filter_rule_t *rule) {
+        return isCxxOnlyPattern(rule) || (!rule->is_mangled && !rule->is_exclude);
+    }
+
+    /**
+     * Appends an XRay entry to a section unless it is already present
+     */
+    static void addEntry(std::vector<std::string> &section, const std::string &entry) {
+        if (std::find(section.begin(), section.end(), entry) == section.end()) {
+            section.push_back(entry);
+        }
+    }
+
+    /**
+     * Prints a Score-P rule as comment into the XRay output
+     */
+    static void commentRule(std::stringstream &out, const char *reason, const scorep_filter_rule_t *rule) {
+        out << "# " << reason << ": " << (rule->is_exclude ? "EXCLUDE " : "INCLUDE ")
+            << (rule->is_mangled ? "MANGLED " : "") << rule->pattern << std::endl;
+    }
+
+    /**
+     * Converts Score-P rules of one kind into XRay entries. As XRay prefers [always] over [never] regardless of their
+     * order, only the last block of EXCLUDE rules and the INCLUDE rules following it keep their meaning. Earlier rules
+     * are overruled by these and are dropped.
+     * For files, [always] would force the instrumentation of all functions of a file, hence INCLUDE rules cannot be
+     * converted and void the EXCLUDE rules before them.
+     * @param rules Score-P rules of one kind in their order
+     * @param prefix Entry prefix in XRay, "src:" or "fun:"
+     * @param info Receives comments about dropped rules
+     * @param always Receives the [always] entries
+     * @param never Receives the [never] entries
+     * @return true if a demangled C++ rule was dropped
+     */
+    static bool convertRules(const scorep_filter_rule_t *rules, const std::string &prefix, std::stringstream &info,
+                             std::vector<std::string> &always, std::vector<std::string> &never) {
+        std::vector<const scorep_filter_rule_t *> ruleList;
+        for (const scorep_filter_rule_t *rule = rules; rule != nullptr; rule = rule->next) {
+            ruleList.push_back(rule);
+        }
+        bool isFile = prefix == "src:";
+        bool droppedCxxRule = false;
+
+        size_t includeBegin = ruleList.size();
+        while (includeBegin > 0 && !ruleList[includeBegin - 1]->is_exclude) {
+            includeBegin--;
+        }
+        size_t excludeBegin = includeBegin;
+        while (excludeBegin > 0 && ruleList[excludeBegin - 1]->is_exclude) {
+            excludeBegin--;
+        }
+
+        // The EXCLUDE block is only valid if every INCLUDE after it is converted, too
+        bool includesConverted = true;
+        for (size_t i = includeBegin; i < ruleList.size(); i++) {
+            const scorep_filter_rule_t *rule = ruleList[i];
+            if (isFile || std::string(rule->pattern) == "*" || isCxxOnlyPattern(rule)) {
+                includesConverted = false;
+            }
+        }
+
+        for (size_t i = 0; i < excludeBegin; i++) {
+            commentRule(info, "dropped, overruled by later rules", ruleList[i]);
+        }
+        for (size_t i = excludeBegin; i < includeBegin; i++) {
+            const scorep_filter_rule_t *rule = ruleList[i];
+            if (!includesConverted) {
+                commentRule(info, "dropped, a later INCLUDE cannot be expressed", rule);
+            } else if (isCxxOnlyPattern(rule)) {
+                commentRule(info, "dropped, demangled C++ name", rule);
+                droppedCxxRule = true;
+            } else {
+                addEntry(never, prefix + rule->pattern);
+            }
+        }
+        for (size_t i = includeBegin; i < ruleList.size(); i++) {
+            const scorep_filter_rule_t *rule = ruleList[i];
+            if (isFile || std::string(rule->pattern) == "*") {
+                commentRule(info, "dropped, cannot be expressed", rule);
+            } else if (isCxxOnlyPattern(rule)) {
+                commentRule(info, "dropped, demangled C++ name", rule);
+                droppedCxxRule = true;
+            } else {
+                addEntry(always, prefix + rule->pattern);
+            }
+        }
+        return droppedCxxRule;
+    }
+
+    /**
+     * Escapes separators in XRay patterns for the Score-P filter parser
+     */
+    static std::string escapeForScorep(const std::string &pattern) {
+        std::string escaped;
+        for (char c: pattern) {
+            if (c == ' ' || c == '\t' || c == '#') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
 
     FilterConverter::FilterConverter(std::string inFilePath) : inFilePath(std::move(inFilePath)) {
         if (readInFile()) {
@@ -88,6 +205,31 @@ namespace XRayPlugin {
         }
     }
 
+    void FilterConverter::addSourceFile(const std::string &sourceFile) {
+        sourceFiles.insert(sourceFile);
+        convertedXrayContent.clear();
+    }
+
+    void FilterConverter::addSymbols(const std::vector<std::string> &mangledNames,
+                                     const std::vector<std::string> &demangledNames) {
+        for (size_t i = 0; i < mangledNames.size() && i < demangledNames.size(); i++) {
+            symbols.emplace(mangledNames[i], demangledNames[i]);
+        }
+        convertedXrayContent.clear();
+    }
+
+    bool FilterConverter::needsSymbols() {
+        if (!formatOkay || inIsXray || (!filter && !parseFilter())) {
+            return false;
+        }
+        for (const scorep_filter_rule_t *rule = filter->function_rules; rule != nullptr; rule = rule->next) {
+            if (needsSymbolResolution(rule)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     bool FilterConverter::saveAsScorep(std::string &outFilePath) {
         if (!formatOkay) {
             // Better to fail than to risk undefined instrumentation behaviour
@@ -96,8 +238,12 @@ namespace XRayPlugin {
         if (!inIsXray) {
             return writeFile(outFilePath, inFileContent);
         }
-        UTILS_WARNING("Converting XRay Filter files to ScoreP filter is not supported!");
-        return false;
+        if (convertedScorepContent.empty()) {
+            if (!convertToScorep()) {
+                return false;
+            }
+        }
+        return writeFile(outFilePath, convertedScorepContent);
     }
 
     bool FilterConverter::saveAsXRay(std::string &outFilePath) {
@@ -110,7 +256,7 @@ namespace XRayPlugin {
         }
         if (convertedXrayContent.empty()) {
             // Only now is a conversion really necessary
-            if (!parseFilter()) {
+            if (!filter && !parseFilter()) {
                 return false;
             }
             if (!convertToXRay()) {
@@ -129,59 +275,157 @@ namespace XRayPlugin {
         SCOREP_ErrorCode result = SCOREP_Filter_ParseFile(filter, inFilePath.c_str());
         if (result != SCOREP_SUCCESS) {
             UTILS_WARNING("Could not read or parse instrumentation filter file!");
+            SCOREP_Filter_Delete(filter);
+            filter = nullptr;
             return false;
         }
         return true;
     }
 
     bool FilterConverter::convertToXRay() {
-        UTILS_WARNING("Note that converting Score-P filters to XRay filters XRay is currently only supported on a "
-                      "very basic level. The behaviour therefore differs from Score-P filters in many aspects.\n"
-                      " Consider using --no-xray-delete-converted-filter and then edit the xray filter to your needs"
-                      " manually.\n Differences include:\n"
-                      "\t(!) Regions and Files are included if they match a single inclusion filter, regardless of"
-                      " an exclusion filter matching the file/region\n"
-                      "\t(!) Demangled names are not properly recognized by XRay!\n"
-                      "Therefore, be wary of using \"*\" without any further specification in your INCLUDE sections, as"
-                      " that will effectively disable all exclusion filters! Furthermore, consider using mangled names."
-                      "\nNote that runtime filtering is not affected by these restrictions.");
-        std::stringstream xrayOutAlways;
-        std::stringstream xrayOutNever;
+        std::vector<std::string> xrayOutAlways;
+        std::vector<std::string> xrayOutNever;
         std::stringstream xrayInfo;
 
-        xrayInfo << "# converted Score-P filter file" << std::endl;
-        xrayOutAlways << "[always]" << std::endl;
-        xrayOutNever << "[never]" << std::endl;
+        xrayInfo << "# converted Score-P filter file " << inFilePath << std::endl;
 
-        scorep_filter_rule_t *fileRule = filter->file_rules;
-        while (fileRule != nullptr) {
-            if (fileRule->is_exclude) {
-                xrayOutNever << "src:" << fileRule->pattern << std::endl;
-            } else {
-                xrayOutAlways << "src:" << fileRule->pattern << std::endl;
+        convertRules(filter->file_rules, "src:", xrayInfo, xrayOutAlways, xrayOutNever);
+        bool droppedCxxRule = convertRules(filter->function_rules, "fun:", xrayInfo, xrayOutAlways, xrayOutNever);
+
+        // Exact entries for the known source files and symbols. They agree with the converted patterns, as these only
+        // contain rules that decide on their own
+        for (const auto &sourceFile: sourceFiles) {
+            int excluded = 0;
+            SCOREP_Filter_MatchFile(filter, sourceFile.c_str(), &excluded);
+            if (excluded) {
+                addEntry(xrayOutNever, "src:" + sourceFile);
+            }
+        }
+        for (const auto &symbol: symbols) {
+            int excluded = 0;
+            int included = 0;
+            SCOREP_Filter_MatchFunction(filter, symbol.second.c_str(), symbol.first.c_str(), &excluded);
+            if (excluded) {
+                addEntry(xrayOutNever, "fun:" + symbol.first);
+                continue;
             }
-            fileRule = fileRule->next;
+            SCOREP_Filter_IncludeFunction(filter, symbol.second.c_str(), symbol.first.c_str(), &included);
+            if (included) {
+                addEntry(xrayOutAlways, "fun:" + symbol.first);
+            }
+        }
+
+        if (droppedCxxRule) {
+            std::string warn("Demangled C++ names in the instrumentation filter only apply to functions defined in "
+                             "the compiled source file and in objects and libraries on the command line, as XRay "
+                             "uses mangled names. Consider specifying mangled names in your instrumentation filter "
+                             "file.");
+            UTILS_WARNING(warn.c_str());
+            xrayInfo << "# " << warn << std::endl;
+        }
+
+        xrayInfo << "[always]" << std::endl;
+        for (const auto &entry: xrayOutAlways) {
+            xrayInfo << entry << std::endl;
+        }
+        xrayInfo << "[never]" << std::endl;
+        for (const auto &entry: xrayOutNever) {
+            xrayInfo << entry << std::endl;
         }
+        convertedXrayContent = xrayInfo.str();
+        return true;
+    }
+
+    bool FilterConverter::convertToScorep() {
+        std::vector<std::string> filesNever;
+        std::vector<std::string> filesAlways;
+        std::vector<std::string> functionsNever;
+        std::vector<std::string> functionsAlways;
 
-        scorep_filter_rule_t *regionRule = filter->function_rules;
-        bool emittedWarning = false; // Only emit warning to xray file once
-        while (regionRule != nullptr) {
-            if (!regionRule->is_mangled && !emittedWarning) {
-                std::string warn("A demangled region rule was specified in the filter file, but XRay uses mangled "
-                                 "names. Consider specifying mangled names in your instrumentation filter file.");
-                UTILS_WARNING(warn.c_str());
-                xrayInfo << "# " << warn << std::endl;
-                emittedWarning = true;
+        std::istringstream stream(inFileContent);
+        std::string line;
+        std::string section = "*"; // Entries before the first section header belong to all sections
+        size_t lineNo = 0;
+        while (std::getline(stream, line)) {
+            lineNo++;
+            size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#') {
+                continue;
             }
-            if (regionRule->is_exclude) {
-                xrayOutNever << "fun:" << regionRule->pattern << std::endl;
-            } else {
-                xrayOutAlways << "fun:" << regionRule->pattern << std::endl;
+            line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+            if (line.front() == '[') {
+                if (line.back() != ']') {
+                    UTILS_WARNING("Malformed section header in XRay filter file line %zu: %s", lineNo, line.c_str());
+                    return false;
+                }
+                section = line.substr(1, line.size() - 2);
+                continue;
+            }
+            size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                UTILS_WARNING("Malformed entry in XRay filter file line %zu: %s", lineNo, line.c_str());
+                return false;
             }
-            regionRule = regionRule->next;
+            std::string prefix = line.substr(0, colon);
+            std::string pattern = line.substr(colon + 1);
+            // Entries may carry a category, e.g. the "arg1" of always instrumented functions logging an argument
+            std::string category;
+            size_t equals = pattern.rfind('=');
+            if (equals != std::string::npos) {
+                category = pattern.substr(equals + 1);
+                pattern = pattern.substr(0, equals);
+            }
+            bool isAlways = section.compare(0, 6, "always") == 0 || category.compare(0, 6, "always") == 0;
+            bool isNever = section == "never" || category == "never";
+            if (isAlways == isNever || (prefix != "fun" && prefix != "src")) {
+                UTILS_WARNING("Ignoring unsupported entry in XRay filter file line %zu: %s", lineNo, line.c_str());
+                continue;
+            }
+            std::vector<std::string> &target = prefix == "src" ? (isAlways ? filesAlways : filesNever)
+                                                                : (isAlways ? functionsAlways : functionsNever);
+            target.push_back(escapeForScorep(pattern));
         }
 
-        convertedXrayContent = xrayInfo.str() + xrayOutAlways.str() + xrayOutNever.str();
+        // XRay prefers [always] over [never], the last matching Score-P rule decides: put INCLUDE after EXCLUDE
+        std::stringstream out;
+        out << "# converted XRay filter file " << inFilePath << std::endl;
+        if (!filesNever.empty() || !filesAlways.empty()) {
+            if (!filesAlways.empty()) {
+                out << "# XRay instruments all functions of the INCLUDE files, Score-P only stops excluding them"
+                    << std::endl;
+            }
+            out << "SCOREP_FILE_NAMES_BEGIN" << std::endl;
+            if (!filesNever.empty()) {
+                out << "  EXCLUDE" << std::endl;
+                for (const auto &pattern: filesNever) {
+                    out << "    " << pattern << std::endl;
+                }
+            }
+            if (!filesAlways.empty()) {
+                out << "  INCLUDE" << std::endl;
+                for (const auto &pattern: filesAlways) {
+                    out << "    " << pattern << std::endl;
+                }
+            }
+            out << "SCOREP_FILE_NAMES_END" << std::endl;
+        }
+        if (!functionsNever.empty() || !functionsAlways.empty()) {
+            out << "SCOREP_REGION_NAMES_BEGIN" << std::endl;
+            if (!functionsNever.empty()) {
+                out << "  EXCLUDE MANGLED" << std::endl;
+                for (const auto &pattern: functionsNever) {
+                    out << "    " << pattern << std::endl;
+                }
+            }
+            if (!functionsAlways.empty()) {
+                out << "  INCLUDE MANGLED" << std::endl;
+                for (const auto &pattern: functionsAlways) {
+                    out << "    " << pattern << std::endl;
+                }
+            }
+            out << "SCOREP_REGION_NAMES_END" << std::endl;
+        }
+        convertedScorepContent = out.str();
         return true;
     }
 
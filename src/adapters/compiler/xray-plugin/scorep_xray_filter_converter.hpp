@@ -4,6 +4,8 @@
 #include "config.h"
 #include <string>
 #include <set>
+#include <utility>
+#include <vector>
 #include "SCOREP_Filter.h"
 
 namespace XRayPlugin {
@@ -12,10 +14,13 @@ namespace XRayPlugin {
      * Helper class to transparently read a filter file and convert it into a xray filter file if requested.
      * The data is kept during the lifetime of this class so that the contents can be written multiple times,
      * e.g. if an export is wanted.
-     * The conversion xray=>scorep is currently not supported, and scorep=>xray is only
-     * supported on a very basic level and may produce errors
-     * TODO: Currently, the conversion process is faulty since XRay/LLVM Sanitizer list filter files behave differently
-     * TODO: Support real conversion
+     * Both directions keep the meaning of the rules where the formats allow it:
+     * In Score-P filters, the last matching rule decides, in XRay attribute lists, [always] wins over [never] and
+     * source file entries win over function entries. Score-P rules that cannot be expressed in XRay are dropped
+     * instead of being approximated, so that the converted list never removes a function that Score-P would measure.
+     * XRay matches function entries against mangled names. Demangled Score-P rules are therefore resolved against
+     * the symbols added via addSymbols(), and file rules are evaluated exactly for source files added via
+     * addSourceFile().
      */
     class FilterConverter {
 
@@ -24,6 +29,30 @@ namespace XRayPlugin {
 
         ~FilterConverter();
 
+        /**
+         * Adds a source file that will be compiled with the converted list. File rules are evaluated for it
+         * directly, in addition to the converted patterns.
+         * @param sourceFile Path of the source file as passed to the compiler
+         */
+        void addSourceFile(const std::string &sourceFile);
+
+        /**
+         * Adds function symbols to resolve the function rules against. Each symbol is converted into an exact
+         * entry if the filter excludes or explicitly includes it.
+         * @param mangledNames Mangled names of the symbols
+         * @param demangledNames Demangled names of the symbols, in the same order
+         */
+        void addSymbols(const std::vector<std::string> &mangledNames,
+                        const std::vector<std::string> &demangledNames);
+
+        /**
+         * Checks whether the filter contains function rules which can only be converted exactly for the symbols
+         * added via addSymbols(): demangled C++ rules and INCLUDE rules not given as MANGLED, as the latter also
+         * include C++ functions by their demangled names
+         * @return true if such rules exist, false otherwise or if the filter is not in Score-P format
+         */
+        bool needsSymbols();
+
         /**
          * Saves the filter content in a xray readable format to the provided file output path.
          * @param outFilePath Path to output file
@@ -33,7 +62,6 @@ namespace XRayPlugin {
 
         /**
          * Saves the filter content in a scorep readable format to the provided file output path.
-         * Note that saving as scorep is currently not supported if the input file type was xray
          * @param outFilePath Path to output file
          * @return true if successful, false otherwise
          */
@@ -58,9 +86,18 @@ namespace XRayPlugin {
         // Filled with converted xray content, if it was needed
         std::string convertedXrayContent;
 
+        // Filled with converted scorep content, if it was needed
+        std::string convertedScorepContent;
+
         // Scorep Filter of provided input file (if the file was in scorep format and the filter was needed)
         SCOREP_Filter *filter = nullptr;
 
+        // Source files to evaluate the file rules for
+        std::set<std::string> sourceFiles;
+
+        // Symbols to resolve the function rules against, pairs of mangled and demangled name
+        std::set<std::pair<std::string, std::string>> symbols;
+
         /**
          * Read contents of provided input file and keep them as string
          * @return
@@ -79,6 +116,12 @@ namespace XRayPlugin {
          */
         bool convertToXRay();
 
+        /**
+         * Converts buffered xray input to scorep format
+         * @return true if successful, false if the input could not be parsed
+         */
+        bool convertToScorep();
+
         /**
          * Writes a content string to a file at the provided output path
          * @param outFilePath path to output file
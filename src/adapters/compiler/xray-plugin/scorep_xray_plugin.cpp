@@ -12,7 +12,17 @@ extern "C" {
 }
 
 #include "scorep_xray_plugin.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // No need to check whether XRAY runtime is available since this header is only included when xray plugin
 // instrumentation is enabled, which means compiling and linking with -fxray-instrumented
@@ -28,6 +38,24 @@ namespace XRayPlugin {
     // Array of region_descriptions for all XRay instrumented functions
     static std::vector<scorep_compiler_region_description> *regions;
 
+    // Array of only the region handles for each region for more cache friendliness, read by the sled handler.
+    // Entries only change after initialization if the control channel defines a region lazily. Never freed, as
+    // handlers may still run after XRay stopped calling them for new events
+    static std::atomic<uint32_t> *regionHandles;
+
+    // Patching state per region, only accessed during initialization and by the control channel thread
+    static std::vector<bool> patchedRegions;
+
+    // Runtime control channel, see SCOREP_XRAY_CONTROL_DIR
+    static bool controlActive;
+    static std::string controlPath;
+    static std::thread controlThread;
+    static int controlStopPipe[2] = {-1, -1};
+    static std::atomic<uint64_t> controlUpdate;
+
+    // Functions the current thread entered while the control channel is active, innermost last
+    static thread_local std::vector<int32_t> enteredFids;
+
     /**
      * Creates a new, trivially copy-able scorep region description on the heap that can be referenced after passed
      * values go out of scope. Make sure to free contents once it is no longer needed.
@@ -70,6 +98,11 @@ namespace XRayPlugin {
         auto funcAddressMap = maybeMap.get().getFunctionAddresses(); // Mapping of XRay fid -> address (unique)
         regions = new std::vector<scorep_compiler_region_description>(
                 funcAddressMap.size()); // Resize once so insert is trivial
+        regionHandles = new std::atomic<uint32_t>[funcAddressMap.size()];
+        for (size_t i = 0; i < funcAddressMap.size(); i++) {
+            regionHandles[i].store(SCOREP_INVALID_REGION, std::memory_order_relaxed);
+        }
+        patchedRegions.assign(funcAddressMap.size(), false);
         llvm::symbolize::LLVMSymbolizer symbolizer({.Demangle = false});
         for (auto mapping: funcAddressMap) {
             int32_t funcId = mapping.first;
@@ -123,6 +156,7 @@ namespace XRayPlugin {
                 scorep_compiler_plugin_register_region(&region);
                 // Copy handles before filter check as they need to be aligned with XRay IDs
                 uint32_t handle = *region.handle;
+                regionHandles[i].store(handle, std::memory_order_release);
                 // Check if handle corresponds to filtered value or if registering failed
                 shouldPatch = (handle != SCOREP_FILTERED_REGION) && (handle != SCOREP_INVALID_REGION);
             }
@@ -137,23 +171,73 @@ namespace XRayPlugin {
             if (status != XRayPatchingStatus::SUCCESS) {
                 successStatus = false;
                 UTILS_WARNING("Could not (un)patch Xray function sled for xrayId %i: %i", i, status);
+            } else {
+                patchedRegions[i] = shouldPatch;
             }
         }
         return successStatus;
     }
 
     /**
-     * @return A vector containing only the dereferenced region handles for all provided regions
+     * Handler for patched XRay sleds while the control channel is active. (Un)patching a function while a thread
+     * executes it leaves its enter or exit event unmatched. Therefore, track the entered functions per thread, drop
+     * exits without enter, and synthesize exits that were lost. A lost exit is only detected at the next patched exit
+     * of an enclosing function, thus the synthesized exit carries its timestamp: the time the thread spent in the
+     * enclosing function after the unpatched one returned is attributed to the unpatched one. Functions still open
+     * when the thread ends are exited by exitEnteredRegions
+     * @param fid XRay id of function
+     * @param handle Region handle of function
+     * @param entryType Type of sled
      */
-    static inline std::vector<uint32_t>
-    copyRegionHandles(std::vector<scorep_compiler_region_description> *regiondescs) {
-        std::vector<uint32_t> regionHandles((*regiondescs).size());
-        for (int i = 0; i < (*regiondescs).size(); i++) {
-            // Registering also updated the region handle to its final value, they can now be cached
-            uint32_t handle = *(*regiondescs)[i].handle;
-            regionHandles[i] = handle;
-        }
-        return regionHandles;
+    static void handleControlledInstrumentationPoint(int32_t fid, uint32_t handle,
+                                                     XRayEntryType entryType) XRAY_INSTRUMENT_NEVER {
+        static thread_local uint64_t seenUpdate = 0;
+        switch (entryType) {
+            case XRayEntryType::ENTRY: {
+                if (handle == SCOREP_INVALID_REGION || handle == SCOREP_FILTERED_REGION) {
+                    return;
+                }
+                enteredFids.push_back(fid);
+                scorep_plugin_enter_region(handle);
+                uint64_t update = controlUpdate.load(std::memory_order_acquire);
+                if (update != seenUpdate) {
+                    seenUpdate = update;
+                    scorep_plugin_trigger_control_update(update);
+                }
+                break;
+            }
+            case XRayEntryType::TAIL:
+            case XRayEntryType::EXIT: {
+                auto entered = std::find(enteredFids.rbegin(), enteredFids.rend(), fid);
+                if (entered == enteredFids.rend()) {
+                    // Function was patched while this thread executed it
+                    return;
+                }
+                // Functions above were unpatched while this thread executed them
+                while (enteredFids.back() != fid) {
+                    scorep_plugin_exit_region(regionHandles[enteredFids.back() - 1].load(std::memory_order_acquire));
+                    enteredFids.pop_back();
+                }
+                enteredFids.pop_back();
+                scorep_plugin_exit_region(handle);
+                break;
+            }
+            default:
+                UTILS_WARN_ONCE("Unhandled Xray sled event %u for fid %i", entryType, fid);
+        }
+    }
+
+    /**
+     * Exits all functions the current thread entered under the control channel that were not exited yet. Called when
+     * the thread's location is deactivated, i.e., all functions it entered have returned and the remaining ones are
+     * those whose exit was lost by unpatching. Exits are dropped by the measurement once it ended, where the open
+     * regions were already exited
+     */
+    static void exitEnteredRegions() XRAY_INSTRUMENT_NEVER {
+        while (!enteredFids.empty()) {
+            scorep_plugin_exit_region(regionHandles[enteredFids.back() - 1].load(std::memory_order_acquire));
+            enteredFids.pop_back();
+        }
     }
 
     /**
@@ -163,22 +247,181 @@ namespace XRayPlugin {
      * @param entryType Type of sled
      */
     static void handleInstrumentationPoint(int32_t fid, XRayEntryType entryType) XRAY_INSTRUMENT_NEVER {
-        // Array of only the region handles for each region for more cache friendliness
-        // Static const in function was measured to be faster than global dereferencing
-        static const std::vector<uint32_t> regionHandles = copyRegionHandles(regions);
+        // Relaxed loads are plain loads; a region is only patched after its handle was stored
+        uint32_t handle = regionHandles[fid - 1].load(std::memory_order_relaxed);
+        if (controlActive) {
+            handleControlledInstrumentationPoint(fid, handle, entryType);
+            return;
+        }
         switch (entryType) {
             case XRayEntryType::ENTRY:
-                scorep_plugin_enter_region(regionHandles[fid - 1]);
+                scorep_plugin_enter_region(handle);
                 break;
             case XRayEntryType::TAIL:
             case XRayEntryType::EXIT:
-                scorep_plugin_exit_region(regionHandles[fid - 1]);
+                scorep_plugin_exit_region(handle);
                 break;
             default:
                 UTILS_WARN_ONCE("Unhandled Xray sled event %u for fid %i", entryType, fid);
         }
     }
 
+    /**
+     * Patches all functions not excluded by @p filter and unpatches the rest. Functions excluded by the default
+     * filter stay unpatched. Functions included for the first time are defined lazily, even if the runtime filter
+     * excluded them at initialization
+     * @param filter Filter rules received via the control channel
+     */
+    static void applyControlFilter(const SCOREP_Filter *filter) XRAY_INSTRUMENT_NEVER {
+        size_t numPatched = 0;
+        size_t numUnpatched = 0;
+        for (size_t i = 0; i < (*regions).size(); i++) {
+            scorep_compiler_region_description &region = (*regions)[i];
+            bool shouldPatch = !SCOREP_Env_XRayDefaultFilterActive() ||
+                               mayInstrument(region.name, region.canonical_name);
+            if (shouldPatch) {
+                int excluded = 0;
+                SCOREP_Filter_Match(filter, region.file, region.name, region.canonical_name, &excluded);
+                shouldPatch = !excluded;
+            }
+            if (shouldPatch == patchedRegions[i]) {
+                continue;
+            }
+            if (shouldPatch && (*region.handle == SCOREP_INVALID_REGION || *region.handle == SCOREP_FILTERED_REGION)) {
+                scorep_compiler_plugin_define_region(&region);
+                // Store handle before patching, the sled handler may fire immediately afterwards
+                regionHandles[i].store(*region.handle, std::memory_order_release);
+            }
+            XRayPatchingStatus status = shouldPatch ? __xray_patch_function(i + 1)     // XrayIDs start at 1
+                                                    : __xray_unpatch_function(i + 1);  // XrayIDs start at 1
+            if (status != XRayPatchingStatus::SUCCESS) {
+                UTILS_WARNING("Could not (un)patch Xray function sled for xrayId %zu: %i", i + 1, status);
+                continue;
+            }
+            patchedRegions[i] = shouldPatch;
+            (shouldPatch ? numPatched : numUnpatched)++;
+        }
+        uint64_t update = controlUpdate.fetch_add(1, std::memory_order_acq_rel) + 1;
+        if (SCOREP_Env_RunVerbose()) {
+            std::cerr << "XRay control update " << update << ": " << numPatched << " functions patched, "
+                      << numUnpatched << " functions unpatched" << std::endl;
+        }
+    }
+
+    /**
+     * Receives one set of filter rules from the control channel FIFO, i.e., everything written until the last writer
+     * closed it. Neither opening nor reading blocks, the thread waits in poll() for a writer or the stop request, thus
+     * a writer keeping the FIFO open does not delay the finalization
+     * @param rules Receives the filter rules
+     * @return true if a set of rules was received, false if the channel was stopped or failed
+     */
+    static bool receiveControlRules(std::string &rules) XRAY_INSTRUMENT_NEVER {
+        // A non-blocking reader does not wait for a writer in open. Linux reports the hang-up only after a writer
+        // opened and closed the FIFO again
+        int fd = open(controlPath.c_str(), O_RDONLY | O_NONBLOCK);
+        if (fd < 0) {
+            UTILS_WARNING("Could not open XRay control channel '%s': %s", controlPath.c_str(), strerror(errno));
+            return false;
+        }
+        rules.clear();
+        bool received = false;
+        while (true) {
+            struct pollfd fds[2] = {{fd, POLLIN, 0}, {controlStopPipe[0], POLLIN, 0}};
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                UTILS_WARNING("Could not wait for XRay control channel '%s': %s", controlPath.c_str(),
+                              strerror(errno));
+                break;
+            }
+            if (fds[1].revents != 0) {
+                break;
+            }
+            if (fds[0].revents == 0) {
+                continue;
+            }
+            char buffer[4096];
+            ssize_t length = read(fd, buffer, sizeof(buffer));
+            if (length > 0) {
+                rules.append(buffer, length);
+            } else if (length == 0) {
+                // The last writer closed the FIFO
+                received = true;
+                break;
+            } else if (errno != EAGAIN && errno != EINTR) {
+                UTILS_WARNING("Could not read XRay control channel '%s': %s", controlPath.c_str(), strerror(errno));
+                break;
+            }
+        }
+        close(fd);
+        return received;
+    }
+
+    /**
+     * Body of the control channel thread. Each writer of the FIFO sends one complete set of filter rules, which is
+     * applied once the writer closes the FIFO
+     */
+    static void runControlChannel() XRAY_INSTRUMENT_NEVER {
+        // The filter parser reads files, hand the received rules over via a private file next to the FIFO
+        std::string rulesPath = controlPath + ".rules";
+        std::string rules;
+        while (receiveControlRules(rules)) {
+            FILE *file = fopen(rulesPath.c_str(), "w");
+            bool written = file != nullptr && fwrite(rules.data(), 1, rules.size(), file) == rules.size();
+            if (file != nullptr && fclose(file) != 0) {
+                written = false;
+            }
+            SCOREP_Filter *filter = SCOREP_Filter_New();
+            if (written && SCOREP_Filter_ParseFile(filter, rulesPath.c_str()) == SCOREP_SUCCESS) {
+                applyControlFilter(filter);
+            } else {
+                UTILS_WARNING("Ignoring invalid filter rules received via '%s'", controlPath.c_str());
+            }
+            SCOREP_Filter_Delete(filter);
+            unlink(rulesPath.c_str());
+        }
+    }
+
+    /**
+     * Creates the control channel FIFO of this process and starts the thread serving it
+     * @param dir Directory to create the FIFO in
+     */
+    static void startControlChannel(const std::string &dir) XRAY_INSTRUMENT_NEVER {
+        controlPath = dir + "/scorep-xray-control." + std::to_string(getpid());
+        if (pipe(controlStopPipe) != 0) {
+            UTILS_WARNING("Could not create XRay control channel: %s", strerror(errno));
+            return;
+        }
+        if (mkfifo(controlPath.c_str(), 0600) != 0) {
+            UTILS_WARNING("Could not create XRay control channel '%s': %s", controlPath.c_str(), strerror(errno));
+            close(controlStopPipe[0]);
+            close(controlStopPipe[1]);
+            return;
+        }
+        controlThread = std::thread(runControlChannel);
+        if (SCOREP_Env_RunVerbose()) {
+            std::cerr << "XRay control channel: " << controlPath << std::endl;
+        }
+    }
+
+    /**
+     * Stops the control channel thread and removes the FIFO
+     */
+    static void stopControlChannel() XRAY_INSTRUMENT_NEVER {
+        if (!controlThread.joinable()) {
+            return;
+        }
+        // Wake the thread, which polls the stop pipe together with the FIFO
+        char stop = 0;
+        while (write(controlStopPipe[1], &stop, 1) < 0 && errno == EINTR) {
+        }
+        controlThread.join();
+        close(controlStopPipe[0]);
+        close(controlStopPipe[1]);
+        unlink(controlPath.c_str());
+    }
+
     /**
      * @return true if measurement will be active. False if xray needn't be setup
      */
@@ -199,7 +442,14 @@ namespace XRayPlugin {
         bool execNameIsFile;
         std::string fileName = SCOREP_GetExecutableName(&execNameIsFile);
         bool regionsAvailable = buildRegionsForExecutable(fileName);
+        std::string controlDir = SCOREP_Env_GetXRayControlDir();
+        if (!controlDir.empty() && SCOREP_Env_DoUnwinding()) {
+            UTILS_WARNING("The XRay control channel is not available when unwinding is enabled.");
+            controlDir.clear();
+        }
         if (regionsAvailable) {
+            // Decide before patching, so that every event passes the same handler
+            controlActive = !controlDir.empty();
             // XRay will throw errors if no function was actually instrumented
             int xrayInitSuccess = __xray_set_handler(&handleInstrumentationPoint);
             if (!xrayInitSuccess) {
@@ -207,6 +457,9 @@ namespace XRayPlugin {
                 return SCOREP_ErrorCode::SCOREP_ERROR_XRAY_INIT;
             }
             registerAndPatch();
+            if (controlActive) {
+                startControlChannel(controlDir);
+            }
         }
         return SCOREP_ErrorCode::SCOREP_SUCCESS;
     }
@@ -217,7 +470,11 @@ namespace XRayPlugin {
      * @param unpatch Whether to unpatch all sleds for a clean state
      */
     static void cleanupXRay() XRAY_INSTRUMENT_NEVER {
+        stopControlChannel();
         if (regions) {
+            // Sleds may still fire after finalization, but must not call into the measurement anymore. Threads
+            // already inside the handler may still read regionHandles, thus it is intentionally not freed
+            __xray_remove_handler();
             for (auto region: (*regions)) {
                 free((void *) region.name);
                 free((void *) region.file);
@@ -234,6 +491,16 @@ SCOREP_ErrorCode initXRayPlugin() XRAY_INSTRUMENT_NEVER {
     return XRayPlugin::initXRay();
 }
 
+void endXRayPlugin() XRAY_INSTRUMENT_NEVER {
+    XRayPlugin::stopControlChannel();
+}
+
+void deactivateXRayPluginLocation() XRAY_INSTRUMENT_NEVER {
+    if (XRayPlugin::controlActive) {
+        XRayPlugin::exitEnteredRegions();
+    }
+}
+
 void finalizeXRayPlugin() XRAY_INSTRUMENT_NEVER {
     XRayPlugin::cleanupXRay();
 }
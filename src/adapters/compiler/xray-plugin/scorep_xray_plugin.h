@@ -27,6 +27,17 @@ UTILS_BEGIN_C_DECLS
  */
 SCOREP_ErrorCode initXRayPlugin() XRAY_INSTRUMENT_NEVER;
 
+/**
+ * Stops the runtime control channel, if active. Afterwards, the set of patched functions does not change anymore
+ */
+void endXRayPlugin() XRAY_INSTRUMENT_NEVER;
+
+/**
+ * Exits the regions the current thread entered under the runtime control channel whose exit was lost by unpatching.
+ * To be called when the location of the current thread is deactivated, while events are still allowed
+ */
+void deactivateXRayPluginLocation() XRAY_INSTRUMENT_NEVER;
+
 /**
  * Finalize XRay plugin and free associated memory.
  * Note: This does not call finalize on other Score-P internal structures
@@ -1,7 +1,7 @@
 /*
  * This file is part of the Score-P software (http://www.score-p.org)
  *
- * Copyright (c) 2016-2020, 2023,
+ * Copyright (c) 2016-2020, 2023, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2021,
@@ -123,6 +123,42 @@ posix_io_vector_complete( SCOREP_IoFileHandle    handle,
  * Synchronous I/O
  */
 
+#if HAVE( POSIX_IO_SYMBOL_CHDIR )
+int
+SCOREP_LIBWRAP_FUNC_NAME( chdir )( const char* path )
+{
+    bool trigger = SCOREP_IN_MEASUREMENT_TEST_AND_INCREMENT();
+    INITIALIZE_FUNCTION_POINTER( chdir );
+    int ret;
+
+    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
+    {
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_chdir );
+
+        SCOREP_ENTER_WRAPPED_REGION();
+        ret = SCOREP_LIBWRAP_FUNC_CALL( chdir,
+                                        ( path ) );
+        SCOREP_EXIT_WRAPPED_REGION();
+
+        SCOREP_ExitRegion( scorep_posix_io_region_chdir );
+    }
+    else
+    {
+        ret = SCOREP_LIBWRAP_FUNC_CALL( chdir,
+                                        ( path ) );
+    }
+
+    if ( ret == 0 )
+    {
+        /* Relative path names resolve differently now */
+        SCOREP_IoMgmt_InvalidateIoFileHandles();
+    }
+
+    SCOREP_IN_MEASUREMENT_DECREMENT();
+    return ret;
+}
+#endif
+
 #if HAVE( POSIX_IO_SYMBOL_CLOSE )
 int
 SCOREP_LIBWRAP_FUNC_NAME( close )( int fd )
@@ -133,7 +169,7 @@ SCOREP_LIBWRAP_FUNC_NAME( close )( int fd )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_close );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_close );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                        &fd );
@@ -186,7 +222,7 @@ SCOREP_LIBWRAP_FUNC_NAME( closedir )( DIR* dirp )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_closedir );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_closedir );
 
         SCOREP_IoHandleHandle handle = SCOREP_INVALID_IO_HANDLE;
         int                   fd     = dirfd( dirp );
@@ -245,7 +281,7 @@ SCOREP_LIBWRAP_FUNC_NAME( creat )( const char* pathname, mode_t mode )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_creat );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_creat );
 
         SCOREP_IoMgmt_BeginHandleCreation( SCOREP_IO_PARADIGM_POSIX,
                                            SCOREP_IO_HANDLE_FLAG_NONE,
@@ -304,7 +340,7 @@ SCOREP_LIBWRAP_FUNC_NAME( creat64 )( const char* pathname, mode_t mode )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_creat64 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_creat64 );
 
         SCOREP_IoMgmt_BeginHandleCreation( SCOREP_IO_PARADIGM_POSIX,
                                            SCOREP_IO_HANDLE_FLAG_NONE,
@@ -362,7 +398,7 @@ SCOREP_LIBWRAP_FUNC_NAME( dup )( int oldfd )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_dup );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_dup );
 
         SCOREP_IoHandleHandle old_handle = SCOREP_IoMgmt_GetIoHandle( SCOREP_IO_PARADIGM_POSIX, &oldfd );
 
@@ -426,7 +462,7 @@ SCOREP_LIBWRAP_FUNC_NAME( dup2 )( int oldfd, int newfd )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_dup2 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_dup2 );
 
         SCOREP_IoHandleHandle new_handle = SCOREP_IoMgmt_GetIoHandle( SCOREP_IO_PARADIGM_POSIX, &newfd );
         SCOREP_IoHandleHandle old_handle = SCOREP_IoMgmt_GetIoHandle( SCOREP_IO_PARADIGM_POSIX, &oldfd );
@@ -510,7 +546,7 @@ SCOREP_LIBWRAP_FUNC_NAME( dup3 )( int oldfd, int newfd, int flags )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_dup3 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_dup3 );
 
         SCOREP_IoHandleHandle new_handle = SCOREP_IoMgmt_GetIoHandle( SCOREP_IO_PARADIGM_POSIX, &newfd );
         SCOREP_IoHandleHandle old_handle = SCOREP_IoMgmt_GetIoHandle( SCOREP_IO_PARADIGM_POSIX, &oldfd );
@@ -571,6 +607,42 @@ SCOREP_LIBWRAP_FUNC_NAME( dup3 )( int oldfd, int newfd, int flags )
 }
 #endif
 
+#if HAVE( POSIX_IO_SYMBOL_FCHDIR )
+int
+SCOREP_LIBWRAP_FUNC_NAME( fchdir )( int fd )
+{
+    bool trigger = SCOREP_IN_MEASUREMENT_TEST_AND_INCREMENT();
+    INITIALIZE_FUNCTION_POINTER( fchdir );
+    int ret;
+
+    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
+    {
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fchdir );
+
+        SCOREP_ENTER_WRAPPED_REGION();
+        ret = SCOREP_LIBWRAP_FUNC_CALL( fchdir,
+                                        ( fd ) );
+        SCOREP_EXIT_WRAPPED_REGION();
+
+        SCOREP_ExitRegion( scorep_posix_io_region_fchdir );
+    }
+    else
+    {
+        ret = SCOREP_LIBWRAP_FUNC_CALL( fchdir,
+                                        ( fd ) );
+    }
+
+    if ( ret == 0 )
+    {
+        /* Relative path names resolve differently now */
+        SCOREP_IoMgmt_InvalidateIoFileHandles();
+    }
+
+    SCOREP_IN_MEASUREMENT_DECREMENT();
+    return ret;
+}
+#endif
+
 #if HAVE( POSIX_IO_SYMBOL_FCNTL )
 int
 SCOREP_LIBWRAP_FUNC_NAME( fcntl )( int fd, int cmd, ... )
@@ -581,7 +653,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fcntl )( int fd, int cmd, ... )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fcntl );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fcntl );
     }
 
     int                   int_arg;
@@ -818,7 +890,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fdatasync )( int fd )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fdatasync );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fdatasync );
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX, &fd );
         if ( io_handle != SCOREP_INVALID_IO_HANDLE )
         {
@@ -867,7 +939,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fsync )( int fd )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fsync );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fsync );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX, &fd );
         if ( io_handle != SCOREP_INVALID_IO_HANDLE )
@@ -917,7 +989,7 @@ SCOREP_LIBWRAP_FUNC_NAME( lockf )( int fd, int cmd, off_t len )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_lockf );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_lockf );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX, &fd );
         if ( handle != SCOREP_INVALID_IO_HANDLE && cmd == F_ULOCK )
@@ -974,7 +1046,7 @@ SCOREP_LIBWRAP_FUNC_NAME( lseek )( int fd, off_t offset, int whence )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_lseek );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_lseek );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX, &fd );
 
@@ -1015,7 +1087,7 @@ SCOREP_LIBWRAP_FUNC_NAME( lseek64 )( int fd, scorep_off64_t offset, int whence )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_lseek64 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_lseek64 );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX, &fd );
 
@@ -1056,7 +1128,7 @@ SCOREP_LIBWRAP_FUNC_NAME( open )( const char* pathname, int flags, ... /* mode_t
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_open );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_open );
 
         SCOREP_IoMgmt_BeginHandleCreation( SCOREP_IO_PARADIGM_POSIX,
                                            SCOREP_IO_HANDLE_FLAG_NONE,
@@ -1138,7 +1210,7 @@ SCOREP_LIBWRAP_FUNC_NAME( open64 )( const char* pathname, int flags, ... )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_open64 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_open64 );
 
         SCOREP_IoMgmt_BeginHandleCreation( SCOREP_IO_PARADIGM_POSIX,
                                            SCOREP_IO_HANDLE_FLAG_NONE,
@@ -1218,7 +1290,7 @@ SCOREP_LIBWRAP_FUNC_NAME( openat )( int dirfd, const char* pathname, int flags,
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_openat );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_openat );
 
         SCOREP_IoMgmt_BeginHandleCreation( SCOREP_IO_PARADIGM_POSIX,
                                            SCOREP_IO_HANDLE_FLAG_NONE,
@@ -1311,9 +1383,25 @@ SCOREP_LIBWRAP_FUNC_NAME( pread )( int fd, void* buf, size_t count, off_t offset
     INITIALIZE_FUNCTION_POINTER( pread );
     ssize_t ret;
 
-    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
+    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN )
+         && SCOREP_IoMgmt_BeginAggregatedOperation( SCOREP_IO_PARADIGM_POSIX,
+                                                    &fd,
+                                                    scorep_posix_io_region_pread,
+                                                    SCOREP_IO_OPERATION_MODE_READ,
+                                                    ( uint64_t )count,
+                                                    SCOREP_BLOCKING_IO_OPERATION_MATCHING_ID_POSIX /* matching id */ ) )
+    {
+        /* Small operation, recorded as part of a summary operation */
+        SCOREP_ENTER_WRAPPED_REGION();
+        ret = SCOREP_LIBWRAP_FUNC_CALL( pread,
+                                        ( fd, buf, count, offset ) );
+        SCOREP_EXIT_WRAPPED_REGION();
+
+        SCOREP_IoMgmt_CompleteAggregatedOperation( ret > 0 ? ( uint64_t )ret : 0 );
+    }
+    else if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_pread );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_pread );
 
         /*
          * Reads up to 'count' bytes from file descriptor 'fd' at offset 'offset' (from the start of the file) into the buffer starting at 'buf'.
@@ -1368,9 +1456,25 @@ SCOREP_LIBWRAP_FUNC_NAME( pread64 )( int fd, void* buf, size_t count, scorep_off
     INITIALIZE_FUNCTION_POINTER( pread64 );
     ssize_t ret;
 
-    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
+    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN )
+         && SCOREP_IoMgmt_BeginAggregatedOperation( SCOREP_IO_PARADIGM_POSIX,
+                                                    &fd,
+                                                    scorep_posix_io_region_pread64,
+                                                    SCOREP_IO_OPERATION_MODE_READ,
+                                                    ( uint64_t )count,
+                                                    SCOREP_BLOCKING_IO_OPERATION_MATCHING_ID_POSIX /* matching id */ ) )
+    {
+        /* Small operation, recorded as part of a summary operation */
+        SCOREP_ENTER_WRAPPED_REGION();
+        ret = SCOREP_LIBWRAP_FUNC_CALL( pread64,
+                                        ( fd, buf, count, offset ) );
+        SCOREP_EXIT_WRAPPED_REGION();
+
+        SCOREP_IoMgmt_CompleteAggregatedOperation( ret > 0 ? ( uint64_t )ret : 0 );
+    }
+    else if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_pread64 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_pread64 );
 
         /*
          * Reads up to 'count' bytes from file descriptor 'fd' at offset 'offset' (from the start of the file) into the buffer starting at 'buf'.
@@ -1427,7 +1531,7 @@ SCOREP_LIBWRAP_FUNC_NAME( preadv )( int fd, const struct iovec* iov, int iovcnt,
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_preadv );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_preadv );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &fd );
@@ -1478,7 +1582,7 @@ SCOREP_LIBWRAP_FUNC_NAME( preadv2 )( int fd, const struct iovec* iov, int iovcnt
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_preadv2 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_preadv2 );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &fd );
@@ -1529,7 +1633,7 @@ SCOREP_LIBWRAP_FUNC_NAME( preadv64 )( int fd, const struct iovec* iov, int iovcn
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_preadv64 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_preadv64 );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &fd );
@@ -1580,7 +1684,7 @@ SCOREP_LIBWRAP_FUNC_NAME( preadv64v2 )( int fd, const struct iovec* iov, int iov
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_preadv64v2 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_preadv64v2 );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &fd );
@@ -1631,7 +1735,7 @@ SCOREP_LIBWRAP_FUNC_NAME( pselect )( int nfds, fd_set* readfds, fd_set* writefds
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_pselect );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_pselect );
         SCOREP_ENTER_WRAPPED_REGION();
         ret = SCOREP_LIBWRAP_FUNC_CALL( pselect,
                                         ( nfds, readfds, writefds, exceptfds, timeout, sigmask ) );
@@ -1656,9 +1760,25 @@ SCOREP_LIBWRAP_FUNC_NAME( pwrite )( int fd, const void* buf, size_t count, off_t
     INITIALIZE_FUNCTION_POINTER( pwrite );
     ssize_t ret;
 
-    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
+    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN )
+         && SCOREP_IoMgmt_BeginAggregatedOperation( SCOREP_IO_PARADIGM_POSIX,
+                                                    &fd,
+                                                    scorep_posix_io_region_pwrite,
+                                                    SCOREP_IO_OPERATION_MODE_WRITE,
+                                                    ( uint64_t )count,
+                                                    SCOREP_BLOCKING_IO_OPERATION_MATCHING_ID_POSIX /* matching id */ ) )
+    {
+        /* Small operation, recorded as part of a summary operation */
+        SCOREP_ENTER_WRAPPED_REGION();
+        ret = SCOREP_LIBWRAP_FUNC_CALL( pwrite,
+                                        ( fd, buf, count, offset ) );
+        SCOREP_EXIT_WRAPPED_REGION();
+
+        SCOREP_IoMgmt_CompleteAggregatedOperation( ret > 0 ? ( uint64_t )ret : 0 );
+    }
+    else if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_pwrite );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_pwrite );
 
         /*
          * Writes up to 'count' bytes from the buffer starting at 'buf' to the file descriptor 'fd' at offset 'offset'.
@@ -1713,9 +1833,25 @@ SCOREP_LIBWRAP_FUNC_NAME( pwrite64 )( int fd, const void* buf, size_t count, sco
     INITIALIZE_FUNCTION_POINTER( pwrite64 );
     ssize_t ret;
 
-    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
+    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN )
+         && SCOREP_IoMgmt_BeginAggregatedOperation( SCOREP_IO_PARADIGM_POSIX,
+                                                    &fd,
+                                                    scorep_posix_io_region_pwrite64,
+                                                    SCOREP_IO_OPERATION_MODE_WRITE,
+                                                    ( uint64_t )count,
+                                                    SCOREP_BLOCKING_IO_OPERATION_MATCHING_ID_POSIX /* matching id */ ) )
+    {
+        /* Small operation, recorded as part of a summary operation */
+        SCOREP_ENTER_WRAPPED_REGION();
+        ret = SCOREP_LIBWRAP_FUNC_CALL( pwrite64,
+                                        ( fd, buf, count, offset ) );
+        SCOREP_EXIT_WRAPPED_REGION();
+
+        SCOREP_IoMgmt_CompleteAggregatedOperation( ret > 0 ? ( uint64_t )ret : 0 );
+    }
+    else if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_pwrite64 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_pwrite64 );
 
         /*
          * Writes up to 'count' bytes from the buffer starting at 'buf' to the file descriptor 'fd' at offset 'offset'.
@@ -1772,7 +1908,7 @@ SCOREP_LIBWRAP_FUNC_NAME( pwritev )( int fd, const struct iovec* iov, int iovcnt
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_pwritev );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_pwritev );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &fd );
@@ -1823,7 +1959,7 @@ SCOREP_LIBWRAP_FUNC_NAME( pwritev2 )( int fd, const struct iovec* iov, int iovcn
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_pwritev2 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_pwritev2 );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &fd );
@@ -1882,7 +2018,7 @@ SCOREP_LIBWRAP_FUNC_NAME( pwritev64 )( int fd, const struct iovec* iov, int iovc
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_pwritev64 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_pwritev64 );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &fd );
@@ -1933,7 +2069,7 @@ SCOREP_LIBWRAP_FUNC_NAME( pwritev64v2 )( int fd, const struct iovec* iov, int io
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_pwritev64v2 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_pwritev64v2 );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &fd );
@@ -1990,9 +2126,25 @@ SCOREP_LIBWRAP_FUNC_NAME( read )( int fd, void* buf, size_t count )
     INITIALIZE_FUNCTION_POINTER( read );
     ssize_t ret;
 
-    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
+    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN )
+         && SCOREP_IoMgmt_BeginAggregatedOperation( SCOREP_IO_PARADIGM_POSIX,
+                                                    &fd,
+                                                    scorep_posix_io_region_read,
+                                                    SCOREP_IO_OPERATION_MODE_READ,
+                                                    ( uint64_t )count,
+                                                    SCOREP_BLOCKING_IO_OPERATION_MATCHING_ID_POSIX /* matching id */ ) )
+    {
+        /* Small operation, recorded as part of a summary operation */
+        SCOREP_ENTER_WRAPPED_REGION();
+        ret = SCOREP_LIBWRAP_FUNC_CALL( read,
+                                        ( fd, buf, count ) );
+        SCOREP_EXIT_WRAPPED_REGION();
+
+        SCOREP_IoMgmt_CompleteAggregatedOperation( ret > 0 ? ( uint64_t )ret : 0 );
+    }
+    else if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_read );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_read );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &fd );
@@ -2043,7 +2195,7 @@ SCOREP_LIBWRAP_FUNC_NAME( readv )( int fd, const struct iovec* iov, int iovcnt )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_readv );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_readv );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &fd );
@@ -2084,6 +2236,42 @@ SCOREP_LIBWRAP_FUNC_NAME( readv )( int fd, const struct iovec* iov, int iovcnt )
 }
 #endif
 
+#if HAVE( POSIX_IO_SYMBOL_RENAMEAT )
+int
+SCOREP_LIBWRAP_FUNC_NAME( renameat )( int olddirfd, const char* oldpath, int newdirfd, const char* newpath )
+{
+    bool trigger = SCOREP_IN_MEASUREMENT_TEST_AND_INCREMENT();
+    INITIALIZE_FUNCTION_POINTER( renameat );
+    int ret;
+
+    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
+    {
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_renameat );
+
+        SCOREP_ENTER_WRAPPED_REGION();
+        ret = SCOREP_LIBWRAP_FUNC_CALL( renameat,
+                                        ( olddirfd, oldpath, newdirfd, newpath ) );
+        SCOREP_EXIT_WRAPPED_REGION();
+
+        SCOREP_ExitRegion( scorep_posix_io_region_renameat );
+    }
+    else
+    {
+        ret = SCOREP_LIBWRAP_FUNC_CALL( renameat,
+                                        ( olddirfd, oldpath, newdirfd, newpath ) );
+    }
+
+    if ( ret == 0 )
+    {
+        /* Path names may refer to different files now */
+        SCOREP_IoMgmt_InvalidateIoFileHandles();
+    }
+
+    SCOREP_IN_MEASUREMENT_DECREMENT();
+    return ret;
+}
+#endif
+
 #if HAVE( POSIX_IO_SYMBOL_SELECT )
 int
 SCOREP_LIBWRAP_FUNC_NAME( select )( int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds, struct timeval* timeout )
@@ -2094,7 +2282,7 @@ SCOREP_LIBWRAP_FUNC_NAME( select )( int nfds, fd_set* readfds, fd_set* writefds,
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_select );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_select );
         SCOREP_ENTER_WRAPPED_REGION();
         ret = SCOREP_LIBWRAP_FUNC_CALL( select,
                                         ( nfds, readfds, writefds, exceptfds, timeout ) );
@@ -2120,7 +2308,7 @@ SCOREP_LIBWRAP_FUNC_NAME( sync )( void )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_sync );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_sync );
 
         SCOREP_IoMgmt_PushHandle( scorep_posix_io_sync_all_handle );
 
@@ -2164,7 +2352,7 @@ SCOREP_LIBWRAP_FUNC_NAME( syncfs )( int fd )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_syncfs );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_syncfs );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &fd );
@@ -2215,7 +2403,7 @@ SCOREP_LIBWRAP_FUNC_NAME( unlink )( const char* pathname )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_unlink );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_unlink );
 
         SCOREP_IoFileHandle file_handle = SCOREP_IoMgmt_GetIoFileHandle( pathname );
 
@@ -2237,6 +2425,12 @@ SCOREP_LIBWRAP_FUNC_NAME( unlink )( const char* pathname )
         ret = SCOREP_LIBWRAP_FUNC_CALL( unlink,
                                         ( pathname ) );
     }
+    if ( ret == 0 )
+    {
+        /* Path names may refer to different files now */
+        SCOREP_IoMgmt_InvalidateIoFileHandles();
+    }
+
     SCOREP_IN_MEASUREMENT_DECREMENT();
     return ret;
 }
@@ -2252,7 +2446,7 @@ SCOREP_LIBWRAP_FUNC_NAME( unlinkat )( int dirfd, const char* pathname, int flags
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_unlinkat );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_unlinkat );
 
         char                  file_path[ PATH_MAX ];
         SCOREP_IoFileHandle   file_handle      = SCOREP_INVALID_IO_FILE;
@@ -2297,6 +2491,12 @@ SCOREP_LIBWRAP_FUNC_NAME( unlinkat )( int dirfd, const char* pathname, int flags
         ret = SCOREP_LIBWRAP_FUNC_CALL( unlinkat,
                                         ( dirfd, pathname, flags ) );
     }
+    if ( ret == 0 )
+    {
+        /* Path names may refer to different files now */
+        SCOREP_IoMgmt_InvalidateIoFileHandles();
+    }
+
     SCOREP_IN_MEASUREMENT_DECREMENT();
     return ret;
 }
@@ -2310,9 +2510,25 @@ SCOREP_LIBWRAP_FUNC_NAME( write )( int fd, const void* buf, size_t count )
     INITIALIZE_FUNCTION_POINTER( write );
     ssize_t ret;
 
-    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
+    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN )
+         && SCOREP_IoMgmt_BeginAggregatedOperation( SCOREP_IO_PARADIGM_POSIX,
+                                                    &fd,
+                                                    scorep_posix_io_region_write,
+                                                    SCOREP_IO_OPERATION_MODE_WRITE,
+                                                    ( uint64_t )count,
+                                                    SCOREP_BLOCKING_IO_OPERATION_MATCHING_ID_POSIX /* matching id */ ) )
+    {
+        /* Small operation, recorded as part of a summary operation */
+        SCOREP_ENTER_WRAPPED_REGION();
+        ret = SCOREP_LIBWRAP_FUNC_CALL( write,
+                                        ( fd, buf, count ) );
+        SCOREP_EXIT_WRAPPED_REGION();
+
+        SCOREP_IoMgmt_CompleteAggregatedOperation( ret > 0 ? ( uint64_t )ret : 0 );
+    }
+    else if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_write );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_write );
 
         SCOREP_IoFileHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                      &fd );
@@ -2362,7 +2578,7 @@ SCOREP_LIBWRAP_FUNC_NAME( writev )( int fd, const struct iovec* iov, int iovcnt
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_writev );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_writev );
 
         SCOREP_IoFileHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                      &fd );
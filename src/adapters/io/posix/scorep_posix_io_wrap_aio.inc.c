@@ -58,7 +58,7 @@ SCOREP_LIBWRAP_FUNC_NAME( aio_cancel )( int fd, struct aiocb* aiocbp )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_aio_cancel );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_aio_cancel );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                        &fd );
@@ -106,7 +106,7 @@ SCOREP_LIBWRAP_FUNC_NAME( aio_error )( const struct aiocb* aiocbp )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_aio_error );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_aio_error );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                        &( aiocbp->aio_fildes ) );
@@ -159,7 +159,7 @@ SCOREP_LIBWRAP_FUNC_NAME( aio_fsync )( int op, struct aiocb* aiocbp )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_aio_fsync );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_aio_fsync );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_INVALID_IO_HANDLE;
 
@@ -198,7 +198,7 @@ SCOREP_LIBWRAP_FUNC_NAME( aio_read )( struct aiocb* aiocbp )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_aio_read );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_aio_read );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &( aiocbp->aio_fildes ) );
@@ -250,7 +250,7 @@ SCOREP_LIBWRAP_FUNC_NAME( aio_return )( struct aiocb* aiocbp )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_aio_return );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_aio_return );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                        &( aiocbp->aio_fildes ) );
@@ -295,7 +295,7 @@ SCOREP_LIBWRAP_FUNC_NAME( aio_suspend )( const struct aiocb* const aiocb_list[],
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_aio_suspend );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_aio_suspend );
         SCOREP_ENTER_WRAPPED_REGION();
         ret = SCOREP_LIBWRAP_FUNC_CALL( aio_suspend,
                                         ( aiocb_list, nitems, timeout ) );
@@ -322,7 +322,7 @@ SCOREP_LIBWRAP_FUNC_NAME( aio_write )( struct aiocb* aiocbp )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_aio_write );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_aio_write );
 
         SCOREP_IoHandleHandle io_handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_POSIX,
                                                                           &( aiocbp->aio_fildes ) );
@@ -376,7 +376,7 @@ SCOREP_LIBWRAP_FUNC_NAME( lio_listio )( int mode, struct aiocb* const aiocb_list
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) && ( aio_translate_mode( mode, &io_operation_flags ) != -1 ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_lio_listio );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_lio_listio );
 
         struct aiocb*          aiocbp;
         SCOREP_IoHandleHandle  handle;
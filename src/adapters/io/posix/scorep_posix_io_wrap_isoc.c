@@ -1,7 +1,7 @@
 /*
  * This file is part of the Score-P software (http://www.score-p.org)
  *
- * Copyright (c) 2016-2020, 2023,
+ * Copyright (c) 2016-2020, 2023, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2022,
@@ -211,7 +211,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fclose )( FILE* fp )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fclose );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fclose );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_RemoveHandle( SCOREP_IO_PARADIGM_ISOC,
                                                                    &fp );
@@ -282,7 +282,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fdopen )( int fd, const char* mode )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fdopen );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fdopen );
 
         SCOREP_IoHandleHandle fd_handle = SCOREP_IoMgmt_GetIoHandle( SCOREP_IO_PARADIGM_POSIX, &fd );
         SCOREP_IoMgmt_BeginHandleCreation( SCOREP_IO_PARADIGM_ISOC,
@@ -336,7 +336,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fflush )( FILE* stream )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fflush );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fflush );
 
         SCOREP_IoHandleHandle io_handle;
         if ( stream == NULL )
@@ -396,7 +396,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fgetc )( FILE* stream )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fgetc );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fgetc );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
@@ -446,7 +446,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fgetpos )( FILE* stream, fpos_t* pos )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fgetpos );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fgetpos );
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
         SCOREP_ENTER_WRAPPED_REGION();
         ret = SCOREP_LIBWRAP_FUNC_CALL( fgetpos,
@@ -475,7 +475,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fgets )( char* s, int size, FILE* stream )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fgets );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fgets );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
@@ -524,7 +524,7 @@ SCOREP_LIBWRAP_FUNC_NAME( flockfile )( FILE* filehandle )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_flockfile );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_flockfile );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &filehandle );
 
@@ -582,7 +582,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fopen )( const char* path, const char* mode )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fopen );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fopen );
 
         SCOREP_IoMgmt_BeginHandleCreation( SCOREP_IO_PARADIGM_ISOC,
                                            SCOREP_IO_HANDLE_FLAG_NONE,
@@ -679,7 +679,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fopen64 )( const char* path, const char* mode )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fopen64 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fopen64 );
 
         SCOREP_IoMgmt_BeginHandleCreation( SCOREP_IO_PARADIGM_ISOC,
                                            SCOREP_IO_HANDLE_FLAG_NONE,
@@ -748,7 +748,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fputc )( int c, FILE* stream )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fputc );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fputc );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
@@ -798,7 +798,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fprintf )( FILE* stream, const char* format, ... )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fprintf );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fprintf );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
@@ -856,7 +856,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fputs )( const char* s, FILE* stream )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fputs );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fputs );
 
         uint64_t              length = ( uint64_t )strlen( s );
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
@@ -907,7 +907,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fread )( void* ptr, size_t size, size_t nmemb, FILE* s
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fread );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fread );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
@@ -957,7 +957,7 @@ SCOREP_LIBWRAP_FUNC_NAME( freopen )( const char* path, const char* mode, FILE* s
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_freopen );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_freopen );
 
         // Case: stream will be closed by freopen
         SCOREP_IoHandleHandle old_handle = SCOREP_IoMgmt_RemoveHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
@@ -1035,7 +1035,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fscanf )( FILE* stream, const char* format, ... )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fscanf );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fscanf );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
 
@@ -1095,7 +1095,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fseek )( FILE* stream, long offset, int whence )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fseek );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fseek );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
 
@@ -1139,7 +1139,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fseeko )( FILE* stream, off_t offset, int whence )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fseeko );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fseeko );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
 
@@ -1181,7 +1181,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fseeko64 )( FILE* stream, scorep_off64_t offset, int w
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fseeko64 );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fseeko64 );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
 
@@ -1223,7 +1223,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fsetpos )( FILE* stream, const fpos_t* pos )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fsetpos );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fsetpos );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
 
@@ -1265,7 +1265,7 @@ SCOREP_LIBWRAP_FUNC_NAME( ftell )( FILE* stream )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_ftell );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_ftell );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
 
@@ -1298,7 +1298,7 @@ SCOREP_LIBWRAP_FUNC_NAME( ftello )( FILE* stream )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_ftello );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_ftello );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
 
@@ -1331,7 +1331,7 @@ SCOREP_LIBWRAP_FUNC_NAME( ftrylockfile )( FILE* filehandle )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_ftrylockfile );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_ftrylockfile );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &filehandle );
 
@@ -1375,7 +1375,7 @@ SCOREP_LIBWRAP_FUNC_NAME( funlockfile )( FILE* filehandle )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_funlockfile );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_funlockfile );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &filehandle );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
@@ -1411,7 +1411,7 @@ SCOREP_LIBWRAP_FUNC_NAME( fwrite )( const void* ptr, size_t size, size_t nmemb,
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_fwrite );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_fwrite );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
@@ -1462,7 +1462,7 @@ SCOREP_LIBWRAP_FUNC_NAME( getc )( FILE* stream )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_getc );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_getc );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
@@ -1512,7 +1512,7 @@ SCOREP_LIBWRAP_FUNC_NAME( getchar )( void )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_getchar );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_getchar );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stdin );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
@@ -1562,7 +1562,7 @@ SCOREP_LIBWRAP_FUNC_NAME( gets )( char* s )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_gets );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_gets );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stdin );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
@@ -1612,7 +1612,7 @@ SCOREP_LIBWRAP_FUNC_NAME( printf )( const char* format, ... )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_printf );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_printf );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stdout );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
@@ -1668,7 +1668,7 @@ SCOREP_LIBWRAP_FUNC_NAME( putchar )( int c )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_putchar );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_putchar );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stdout );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
@@ -1720,7 +1720,7 @@ SCOREP_LIBWRAP_FUNC_NAME( puts )( const char* s )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_puts );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_puts );
 
         uint64_t              length = ( uint64_t )strlen( s ) + 1 /* terminating null byte */;
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stdout );
@@ -1771,7 +1771,7 @@ SCOREP_LIBWRAP_FUNC_NAME( remove )( const char* pathname )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_remove );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_remove );
 
         SCOREP_IoFileHandle file_handle = SCOREP_IoMgmt_GetIoFileHandle( pathname );
 
@@ -1791,6 +1791,48 @@ SCOREP_LIBWRAP_FUNC_NAME( remove )( const char* pathname )
     {
         ret = SCOREP_LIBWRAP_FUNC_CALL( remove, ( pathname ) );
     }
+    if ( ret == 0 )
+    {
+        /* Path names may refer to different files now */
+        SCOREP_IoMgmt_InvalidateIoFileHandles();
+    }
+
+    SCOREP_IN_MEASUREMENT_DECREMENT();
+    return ret;
+}
+#endif
+
+#if HAVE( POSIX_IO_SYMBOL_RENAME )
+int
+SCOREP_LIBWRAP_FUNC_NAME( rename )( const char* oldpath, const char* newpath )
+{
+    bool trigger = SCOREP_IN_MEASUREMENT_TEST_AND_INCREMENT();
+    INITIALIZE_FUNCTION_POINTER( rename );
+    int ret;
+
+    if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
+    {
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_rename );
+
+        SCOREP_ENTER_WRAPPED_REGION();
+        ret = SCOREP_LIBWRAP_FUNC_CALL( rename,
+                                        ( oldpath, newpath ) );
+        SCOREP_EXIT_WRAPPED_REGION();
+
+        SCOREP_ExitRegion( scorep_posix_io_region_rename );
+    }
+    else
+    {
+        ret = SCOREP_LIBWRAP_FUNC_CALL( rename,
+                                        ( oldpath, newpath ) );
+    }
+
+    if ( ret == 0 )
+    {
+        /* Path names may refer to different files now */
+        SCOREP_IoMgmt_InvalidateIoFileHandles();
+    }
+
     SCOREP_IN_MEASUREMENT_DECREMENT();
     return ret;
 }
@@ -1805,7 +1847,7 @@ SCOREP_LIBWRAP_FUNC_NAME( rewind )( FILE* stream )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_rewind );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_rewind );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
 
@@ -1845,7 +1887,7 @@ SCOREP_LIBWRAP_FUNC_NAME( scanf )( const char* format, ... )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_scanf );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_scanf );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, stdin );
 
@@ -1904,7 +1946,7 @@ SCOREP_LIBWRAP_FUNC_NAME( ungetc )( int c, FILE* stream )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_ungetc );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_ungetc );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
 
@@ -1937,7 +1979,7 @@ SCOREP_LIBWRAP_FUNC_NAME( vfprintf )( FILE* stream, const char* format, va_list
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_vfprintf );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_vfprintf );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
 
@@ -1988,7 +2030,7 @@ SCOREP_LIBWRAP_FUNC_NAME( vfscanf )( FILE* stream, const char* format, va_list a
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_vfscanf );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_vfscanf );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stream );
 
@@ -2039,7 +2081,7 @@ SCOREP_LIBWRAP_FUNC_NAME( vscanf )( const char* format, va_list ap )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_vscanf );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_vscanf );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stdin );
 
@@ -2090,7 +2132,7 @@ SCOREP_LIBWRAP_FUNC_NAME( vprintf )( const char* format, va_list ap )
 
     if ( trigger && SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
     {
-        SCOREP_EnterWrappedRegion( scorep_posix_io_region_vprintf );
+        SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( scorep_posix_io_region_vprintf );
 
         SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetAndPushHandle( SCOREP_IO_PARADIGM_ISOC, &stdout );
         if ( handle != SCOREP_INVALID_IO_HANDLE )
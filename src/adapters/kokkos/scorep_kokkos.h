@@ -47,9 +47,12 @@ extern size_t scorep_kokkos_subsystem_id;
 SCOREP_RmaWindowHandle
 scorep_kokkos_define_rma_win( void );
 
+struct scorep_kokkos_region_cache_entry;
+
 typedef struct scorep_kokkos_cpu_location_data
 {
-    bool active_deep_copy;
+    bool                                     active_deep_copy;
+    struct scorep_kokkos_region_cache_entry* region_cache;
 } scorep_kokkos_cpu_location_data;
 
 typedef struct scorep_kokkos_gpu_location_data
@@ -1,7 +1,7 @@
 /*
  * This file is part of the Score-P software (http://www.score-p.org)
  *
- * Copyright (c) 2020, 2022,
+ * Copyright (c) 2020, 2022, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2022,
@@ -24,6 +24,8 @@
 #include <SCOREP_RuntimeManagement.h>
 #include <SCOREP_Definitions.h>
 #include <SCOREP_Events.h>
+#include <SCOREP_Location.h>
+#include <SCOREP_Memory.h>
 #include <SCOREP_InMeasurement.h>
 #include <SCOREP_Filtering.h>
 #include <SCOREP_Task.h>
@@ -34,6 +36,7 @@
 #define SCOREP_DEBUG_MODULE_NAME KOKKOS
 #include <UTILS_Debug.h>
 
+#include <UTILS_Atomic.h>
 #include <UTILS_CStr.h>
 #include <UTILS_Mutex.h>
 
@@ -99,6 +102,7 @@ typedef struct scorep_kokkos_region_node
 {
     struct scorep_kokkos_region_node* next;   /**< bucket for collision */
     SCOREP_RegionHandle               region; /**< associated region handle */
+    const char*                       name;   /**< name of the region, owned by the definition */
     uint32_t                          hash;   /**< hash of string for faster comparison */
     scorep_kokkos_group               group;  /**< ID of group for the region, also part of comparsion */
 } scorep_kokkos_region_node;
@@ -107,9 +111,35 @@ typedef struct scorep_kokkos_region_node
 #define KOKKOS_REGION_HASH_MASK  hashmask( KOKKOS_REGION_HASH_SHIFT )
 #define KOKKOS_REGION_HASH_SIZE  hashsize( KOKKOS_REGION_HASH_SHIFT )
 
+/*
+ * Nodes are only ever prepended to a bucket and never removed. Readers load
+ * the bucket head with acquire semantics and walk it without locking, the
+ * mutex only serializes inserts.
+ */
 static scorep_kokkos_region_node* kokkos_regions_hashtab[ KOKKOS_REGION_HASH_SIZE ];
 static UTILS_Mutex                kokkos_regions_hashtab_mutex;
 
+/*
+ * Per-location, direct-mapped cache in front of the name decoding, the
+ * filter, and the hash table. Kokkos usually passes the same name pointer
+ * for repeated launches of a kernel, thus the slot is selected by the
+ * pointer value. As the pointer may be reused for a different string, a
+ * copy of the name is kept to validate a hit.
+ */
+typedef struct scorep_kokkos_region_cache_entry
+{
+    const char*         name;          /**< name pointer as passed by Kokkos */
+    uint64_t            name_prefix;   /**< first 8 bytes of @a name, see name_prefix() */
+    char*               name_copy;     /**< contents of @a name when cached */
+    size_t              copy_capacity; /**< size of the @a name_copy buffer */
+    scorep_kokkos_group group;         /**< Kokkos group of the region */
+    SCOREP_RegionHandle region;        /**< region handle or SCOREP_FILTERED_REGION */
+} scorep_kokkos_region_cache_entry;
+
+#define KOKKOS_REGION_CACHE_SHIFT 6
+#define KOKKOS_REGION_CACHE_SIZE  ( 1 << KOKKOS_REGION_CACHE_SHIFT )
+#define KOKKOS_REGION_CACHE_MASK  ( KOKKOS_REGION_CACHE_SIZE - 1 )
+
 static const char*
 scorep_kokkos_group_name( scorep_kokkos_group group )
 {
@@ -148,29 +178,51 @@ scorep_kokkos_group_region_type( scorep_kokkos_group group )
     }
 }
 
+static scorep_kokkos_region_node*
+find_region_node( scorep_kokkos_region_node* node,
+                  scorep_kokkos_region_node* end,
+                  uint32_t                   hash,
+                  scorep_kokkos_group        group,
+                  const char*                name )
+{
+    while ( node != end )
+    {
+        if ( hash == node->hash
+             && group == node->group
+             && strcmp( node->name, name ) == 0 )
+        {
+            return node;
+        }
+
+        node = node->next;
+    }
+
+    return NULL;
+}
+
 static SCOREP_RegionHandle
 get_region( scorep_kokkos_group group,
             const char*         name,
             const char*         mangledName )
 {
-    UTILS_MutexLock( &kokkos_regions_hashtab_mutex );
-
     uint32_t hash = jenkins_hash( name, strlen( name ), 0 );
     uint32_t id   = hash & KOKKOS_REGION_HASH_MASK;
 
-    scorep_kokkos_region_node* node = kokkos_regions_hashtab[ id ];
-    while ( node )
+    scorep_kokkos_region_node* head =
+        UTILS_Atomic_LoadN_void_ptr( &kokkos_regions_hashtab[ id ],
+                                     UTILS_ATOMIC_ACQUIRE );
+    scorep_kokkos_region_node* node =
+        find_region_node( head, NULL, hash, group, name );
+    if ( node )
     {
-        if ( hash == node->hash
-             && group == node->group
-             && strcmp( SCOREP_RegionHandle_GetName( node->region ), name ) == 0 )
-        {
-            break;
-        }
-
-        node = node->next;
+        return node->region;
     }
 
+    UTILS_MutexLock( &kokkos_regions_hashtab_mutex );
+
+    /* Only nodes inserted since the unlocked search need to be checked. */
+    scorep_kokkos_region_node* new_head = kokkos_regions_hashtab[ id ];
+    node = find_region_node( new_head, head, hash, group, name );
     if ( !node )
     {
         SCOREP_RegionHandle region_handle =
@@ -183,11 +235,14 @@ get_region( scorep_kokkos_group group,
                                           scorep_kokkos_group_region_type( group ) );
         SCOREP_RegionHandle_SetGroup( region_handle, scorep_kokkos_group_name( group ) );
 
-        node                         = SCOREP_Memory_AllocForMisc( sizeof( *node ) );
-        node->region                 = region_handle;
-        node->hash                   = hash;
-        node->next                   = kokkos_regions_hashtab[ id ];
-        kokkos_regions_hashtab[ id ] = node;
+        node         = SCOREP_Memory_AllocForMisc( sizeof( *node ) );
+        node->region = region_handle;
+        node->name   = SCOREP_RegionHandle_GetName( region_handle );
+        node->hash   = hash;
+        node->group  = group;
+        node->next   = new_head;
+        UTILS_Atomic_StoreN_void_ptr( &kokkos_regions_hashtab[ id ], node,
+                                      UTILS_ATOMIC_RELEASE );
     }
     SCOREP_RegionHandle region = node->region;
 
@@ -311,6 +366,107 @@ decode_parallel_region_name( const char** name )
     return result;
 }
 
+static bool
+is_parallel_group( scorep_kokkos_group group )
+{
+    return group == scorep_kokkos_parallel_for
+           || group == scorep_kokkos_parallel_scan
+           || group == scorep_kokkos_parallel_reduce;
+}
+
+/*
+ * Packs the first 8 characters of @a name into an integer, zero-padded after
+ * the terminator. Thus the top byte is zero if @a name is shorter than 8
+ * characters, and equal prefixes mean equal names then.
+ */
+static inline uint64_t
+name_prefix( const char* name )
+{
+    uint64_t prefix = 0;
+    for ( int i = 0; i < 8 && name[ i ]; i++ )
+    {
+        prefix |= ( uint64_t )( unsigned char )name[ i ] << ( 8 * i );
+    }
+    return prefix;
+}
+
+/*
+ * Returns the region handle for the Kokkos name @a name in group @a group,
+ * or SCOREP_FILTERED_REGION if the region is filtered. Repeated calls with
+ * the same name pointer are served from the location's region cache without
+ * decoding, filtering, hashing, or locking.
+ */
+static SCOREP_RegionHandle
+lookup_region( scorep_kokkos_group group,
+               const char*         name )
+{
+    SCOREP_Location*                 location = SCOREP_Location_GetCurrentCPULocation();
+    scorep_kokkos_cpu_location_data* data     =
+        SCOREP_Location_GetSubsystemData( location, scorep_kokkos_subsystem_id );
+
+    if ( data->region_cache == NULL )
+    {
+        size_t cache_size = KOKKOS_REGION_CACHE_SIZE * sizeof( *data->region_cache );
+        data->region_cache = SCOREP_Location_AllocForMisc( location, cache_size );
+        memset( data->region_cache, 0, cache_size );
+    }
+
+    /* A hit needs the same pointer and prefix, only the remainder of longer
+     * names is compared with the copy. */
+    uint32_t slot = ( ( ( uintptr_t )name >> 4 ) ^ group ) & KOKKOS_REGION_CACHE_MASK;
+    scorep_kokkos_region_cache_entry* entry  = &data->region_cache[ slot ];
+    uint64_t                          prefix = name_prefix( name );
+    if ( entry->name == name
+         && entry->group == group
+         && entry->name_prefix == prefix
+         && ( ( prefix >> 56 ) == 0 || strcmp( entry->name_copy + 8, name + 8 ) == 0 ) )
+    {
+        return entry->region;
+    }
+
+    SCOREP_RegionHandle region;
+    if ( is_parallel_group( group ) )
+    {
+        const char* mangled_name = name;
+        const char* region_name  = decode_parallel_region_name( &mangled_name );
+        if ( SCOREP_Filtering_MatchFunction( region_name, mangled_name ) )
+        {
+            region = SCOREP_FILTERED_REGION;
+        }
+        else
+        {
+            region = get_region( group, region_name, mangled_name );
+        }
+        if ( mangled_name )
+        {
+            free( ( char* )region_name );
+        }
+    }
+    else if ( SCOREP_Filtering_MatchFunction( name, NULL ) )
+    {
+        region = SCOREP_FILTERED_REGION;
+    }
+    else
+    {
+        region = get_region( group, name, NULL );
+    }
+
+    /* Replace the slot, reusing its name buffer if the new name fits. */
+    size_t name_length = strlen( name ) + 1;
+    if ( entry->copy_capacity < name_length )
+    {
+        entry->name_copy     = SCOREP_Location_AllocForMisc( location, name_length );
+        entry->copy_capacity = name_length;
+    }
+    memcpy( entry->name_copy, name, name_length );
+    entry->name        = name;
+    entry->name_prefix = prefix;
+    entry->group       = group;
+    entry->region      = region;
+
+    return region;
+}
+
 static void
 recording_setup( void )
 {
@@ -455,26 +611,15 @@ kokkosp_begin_parallel_for( const char*    name,
         return;
     }
 
-    const char* region_name = decode_parallel_region_name( &name );
-    if ( SCOREP_Filtering_MatchFunction( region_name, name ) )
+    SCOREP_RegionHandle region = lookup_region( scorep_kokkos_parallel_for, name );
+    if ( region == SCOREP_FILTERED_REGION )
     {
-        if ( name )
-        {
-            free( ( char* )region_name );
-        }
         UTILS_DEBUG( "[Kokkos] parallel_for %s filtered\n", name );
         *kID = SCOREP_FILTERED_REGION;
         SCOREP_IN_MEASUREMENT_DECREMENT();
         return;
     }
 
-    SCOREP_RegionHandle region = get_region( scorep_kokkos_parallel_for,
-                                             region_name, name );
-    if ( name )
-    {
-        free( ( char* )region_name );
-    }
-
     *kID = ( uint64_t )region;
     SCOREP_EnterRegion( region );
 
@@ -525,26 +670,15 @@ kokkosp_begin_parallel_scan( const char*    name,
         return;
     }
 
-    const char* region_name = decode_parallel_region_name( &name );
-    if ( SCOREP_Filtering_MatchFunction( region_name, name ) )
+    SCOREP_RegionHandle region = lookup_region( scorep_kokkos_parallel_scan, name );
+    if ( region == SCOREP_FILTERED_REGION )
     {
-        if ( name )
-        {
-            free( ( char* )region_name );
-        }
         UTILS_DEBUG( "[Kokkos] parallel_scan %s filtered\n", name );
         *kID = SCOREP_FILTERED_REGION;
         SCOREP_IN_MEASUREMENT_DECREMENT();
         return;
     }
 
-    SCOREP_RegionHandle region = get_region( scorep_kokkos_parallel_scan,
-                                             region_name, name );
-    if ( name )
-    {
-        free( ( char* )region_name );
-    }
-
     *kID = ( uint64_t )region;
     SCOREP_EnterRegion( region );
 
@@ -594,26 +728,15 @@ kokkosp_begin_parallel_reduce( const char*    name,
         return;
     }
 
-    const char* region_name = decode_parallel_region_name( &name );
-    if ( SCOREP_Filtering_MatchFunction( region_name, name ) )
+    SCOREP_RegionHandle region = lookup_region( scorep_kokkos_parallel_reduce, name );
+    if ( region == SCOREP_FILTERED_REGION )
     {
-        if ( name )
-        {
-            free( ( char* )region_name );
-        }
         UTILS_DEBUG( "[Kokkos] parallel_reduce %s filtered\n", name );
         *kID = SCOREP_FILTERED_REGION;
         SCOREP_IN_MEASUREMENT_DECREMENT();
         return;
     }
 
-    SCOREP_RegionHandle region = get_region( scorep_kokkos_parallel_reduce,
-                                             region_name, name );
-    if ( name )
-    {
-        free( ( char* )region_name );
-    }
-
     *kID = ( uint64_t )region;
     SCOREP_EnterRegion( region );
 
@@ -845,16 +968,14 @@ kokkosp_push_profile_region( const char* name )
         return;
     }
 
-    if ( SCOREP_Filtering_MatchFunction( name, NULL ) )
+    SCOREP_RegionHandle region = lookup_region( scorep_kokkos_profile_region, name );
+    if ( region == SCOREP_FILTERED_REGION )
     {
         SCOREP_Task_Enter( SCOREP_Location_GetCurrentCPULocation(), SCOREP_FILTERED_REGION );
         SCOREP_IN_MEASUREMENT_DECREMENT();
         return;
     }
 
-    SCOREP_RegionHandle region = get_region( scorep_kokkos_profile_region,
-                                             name, NULL );
-
     SCOREP_EnterRegion( region );
 
     SCOREP_IN_MEASUREMENT_DECREMENT();
@@ -934,14 +1055,7 @@ kokkosp_create_profile_section( const char* name,
         return;
     }
 
-    if ( SCOREP_Filtering_MatchFunction( name, NULL ) )
-    {
-        *sectionId = SCOREP_FILTERED_REGION;
-        SCOREP_IN_MEASUREMENT_DECREMENT();
-        return;
-    }
-
-    *sectionId = get_region( scorep_kokkos_profile_section, name, NULL );
+    *sectionId = lookup_region( scorep_kokkos_profile_section, name );
 
     SCOREP_IN_MEASUREMENT_DECREMENT();
 }
@@ -76,6 +76,7 @@ init_host_location( SCOREP_Location* location )
 {
     scorep_kokkos_cpu_location_data* data = SCOREP_Memory_AllocForMisc( sizeof( *data ) );
     data->active_deep_copy = false;
+    data->region_cache     = NULL;
     SCOREP_Location_SetSubsystemData( location, scorep_kokkos_subsystem_id, data );
 }
 
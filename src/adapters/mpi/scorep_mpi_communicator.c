@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2013, 2016, 2020, 2022,
+ * Copyright (c) 2009-2013, 2016, 2020, 2022, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -40,6 +40,9 @@
 #include "scorep_mpi_communicator_mgmt.h"
 #include "SCOREP_Mpi.h"
 #include <SCOREP_Definitions.h>
+#include <SCOREP_FastHashtab.h>
+#include <SCOREP_Memory.h>
+#include <jenkins_hash.h>
 
 #include <UTILS_Error.h>
 #include <UTILS_Mutex.h>
@@ -79,8 +82,7 @@ extern uint64_t scorep_mpi_max_windows;
 
 /**
  *  @internal
- *  Index in the scorep_mpi_windows array of last valid entry in window tracking data
- *  structure.
+ *  Number of tracked windows.
  */
 static int32_t scorep_mpi_last_window = 0;
 
@@ -90,6 +92,57 @@ static int32_t scorep_mpi_last_window = 0;
  */
 extern UTILS_Mutex scorep_mpi_window_mutex;
 
+/*
+ * Window tracking data structure. Maps the MPI window handles to the
+ * Score-P handles. Lookups do not take a lock, inserts and removes are
+ * still serialized by scorep_mpi_window_mutex.
+ */
+typedef MPI_Win                win_table_key_t;
+typedef SCOREP_RmaWindowHandle win_table_value_t;
+
+#define WIN_TABLE_HASH_EXPONENT 8
+
+static inline uint32_t
+win_table_bucket_idx( win_table_key_t key )
+{
+    return jenkins_hash( &key, sizeof( key ), 0 ) & hashmask( WIN_TABLE_HASH_EXPONENT );
+}
+
+static inline bool
+win_table_equals( win_table_key_t key1,
+                  win_table_key_t key2 )
+{
+    return key1 == key2;
+}
+
+static inline void*
+win_table_allocate_chunk( size_t chunkSize )
+{
+    return SCOREP_Memory_AlignedAllocForMisc( SCOREP_CACHELINESIZE, chunkSize );
+}
+
+static inline void
+win_table_free_chunk( void* chunk )
+{
+}
+
+static inline win_table_value_t
+win_table_value_ctor( win_table_key_t* key,
+                      const void*      ctorData )
+{
+    return *( const win_table_value_t* )ctorData;
+}
+
+static inline void
+win_table_value_dtor( win_table_key_t   key,
+                      win_table_value_t value )
+{
+}
+
+SCOREP_HASH_TABLE_NON_MONOTONIC( win_table, 7, hashsize( WIN_TABLE_HASH_EXPONENT ) );
+
+#undef WIN_TABLE_HASH_EXPONENT
+
 #endif // !SCOREP_MPI_NO_RMA
 
 /* ------------------------------------------- Definitions for communicators and groups */
@@ -174,11 +227,18 @@ scorep_mpi_win_create( const char* name,
                                               SCOREP_MPI_COMM_HANDLE( comm ),
                                               SCOREP_RMA_WINDOW_FLAG_CREATE_DESTROY_EVENTS );
 
-    /* enter win in scorep_mpi_windows[] array */
-    scorep_mpi_windows[ scorep_mpi_last_window ].win    = win;
-    scorep_mpi_windows[ scorep_mpi_last_window ].handle = handle;
-
-    scorep_mpi_last_window++;
+    /* enter win in the window table, replacing a stale entry of a window
+     * that was freed without passing through scorep_mpi_win_free() */
+    win_table_value_t tracked_handle;
+    if ( win_table_get_and_insert( win, &handle, &tracked_handle ) )
+    {
+        scorep_mpi_last_window++;
+    }
+    else
+    {
+        win_table_remove( win );
+        win_table_get_and_insert( win, &handle, &tracked_handle );
+    }
     UTILS_MutexUnlock( &scorep_mpi_window_mutex );
 
     return handle;
@@ -188,27 +248,9 @@ void
 scorep_mpi_win_free( MPI_Win win )
 {
     UTILS_MutexLock( &scorep_mpi_window_mutex );
-    if ( scorep_mpi_last_window == 1 && scorep_mpi_windows[ 0 ].win == win )
-    {
-        scorep_mpi_last_window = 0;
-    }
-    else if ( scorep_mpi_last_window > 1 )
+    if ( win_table_remove( win ) )
     {
-        int i = 0;
-
-        while ( i < scorep_mpi_last_window && scorep_mpi_windows[ i ].win != win )
-        {
-            i++;
-        }
-
-        if ( i < scorep_mpi_last_window-- )
-        {
-            scorep_mpi_windows[ i ] = scorep_mpi_windows[ scorep_mpi_last_window ];
-        }
-        else
-        {
-            UTILS_ERROR( SCOREP_ERROR_MPI_NO_WINDOW, "" );
-        }
+        scorep_mpi_last_window--;
     }
     else
     {
@@ -220,27 +262,17 @@ scorep_mpi_win_free( MPI_Win win )
 SCOREP_RmaWindowHandle
 scorep_mpi_win_handle( MPI_Win win )
 {
-    int i = 0;
+    win_table_value_t handle;
 
-    UTILS_MutexLock( &scorep_mpi_window_mutex );
-    while ( i < scorep_mpi_last_window && scorep_mpi_windows[ i ].win != win )
+    if ( win_table_get( win, &handle ) )
     {
-        i++;
+        return handle;
     }
 
-    if ( i != scorep_mpi_last_window )
-    {
-        UTILS_MutexUnlock( &scorep_mpi_window_mutex );
-        return scorep_mpi_windows[ i ].handle;
-    }
-    else
-    {
-        UTILS_MutexUnlock( &scorep_mpi_window_mutex );
-        UTILS_ERROR( SCOREP_ERROR_MPI_NO_WINDOW,
-                     "You are using a window that was not tracked. "
-                     "Please contact the Score-P support team." );
-        return SCOREP_INVALID_RMA_WINDOW;
-    }
+    UTILS_ERROR( SCOREP_ERROR_MPI_NO_WINDOW,
+                 "You are using a window that was not tracked. "
+                 "Please contact the Score-P support team." );
+    return SCOREP_INVALID_RMA_WINDOW;
 }
 
 void
@@ -293,60 +325,6 @@ scorep_mpi_group_translate_ranks( MPI_Group group )
     return size;
 }
 
-void
-scorep_mpi_comm_free( MPI_Comm comm )
-{
-    const char* message = "You are trying to free a communicator that was "
-                          "not tracked. Maybe you used a non-standard "
-                          "MPI function call to create it.";
-
-    /* check if comm handling is initialized (see scorep_mpi_comm_create comment) */
-    if ( !scorep_mpi_comm_initialized )
-    {
-        UTILS_WARNING( "Skipping attempt to free communicator "
-                       "outside init->finalize scope" );
-        return;
-    }
-
-    /* Lock communicator definition */
-    UTILS_MutexLock( &scorep_mpi_communicator_mutex );
-
-    /* if only one communicator exists, we just need to decrease \a
-     * scorep_mpi_last_comm */
-    if ( scorep_mpi_last_comm == 1 && scorep_mpi_comms[ 0 ].comm == comm )
-    {
-        scorep_mpi_last_comm = 0;
-    }
-    /* if more than one communicator exists, we need to search for the
-     * entry */
-    else if ( scorep_mpi_last_comm > 1 )
-    {
-        int i = 0;
-
-        while ( i < scorep_mpi_last_comm && scorep_mpi_comms[ i ].comm != comm )
-        {
-            i++;
-        }
-
-        if ( i < scorep_mpi_last_comm-- )
-        {
-            /* swap deletion candidate with last entry in the list */
-            scorep_mpi_comms[ i ] = scorep_mpi_comms[ scorep_mpi_last_comm ];
-        }
-        else
-        {
-            UTILS_ERROR( SCOREP_ERROR_MPI_NO_COMM, "scorep_mpi_comm_free1 %s", message );
-        }
-    }
-    else
-    {
-        UTILS_ERROR( SCOREP_ERROR_MPI_NO_COMM, "scorep_mpi_comm_free2 %s", message );
-    }
-
-    /* Unlock communicator definition */
-    UTILS_MutexUnlock( &scorep_mpi_communicator_mutex );
-}
-
 void
 scorep_mpi_comm_set_name( MPI_Comm comm, const char* name )
 {
@@ -4,7 +4,7 @@
  * Copyright (c) 2013-2014, 2017, 2022,
  * Forschungszentrum Juelich GmbH, Germany
  *
- * Copyright (c) 2018, 2020,
+ * Copyright (c) 2018, 2020, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * This software may be modified and distributed under the terms of
@@ -29,6 +29,8 @@
 #include <UTILS_Mutex.h>
 #include <SCOREP_Memory.h>
 #include <SCOREP_Definitions.h>
+#include <SCOREP_FastHashtab.h>
+#include <jenkins_hash.h>
 
 #include "scorep_mpi_rma_request.h"
 
@@ -57,12 +59,6 @@ uint32_t scorep_mpi_number_of_root_comms = 0;
  */
 UTILS_Mutex scorep_mpi_window_mutex = UTILS_MUTEX_INIT;
 
-/**
- *  @internal
- *  Window tracking array
- */
-struct scorep_mpi_win_type* scorep_mpi_windows = NULL;
-
 /**
  *  @internal
  *  Data structure to track active GATS epochs.
@@ -120,12 +116,6 @@ struct scorep_mpi_id_root_pair
     int          root;    /**< global rank of id-providing process */
 };
 
-/**
- *  @internal
- *  Communicator tracking data structure. Array of created communicators' handles.
- */
-struct scorep_mpi_communicator_type* scorep_mpi_comms = NULL;
-
 /**
  *  @internal
  *  Group tracking data structure. Array of created groups' handles.
@@ -139,10 +129,62 @@ static int scorep_mpi_my_global_rank = SCOREP_INVALID_ROOT_RANK;
 
 /**
  *  @internal
- *  Index into the scorep_mpi_comms array to the last entry.
+ *  Number of tracked communicators, MPI_COMM_WORLD excluded.
  */
 int32_t scorep_mpi_last_comm = 0;
 
+/*
+ * Communicator tracking data structure. Maps the MPI communicator handles
+ * to the Score-P handles. Lookups do not take a lock, thus resolving a
+ * communicator costs the same, regardless of how many exist. Inserts and
+ * removes are still serialized by scorep_mpi_communicator_mutex.
+ */
+typedef MPI_Comm                         comm_table_key_t;
+typedef SCOREP_InterimCommunicatorHandle comm_table_value_t;
+
+#define COMM_TABLE_HASH_EXPONENT 10
+
+static inline uint32_t
+comm_table_bucket_idx( comm_table_key_t key )
+{
+    return jenkins_hash( &key, sizeof( key ), 0 ) & hashmask( COMM_TABLE_HASH_EXPONENT );
+}
+
+static inline bool
+comm_table_equals( comm_table_key_t key1,
+                   comm_table_key_t key2 )
+{
+    return key1 == key2;
+}
+
+static inline void*
+comm_table_allocate_chunk( size_t chunkSize )
+{
+    return SCOREP_Memory_AlignedAllocForMisc( SCOREP_CACHELINESIZE, chunkSize );
+}
+
+static inline void
+comm_table_free_chunk( void* chunk )
+{
+}
+
+static inline comm_table_value_t
+comm_table_value_ctor( comm_table_key_t* key,
+                       const void*       ctorData )
+{
+    return *( const comm_table_value_t* )ctorData;
+}
+
+static inline void
+comm_table_value_dtor( comm_table_key_t   key,
+                       comm_table_value_t value )
+{
+}
+
+SCOREP_HASH_TABLE_NON_MONOTONIC( comm_table, 7, hashsize( COMM_TABLE_HASH_EXPONENT ) );
+
+#undef COMM_TABLE_HASH_EXPONENT
+
 void
 scorep_mpi_win_init( void )
 {
@@ -168,19 +210,6 @@ scorep_mpi_win_init( void )
         }
 
 
-        scorep_mpi_windows = ( struct scorep_mpi_win_type* )SCOREP_Memory_AllocForMisc
-                                 ( sizeof( struct scorep_mpi_win_type ) * SCOREP_MPI_MAX_WIN );
-        if ( scorep_mpi_windows == NULL )
-        {
-            UTILS_ERROR( SCOREP_ERROR_MEM_ALLOC_FAILED,
-                         "Failed to allocate memory for MPI window tracking.\n"
-                         "One-sided communication cannot be recoreded.\n"
-                         "Space for %" PRIu64 " windows was requested.\n"
-                         "You can change this number via the environment variable "
-                         "SCOREP_MPI_MAX_WINDOWS.", SCOREP_MPI_MAX_WIN );
-            SCOREP_MPI_DISABLE_GROUP( SCOREP_MPI_ENABLED_RMA );
-        }
-
         scorep_mpi_epochs = ( struct scorep_mpi_epoch_info_type* )SCOREP_Memory_AllocForMisc
                                 ( sizeof( struct scorep_mpi_epoch_info_type ) * SCOREP_MPI_MAX_EPOCHS );
 
@@ -355,10 +384,19 @@ scorep_mpi_comm_create_finalize( MPI_Comm                         comm,
     comm_payload->root_id           = id;
     comm_payload->io_handle_counter = 0;
 
-    /* enter comm in scorep_mpi_comms[] array */
-    scorep_mpi_comms[ scorep_mpi_last_comm ].comm = comm;
-    scorep_mpi_comms[ scorep_mpi_last_comm ].cid  = handle;
-    scorep_mpi_last_comm++;
+    /* enter comm in the communicator table. An existing entry for the same
+     * MPI handle belongs to a communicator that was freed without passing
+     * through scorep_mpi_comm_free(), the new definition replaces it. */
+    comm_table_value_t tracked_handle;
+    if ( comm_table_get_and_insert( comm, &handle, &tracked_handle ) )
+    {
+        scorep_mpi_last_comm++;
+    }
+    else
+    {
+        comm_table_remove( comm );
+        comm_table_get_and_insert( comm, &handle, &tracked_handle );
+    }
 
     /* clean up */
     UTILS_MutexUnlock( &scorep_mpi_communicator_mutex );
@@ -506,18 +544,6 @@ scorep_mpi_comm_init( void )
     if ( !scorep_mpi_comm_initialized )
     {
         /* Create tracking structures */
-        scorep_mpi_comms = ( struct scorep_mpi_communicator_type* )SCOREP_Memory_AllocForMisc
-                               ( sizeof( struct scorep_mpi_communicator_type ) * SCOREP_MPI_MAX_COMM );
-
-        if ( scorep_mpi_comms == NULL )
-        {
-            UTILS_ERROR( SCOREP_ERROR_MEM_ALLOC_FAILED,
-                         "Failed to allocate memory for communicator tracking.\n"
-                         "Space for %" PRIu64 " communicators was requested.\n"
-                         "You can change this number via the environment variable "
-                         "SCOREP_MPI_MAX_COMMUNICATORS.", SCOREP_MPI_MAX_COMM );
-        }
-
         scorep_mpi_groups = ( struct scorep_mpi_group_type* )SCOREP_Memory_AllocForMisc
                                 ( sizeof( struct scorep_mpi_group_type ) *  SCOREP_MPI_MAX_GROUP );
         if ( scorep_mpi_groups == NULL )
@@ -543,50 +569,66 @@ scorep_mpi_comm_init( void )
     }
 }
 
-SCOREP_InterimCommunicatorHandle
-scorep_mpi_comm_handle( MPI_Comm comm )
+void
+scorep_mpi_comm_free( MPI_Comm comm )
 {
-    int i = 0;
+    /* check if comm handling is initialized (see scorep_mpi_comm_create comment) */
+    if ( !scorep_mpi_comm_initialized )
+    {
+        UTILS_WARNING( "Skipping attempt to free communicator "
+                       "outside init->finalize scope" );
+        return;
+    }
 
     /* Lock communicator definition */
     UTILS_MutexLock( &scorep_mpi_communicator_mutex );
 
-    while ( i < scorep_mpi_last_comm && scorep_mpi_comms[ i ].comm != comm )
+    if ( comm_table_remove( comm ) )
+    {
+        scorep_mpi_last_comm--;
+    }
+    else
     {
-        i++;
+        UTILS_ERROR( SCOREP_ERROR_MPI_NO_COMM,
+                     "You are trying to free a communicator that was "
+                     "not tracked. Maybe you used a non-standard "
+                     "MPI function call to create it." );
     }
 
-    if ( i != scorep_mpi_last_comm )
+    /* Unlock communicator definition */
+    UTILS_MutexUnlock( &scorep_mpi_communicator_mutex );
+}
+
+SCOREP_InterimCommunicatorHandle
+scorep_mpi_comm_handle( MPI_Comm comm )
+{
+    comm_table_value_t handle;
+
+    /* No need for scorep_mpi_communicator_mutex, the table handles
+     * concurrent inserts and removes itself */
+    if ( comm_table_get( comm, &handle ) )
     {
-        /* Unlock communicator definition */
-        UTILS_MutexUnlock( &scorep_mpi_communicator_mutex );
+        return handle;
+    }
 
-        return scorep_mpi_comms[ i ].cid;
+    if ( comm == MPI_COMM_WORLD )
+    {
+        UTILS_WARNING( "This function SHOULD NOT be called with MPI_COMM_WORLD" );
+        return SCOREP_MPI_COMM_WORLD_HANDLE;
+    }
+    else if ( comm == MPI_COMM_NULL )
+    {
+        UTILS_ERROR( SCOREP_ERROR_MPI_NO_COMM,
+                     "It is not possible to track MPI_COMM_NULL. This error"
+                     " is likely due to an incorrect call to MPI" );
+        return SCOREP_INVALID_INTERIM_COMMUNICATOR;
     }
     else
     {
-        /* Unlock communicator definition */
-        UTILS_MutexUnlock( &scorep_mpi_communicator_mutex );
-
-        if ( comm == MPI_COMM_WORLD )
-        {
-            UTILS_WARNING( "This function SHOULD NOT be called with MPI_COMM_WORLD" );
-            return SCOREP_MPI_COMM_WORLD_HANDLE;
-        }
-        else if ( comm == MPI_COMM_NULL )
-        {
-            UTILS_ERROR( SCOREP_ERROR_MPI_NO_COMM,
-                         "It is not possible to track MPI_COMM_NULL. This error"
-                         " is likely due to an incorrect call to MPI" );
-            return SCOREP_INVALID_INTERIM_COMMUNICATOR;
-        }
-        else
-        {
-            UTILS_ERROR( SCOREP_ERROR_MPI_NO_COMM,
-                         "You are using a communicator that was "
-                         "not tracked. Please contact the Score-P support team." );
-            return SCOREP_INVALID_INTERIM_COMMUNICATOR;
-        }
+        UTILS_ERROR( SCOREP_ERROR_MPI_NO_COMM,
+                     "You are using a communicator that was "
+                     "not tracked. Please contact the Score-P support team." );
+        return SCOREP_INVALID_INTERIM_COMMUNICATOR;
     }
 }
 
@@ -4,7 +4,7 @@
  * Copyright (c) 2013, 2017, 2022,
  * Forschungszentrum Juelich GmbH, Germany
  *
- * Copyright (c) 2018,
+ * Copyright (c) 2018, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * This software may be modified and distributed under the terms of
@@ -62,22 +62,6 @@ typedef SCOREP_GroupHandle SCOREP_Mpi_GroupHandle;
  */
 typedef uint8_t SCOREP_Mpi_EpochType;
 
-/**
- *  @internal
- *  Structure to translate MPI window handles to internal SCOREP IDs.
- */
-struct scorep_mpi_win_type
-{
-    MPI_Win                win;    /** MPI window handle */
-    SCOREP_RmaWindowHandle handle; /** Internal SCOREP window handle */
-};
-
-/**
- *  @internal
- *  Array which maps all MPI windows to Score-P internal handles.
- */
-extern struct scorep_mpi_win_type* scorep_mpi_windows;
-
 /**
  * @internal
  *  Entry data structure to track GATS epochs
@@ -116,16 +100,6 @@ typedef struct scorep_mpi_comm_definition_payload
  */
 extern struct scorep_mpi_world_type scorep_mpi_world;
 
-/**
- *  @internal
- * structure for communicator tracking
- */
-struct scorep_mpi_communicator_type
-{
-    MPI_Comm                         comm; /**< MPI Communicator handle */
-    SCOREP_InterimCommunicatorHandle cid;  /**< Internal SCOREP Communicator handle */
-};
-
 /**
  * @internal
  * structure for group tracking
@@ -169,8 +143,6 @@ extern int32_t scorep_mpi_last_comm;
 
 extern struct scorep_mpi_group_type* scorep_mpi_groups;
 
-extern struct scorep_mpi_communicator_type* scorep_mpi_comms;
-
 /**
  * @internal
  * @brief Initialize communicator management.
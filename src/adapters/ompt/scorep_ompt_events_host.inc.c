@@ -4,6 +4,9 @@
  * Copyright (c) 2022-2024,
  * Forschungszentrum Juelich GmbH, Germany
  *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
  * This software may be modified and distributed under the terms of
  * a BSD-style license. See the COPYING file in the package base
  * directory for details.
@@ -21,6 +24,7 @@
 
 #include "scorep_ompt_callbacks_host.h"
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
@@ -237,13 +241,37 @@ static task_t initial_task;
 static THREAD_LOCAL_STORAGE_SPECIFIER struct scorep_thread_private_data* tpd;
 
 
-/* free list of parallel_t objects */
-static UTILS_Mutex parallel_regions_free_list_mutex = UTILS_MUTEX_INIT;
-static parallel_t* parallel_regions_free_list;
+/* Object pools for parallel_t and task_t objects. Objects are frequently
+   released by a thread different from the one that acquired them (last team
+   member to leave a parallel region, explicit tasks executed elsewhere).
+   Thus, each thread keeps a local free list and hands surplus objects in
+   batches of OBJECT_POOL_BATCH_SIZE to a global lock-free stack. The global
+   stack is only ever pushed to via CAS and emptied as a whole via exchange,
+   thus no ABA problem can arise. */
+#define OBJECT_POOL_BATCH_SIZE 32
+
+typedef struct object_pool
+{
+    void*  global_free_list; /* lock-free stack of returned batches */
+    size_t next_offset;      /* offsetof( <type>, next ) */
+} object_pool;
+
+typedef struct object_pool_cache
+{
+    void*    free_list;
+    uint32_t count;
+} object_pool_cache;
+
+#define OBJECT_POOL_NEXT( POOL, OBJECT ) \
+    ( *( void** )( ( char* )( OBJECT ) + ( POOL )->next_offset ) )
+
 
+static object_pool parallel_regions_pool = { NULL, offsetof( parallel_t, next ) };
+static THREAD_LOCAL_STORAGE_SPECIFIER object_pool_cache parallel_regions_free_list;
 
-/* thread-local free list of implicit and explicit task_t objects. */
-static THREAD_LOCAL_STORAGE_SPECIFIER task_t* tasks_free_list;
+
+static object_pool tasks_pool = { NULL, offsetof( task_t, next ) };
+static THREAD_LOCAL_STORAGE_SPECIFIER object_pool_cache tasks_free_list;
 
 
 /* convenience */
@@ -322,28 +350,134 @@ complete_adapter_init( void )
     UTILS_MutexUnlock( &adapter_ready_mutex );
 }
 
-static inline parallel_t*
-get_parallel_region_from_pool( void )
+/* Returns an object from the thread-local free list, refilling it from the
+   global stack if needed. Returns NULL if both are empty. */
+static inline void*
+object_pool_get( object_pool*       pool,
+                 object_pool_cache* cache )
 {
-    UTILS_MutexLock( &parallel_regions_free_list_mutex );
-    parallel_t* parallel_region;
-    uint32_t*   task_generation_numbers = NULL;
-    if ( parallel_regions_free_list != NULL )
+    if ( cache->free_list == NULL )
+    {
+        cache->free_list = UTILS_Atomic_ExchangeN_void_ptr( &( pool->global_free_list ),
+                                                            NULL,
+                                                            UTILS_ATOMIC_ACQUIRE );
+        cache->count = 0;
+        for ( void* object = cache->free_list;
+              object != NULL;
+              object = OBJECT_POOL_NEXT( pool, object ) )
+        {
+            cache->count++;
+        }
+        if ( cache->free_list == NULL )
+        {
+            return NULL;
+        }
+    }
+
+    void* object = cache->free_list;
+    cache->free_list = OBJECT_POOL_NEXT( pool, object );
+    cache->count--;
+    return object;
+}
+
+
+/* Pushes the linked objects from @a head to @a tail onto the global stack. */
+static inline void
+object_pool_push( object_pool* pool,
+                  void*        head,
+                  void*        tail )
+{
+    void* global_head = UTILS_Atomic_LoadN_void_ptr( &( pool->global_free_list ),
+                                                     UTILS_ATOMIC_RELAXED );
+    do
+    {
+        OBJECT_POOL_NEXT( pool, tail ) = global_head;
+    }
+    while ( !UTILS_Atomic_CompareExchangeN_void_ptr( &( pool->global_free_list ),
+                                                     &global_head,
+                                                     head,
+                                                     true,
+                                                     UTILS_ATOMIC_RELEASE,
+                                                     UTILS_ATOMIC_RELAXED ) );
+}
+
+
+/* Puts @a object into the thread-local free list. If the list holds two
+   batches, one batch is handed over to the global stack. */
+static inline void
+object_pool_release( object_pool*       pool,
+                     object_pool_cache* cache,
+                     void*              object )
+{
+    OBJECT_POOL_NEXT( pool, object ) = cache->free_list;
+    cache->free_list                 = object;
+    cache->count++;
+
+    if ( cache->count < 2 * OBJECT_POOL_BATCH_SIZE )
     {
-        parallel_region            = parallel_regions_free_list;
-        parallel_regions_free_list = parallel_regions_free_list->next;
-        task_generation_numbers    = parallel_region->task_generation_numbers;
+        return;
     }
-    else
+
+    void* batch_head = cache->free_list;
+    void* batch_tail = batch_head;
+    for ( uint32_t i = 1; i < OBJECT_POOL_BATCH_SIZE; i++ )
+    {
+        batch_tail = OBJECT_POOL_NEXT( pool, batch_tail );
+    }
+    cache->free_list = OBJECT_POOL_NEXT( pool, batch_tail );
+    cache->count    -= OBJECT_POOL_BATCH_SIZE;
+
+    object_pool_push( pool, batch_head, batch_tail );
+}
+
+
+/* Hands the whole thread-local free list over to the global stack, called
+   when the thread ends. */
+static inline void
+object_pool_drain( object_pool*       pool,
+                   object_pool_cache* cache )
+{
+    if ( cache->free_list == NULL )
+    {
+        return;
+    }
+
+    void* tail = cache->free_list;
+    while ( OBJECT_POOL_NEXT( pool, tail ) != NULL )
+    {
+        tail = OBJECT_POOL_NEXT( pool, tail );
+    }
+    object_pool_push( pool, cache->free_list, tail );
+    cache->free_list = NULL;
+    cache->count     = 0;
+}
+
+
+static inline parallel_t*
+get_parallel_region_from_pool( void )
+{
+    parallel_t* parallel_region = object_pool_get( &parallel_regions_pool,
+                                                   &parallel_regions_free_list );
+    if ( parallel_region == NULL )
     {
         /* For league parallel regions we might have no location.*/
         parallel_region = SCOREP_Memory_AlignedMalloc( SCOREP_CACHELINESIZE,
                                                        sizeof( *parallel_region ) );
         UTILS_BUG_ON( parallel_region == NULL );
+        memset( parallel_region, 0,  sizeof( *parallel_region ) );
+        return parallel_region;
     }
+
+    /* Reset all members like a new object, as league regions skip
+       init_parallel_obj() and it sets the explicit tasking members only for
+       regions with a parent. task_generation_numbers is kept for reuse, it is
+       reallocated and cleared by init_parallel_obj() before any use. next is
+       owned by the pool. */
+    uint32_t*          task_generation_numbers = parallel_region->task_generation_numbers;
+    struct parallel_t* next                    = parallel_region->next;
     memset( parallel_region, 0,  sizeof( *parallel_region ) );
     parallel_region->task_generation_numbers = task_generation_numbers;
-    UTILS_MutexUnlock( &parallel_regions_free_list_mutex );
+    parallel_region->next                    = next;
     return parallel_region;
 }
 
@@ -361,10 +495,9 @@ release_parallel_region( parallel_t* parallelRegion )
                                       UTILS_ATOMIC_SEQUENTIAL_CONSISTENT ) == 0 )
     {
         /* return to pool */
-        UTILS_MutexLock( &parallel_regions_free_list_mutex );
-        parallelRegion->next       = parallel_regions_free_list;
-        parallel_regions_free_list = parallelRegion;
-        UTILS_MutexUnlock( &parallel_regions_free_list_mutex );
+        object_pool_release( &parallel_regions_pool,
+                             &parallel_regions_free_list,
+                             parallelRegion );
     }
 }
 
@@ -377,14 +510,13 @@ get_task_from_pool( void )
     uint8_t              workshare_regions_capacity = 0;
     SCOREP_RegionHandle* sync_regions               = NULL;
     uint8_t              sync_regions_capacity      = 0;
-    if ( tasks_free_list != NULL )
+    data = object_pool_get( &tasks_pool, &tasks_free_list );
+    if ( data != NULL )
     {
-        data                       = tasks_free_list;
         workshare_regions          = data->workshare_regions;
         workshare_regions_capacity = data->workshare_regions_capacity;
         sync_regions               = data->sync_regions;
         sync_regions_capacity      = data->sync_regions_capacity;
-        tasks_free_list            = tasks_free_list->next;
     }
     else
     {
@@ -407,8 +539,7 @@ get_task_from_pool( void )
 static void
 release_task_to_pool( task_t* task )
 {
-    task->next      = tasks_free_list;
-    tasks_free_list = task;
+    object_pool_release( &tasks_pool, &tasks_free_list, task );
 }
 
 
@@ -464,6 +595,11 @@ scorep_ompt_cb_host_thread_end( ompt_data_t* thread_data )
     SCOREP_IN_MEASUREMENT_INCREMENT();
     UTILS_DEBUG( "[%s] atid %" PRIu32,
                  UTILS_FUNCTION_NAME, thread_data->value );
+
+    /* Objects in the free lists of this thread would be lost otherwise */
+    object_pool_drain( &parallel_regions_pool, &parallel_regions_free_list );
+    object_pool_drain( &tasks_pool, &tasks_free_list );
+
     SCOREP_IN_MEASUREMENT_DECREMENT();
 }
 
@@ -601,7 +737,8 @@ init_parallel_obj( parallel_t*                        parallel,
     parallel->ref_count  = refCount;
 
     /* For parallel_t corresponding to implicit parallel region (no parent), we
-     * can stop here. Remaining members are 0/NULL. */
+     * can stop here. Remaining members are 0, see
+     * get_parallel_region_from_pool(). */
     if ( parent == NULL )
     {
         return;
@@ -1172,10 +1172,8 @@ POMP2_Set_lock( omp_lock_t* s )
 
     if ( scorep_opari2_recording_on )
     {
-        UTILS_MutexLock( &scorep_opari2_openmp_lock );
         SCOREP_Opari2_Openmp_Lock* lock = SCOREP_Opari2_Openmp_GetAcquireLock( s );
         SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP, lock->handle, lock->acquisition_order );
-        UTILS_MutexUnlock( &scorep_opari2_openmp_lock );
 
         SCOREP_ExitRegion( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_SET_LOCK ] );
     }
@@ -1205,10 +1203,8 @@ POMP2_Unset_lock( omp_lock_t* s )
     {
         SCOREP_EnterWrappedRegion( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_UNSET_LOCK ] );
 
-        UTILS_MutexLock( &scorep_opari2_openmp_lock );
         SCOREP_Opari2_Openmp_Lock* lock = SCOREP_Opari2_Openmp_GetReleaseLock( s );
         SCOREP_ThreadReleaseLock( SCOREP_PARADIGM_OPENMP, lock->handle, lock->acquisition_order );
-        UTILS_MutexUnlock( &scorep_opari2_openmp_lock );
     }
     else if ( SCOREP_IsUnwindingEnabled() )
     {
@@ -1261,10 +1257,8 @@ POMP2_Test_lock( omp_lock_t* s )
     {
         if ( result )
         {
-            UTILS_MutexLock( &scorep_opari2_openmp_lock );
             SCOREP_Opari2_Openmp_Lock* lock = SCOREP_Opari2_Openmp_GetAcquireLock( s );
             SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP, lock->handle, lock->acquisition_order );
-            UTILS_MutexUnlock( &scorep_opari2_openmp_lock );
         }
         SCOREP_ExitRegion( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_TEST_LOCK ] );
     }
@@ -1387,10 +1381,8 @@ POMP2_Set_nest_lock( omp_nest_lock_t* s )
 
     if ( scorep_opari2_recording_on )
     {
-        UTILS_MutexLock( &scorep_opari2_openmp_lock );
         SCOREP_Opari2_Openmp_Lock* lock = SCOREP_Opari2_Openmp_GetAcquireNestLock( s );
         SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP, lock->handle, lock->acquisition_order );
-        UTILS_MutexUnlock( &scorep_opari2_openmp_lock );
         SCOREP_ExitRegion( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_SET_NEST_LOCK ] );
     }
     else if ( SCOREP_IsUnwindingEnabled() )
@@ -1418,10 +1410,8 @@ POMP2_Unset_nest_lock( omp_nest_lock_t* s )
     if ( scorep_opari2_recording_on )
     {
         SCOREP_EnterWrappedRegion( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_UNSET_NEST_LOCK ] );
-        UTILS_MutexLock( &scorep_opari2_openmp_lock );
         SCOREP_Opari2_Openmp_Lock* lock = SCOREP_Opari2_Openmp_GetReleaseNestLock( s );
         SCOREP_ThreadReleaseLock( SCOREP_PARADIGM_OPENMP, lock->handle, lock->acquisition_order );
-        UTILS_MutexUnlock( &scorep_opari2_openmp_lock );
     }
     else if ( SCOREP_IsUnwindingEnabled() )
     {
@@ -1474,10 +1464,8 @@ POMP2_Test_nest_lock( omp_nest_lock_t* s )
     {
         if ( result )
         {
-            UTILS_MutexLock( &scorep_opari2_openmp_lock );
             SCOREP_Opari2_Openmp_Lock* lock = SCOREP_Opari2_Openmp_GetAcquireNestLock( s );
             SCOREP_ThreadAcquireLock( SCOREP_PARADIGM_OPENMP, lock->handle, lock->acquisition_order );
-            UTILS_MutexUnlock( &scorep_opari2_openmp_lock );
         }
 
         SCOREP_ExitRegion( scorep_opari2_openmp_lock_region_handles[ SCOREP_OPARI2_OPENMP_TEST_NEST_LOCK ] );
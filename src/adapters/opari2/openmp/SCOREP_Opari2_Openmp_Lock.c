@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012, 2020,
+ * Copyright (c) 2009-2012, 2020, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -40,118 +40,122 @@
 #include <stdlib.h>
 
 #include <SCOREP_Definitions.h>
+#include <SCOREP_Memory.h>
+#include <SCOREP_FastHashtab.h>
+#include <UTILS_Atomic.h>
+#include <jenkins_hash.h>
 
 #include "SCOREP_Opari2_Openmp_Lock.h"
 
-#define SCOREP_OPARI2_OPENMP_LOCKBLOCK_SIZE 100
+static SCOREP_Opari2_Openmp_Lock_HandleType current_lock_handle = 0;
 
-struct lock_block
-{
-    struct SCOREP_Opari2_Openmp_Lock lock[ SCOREP_OPARI2_OPENMP_LOCKBLOCK_SIZE ];
-    struct lock_block*               next;
-    struct lock_block*               prev;
-};
+/* Lock records of destroyed locks, reused by later lock initializations */
+static SCOREP_Opari2_Openmp_Lock* lock_free_list;
+static UTILS_Mutex                lock_free_list_mutex = UTILS_MUTEX_INIT;
 
-static struct lock_block*                lock_head_block = 0;
-static struct lock_block*                lock_last_block = 0;
-static struct SCOREP_Opari2_Openmp_Lock* last_lock       = 0;
-static int                               last_index      = SCOREP_OPARI2_OPENMP_LOCKBLOCK_SIZE;
+/* Type declarations for NON_MONOTONIC_HASH_TABLE */
+typedef const void*                lock_table_key_t;
+typedef SCOREP_Opari2_Openmp_Lock* lock_table_value_t;
 
-static SCOREP_Opari2_Openmp_Lock_HandleType current_lock_handle = 0;
+/* Requirements for NON_MONOTONIC_HASH_TABLE:                                */
+/* The table cannot grow. 2^15 buckets keep the 229376 locks which fit into   */
+/* the first chunk of each bucket. The 4 MiB of buckets are zero-initialized, */
+/* thus only pages of used buckets take physical memory.                      */
+#define LOCK_TABLE_HASH_EXPONENT 15
 
-UTILS_Mutex scorep_opari2_openmp_lock = UTILS_MUTEX_INIT;
+static inline uint32_t
+lock_table_bucket_idx( lock_table_key_t key )
+{
+    return jenkins_hash( &key, sizeof( key ), 0 ) & hashmask( LOCK_TABLE_HASH_EXPONENT );
+}
 
-void
-scorep_opari2_openmp_lock_finalize( void )
+static inline bool
+lock_table_equals( lock_table_key_t key1,
+                   lock_table_key_t key2 )
 {
-    struct lock_block* block;
+    return key1 == key2;
+}
 
-    /* free lock blocks */
+static inline void*
+lock_table_allocate_chunk( size_t chunkSize )
+{
+    return SCOREP_Memory_AlignedAllocForMisc( SCOREP_CACHELINESIZE, chunkSize );
+}
 
-    while ( lock_head_block )
-    {
-        block           = lock_head_block;
-        lock_head_block = lock_head_block->next;
-        free( block );
-    }
+static inline void
+lock_table_free_chunk( void* chunk )
+{
 }
 
-SCOREP_Opari2_Openmp_Lock*
-scorep_opari2_openmp_lock_init( const void* lock )
+static inline lock_table_value_t
+lock_table_value_ctor( lock_table_key_t* key,
+                       void*             ctorData )
 {
-    struct lock_block* new_block;
+    SCOREP_Opari2_Openmp_Lock* lock;
 
-    UTILS_MutexLock( &scorep_opari2_openmp_lock );
-    last_index++;
-    if ( last_index >= SCOREP_OPARI2_OPENMP_LOCKBLOCK_SIZE )
+    UTILS_MutexLock( &lock_free_list_mutex );
+    lock = lock_free_list;
+    if ( lock != NULL )
     {
-        if ( lock_head_block == 0 )
-        {
-            /* first time: allocate and initialize first block */
-            new_block       = malloc( sizeof( struct lock_block ) );
-            new_block->next = 0;
-            new_block->prev = 0;
-            lock_head_block = lock_last_block = new_block;
-        }
-        else if ( lock_last_block == 0 )
-        {
-            /* lock list empty: re-initialize */
-            lock_last_block = lock_head_block;
-        }
-        else
-        {
-            if ( lock_last_block->next == 0 )
-            {
-                /* lock list full: expand */
-                new_block             = malloc( sizeof( struct lock_block ) );
-                new_block->next       = 0;
-                new_block->prev       = lock_last_block;
-                lock_last_block->next = new_block;
-            }
-            /* use next available block */
-            lock_last_block = lock_last_block->next;
-        }
-        last_lock  = &( lock_last_block->lock[ 0 ] );
-        last_index = 0;
+        /* the lock member links the free list */
+        lock_free_list = ( SCOREP_Opari2_Openmp_Lock* )lock->lock;
     }
-    else
+    UTILS_MutexUnlock( &lock_free_list_mutex );
+
+    if ( lock == NULL )
     {
-        last_lock++;
+        lock = SCOREP_Memory_AllocForMisc( sizeof( *lock ) );
     }
-    /* store lock information */
-    last_lock->lock              = lock;
-    last_lock->handle            = current_lock_handle++;
-    last_lock->acquisition_order = 0;
-    last_lock->nest_level        = 0;
-
-    UTILS_MutexUnlock( &scorep_opari2_openmp_lock );
-    return last_lock;
+
+    lock->lock              = *key;
+    lock->handle            = UTILS_Atomic_FetchAdd_uint32( &current_lock_handle, 1,
+                                                            UTILS_ATOMIC_RELAXED );
+    lock->acquisition_order = 0;
+    lock->nest_level        = 0;
+
+    return lock;
+}
+
+static inline void
+lock_table_value_dtor( lock_table_key_t   key,
+                       lock_table_value_t value )
+{
+    UTILS_MutexLock( &lock_free_list_mutex );
+    value->lock    = lock_free_list;
+    lock_free_list = value;
+    UTILS_MutexUnlock( &lock_free_list_mutex );
+}
+
+/* nPairsPerChunk: 8+8 bytes per pair, 8 wasted bytes on x86-64 in 128 bytes */
+SCOREP_HASH_TABLE_NON_MONOTONIC( lock_table,
+                                 7,
+                                 hashsize( LOCK_TABLE_HASH_EXPONENT ) );
+
+#undef LOCK_TABLE_HASH_EXPONENT
+
+
+void
+scorep_opari2_openmp_lock_finalize( void )
+{
+    /* Lock records and chunks live in misc memory, just empty the table */
+    lock_table_free_chunks();
+    lock_free_list = NULL;
+}
+
+SCOREP_Opari2_Openmp_Lock*
+scorep_opari2_openmp_lock_init( const void* lock )
+{
+    SCOREP_Opari2_Openmp_Lock* lock_struct = NULL;
+    lock_table_get_and_insert( lock, NULL, &lock_struct );
+    return lock_struct;
 }
 
 static struct SCOREP_Opari2_Openmp_Lock*
 scorep_opari2_openmp_get_lock( const void* lock )
 {
-    int                               i;
-    struct lock_block*                block;
-    struct SCOREP_Opari2_Openmp_Lock* curr;
-
-    /* search all locks in all blocks */
-    block = lock_head_block;
-    while ( block )
-    {
-        curr = &( block->lock[ 0 ] );
-        for ( i = 0; i < SCOREP_OPARI2_OPENMP_LOCKBLOCK_SIZE; ++i )
-        {
-            if ( curr->lock == lock )
-            {
-                return curr;
-            }
-
-            curr++;
-        }
-        block = block->next;
-    }
-    return 0;
+    SCOREP_Opari2_Openmp_Lock* lock_struct = NULL;
+    lock_table_get( lock, &lock_struct );
+    return lock_struct;
 }
 
 
@@ -202,35 +206,9 @@ SCOREP_Opari2_Openmp_GetLock( const void* lock )
 }
 
 
+
 void
 scorep_opari2_openmp_lock_destroy( const void* lock )
 {
-    /* delete lock by copying last lock in place of lock */
-
-    *scorep_opari2_openmp_get_lock( lock ) = *last_lock;
-
-    /* adjust pointer to last lock  */
-    last_index--;
-    if ( last_index < 0 )
-    {
-        /* reached low end of block */
-        if ( lock_last_block->prev )
-        {
-            /* goto previous block if existing */
-            last_index = SCOREP_OPARI2_OPENMP_LOCKBLOCK_SIZE - 1;
-            last_lock  = &( lock_last_block->
-                            prev->lock[ last_index ] );
-        }
-        else
-        {
-            /* no previous block: re-initialize */
-            last_index = SCOREP_OPARI2_OPENMP_LOCKBLOCK_SIZE;
-            last_lock  = 0;
-        }
-        lock_last_block = lock_last_block->prev;
-    }
-    else
-    {
-        last_lock--;
-    }
+    lock_table_remove( lock );
 }
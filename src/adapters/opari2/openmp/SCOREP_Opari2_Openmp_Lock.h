@@ -39,7 +39,6 @@
  */
 
 #include <scorep/SCOREP_PublicTypes.h>
-#include <UTILS_Mutex.h>
 #include <stdint.h>
 
 /** Definition of the type of the lock handle */
@@ -77,9 +76,9 @@ struct SCOREP_Opari2_Openmp_Lock
     uint32_t                             nest_level; // only used for nested locks
 };
 
-/** Mutex to ensure exclusive access to opari2_openmp_lock lock data structure.
- */
-extern UTILS_Mutex scorep_opari2_openmp_lock;
+/* The lock records are kept in a concurrent hash table keyed by the lock
+   address. Lookups need no mutex. A record is only modified by the thread
+   owning the OpenMP lock, which serializes the updates. */
 
 /** Initializes a new lock handle.
     @param lock The OMP lock which should be initialized
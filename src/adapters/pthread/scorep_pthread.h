@@ -61,12 +61,14 @@ extern SCOREP_RegionHandle scorep_pthread_regions[ SCOREP_PTHREAD_REGION_SENTINE
 extern size_t scorep_pthread_subsystem_id;
 
 struct scorep_pthread_wrapped_arg;
+struct scorep_pthread_mutex;
 
 typedef struct scorep_pthread_location_data scorep_pthread_location_data;
 struct scorep_pthread_location_data
 {
     struct scorep_pthread_wrapped_arg* wrapped_arg;
     struct scorep_pthread_wrapped_arg* free_list;
+    struct scorep_pthread_mutex*       mutex_free_list; /* entries of destroyed mutexes */
 };
 
 #endif /* SCOREP_PTHREAD_H */
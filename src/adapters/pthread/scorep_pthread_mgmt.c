@@ -121,8 +121,9 @@ pthread_subsystem_init_location( struct SCOREP_Location* locationData,
 
     struct scorep_pthread_location_data* data =
         SCOREP_Location_AllocForMisc( locationData, sizeof( *data ) );
-    data->wrapped_arg = NULL;
-    data->free_list   = NULL;
+    data->wrapped_arg     = NULL;
+    data->free_list       = NULL;
+    data->mutex_free_list = NULL;
 
     SCOREP_Location_SetSubsystemData( locationData,
                                       scorep_pthread_subsystem_id,
@@ -4,7 +4,7 @@
  * Copyright (c) 2014, 2022,
  * Forschungszentrum Juelich GmbH, Germany
  *
- * Copyright (c) 2020,
+ * Copyright (c) 2020, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * This software may be modified and distributed under the terms of
@@ -22,14 +22,17 @@
 #include <config.h>
 
 #include "scorep_pthread_mutex.h"
+#include "scorep_pthread.h"
 
 #define SCOREP_DEBUG_MODULE_NAME PTHREAD
 #include <UTILS_Debug.h>
 
 #include <SCOREP_Memory.h>
+#include <SCOREP_Location.h>
+#include <SCOREP_FastHashtab.h>
 
 #include <UTILS_Error.h>
-#include <UTILS_Mutex.h>
+#include <UTILS_Atomic.h>
 #include <jenkins_hash.h>
 
 #include <stdlib.h>
@@ -37,74 +40,101 @@
 #include <inttypes.h>
 
 
-/* *INDENT-OFF* */
-static inline scorep_pthread_mutex* mutex_hash_get( pthread_mutex_t* pthreadMutex );
-static inline void* get_key( pthread_mutex_t* pthreadMutex );
-static inline uint32_t get_bucket( pthread_mutex_t* pthreadMutex );
-/* *INDENT-ON*  */
+static uint32_t mutex_id = 0;
 
 
-static UTILS_Mutex hash_table_mutex;
-/* hash_table_size = 2^^HASH_TABLE_SIZE_EXP */
-#define HASH_TABLE_SIZE_EXP 8
-#define HASH_INITIAL ( uint32_t )0
-static scorep_pthread_mutex* hash_table[ hashsize( HASH_TABLE_SIZE_EXP ) ];
-static int32_t               mutex_id = 0;
-static scorep_pthread_mutex* free_list_head;
+/* Type declarations for NON_MONOTONIC_HASH_TABLE */
+typedef const void*           mutex_table_key_t;
+typedef scorep_pthread_mutex* mutex_table_value_t;
 
-scorep_pthread_mutex*
-scorep_pthread_mutex_hash_put( pthread_mutex_t* pthreadMutex )
+/* Requirements for NON_MONOTONIC_HASH_TABLE:                                */
+#define MUTEX_TABLE_HASH_EXPONENT 10
+
+static inline uint32_t
+mutex_table_bucket_idx( mutex_table_key_t key )
+{
+    uint32_t bucket = jenkins_hash( &key, sizeof( key ), 0 )
+                      & hashmask( MUTEX_TABLE_HASH_EXPONENT );
+
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_PTHREAD, "key    :%p", key );
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_PTHREAD, "bucket :%" PRIu32 "", bucket );
+
+    return bucket;
+}
+
+static inline bool
+mutex_table_equals( mutex_table_key_t key1,
+                    mutex_table_key_t key2 )
+{
+    return key1 == key2;
+}
+
+static inline void*
+mutex_table_allocate_chunk( size_t chunkSize )
+{
+    return SCOREP_Memory_AlignedAllocForMisc( SCOREP_CACHELINESIZE, chunkSize );
+}
+
+static inline void
+mutex_table_free_chunk( void* chunk )
+{
+}
+
+/* Entries of destroyed mutexes are recycled through a free list in the
+ * pthread location data of the destroying thread, thus no locking is
+ * needed for recycling. */
+static inline scorep_pthread_location_data*
+get_location_data( void )
+{
+    return SCOREP_Location_GetSubsystemData( SCOREP_Location_GetCurrentCPULocation(),
+                                             scorep_pthread_subsystem_id );
+}
+
+static inline mutex_table_value_t
+mutex_table_value_ctor( mutex_table_key_t* key,
+                        void*              ctorData )
 {
-    UTILS_MutexLock( &hash_table_mutex );
-    scorep_pthread_mutex* new_mutex = mutex_hash_get( pthreadMutex );
-    if ( !new_mutex )
+    scorep_pthread_location_data* data      = get_location_data();
+    scorep_pthread_mutex*         new_mutex = data->mutex_free_list;
+    if ( new_mutex )
     {
-        if ( free_list_head )
-        {
-            new_mutex      = free_list_head;
-            free_list_head = free_list_head->next;
-        }
-        else
-        {
-            new_mutex = SCOREP_Memory_AllocForMisc( sizeof( scorep_pthread_mutex ) );
-        }
-        memset( new_mutex, 0, sizeof( *new_mutex ) );
+        data->mutex_free_list = new_mutex->next;
+    }
+    else
+    {
+        new_mutex = SCOREP_Memory_AllocForMisc( sizeof( scorep_pthread_mutex ) );
         UTILS_BUG_ON( !new_mutex, "Failed to allocate memory for scorep_pthread_mutex object." );
-        new_mutex->key               = get_key( pthreadMutex );
-        new_mutex->id                = mutex_id++;
-        new_mutex->acquisition_order = 0;
-        new_mutex->nesting_level     = 0;
-        new_mutex->process_shared    = false;
-
-        /* insert at front */
-        uint32_t bucket = get_bucket( pthreadMutex );
-        new_mutex->next      = hash_table[ bucket ];
-        hash_table[ bucket ] = new_mutex;
-
-        UTILS_DEBUG_PRINTF( SCOREP_DEBUG_PTHREAD, "Mutex:%" PRIu32 " in bucket:%"
-                            PRIu32 "", new_mutex->id, bucket );
     }
-    UTILS_MutexUnlock( &hash_table_mutex );
+    new_mutex->next              = NULL;
+    new_mutex->key               = ( void* )*key;
+    new_mutex->id                = UTILS_Atomic_FetchAdd_uint32( &mutex_id, 1,
+                                                                 UTILS_ATOMIC_RELAXED );
+    new_mutex->acquisition_order = 0;
+    new_mutex->nesting_level     = 0;
+    new_mutex->process_shared    = false;
+
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_PTHREAD, "Mutex:%" PRIu32 " for key:%p",
+                        new_mutex->id, new_mutex->key );
+
     return new_mutex;
 }
 
-
-static inline scorep_pthread_mutex*
-mutex_hash_get( pthread_mutex_t* pthreadMutex )
+static inline void
+mutex_table_value_dtor( mutex_table_key_t   key,
+                        mutex_table_value_t value )
 {
-    scorep_pthread_mutex* iterator = hash_table[ get_bucket( pthreadMutex ) ];
-    const void*           key      = get_key( pthreadMutex );
-    while ( iterator != 0 )
-    {
-        if ( key == iterator->key )
-        {
-            break;
-        }
-        iterator = iterator->next;
-    }
-    return iterator;
+    scorep_pthread_location_data* data = get_location_data();
+    value->next           = data->mutex_free_list;
+    data->mutex_free_list = value;
 }
 
+/* nPairsPerChunk: 8+8 bytes per pair, 8 wasted bytes on x86-64 in 128 bytes */
+SCOREP_HASH_TABLE_NON_MONOTONIC( mutex_table,
+                                 7,
+                                 hashsize( MUTEX_TABLE_HASH_EXPONENT ) );
+
+#undef MUTEX_TABLE_HASH_EXPONENT
+
 
 static inline void*
 get_key( pthread_mutex_t* pthreadMutex )
@@ -113,27 +143,20 @@ get_key( pthread_mutex_t* pthreadMutex )
 }
 
 
-static inline uint32_t
-get_bucket( pthread_mutex_t* pthreadMutex )
+scorep_pthread_mutex*
+scorep_pthread_mutex_hash_put( pthread_mutex_t* pthreadMutex )
 {
-    void*    key[]  = { get_key( pthreadMutex ) };
-    uint32_t bucket = jenkins_hash( key, sizeof( void* ), HASH_INITIAL )
-                      & hashmask( HASH_TABLE_SIZE_EXP );
-
-    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_PTHREAD, "key    :%p", key[ 0 ] );
-    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_PTHREAD, "bucket :%" PRIu32 "", bucket );
-
-    return bucket;
+    scorep_pthread_mutex* new_mutex = NULL;
+    mutex_table_get_and_insert( get_key( pthreadMutex ), NULL, &new_mutex );
+    return new_mutex;
 }
 
 
 scorep_pthread_mutex*
 scorep_pthread_mutex_hash_get( pthread_mutex_t* pthreadMutex )
 {
-    UTILS_MutexLock( &hash_table_mutex );
-    scorep_pthread_mutex* iterator = mutex_hash_get( pthreadMutex );
-    UTILS_MutexUnlock( &hash_table_mutex );
-
+    scorep_pthread_mutex* iterator = NULL;
+    mutex_table_get( get_key( pthreadMutex ), &iterator );
     return iterator;
 }
 
@@ -141,41 +164,8 @@ scorep_pthread_mutex_hash_get( pthread_mutex_t* pthreadMutex )
 void
 scorep_pthread_mutex_hash_remove( pthread_mutex_t* pthreadMutex )
 {
-    UTILS_MutexLock( &hash_table_mutex );
-    uint32_t              bucket   = get_bucket( pthreadMutex );
-    scorep_pthread_mutex* iterator = hash_table[ bucket ];
-    if ( iterator )
-    {
-        const void* key = get_key( pthreadMutex );
-        if ( key == iterator->key )
-        {
-            /* delete first element */
-            hash_table[ bucket ] = iterator->next;
-            iterator->next       = free_list_head;
-            free_list_head       = iterator;
-        }
-        else
-        {
-            while ( iterator->next && key != iterator->next->key )
-            {
-                iterator = iterator->next;
-            }
-            if ( iterator->next )
-            {
-                scorep_pthread_mutex* delete_me = iterator->next;
-                iterator->next  = delete_me->next;
-                delete_me->next = free_list_head;
-                free_list_head  = delete_me;
-            }
-            else
-            {
-                UTILS_WARNING( "Pthread mutex not in hash table." );
-            }
-        }
-    }
-    else
+    if ( !mutex_table_remove( get_key( pthreadMutex ) ) )
     {
         UTILS_WARNING( "Pthread mutex not in hash table." );
     }
-    UTILS_MutexUnlock( &hash_table_mutex );
 }
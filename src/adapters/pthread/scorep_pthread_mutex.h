@@ -31,7 +31,7 @@
 typedef struct scorep_pthread_mutex scorep_pthread_mutex;
 struct scorep_pthread_mutex
 {
-    scorep_pthread_mutex* next;        /* Separate chaining with linked lists. */
+    scorep_pthread_mutex* next;        /* Free-list link of recycled entries. */
     void*                 key;         /* Used as key to hash function.
                                         * uintptr_t also possible */
 
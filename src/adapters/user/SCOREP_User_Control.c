@@ -99,3 +99,21 @@ SCOREP_User_RecordingEnabled( void )
 
     return ret;
 }
+
+void
+SCOREP_User_TriggerTraceDump( void )
+{
+    SCOREP_IN_MEASUREMENT_INCREMENT();
+
+    if ( SCOREP_IS_MEASUREMENT_PHASE( PRE ) )
+    {
+        SCOREP_InitMeasurement();
+    }
+
+    if ( SCOREP_IS_MEASUREMENT_PHASE( WITHIN ) )
+    {
+        SCOREP_TriggerTraceDump();
+    }
+
+    SCOREP_IN_MEASUREMENT_DECREMENT();
+}
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2011,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2011, 2015-2016, 2019, 2022, 2024,
+ * Copyright (c) 2009-2011, 2015-2016, 2019, 2022, 2024, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2011,
@@ -72,8 +72,14 @@ static char*    env_machine_name;
 static char*    env_executable;
 static bool     env_system_tree_sequence;
 static bool     force_cfg_files;
+static uint64_t env_duty_cycle_period;
+static uint64_t env_duty_cycle_burst;
+static char*    env_addr2line_cache_dir;
+static uint64_t env_io_aggregation_max_size;
+static uint64_t env_io_aggregation_window;
 #if HAVE(SCOREP_COMPILER_INSTRUMENTATION_XRAY_PLUGIN)
 static bool     env_xray_default_filter;
+static char*    env_xray_control_dir;
 #endif
 
 /*
@@ -247,6 +253,82 @@ static const SCOREP_ConfigVariable core_confvars[] = {
         "If this is set to `false`, the directory will only be created if any "
         "substrate actually writes data."
     },
+    {
+        "duty_cycle_period",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &env_duty_cycle_period,
+        NULL,
+        "0",
+        "Period in nanoseconds of the duty-cycle measurement mode",
+        "If this and `SCOREP_DUTY_CYCLE_BURST` are non-zero, events are only "
+        "recorded for a burst of `SCOREP_DUTY_CYCLE_BURST` nanoseconds at the "
+        "begin of each period, e.g., 50 ms every second. This bounds the "
+        "measurement overhead of long running applications.\n"
+        "Recording is switched off and on at region enter and exit events "
+        "of the main thread outside of parallel regions. It is only switched "
+        "on again on the same call path where it was switched off, thus bursts "
+        "may start late. If this call path is not reached within the length "
+        "of a burst, this burst is skipped.\n"
+        "The time outside of bursts is attributed to the `DUTY CYCLE OFF` "
+        "region, see also `SCOREP_PROFILING_EXTRAPOLATE_DUTY_CYCLE`."
+    },
+    {
+        "duty_cycle_burst",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &env_duty_cycle_burst,
+        NULL,
+        "0",
+        "Length in nanoseconds of the recorded burst in each duty-cycle period",
+        "See `SCOREP_DUTY_CYCLE_PERIOD`. Must be smaller than the period."
+    },
+    {
+        "addr2line_cache_dir",
+        SCOREP_CONFIG_TYPE_PATH,
+        &env_addr2line_cache_dir,
+        NULL,
+        "",
+        "Directory of the persistent address-to-line cache",
+        "If set, source code locations resolved for instrumented addresses "
+        "are stored per shared object in this directory, identified by the "
+        "object's GNU build-id. Later runs and other processes on the node "
+        "map these files and skip resolving known addresses again. The "
+        "directory must exist and should be on node-local storage. Shared "
+        "objects without build-id and addresses which could not be resolved "
+        "are not cached persistently."
+    },
+    {
+        "io_aggregation_max_size",
+        SCOREP_CONFIG_TYPE_SIZE,
+        &env_io_aggregation_max_size,
+        NULL,
+        "0",
+        "Maximum request size of aggregated POSIX I/O operations",
+        "If non-zero and tracing is enabled, consecutive blocking POSIX "
+        "reads and writes (`read`, `write`, `pread`, `pwrite`) of at most "
+        "this many bytes on the same handle are recorded as one summary "
+        "operation. A summary ends at any other event of the location, at "
+        "an operation on a different handle or of a different kind, or after "
+        "`SCOREP_IO_AGGREGATION_WINDOW`. It is written at the next I/O "
+        "operation of the location or at its end, back-dated to the time of "
+        "its first operation, with the total duration, and the total "
+        "requested and transferred bytes. If other events were recorded in "
+        "between, it is placed after them. Metrics recorded with a summary "
+        "are taken when it is written, not at its timestamps. The attributes "
+        "`IO_AGGREGATED_OPERATIONS`, `IO_AGGREGATED_TIME`, and "
+        "`IO_AGGREGATED_SIZE_<min>_<max>` carry the number of operations, "
+        "their total duration in ticks, and a histogram of their request "
+        "sizes in power-of-two classes.\n"
+        "Aggregation is not available if profiling or unwinding is enabled."
+    },
+    {
+        "io_aggregation_window",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &env_io_aggregation_window,
+        NULL,
+        "10000000",
+        "Maximum time span in nanoseconds of aggregated POSIX I/O operations",
+        "See `SCOREP_IO_AGGREGATION_MAX_SIZE`."
+    },
 #if HAVE(SCOREP_COMPILER_INSTRUMENTATION_XRAY_PLUGIN)
     {
             "xray_default_filter",
@@ -259,6 +341,22 @@ static const SCOREP_ConfigVariable core_confvars[] = {
             "instrumented functions such as std::* or MPI::*. If the default filter is disabled"
             ", these functions will be patched at runtime and therefore measured."
     },
+    {
+            "xray_control_dir",
+            SCOREP_CONFIG_TYPE_PATH,
+            &env_xray_control_dir,
+            NULL,
+            "",
+            "Directory of the XRay plugin control channel",
+            "If set, each process creates the FIFO `scorep-xray-control.<pid>` "
+            "in this directory. Filter rules written to it in the syntax of "
+            "SCOREP_FILTERING_FILE replace the runtime filter while the "
+            "application runs: functions excluded by the rules are unpatched, "
+            "all others are patched again. Functions excluded by the XRay "
+            "default filter are never patched. Each update is recorded as "
+            "parameter `XRay control update` by the threads entering a "
+            "measured function afterwards."
+    },
 #endif
     SCOREP_CONFIG_TERMINATOR
 };
@@ -362,6 +460,41 @@ SCOREP_Env_DoForceCfgFiles( void )
     return force_cfg_files;
 }
 
+uint64_t
+SCOREP_Env_GetDutyCyclePeriod( void )
+{
+    assert( env_variables_initialized );
+    return env_duty_cycle_period;
+}
+
+uint64_t
+SCOREP_Env_GetDutyCycleBurst( void )
+{
+    assert( env_variables_initialized );
+    return env_duty_cycle_burst;
+}
+
+const char*
+SCOREP_Env_GetAddr2lineCacheDir( void )
+{
+    assert( env_variables_initialized );
+    return env_addr2line_cache_dir;
+}
+
+uint64_t
+SCOREP_Env_GetIoAggregationMaxSize( void )
+{
+    assert( env_variables_initialized );
+    return env_io_aggregation_max_size;
+}
+
+uint64_t
+SCOREP_Env_GetIoAggregationWindow( void )
+{
+    assert( env_variables_initialized );
+    return env_io_aggregation_window;
+}
+
 bool
 SCOREP_Env_UseSystemTreeSequence( void )
 {
@@ -382,6 +515,13 @@ SCOREP_Env_XRayDefaultFilterActive( void )
     assert( env_variables_initialized );
     return env_xray_default_filter;
 }
+
+const char*
+SCOREP_Env_GetXRayControlDir( void )
+{
+    assert( env_variables_initialized );
+    return env_xray_control_dir;
+}
 #endif
 
 void
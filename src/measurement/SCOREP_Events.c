@@ -205,9 +205,15 @@ scorep_calling_context_enter( SCOREP_Location*    location,
 void
 SCOREP_EnterRegion( SCOREP_RegionHandle regionHandle )
 {
-    SCOREP_Location* location      = SCOREP_Location_GetCurrentCPULocation();
-    uint64_t         timestamp     = scorep_get_timestamp( location );
-    uint64_t*        metric_values = SCOREP_Metric_Read( location );
+    SCOREP_Location* location  = SCOREP_Location_GetCurrentCPULocation();
+    uint64_t         timestamp = scorep_get_timestamp( location );
+
+    if ( scorep_duty_cycle_check( location, timestamp ) )
+    {
+        timestamp = scorep_get_timestamp( location );
+    }
+
+    uint64_t* metric_values = SCOREP_Metric_Read( location );
 
     if ( SCOREP_IsUnwindingEnabled() )
     {
@@ -335,9 +341,15 @@ scorep_calling_context_exit( SCOREP_Location*    location,
 void
 SCOREP_ExitRegion( SCOREP_RegionHandle regionHandle )
 {
-    SCOREP_Location* location      = SCOREP_Location_GetCurrentCPULocation();
-    uint64_t         timestamp     = scorep_get_timestamp( location );
-    uint64_t*        metric_values = SCOREP_Metric_Read( location );
+    SCOREP_Location* location  = SCOREP_Location_GetCurrentCPULocation();
+    uint64_t         timestamp = scorep_get_timestamp( location );
+
+    if ( scorep_duty_cycle_check( location, timestamp ) )
+    {
+        timestamp = scorep_get_timestamp( location );
+    }
+
+    uint64_t* metric_values = SCOREP_Metric_Read( location );
 
     if ( SCOREP_IsUnwindingEnabled() )
     {
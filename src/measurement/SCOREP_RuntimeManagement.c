@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2017, 2019-2020, 2022,
+ * Copyright (c) 2009-2017, 2019-2020, 2022, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -82,6 +82,7 @@
 #include <SCOREP_ErrorCallback.h>
 #include <SCOREP_Task.h>
 #include <SCOREP_Addr2line.h>
+#include <tracing/SCOREP_Tracing.h>
 
 #include "scorep_type_utils.h"
 #include "scorep_subsystem_management.h"
@@ -140,6 +141,29 @@ static bool enable_recording_by_default = true;
  */
 static bool default_recoding_mode_changes_allowed = true;
 
+/* Duty-cycle measurement mode, see SCOREP_DUTY_CYCLE_PERIOD. The state is
+ * only modified by the master thread, see scorep_duty_cycle_switch(), thus
+ * only scorep_duty_cycle_next_switch, which all threads read, needs atomic
+ * accesses. */
+uint64_t                   scorep_duty_cycle_next_switch;
+static uint64_t            duty_cycle_period;
+static uint64_t            duty_cycle_burst;
+static uint64_t            duty_cycle_burst_begin;
+static uint64_t            duty_cycle_next_burst;
+static bool                duty_cycle_off;
+/* Recording is switched off by the duty cycle, not by the user */
+static bool                duty_cycle_disabled;
+static uint64_t            duty_cycle_disabled_begin;
+static SCOREP_RegionHandle duty_cycle_off_region = SCOREP_INVALID_REGION;
+/* Time recorded in bursts, and time switched off by the duty cycle. The
+ * time the user switched recording off counts as neither. */
+static uint64_t            duty_cycle_recorded;
+static uint64_t            duty_cycle_skipped;
+/* The region stack where recording was switched off */
+static SCOREP_TaskHandle   duty_cycle_task;
+static SCOREP_RegionHandle duty_cycle_top_region;
+static uint32_t            duty_cycle_stack_hash;
+
 /**
  * Indicates whether the application initiated an abortion.
  */
@@ -160,6 +184,8 @@ static void define_measurement_attributes( void );
 static void init_mpp( SCOREP_SynchronizationMode syncMode );
 static void synchronize( SCOREP_SynchronizationMode syncMode );
 static void local_cleanup( void );
+static void duty_cycle_initialize( void );
+static void duty_cycle_finalize( void );
 /* *INDENT-ON* */
 
 static char* executable_name;
@@ -558,6 +584,19 @@ SCOREP_InitMeasurementWithArgs( int argc, char* argv[] )
      */
     SCOREP_TIME( SCOREP_Thread_Initialize, ( ) );
 
+    /*
+     * Record the timer, which may be selected automatically, to explain
+     * timing overhead differences between systems.
+     *
+     * @dependsOn Thread (current location)
+     */
+    SCOREP_AddLocationProperty( "Timer", 0, SCOREP_Timer_GetName() );
+    if ( SCOREP_Timer_GetReadCost() > 0 )
+    {
+        SCOREP_AddLocationProperty( "Timer read cost [ns]", 32, "%.1f",
+                                    SCOREP_Timer_GetReadCost() );
+    }
+
     /*
      * @dependsOn Definitions
      */
@@ -613,6 +652,8 @@ SCOREP_InitMeasurementWithArgs( int argc, char* argv[] )
         SCOREP_DisableRecording();
     }
 
+    duty_cycle_initialize();
+
     /*
      * And now we allow also events from outside the measurement system.
      */
@@ -734,6 +775,48 @@ SCOREP_SetDefaultRecordingMode( bool enabled )
 }
 
 
+static void
+enable_recording( SCOREP_RegionHandle offRegion )
+{
+    SCOREP_Location* location      = SCOREP_Location_GetCurrentCPULocation();
+    uint64_t         timestamp     = SCOREP_Timer_GetClockTicks();
+    uint64_t*        metric_values = SCOREP_Metric_Read( location );
+
+    SCOREP_Substrates_EnableRecording();
+    recording_enabled = true;
+
+    SCOREP_CALL_SUBSTRATE( EnableRecording, ENABLE_RECORDING,
+                           ( location, timestamp,
+                             offRegion, metric_values ) );
+}
+
+
+static void
+disable_recording( SCOREP_RegionHandle offRegion )
+{
+    SCOREP_Location* location      = SCOREP_Location_GetCurrentCPULocation();
+    uint64_t         timestamp     = SCOREP_Timer_GetClockTicks();
+    uint64_t*        metric_values = SCOREP_Metric_Read( location );
+
+    SCOREP_CALL_SUBSTRATE( DisableRecording, DISABLE_RECORDING,
+                           ( location, timestamp,
+                             offRegion, metric_values ) );
+
+    SCOREP_Substrates_DisableRecording();
+    recording_enabled = false;
+}
+
+
+/* Ends the time recording was switched off by the duty cycle */
+static void
+duty_cycle_reenable( uint64_t timestamp )
+{
+    duty_cycle_skipped += timestamp - duty_cycle_disabled_begin;
+    duty_cycle_disabled = false;
+    enable_recording( duty_cycle_off_region );
+}
+
+
 /**
  * Enable event recording for this process.
  */
@@ -742,26 +825,22 @@ SCOREP_EnableRecording( void )
 {
     UTILS_DEBUG_ENTRY();
 
-    SCOREP_Location* location      = SCOREP_Location_GetCurrentCPULocation();
-    uint64_t         timestamp     = SCOREP_Timer_GetClockTicks();
-    uint64_t*        metric_values = SCOREP_Metric_Read( location );
-
-    if ( !SCOREP_Thread_InParallel() )
-    {
-        SCOREP_Substrates_EnableRecording();
-        recording_enabled = true;
-
-        SCOREP_CALL_SUBSTRATE( EnableRecording, ENABLE_RECORDING,
-                               ( location, timestamp,
-                                 record_off_region, metric_values ) );
-    }
-    else
+    if ( SCOREP_Thread_InParallel() )
     {
         UTILS_ERROR( SCOREP_ERROR_SWITCH_IN_PARALLEL,
                      "Invalid request for enabling recording. "
                      "Recording is not enabled" );
         return;
     }
+
+    /* The user takes over while the duty cycle switched recording off */
+    if ( duty_cycle_disabled )
+    {
+        duty_cycle_reenable( SCOREP_Timer_GetClockTicks() );
+        return;
+    }
+
+    enable_recording( record_off_region );
 }
 
 
@@ -773,26 +852,21 @@ SCOREP_DisableRecording( void )
 {
     UTILS_DEBUG_ENTRY();
 
-    SCOREP_Location* location      = SCOREP_Location_GetCurrentCPULocation();
-    uint64_t         timestamp     = SCOREP_Timer_GetClockTicks();
-    uint64_t*        metric_values = SCOREP_Metric_Read( location );
-
-    if ( !SCOREP_Thread_InParallel() )
-    {
-        SCOREP_CALL_SUBSTRATE( DisableRecording, DISABLE_RECORDING,
-                               ( location, timestamp,
-                                 record_off_region, metric_values ) );
-
-        SCOREP_Substrates_DisableRecording();
-        recording_enabled = false;
-    }
-    else
+    if ( SCOREP_Thread_InParallel() )
     {
         UTILS_ERROR( SCOREP_ERROR_SWITCH_IN_PARALLEL,
                      "Invalid request for disabling recording. "
                      "Recording is not disabled" );
         return;
     }
+
+    /* The user takes over while the duty cycle switched recording off */
+    if ( duty_cycle_disabled )
+    {
+        duty_cycle_reenable( SCOREP_Timer_GetClockTicks() );
+    }
+
+    disable_recording( record_off_region );
 }
 
 
@@ -808,6 +882,207 @@ SCOREP_RecordingEnabled( void )
 }
 
 
+static void
+duty_cycle_initialize( void )
+{
+    uint64_t period = SCOREP_Env_GetDutyCyclePeriod();
+    uint64_t burst  = SCOREP_Env_GetDutyCycleBurst();
+    if ( period == 0 || burst == 0 )
+    {
+        return;
+    }
+    if ( burst >= period )
+    {
+        UTILS_WARNING( "Ignoring duty cycle, SCOREP_DUTY_CYCLE_BURST=%" PRIu64
+                       " is not smaller than SCOREP_DUTY_CYCLE_PERIOD=%" PRIu64 ".",
+                       burst, period );
+        return;
+    }
+
+    double ticks_per_ns = SCOREP_Timer_GetClockResolutionEstimate() / 1e9;
+    duty_cycle_period = period * ticks_per_ns;
+    duty_cycle_burst  = burst * ticks_per_ns;
+    if ( duty_cycle_burst == 0 )
+    {
+        duty_cycle_burst = 1;
+    }
+
+    duty_cycle_off_region = SCOREP_Definitions_NewRegion(
+        "DUTY CYCLE OFF", NULL,
+        SCOREP_INVALID_SOURCE_FILE,
+        SCOREP_INVALID_LINE_NO,
+        SCOREP_INVALID_LINE_NO,
+        SCOREP_PARADIGM_MEASUREMENT,
+        SCOREP_REGION_ARTIFICIAL );
+
+    duty_cycle_burst_begin = SCOREP_Timer_GetClockTicks();
+    UTILS_Atomic_StoreN_uint64( &scorep_duty_cycle_next_switch,
+                                duty_cycle_burst_begin + duty_cycle_burst,
+                                UTILS_ATOMIC_RELAXED );
+}
+
+
+/* Ends the duty cycle at finalization, recording must be on afterwards */
+static void
+duty_cycle_finalize( void )
+{
+    if ( !UTILS_Atomic_LoadN_uint64( &scorep_duty_cycle_next_switch, UTILS_ATOMIC_RELAXED ) )
+    {
+        return;
+    }
+    UTILS_Atomic_StoreN_uint64( &scorep_duty_cycle_next_switch, 0, UTILS_ATOMIC_RELAXED );
+
+    uint64_t timestamp = SCOREP_Timer_GetClockTicks();
+    if ( duty_cycle_disabled )
+    {
+        duty_cycle_reenable( timestamp );
+    }
+    else if ( !duty_cycle_off && recording_enabled )
+    {
+        duty_cycle_recorded += timestamp - duty_cycle_burst_begin;
+    }
+    duty_cycle_off = false;
+}
+
+
+bool
+scorep_duty_cycle_switch( SCOREP_Location* location,
+                          uint64_t         timestamp )
+{
+    /* Only the master thread switches, on its own location. Thus the
+     * duty-cycle state has a single writer, even with threading models which
+     * are not fork-join or with locations of accelerators, whose events may
+     * be recorded by other threads. */
+    if ( SCOREP_Location_GetId( location ) != 0 )
+    {
+        return false;
+    }
+
+    /* Recording can only be switched while no other thread is active,
+     * which covers fork-join and create-wait threads */
+    if ( SCOREP_Thread_InParallel() )
+    {
+        return false;
+    }
+
+    SCOREP_TaskHandle task = SCOREP_Task_GetCurrentTask( location );
+    if ( !duty_cycle_off )
+    {
+        duty_cycle_off        = true;
+        duty_cycle_next_burst = duty_cycle_burst_begin + duty_cycle_period;
+        UTILS_Atomic_StoreN_uint64( &scorep_duty_cycle_next_switch,
+                                    duty_cycle_next_burst,
+                                    UTILS_ATOMIC_RELAXED );
+
+        /* Nothing to do if the user switched it off, the burst was not
+         * recorded then */
+        if ( !recording_enabled )
+        {
+            return false;
+        }
+
+        duty_cycle_recorded      += timestamp - duty_cycle_burst_begin;
+        duty_cycle_disabled       = true;
+        duty_cycle_disabled_begin = timestamp;
+        duty_cycle_task           = task;
+        duty_cycle_top_region     = SCOREP_Task_GetTopRegion( task );
+        duty_cycle_stack_hash     = SCOREP_Task_GetRegionStackHash( task );
+        disable_recording( duty_cycle_off_region );
+        return true;
+    }
+
+    /* Switch it on only on the call path where it was switched off, to keep
+     * the recorded region nesting consistent. The cheap comparisons come
+     * first, the stack hash is only computed if they match. */
+    if ( duty_cycle_disabled
+         && ( task != duty_cycle_task
+              || SCOREP_Task_GetTopRegion( task ) != duty_cycle_top_region
+              || SCOREP_Task_GetRegionStackHash( task ) != duty_cycle_stack_hash ) )
+    {
+        /* Every event is checked for the call path for at most the length
+         * of a burst, then this burst is skipped. Thus, the overhead stays
+         * bounded if the call path is not reached again, e.g., if recording
+         * was switched off inside a long running region. */
+        if ( timestamp >= duty_cycle_next_burst + duty_cycle_burst )
+        {
+            while ( duty_cycle_next_burst <= timestamp )
+            {
+                duty_cycle_next_burst += duty_cycle_period;
+            }
+            UTILS_Atomic_StoreN_uint64( &scorep_duty_cycle_next_switch,
+                                        duty_cycle_next_burst,
+                                        UTILS_ATOMIC_RELAXED );
+        }
+        return false;
+    }
+
+    duty_cycle_off         = false;
+    duty_cycle_burst_begin = timestamp;
+    UTILS_Atomic_StoreN_uint64( &scorep_duty_cycle_next_switch,
+                                timestamp + duty_cycle_burst,
+                                UTILS_ATOMIC_RELAXED );
+
+    if ( !duty_cycle_disabled )
+    {
+        return false;
+    }
+    duty_cycle_reenable( timestamp );
+    return true;
+}
+
+
+/**
+ * Ratio of the time in which the duty cycle recorded events to the time in
+ * which the duty cycle or its bursts had recording switched on.
+ */
+double
+SCOREP_GetRecordingCoverage( void )
+{
+    uint64_t recorded = duty_cycle_recorded;
+    uint64_t skipped  = duty_cycle_skipped;
+    if ( UTILS_Atomic_LoadN_uint64( &scorep_duty_cycle_next_switch, UTILS_ATOMIC_RELAXED ) )
+    {
+        uint64_t now = SCOREP_Timer_GetClockTicks();
+        if ( duty_cycle_disabled )
+        {
+            skipped += now - duty_cycle_disabled_begin;
+        }
+        else if ( !duty_cycle_off && recording_enabled )
+        {
+            recorded += now - duty_cycle_burst_begin;
+        }
+    }
+    if ( recorded == 0 || skipped == 0 )
+    {
+        return 1.0;
+    }
+
+    return ( double )recorded / ( recorded + skipped );
+}
+
+
+SCOREP_RegionHandle
+SCOREP_GetDutyCycleOffRegion( void )
+{
+    return duty_cycle_off_region;
+}
+
+
+/**
+ * Requests a dump of the trace ring buffers.
+ */
+void
+SCOREP_TriggerTraceDump( void )
+{
+    UTILS_DEBUG_ENTRY();
+
+    if ( SCOREP_IsTracingEnabled() )
+    {
+        SCOREP_Tracing_TriggerDump();
+    }
+}
+
+
 /**
  * Called by the tracing component before a buffer flush happens.
  */
@@ -913,6 +1188,8 @@ scorep_finalize( void )
     /* Last remaining at-exit user is TAU. Give him the chance to do something. */
     SCOREP_TIME( trigger_exit_callbacks, ( ) );
 
+    duty_cycle_finalize();
+
     if ( !enable_recording_by_default )
     {
         SCOREP_EnableRecording();
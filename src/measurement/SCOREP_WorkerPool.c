@@ -0,0 +1,394 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ * @file
+ *
+ * Implements the worker pool with Pthreads. The workers sleep on a condition
+ * variable between two loops. A loop is published by incrementing the
+ * generation counter, tasks are dispensed by an atomic counter, and the last
+ * worker that runs out of tasks signals the caller. The background thread of
+ * an SCOREP_AsyncWorker uses the same scheme with a single pending task.
+ */
+
+#include <config.h>
+#include <SCOREP_WorkerPool.h>
+
+#include <SCOREP_InMeasurement.h>
+
+#include <UTILS_Atomic.h>
+#include <UTILS_Error.h>
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if HAVE( WORKER_THREADS )
+#include <pthread.h>
+#endif
+
+
+struct SCOREP_WorkerPool
+{
+    /* Number of threads executing tasks, including the creating thread */
+    uint32_t num_threads;
+
+#if HAVE( WORKER_THREADS )
+    pthread_t*      workers;
+    pthread_mutex_t mutex;
+    pthread_cond_t  start_cond;
+    pthread_cond_t  done_cond;
+    /* Incremented for every loop, protected by mutex */
+    uint64_t        generation;
+    /* Number of workers which did not yet finish the current loop */
+    uint32_t        num_busy;
+    bool            shutdown;
+#endif
+
+    /* The current loop */
+    SCOREP_WorkerPool_Func func;
+    void*                  arg;
+    uint32_t               count;
+    uint32_t               next_index;
+};
+
+
+static void
+run_tasks( SCOREP_WorkerPool* pool )
+{
+    uint32_t index;
+    while ( ( index = UTILS_Atomic_FetchAdd_uint32( &pool->next_index, 1,
+                                                    UTILS_ATOMIC_RELAXED ) ) < pool->count )
+    {
+        pool->func( index, pool->arg );
+    }
+}
+
+
+#if HAVE( WORKER_THREADS )
+
+static void*
+worker_main( void* arg )
+{
+    SCOREP_WorkerPool* pool       = arg;
+    uint64_t           generation = 0;
+
+    /* Calls into wrapped functions, e.g., malloc or write, must not trigger
+       events, as this thread is no location */
+    SCOREP_IN_MEASUREMENT_INCREMENT();
+
+    pthread_mutex_lock( &pool->mutex );
+    while ( true )
+    {
+        while ( !pool->shutdown && pool->generation == generation )
+        {
+            pthread_cond_wait( &pool->start_cond, &pool->mutex );
+        }
+        if ( pool->shutdown )
+        {
+            break;
+        }
+        generation = pool->generation;
+        pthread_mutex_unlock( &pool->mutex );
+
+        run_tasks( pool );
+
+        pthread_mutex_lock( &pool->mutex );
+        if ( --pool->num_busy == 0 )
+        {
+            pthread_cond_signal( &pool->done_cond );
+        }
+    }
+    pthread_mutex_unlock( &pool->mutex );
+
+    SCOREP_IN_MEASUREMENT_DECREMENT();
+
+    return NULL;
+}
+
+#endif /* HAVE( WORKER_THREADS ) */
+
+
+SCOREP_WorkerPool*
+SCOREP_WorkerPool_Create( uint32_t numThreads,
+                          uint32_t maxThreads )
+{
+    if ( numThreads == 0 )
+    {
+        long online = sysconf( _SC_NPROCESSORS_ONLN );
+        numThreads = online > 0 ? ( uint32_t )online : 1;
+    }
+    if ( maxThreads != 0 && numThreads > maxThreads )
+    {
+        numThreads = maxThreads;
+    }
+    if ( numThreads <= 1 )
+    {
+        return NULL;
+    }
+
+#if HAVE( WORKER_THREADS )
+    SCOREP_WorkerPool* pool = calloc( 1, sizeof( *pool ) );
+    UTILS_ASSERT( pool );
+    pool->workers = calloc( numThreads - 1, sizeof( *pool->workers ) );
+    UTILS_ASSERT( pool->workers );
+    pthread_mutex_init( &pool->mutex, NULL );
+    pthread_cond_init( &pool->start_cond, NULL );
+    pthread_cond_init( &pool->done_cond, NULL );
+
+    pool->num_threads = 1;
+    for ( uint32_t i = 0; i < numThreads - 1; i++ )
+    {
+        int result = pthread_create( &pool->workers[ i ], NULL, worker_main, pool );
+        if ( result != 0 )
+        {
+            UTILS_WARNING( "Could only create %" PRIu32 " of %" PRIu32 " worker threads: %s",
+                           i, numThreads - 1, strerror( result ) );
+            break;
+        }
+        pool->num_threads++;
+    }
+    if ( pool->num_threads == 1 )
+    {
+        SCOREP_WorkerPool_Destroy( pool );
+        return NULL;
+    }
+
+    return pool;
+#else
+    return NULL;
+#endif /* HAVE( WORKER_THREADS ) */
+}
+
+
+uint32_t
+SCOREP_WorkerPool_GetNumThreads( SCOREP_WorkerPool* pool )
+{
+    return pool ? pool->num_threads : 1;
+}
+
+
+void
+SCOREP_WorkerPool_ParallelFor( SCOREP_WorkerPool*     pool,
+                               uint32_t               count,
+                               SCOREP_WorkerPool_Func func,
+                               void*                  arg )
+{
+    if ( pool == NULL || count <= 1 )
+    {
+        for ( uint32_t i = 0; i < count; i++ )
+        {
+            func( i, arg );
+        }
+        return;
+    }
+
+#if HAVE( WORKER_THREADS )
+    pthread_mutex_lock( &pool->mutex );
+    pool->func       = func;
+    pool->arg        = arg;
+    pool->count      = count;
+    pool->next_index = 0;
+    pool->num_busy   = pool->num_threads - 1;
+    pool->generation++;
+    pthread_cond_broadcast( &pool->start_cond );
+    pthread_mutex_unlock( &pool->mutex );
+
+    run_tasks( pool );
+
+    pthread_mutex_lock( &pool->mutex );
+    while ( pool->num_busy > 0 )
+    {
+        pthread_cond_wait( &pool->done_cond, &pool->mutex );
+    }
+    pthread_mutex_unlock( &pool->mutex );
+#endif /* HAVE( WORKER_THREADS ) */
+}
+
+
+void
+SCOREP_WorkerPool_Destroy( SCOREP_WorkerPool* pool )
+{
+    if ( pool == NULL )
+    {
+        return;
+    }
+
+#if HAVE( WORKER_THREADS )
+    pthread_mutex_lock( &pool->mutex );
+    pool->shutdown = true;
+    pthread_cond_broadcast( &pool->start_cond );
+    pthread_mutex_unlock( &pool->mutex );
+
+    for ( uint32_t i = 0; i < pool->num_threads - 1; i++ )
+    {
+        pthread_join( pool->workers[ i ], NULL );
+    }
+
+    pthread_cond_destroy( &pool->done_cond );
+    pthread_cond_destroy( &pool->start_cond );
+    pthread_mutex_destroy( &pool->mutex );
+    free( pool->workers );
+#endif /* HAVE( WORKER_THREADS ) */
+    free( pool );
+}
+
+
+struct SCOREP_AsyncWorker
+{
+#if HAVE( WORKER_THREADS )
+    pthread_t       thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    bool            busy;
+    bool            shutdown;
+#endif
+
+    /* The current task */
+    SCOREP_WorkerPool_Func func;
+    void*                  arg;
+};
+
+
+#if HAVE( WORKER_THREADS )
+
+static void*
+async_worker_main( void* arg )
+{
+    SCOREP_AsyncWorker* worker = arg;
+
+    /* See worker_main() */
+    SCOREP_IN_MEASUREMENT_INCREMENT();
+
+    pthread_mutex_lock( &worker->mutex );
+    while ( true )
+    {
+        while ( !worker->shutdown && !worker->busy )
+        {
+            pthread_cond_wait( &worker->cond, &worker->mutex );
+        }
+        if ( !worker->busy )
+        {
+            break;
+        }
+        pthread_mutex_unlock( &worker->mutex );
+
+        worker->func( 0, worker->arg );
+
+        pthread_mutex_lock( &worker->mutex );
+        worker->busy = false;
+        pthread_cond_broadcast( &worker->cond );
+    }
+    pthread_mutex_unlock( &worker->mutex );
+
+    SCOREP_IN_MEASUREMENT_DECREMENT();
+
+    return NULL;
+}
+
+#endif /* HAVE( WORKER_THREADS ) */
+
+
+SCOREP_AsyncWorker*
+SCOREP_AsyncWorker_Create( void )
+{
+#if HAVE( WORKER_THREADS )
+    SCOREP_AsyncWorker* worker = calloc( 1, sizeof( *worker ) );
+    UTILS_ASSERT( worker );
+    pthread_mutex_init( &worker->mutex, NULL );
+    pthread_cond_init( &worker->cond, NULL );
+
+    int result = pthread_create( &worker->thread, NULL, async_worker_main, worker );
+    if ( result != 0 )
+    {
+        UTILS_WARNING( "Could not create background thread: %s", strerror( result ) );
+        pthread_cond_destroy( &worker->cond );
+        pthread_mutex_destroy( &worker->mutex );
+        free( worker );
+        return NULL;
+    }
+
+    return worker;
+#else
+    return NULL;
+#endif /* HAVE( WORKER_THREADS ) */
+}
+
+
+void
+SCOREP_AsyncWorker_Start( SCOREP_AsyncWorker*    worker,
+                          SCOREP_WorkerPool_Func func,
+                          void*                  arg )
+{
+    if ( worker == NULL )
+    {
+        func( 0, arg );
+        return;
+    }
+
+#if HAVE( WORKER_THREADS )
+    pthread_mutex_lock( &worker->mutex );
+    while ( worker->busy )
+    {
+        pthread_cond_wait( &worker->cond, &worker->mutex );
+    }
+    worker->func = func;
+    worker->arg  = arg;
+    worker->busy = true;
+    pthread_cond_broadcast( &worker->cond );
+    pthread_mutex_unlock( &worker->mutex );
+#endif /* HAVE( WORKER_THREADS ) */
+}
+
+
+void
+SCOREP_AsyncWorker_Wait( SCOREP_AsyncWorker* worker )
+{
+    if ( worker == NULL )
+    {
+        return;
+    }
+
+#if HAVE( WORKER_THREADS )
+    pthread_mutex_lock( &worker->mutex );
+    while ( worker->busy )
+    {
+        pthread_cond_wait( &worker->cond, &worker->mutex );
+    }
+    pthread_mutex_unlock( &worker->mutex );
+#endif /* HAVE( WORKER_THREADS ) */
+}
+
+
+void
+SCOREP_AsyncWorker_Destroy( SCOREP_AsyncWorker* worker )
+{
+    if ( worker == NULL )
+    {
+        return;
+    }
+
+#if HAVE( WORKER_THREADS )
+    pthread_mutex_lock( &worker->mutex );
+    worker->shutdown = true;
+    pthread_cond_broadcast( &worker->cond );
+    pthread_mutex_unlock( &worker->mutex );
+
+    pthread_join( worker->thread, NULL );
+
+    pthread_cond_destroy( &worker->cond );
+    pthread_mutex_destroy( &worker->mutex );
+#endif /* HAVE( WORKER_THREADS ) */
+    free( worker );
+}
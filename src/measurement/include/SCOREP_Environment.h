@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2011,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2011, 2015-2016, 2019,
+ * Copyright (c) 2009-2011, 2015-2016, 2019, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2011,
@@ -82,6 +82,21 @@ SCOREP_Env_GetExecutable( void );
 bool
 SCOREP_Env_UseSystemTreeSequence( void );
 
+uint64_t
+SCOREP_Env_GetDutyCyclePeriod( void );
+
+uint64_t
+SCOREP_Env_GetDutyCycleBurst( void );
+
+const char*
+SCOREP_Env_GetAddr2lineCacheDir( void );
+
+uint64_t
+SCOREP_Env_GetIoAggregationMaxSize( void );
+
+uint64_t
+SCOREP_Env_GetIoAggregationWindow( void );
+
 /*
  * Tracing setup
  */
@@ -114,6 +129,9 @@ SCOREP_Env_DoForceCfgFiles( void );
 #if HAVE(XRAY_PLUGIN_SUPPORT)
 bool
 SCOREP_Env_XRayDefaultFilterActive( void );
+
+const char*
+SCOREP_Env_GetXRayControlDir( void );
 #endif
 
 UTILS_END_C_DECLS
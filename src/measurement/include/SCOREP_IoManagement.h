@@ -1,7 +1,7 @@
 /*
  * This file is part of the Score-P software (http://www.score-p.org)
  *
- * Copyright (c) 2017, 2023,
+ * Copyright (c) 2017, 2023, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * This software may be modified and distributed under the terms of
@@ -124,6 +124,8 @@ SCOREP_IoMgmt_GetParadigmName( SCOREP_IoParadigmType paradigm );
  * @brief Determines the absolute path of a given file and creates the Score-P
  *        file I/O handle. This is internally stored and returned.
  *        In the case the file does not exists, SCOREP_INVALID_IO_FILE is returned.
+ *        Recently resolved path names are cached, see
+ *        SCOREP_IoMgmt_InvalidateIoFileHandles.
  *
  * @param pathname      The path to a file or directory.
  *
@@ -133,6 +135,16 @@ SCOREP_IoMgmt_GetParadigmName( SCOREP_IoParadigmType paradigm );
 SCOREP_IoFileHandle
 SCOREP_IoMgmt_GetIoFileHandle( const char* pathname );
 
+/**
+ * @brief Invalidates the results of SCOREP_IoMgmt_GetIoFileHandle, which are
+ *        cached per given path name to avoid repeated path resolution.
+ *        Needs to be called after operations that may change the resolution
+ *        of a path name, like renaming or deleting files, or changing the
+ *        working directory.
+ */
+void
+SCOREP_IoMgmt_InvalidateIoFileHandles( void );
+
 /**
  * @brief Returns the absolute path as C string of a Score-P I/O handle.
  *
@@ -384,6 +396,91 @@ SCOREP_IoMgmt_PushHandle( SCOREP_IoHandleHandle handle );
 void
 SCOREP_IoMgmt_PopHandle( SCOREP_IoHandleHandle handle );
 
+/**
+ * @}
+ */
+
+/**
+ * Aggregated I/O operations.
+ *
+ * Consecutive small blocking operations on the same I/O handle can be
+ * recorded as one summary operation, see `SCOREP_IO_AGGREGATION_MAX_SIZE`.
+ * A summary is written at the next I/O operation of the location, which
+ * wrappers enter via SCOREP_IO_MGMT_ENTER_WRAPPED_REGION(), or when the
+ * location is deactivated. Events of the location written in between end
+ * the summary and precede it.
+ *
+ * @{
+ */
+
+/**
+ * @brief Starts a blocking I/O operation in aggregated form, if possible.
+ *
+ * Call in a wrapper instead of entering the region, pushing the I/O handle,
+ * and triggering the I/O operation begin event.
+ *
+ * @param paradigm      The I/O paradigm to operate in.
+ * @param ioHandle      The paradigm specific I/O handle reference.
+ * @param region        The region of the wrapper.
+ * @param mode          The I/O operation mode.
+ * @param bytesRequest  The requested bytes.
+ * @param matchingId    The matching id of the blocking operation.
+ *
+ * @return True if the operation is aggregated. Then no other event must be
+ *         triggered for it and SCOREP_IoMgmt_CompleteAggregatedOperation()
+ *         must be called after the actual action.
+ */
+bool
+SCOREP_IoMgmt_BeginAggregatedOperation( SCOREP_IoParadigmType  paradigm,
+                                        const void*            ioHandle,
+                                        SCOREP_RegionHandle    region,
+                                        SCOREP_IoOperationMode mode,
+                                        uint64_t               bytesRequest,
+                                        uint64_t               matchingId );
+
+/**
+ * @brief Completes an aggregated I/O operation.
+ *
+ * @param bytesResult   The transferred bytes.
+ */
+void
+SCOREP_IoMgmt_CompleteAggregatedOperation( uint64_t bytesResult );
+
+/**
+ * @brief Writes the pending summary operation of the current location, if
+ * any.
+ *
+ * Only call if @a scorep_io_mgmt_aggregation_enabled is set.
+ */
+void
+SCOREP_IoMgmt_FlushAggregatedOperation( void );
+
+/**
+ * True if I/O operations may be aggregated in this measurement.
+ */
+extern bool scorep_io_mgmt_aggregation_enabled;
+
+/**
+ * @brief Enters the region of an I/O wrapper.
+ *
+ * Use in I/O wrappers instead of SCOREP_EnterWrappedRegion(). Writes the
+ * pending summary operation of the current location first, so that it
+ * precedes the events of this I/O operation. A macro, as
+ * SCOREP_EnterWrappedRegion() needs the return address of the wrapper.
+ *
+ * @param region        The region of the wrapper.
+ */
+#define SCOREP_IO_MGMT_ENTER_WRAPPED_REGION( region ) \
+    do \
+    { \
+        if ( scorep_io_mgmt_aggregation_enabled ) \
+        { \
+            SCOREP_IoMgmt_FlushAggregatedOperation(); \
+        } \
+        SCOREP_EnterWrappedRegion( region ); \
+    } \
+    while ( 0 )
+
 /**
  * @}
  */
@@ -176,6 +176,36 @@ SCOREP_DisableRecording( void );
 bool
 SCOREP_RecordingEnabled( void );
 
+
+/**
+ * Ratio of the time in which events were recorded by the duty-cycle
+ * measurement mode (SCOREP_DUTY_CYCLE_PERIOD), to this time plus the time
+ * the duty cycle switched recording off. Time in which the user switched
+ * recording off is not included.
+ *
+ * @return The ratio in (0,1], 1 if the duty cycle is not active.
+ */
+double
+SCOREP_GetRecordingCoverage( void );
+
+
+/**
+ * The region entered while the duty cycle switched recording off.
+ *
+ * @return The region handle, SCOREP_INVALID_REGION if the duty cycle is not
+ * active.
+ */
+SCOREP_RegionHandle
+SCOREP_GetDutyCycleOffRegion( void );
+
+
+/**
+ * Requests a dump of the trace ring buffers of this process, if tracing is
+ * in flight recorder mode (SCOREP_TRACING_RING_SIZE). Noop otherwise.
+ */
+void
+SCOREP_TriggerTraceDump( void );
+
 /**
  * Sets whether recording is enabled or disabled by default at measurement start.
  * Has only effect, when set during initialization.
@@ -0,0 +1,148 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+#ifndef SCOREP_WORKER_POOL_H
+#define SCOREP_WORKER_POOL_H
+
+/**
+ * @file
+ * @brief A pool of threads to parallelize the processing of measurement data
+ *        at finalization, e.g., of the data of all locations of a process.
+ *
+ * The worker threads are plain threads of the threading system, they are
+ * neither Score-P locations nor seen by the threading adapters. Thus, tasks
+ * must not trigger events or call SCOREP_Location_GetCurrentCPULocation().
+ * Memory needs to be allocated from the location whose data is processed.
+ *
+ * Without thread support, or if only one thread is requested, no pool is
+ * created and SCOREP_WorkerPool_ParallelFor() runs all tasks on the calling
+ * thread. The same applies to the background thread of SCOREP_AsyncWorker.
+ */
+
+#include <stdint.h>
+
+
+/** Opaque type of a worker pool. */
+typedef struct SCOREP_WorkerPool SCOREP_WorkerPool;
+
+
+/**
+ * Type of the function which processes one task of
+ * SCOREP_WorkerPool_ParallelFor().
+ *
+ * @param index  The index of the task, in the range [0, count).
+ * @param arg    The argument passed to SCOREP_WorkerPool_ParallelFor().
+ */
+typedef void ( * SCOREP_WorkerPool_Func )( uint32_t index,
+                                           void*    arg );
+
+
+/**
+ * Creates a worker pool.
+ *
+ * @param numThreads  The number of threads that execute tasks, including the
+ *                    calling thread. 0 selects one thread per online CPU.
+ * @param maxThreads  Upper bound for the number of threads, e.g., the number
+ *                    of tasks. 0 means no bound.
+ *
+ * @return The new pool, or NULL if the tasks shall run serially.
+ */
+SCOREP_WorkerPool*
+SCOREP_WorkerPool_Create( uint32_t numThreads,
+                          uint32_t maxThreads );
+
+
+/**
+ * Returns the number of threads executing tasks, including the calling thread.
+ *
+ * @param pool  The pool, may be NULL.
+ */
+uint32_t
+SCOREP_WorkerPool_GetNumThreads( SCOREP_WorkerPool* pool );
+
+
+/**
+ * Calls @a func for every index in [0, @a count) and returns after all calls
+ * finished. The calling thread participates in the processing. Tasks are
+ * assigned dynamically, in ascending order of their index. Must only be called
+ * by the thread that created the pool.
+ *
+ * @param pool   The pool, if NULL all tasks are processed by the calling thread.
+ * @param count  The number of tasks.
+ * @param func   The function to call for each task.
+ * @param arg    The argument passed to @a func.
+ */
+void
+SCOREP_WorkerPool_ParallelFor( SCOREP_WorkerPool*     pool,
+                               uint32_t               count,
+                               SCOREP_WorkerPool_Func func,
+                               void*                  arg );
+
+
+/**
+ * Terminates the worker threads and releases the pool.
+ *
+ * @param pool  The pool, may be NULL.
+ */
+void
+SCOREP_WorkerPool_Destroy( SCOREP_WorkerPool* pool );
+
+
+/** Opaque type of a thread that runs one task at a time in the background. */
+typedef struct SCOREP_AsyncWorker SCOREP_AsyncWorker;
+
+
+/**
+ * Creates a thread that runs tasks in the background, e.g., to overlap file
+ * output with communication.
+ *
+ * @return The new worker, or NULL if tasks shall run synchronously.
+ */
+SCOREP_AsyncWorker*
+SCOREP_AsyncWorker_Create( void );
+
+
+/**
+ * Waits until the previous task finished and starts calling @a func with
+ * index 0 and @a arg in the background. Tasks are thus executed one after
+ * another in the order of submission.
+ *
+ * @param worker  The worker, if NULL @a func is called by the calling thread
+ *                before this function returns.
+ * @param func    The function to call.
+ * @param arg     The argument passed to @a func.
+ */
+void
+SCOREP_AsyncWorker_Start( SCOREP_AsyncWorker*    worker,
+                          SCOREP_WorkerPool_Func func,
+                          void*                  arg );
+
+
+/**
+ * Waits until the last started task finished.
+ *
+ * @param worker  The worker, may be NULL.
+ */
+void
+SCOREP_AsyncWorker_Wait( SCOREP_AsyncWorker* worker );
+
+
+/**
+ * Waits for the last task, terminates the thread, and releases the worker.
+ *
+ * @param worker  The worker, may be NULL.
+ */
+void
+SCOREP_AsyncWorker_Destroy( SCOREP_AsyncWorker* worker );
+
+
+#endif /* SCOREP_WORKER_POOL_H */
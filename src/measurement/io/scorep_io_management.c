@@ -1,7 +1,7 @@
 /*
  * This file is part of the Score-P software (http://www.score-p.org)
  *
- * Copyright (c) 2017, 2019-2020, 2022-2023,
+ * Copyright (c) 2017, 2019-2020, 2022-2023, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2022,
@@ -20,7 +20,9 @@
 
 #include <config.h>
 
+#include <inttypes.h>
 #include <limits.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -30,7 +32,11 @@
 #include <SCOREP_Platform.h>
 #include <SCOREP_Events.h>
 #include <SCOREP_FastHashtab.h>
+#include <SCOREP_RuntimeManagement.h>
+#include <SCOREP_Timer_Ticks.h>
+#include <SCOREP_Timer_Utils.h>
 
+#include <scorep_status.h>
 #include <scorep_subsystem_management.h>
 #include <scorep_substrates_definition.h>
 
@@ -39,11 +45,17 @@
 #define SCOREP_DEBUG_MODULE_NAME IO_MANAGEMENT
 #include <UTILS_Debug.h>
 #include <UTILS_Mutex.h>
+#include <UTILS_Atomic.h>
 
 #define SCOREP_IO_HANDLE_HASHTABLE_POWER 6
 #define SCOREP_IO_HANDLE_HASHTABLE_MASK hashmask( SCOREP_IO_HANDLE_HASHTABLE_POWER )
 #define SCOREP_IO_HANDLE_HASHTABLE_SIZE hashsize( SCOREP_IO_HANDLE_HASHTABLE_POWER )
 
+/** Initial number of entries in the direct-indexed handle table. */
+#define SCOREP_IO_HANDLE_DIRECT_TABLE_MIN_SIZE 1024
+/** I/O handles larger or equal to this value are only kept in the hash table. */
+#define SCOREP_IO_HANDLE_DIRECT_TABLE_MAX_SIZE ( 1 << 24 )
+
 /** @brief Payload in every IoHandleHandle definition. */
 typedef struct io_handle_payload
 {
@@ -66,6 +78,21 @@ typedef struct io_handle_stack_entry
     uint32_t recursive_creation_counter;
 } io_handle_stack_entry;
 
+/** @brief Direct-indexed table of active I/O handles, used for paradigms
+    whose I/O handles are small non-negative integers (i.e., file descriptors).
+    The table is replaced by a larger copy when needed. Replaced tables are
+    kept until the paradigm is deregistered, as concurrent readers may still
+    access them. */
+typedef struct io_handle_direct_table io_handle_direct_table;
+struct io_handle_direct_table
+{
+    /** @brief The replaced, smaller table */
+    io_handle_direct_table* previous;
+    /** @brief Number of entries in @a handles */
+    uint32_t                size;
+    SCOREP_IoHandleHandle   handles[];
+};
+
 /** @brief context for one registered I/O paradigm. */
 typedef struct io_mgmt_paradigm
 {
@@ -73,20 +100,51 @@ typedef struct io_mgmt_paradigm
     SCOREP_IoParadigm* definition;
     /** @brief The size for the paradigm specific I/O handle value
         (i.e., sizeof(int|FILE*|MPI_File)). */
-    size_t                payload_size;
+    size_t                  payload_size;
     /** @brief Hash table of all active I/O handles. */
-    SCOREP_IoHandleHandle handles[ SCOREP_IO_HANDLE_HASHTABLE_SIZE ];
+    SCOREP_IoHandleHandle   handles[ SCOREP_IO_HANDLE_HASHTABLE_SIZE ];
     /** @brief mutex to protect @a handles table for this I/O paradigm */
-    UTILS_Mutex           mutex;
+    UTILS_Mutex             mutex;
+    /** @brief Lock-free lookup table of the active I/O handles in @a handles,
+        only for integer-keyed paradigms, NULL otherwise. Writers hold
+        @a mutex. */
+    io_handle_direct_table* direct_handles;
 } io_mgmt_paradigm;
 
+/** Number of power-of-two classes of the request size histogram. */
+#define IO_AGGREGATION_SIZE_CLASSES 65
+
+/** @brief Pending summary of consecutive aggregated I/O operations. */
+typedef struct io_aggregated_operation
+{
+    SCOREP_IoHandleHandle  handle;
+    SCOREP_RegionHandle    region;
+    SCOREP_IoOperationMode mode;
+    uint64_t               matching_id;
+    /** @brief Number of completed operations, 0 if nothing is pending */
+    uint64_t               n_operations;
+    /** @brief Begin of the first completed operation */
+    uint64_t               begin;
+    /** @brief Sum of the durations of the completed operations */
+    uint64_t               duration;
+    uint64_t               bytes_request;
+    uint64_t               bytes_result;
+    /** @brief Begin and request size of the current operation */
+    uint64_t               current_begin;
+    uint64_t               current_bytes_request;
+    /** @brief Number of operations per request size class */
+    uint64_t               size_classes[ IO_AGGREGATION_SIZE_CLASSES ];
+} io_aggregated_operation;
+
 /** @brief The per-location data, which holds the locations handle stack. */
 typedef struct io_mgmt_location_data
 {
     /** @brief This locations current handle stack. */
-    io_handle_stack_entry* handle_stack;
+    io_handle_stack_entry*  handle_stack;
     /** @brief unused handle stack entries */
-    io_handle_stack_entry* unused_handle_stack_entries;
+    io_handle_stack_entry*  unused_handle_stack_entries;
+    /** @brief The pending summary of aggregated I/O operations */
+    io_aggregated_operation aggregated_operation;
 } io_mgmt_location_data;
 
 static size_t io_mgmt_subsystem_id;
@@ -94,6 +152,16 @@ static size_t io_mgmt_subsystem_id;
 /** @brief All registered I/O paradigms. */
 static io_mgmt_paradigm* io_paradigms[ SCOREP_NUM_IO_PARADIGMS ];
 
+bool scorep_io_mgmt_aggregation_enabled;
+
+/** @brief Maximum request size and time span in ticks of aggregated operations. */
+static uint64_t io_aggregation_max_size;
+static uint64_t io_aggregation_window;
+
+static SCOREP_AttributeHandle io_aggregation_operations_attribute;
+static SCOREP_AttributeHandle io_aggregation_time_attribute;
+static SCOREP_AttributeHandle io_aggregation_size_attributes[ IO_AGGREGATION_SIZE_CLASSES ];
+
 /************************** I/O file handle table *****************************/
 
 typedef struct
@@ -150,6 +218,77 @@ SCOREP_HASH_TABLE_MONOTONIC( io_file_table,
                              6,
                              hashsize( IO_FILE_TABLE_HASH_EXPONENT ) );
 
+/************************** I/O file path cache *******************************/
+
+/* Direct-mapped cache from given path names to file handles, avoids the
+ * realpath() call, and its lstat() per path component, when the same files
+ * are opened repeatedly. Longer path names are not cached. */
+#define IO_FILE_PATH_CACHE_SIZE     64
+#define IO_FILE_PATH_CACHE_MAX_PATH 256
+
+typedef struct
+{
+    uint32_t            generation;
+    uint32_t            hash_value;
+    SCOREP_IoFileHandle file_handle;
+    char                path[ IO_FILE_PATH_CACHE_MAX_PATH ];
+} io_file_path_cache_entry;
+
+static io_file_path_cache_entry io_file_path_cache[ IO_FILE_PATH_CACHE_SIZE ];
+static UTILS_Mutex              io_file_path_cache_mutex = UTILS_MUTEX_INIT;
+
+/* Entries of older generations are invalid */
+static uint32_t io_file_path_cache_generation;
+
+static bool
+io_file_path_cache_lookup( const char*          pathname,
+                           uint32_t             hashValue,
+                           uint32_t             generation,
+                           SCOREP_IoFileHandle* fileHandle )
+{
+    io_file_path_cache_entry* entry = &io_file_path_cache[ hashValue % IO_FILE_PATH_CACHE_SIZE ];
+    bool                      found = false;
+
+    UTILS_MutexLock( &io_file_path_cache_mutex );
+    if ( entry->file_handle != SCOREP_INVALID_IO_FILE
+         && entry->generation == generation
+         && entry->hash_value == hashValue
+         && strcmp( entry->path, pathname ) == 0 )
+    {
+        *fileHandle = entry->file_handle;
+        found       = true;
+    }
+    UTILS_MutexUnlock( &io_file_path_cache_mutex );
+
+    return found;
+}
+
+/* @a generation is the one read before resolving @a pathname, so a result
+ * racing with an invalidation is never used. */
+static void
+io_file_path_cache_insert( const char*         pathname,
+                           size_t              length,
+                           uint32_t            hashValue,
+                           uint32_t            generation,
+                           SCOREP_IoFileHandle fileHandle )
+{
+    io_file_path_cache_entry* entry = &io_file_path_cache[ hashValue % IO_FILE_PATH_CACHE_SIZE ];
+
+    UTILS_MutexLock( &io_file_path_cache_mutex );
+    entry->generation  = generation;
+    entry->hash_value  = hashValue;
+    entry->file_handle = fileHandle;
+    memcpy( entry->path, pathname, length + 1 );
+    UTILS_MutexUnlock( &io_file_path_cache_mutex );
+}
+
+void
+SCOREP_IoMgmt_InvalidateIoFileHandles( void )
+{
+    UTILS_Atomic_AddFetch_uint32( &io_file_path_cache_generation, 1,
+                                  UTILS_ATOMIC_SEQUENTIAL_CONSISTENT );
+}
+
 /******************************************************************************/
 
 static inline io_mgmt_location_data*
@@ -273,6 +412,83 @@ insert_handle( SCOREP_IoParadigmType paradigm,
     io_paradigms[ paradigm ]->handles[ index ] = handle;
 }
 
+/** @brief Returns true and sets @a index if @a ioHandle is kept in the
+    direct-indexed table of @a paradigm. */
+static inline bool
+direct_table_index( io_mgmt_paradigm* paradigm,
+                    const void*       ioHandle,
+                    uint32_t*         index )
+{
+    if ( !paradigm->direct_handles )
+    {
+        return false;
+    }
+
+    int fd;
+    memcpy( &fd, ioHandle, sizeof( fd ) );
+    if ( fd < 0 || fd >= SCOREP_IO_HANDLE_DIRECT_TABLE_MAX_SIZE )
+    {
+        return false;
+    }
+
+    *index = fd;
+    return true;
+}
+
+/** @brief Sets the direct-indexed table entry of @a ioHandle to the active
+    I/O handle in the hash table. Grows the direct-indexed table if needed.
+    Needs to be called with the paradigm's mutex held. */
+static void
+direct_table_update( SCOREP_IoParadigmType paradigm,
+                     const void*           ioHandle )
+{
+    io_mgmt_paradigm* ctx = io_paradigms[ paradigm ];
+    uint32_t          index;
+    if ( !direct_table_index( ctx, ioHandle, &index ) )
+    {
+        return;
+    }
+
+    io_handle_payload*    entry;
+    SCOREP_IoHandleHandle handle = *get_handle_ref( paradigm, ioHandle, 0, &entry );
+
+    io_handle_direct_table* table = ctx->direct_handles;
+    if ( index >= table->size )
+    {
+        if ( handle == SCOREP_INVALID_IO_HANDLE )
+        {
+            /* entries beyond the table are invalid anyway */
+            return;
+        }
+
+        uint32_t new_size = table->size;
+        while ( new_size <= index )
+        {
+            new_size *= 2;
+        }
+
+        io_handle_direct_table* new_table =
+            malloc( sizeof( *new_table ) + new_size * sizeof( SCOREP_IoHandleHandle ) );
+        UTILS_ASSERT( new_table );
+        new_table->previous = table;
+        new_table->size     = new_size;
+        memcpy( new_table->handles, table->handles,
+                table->size * sizeof( SCOREP_IoHandleHandle ) );
+        for ( uint32_t i = table->size; i < new_size; i++ )
+        {
+            new_table->handles[ i ] = SCOREP_INVALID_IO_HANDLE;
+        }
+
+        /* publish the complete table to the readers */
+        UTILS_Atomic_StoreN_void_ptr( ( void** )&ctx->direct_handles, new_table,
+                                      UTILS_ATOMIC_RELEASE );
+        table = new_table;
+    }
+
+    UTILS_Atomic_StoreN_uint32( &table->handles[ index ], handle,
+                                UTILS_ATOMIC_RELAXED );
+}
+
 void
 SCOREP_IoMgmt_RegisterParadigm( SCOREP_IoParadigmType     paradigm,
                                 SCOREP_IoParadigmClass    paradigmClass,
@@ -323,6 +539,25 @@ SCOREP_IoMgmt_RegisterParadigm( SCOREP_IoParadigmType     paradigm,
     va_end( va );
 
     io_paradigms[ paradigm ]->payload_size = payloadSize;
+
+    /* POSIX file descriptors are small integers, resolve them without
+     * the paradigm's mutex via a direct-indexed table */
+    if ( paradigm == SCOREP_IO_PARADIGM_POSIX )
+    {
+        UTILS_BUG_ON( payloadSize != sizeof( int ),
+                      "Invalid I/O handle size for direct-indexed table" );
+
+        io_handle_direct_table* table =
+            malloc( sizeof( *table ) + SCOREP_IO_HANDLE_DIRECT_TABLE_MIN_SIZE * sizeof( SCOREP_IoHandleHandle ) );
+        UTILS_ASSERT( table );
+        table->previous = NULL;
+        table->size     = SCOREP_IO_HANDLE_DIRECT_TABLE_MIN_SIZE;
+        for ( uint32_t i = 0; i < table->size; i++ )
+        {
+            table->handles[ i ] = SCOREP_INVALID_IO_HANDLE;
+        }
+        io_paradigms[ paradigm ]->direct_handles = table;
+    }
 }
 
 void
@@ -333,6 +568,14 @@ SCOREP_IoMgmt_DeregisterParadigm( SCOREP_IoParadigmType paradigm )
     UTILS_BUG_ON( !io_paradigms[ paradigm ],
                   "Paradigm cannot be de-registered because it was never registered" );
 
+    io_handle_direct_table* table = io_paradigms[ paradigm ]->direct_handles;
+    while ( table )
+    {
+        io_handle_direct_table* previous = table->previous;
+        free( table );
+        table = previous;
+    }
+
     free( io_paradigms[ paradigm ] );
 
     io_paradigms[ paradigm ] = NULL;
@@ -401,6 +644,8 @@ SCOREP_IoMgmt_CreatePreCreatedHandle( SCOREP_IoParadigmType            paradigm,
     payload->next                              = io_paradigms[ paradigm ]->handles[ index ];
     io_paradigms[ paradigm ]->handles[ index ] = handle;
 
+    direct_table_update( paradigm, ioHandle );
+
     UTILS_MutexUnlock( &io_paradigms[ paradigm ]->mutex );
 }
 
@@ -488,6 +733,7 @@ SCOREP_IoMgmt_CompleteHandleCreation( SCOREP_IoParadigmType paradigm,
     UTILS_MutexLock( &io_paradigms[ paradigm ]->mutex );
 
     insert_handle( paradigm, handle, payload_get_handle( entry ), entry->hash );
+    direct_table_update( paradigm, payload_get_handle( entry ) );
 
     UTILS_MutexUnlock( &io_paradigms[ paradigm ]->mutex );
 
@@ -579,6 +825,7 @@ SCOREP_IoMgmt_CompleteHandleDuplication( SCOREP_IoParadigmType paradigm,
     UTILS_MutexLock( &io_paradigms[ paradigm ]->mutex );
 
     insert_handle( paradigm, handle, payload_get_handle( entry ), entry->hash );
+    direct_table_update( paradigm, payload_get_handle( entry ) );
 
     UTILS_MutexUnlock( &io_paradigms[ paradigm ]->mutex );
 
@@ -632,6 +879,8 @@ SCOREP_IoMgmt_RemoveHandle( SCOREP_IoParadigmType paradigm,
     *handle_iterator = entry->next;
     entry->next      = SCOREP_INVALID_IO_HANDLE;
 
+    direct_table_update( paradigm, ioHandle );
+
     UTILS_MutexUnlock( &io_paradigms[ paradigm ]->mutex );
 
     return old_handle;
@@ -652,6 +901,7 @@ SCOREP_IoMgmt_ReinsertHandle( SCOREP_IoParadigmType paradigm,
     UTILS_MutexLock( &io_paradigms[ paradigm ]->mutex );
 
     insert_handle( paradigm, handle, payload_get_handle( entry ), entry->hash );
+    direct_table_update( paradigm, payload_get_handle( entry ) );
 
     UTILS_MutexUnlock( &io_paradigms[ paradigm ]->mutex );
 }
@@ -718,6 +968,27 @@ SCOREP_IoMgmt_GetIoHandle( SCOREP_IoParadigmType paradigm,
                   "Invalid I/O paradigm %d", paradigm );
     UTILS_BUG_ON( !io_paradigms[ paradigm ], "The given paradigm was not registered" );
 
+    uint32_t index;
+    if ( direct_table_index( io_paradigms[ paradigm ], ioHandle, &index ) )
+    {
+        io_handle_direct_table* table =
+            UTILS_Atomic_LoadN_void_ptr( ( void** )&io_paradigms[ paradigm ]->direct_handles,
+                                         UTILS_ATOMIC_ACQUIRE );
+        SCOREP_IoHandleHandle handle = SCOREP_INVALID_IO_HANDLE;
+        if ( index < table->size )
+        {
+            handle = UTILS_Atomic_LoadN_uint32( &table->handles[ index ],
+                                                UTILS_ATOMIC_RELAXED );
+        }
+        if ( handle == SCOREP_INVALID_IO_HANDLE )
+        {
+            UTILS_DEBUG_PRINTF( SCOREP_DEBUG_IO_MANAGEMENT,
+                                "[Paradigm: %d] Could not find I/O handle in direct-indexed table",
+                                paradigm );
+        }
+        return handle;
+    }
+
     UTILS_MutexLock( &io_paradigms[ paradigm ]->mutex );
 
     io_handle_payload*     entry;
@@ -734,12 +1005,239 @@ SCOREP_IoMgmt_GetIoHandle( SCOREP_IoParadigmType paradigm,
     return *handle_iterator;
 }
 
+/** @brief Returns the request size class of @a bytes: 0 for 0 bytes, c for
+    [2^(c-1), 2^c) bytes. */
+static inline uint32_t
+io_aggregation_size_class( uint64_t bytes )
+{
+    uint32_t size_class = 0;
+    while ( bytes )
+    {
+        size_class++;
+        bytes >>= 1;
+    }
+    return size_class;
+}
+
+/** @brief Writes the pending summary operation of @a location. Needs to be
+    called by the thread owning @a location.
+
+    The summary is written at the next I/O operation of the location or when
+    the location is deactivated, thus its timestamps are back-dated to its
+    operations. Only if events were written since its first operation, it is
+    placed after them. Metrics of its enter and exit events are read when the
+    summary is written, not at its timestamps. */
+static void
+flush_aggregated_operation( SCOREP_Location*       location,
+                            io_mgmt_location_data* data )
+{
+    io_aggregated_operation* op = &data->aggregated_operation;
+    if ( op->n_operations == 0 )
+    {
+        return;
+    }
+
+    /* The summary starts at its first operation, but never before the last
+     * event of the location, and ends before the next one. */
+    uint64_t now   = SCOREP_Timer_GetClockTicks();
+    uint64_t begin = op->begin;
+    uint64_t last  = SCOREP_Location_GetLastTimestamp( location );
+    if ( begin < last )
+    {
+        begin = last;
+    }
+    if ( begin > now )
+    {
+        begin = now;
+    }
+    uint64_t end = begin + op->duration;
+    if ( end > now )
+    {
+        end = now;
+    }
+
+    SCOREP_IoParadigmType paradigm = SCOREP_IoHandleHandle_GetIoParadigm( op->handle );
+
+    SCOREP_Location_EnterRegion( location, begin, op->region );
+    SCOREP_CALL_SUBSTRATE_MGMT( IoParadigmEnter, IO_PARADIGM_ENTER,
+                                ( location, paradigm ) );
+    SCOREP_CALL_SUBSTRATE( IoOperationBegin, IO_OPERATION_BEGIN,
+                           ( location, begin, op->handle, op->mode,
+                             SCOREP_IO_OPERATION_FLAG_NON_COLLECTIVE | SCOREP_IO_OPERATION_FLAG_BLOCKING,
+                             op->bytes_request, op->matching_id, SCOREP_IO_UNKNOWN_OFFSET ) );
+
+    SCOREP_Location_AddAttribute( location, io_aggregation_operations_attribute, &op->n_operations );
+    SCOREP_Location_AddAttribute( location, io_aggregation_time_attribute, &op->duration );
+    for ( uint32_t i = 0; i < IO_AGGREGATION_SIZE_CLASSES; i++ )
+    {
+        if ( op->size_classes[ i ] )
+        {
+            SCOREP_Location_AddAttribute( location, io_aggregation_size_attributes[ i ],
+                                          &op->size_classes[ i ] );
+            op->size_classes[ i ] = 0;
+        }
+    }
+    SCOREP_CALL_SUBSTRATE( IoOperationComplete, IO_OPERATION_COMPLETE,
+                           ( location, end, op->handle, op->mode,
+                             op->bytes_result, op->matching_id ) );
+    SCOREP_CALL_SUBSTRATE_MGMT( IoParadigmLeave, IO_PARADIGM_LEAVE,
+                                ( location, paradigm ) );
+    SCOREP_Location_ExitRegion( location, end, op->region );
+
+    /* An operation in progress stays, it starts the next summary */
+    op->n_operations  = 0;
+    op->duration      = 0;
+    op->bytes_request = 0;
+    op->bytes_result  = 0;
+}
+
+bool
+SCOREP_IoMgmt_BeginAggregatedOperation( SCOREP_IoParadigmType  paradigm,
+                                        const void*            ioHandle,
+                                        SCOREP_RegionHandle    region,
+                                        SCOREP_IoOperationMode mode,
+                                        uint64_t               bytesRequest,
+                                        uint64_t               matchingId )
+{
+    if ( !scorep_io_mgmt_aggregation_enabled || bytesRequest > io_aggregation_max_size )
+    {
+        return false;
+    }
+
+    SCOREP_IoHandleHandle handle = SCOREP_IoMgmt_GetIoHandle( paradigm, ioHandle );
+    if ( handle == SCOREP_INVALID_IO_HANDLE )
+    {
+        return false;
+    }
+
+    SCOREP_Location*         location  = SCOREP_Location_GetCurrentCPULocation();
+    io_mgmt_location_data*   data      = get_location_data();
+    io_aggregated_operation* op        = &data->aggregated_operation;
+    uint64_t                 timestamp = SCOREP_Timer_GetClockTicks();
+
+    /* Other events of the location end the summary, too, as it cannot be
+       placed before them anymore */
+    if ( op->n_operations > 0
+         && ( op->handle != handle
+              || op->region != region
+              || op->mode != mode
+              || timestamp - op->begin >= io_aggregation_window
+              || SCOREP_Location_GetLastTimestamp( location ) > op->begin ) )
+    {
+        flush_aggregated_operation( location, data );
+        timestamp = SCOREP_Timer_GetClockTicks();
+    }
+
+    op->handle                = handle;
+    op->region                = region;
+    op->mode                  = mode;
+    op->matching_id           = matchingId;
+    op->current_begin         = timestamp;
+    op->current_bytes_request = bytesRequest;
+
+    return true;
+}
+
+void
+SCOREP_IoMgmt_CompleteAggregatedOperation( uint64_t bytesResult )
+{
+    uint64_t                 timestamp = SCOREP_Timer_GetClockTicks();
+    io_mgmt_location_data*   data      = get_location_data();
+    io_aggregated_operation* op        = &data->aggregated_operation;
+
+    if ( op->n_operations == 0 )
+    {
+        op->begin = op->current_begin;
+    }
+    op->n_operations++;
+    op->duration      += timestamp - op->current_begin;
+    op->bytes_request += op->current_bytes_request;
+    op->bytes_result  += bytesResult;
+    op->size_classes[ io_aggregation_size_class( op->current_bytes_request ) ]++;
+}
+
+void
+SCOREP_IoMgmt_FlushAggregatedOperation( void )
+{
+    SCOREP_Location*       location = SCOREP_Location_GetCurrentCPULocation();
+    io_mgmt_location_data* data     =
+        SCOREP_Location_GetSubsystemData( location, io_mgmt_subsystem_id );
+    if ( data && data->aggregated_operation.n_operations > 0 )
+    {
+        flush_aggregated_operation( location, data );
+    }
+}
+
+/** @brief Enables the aggregation of I/O operations, if requested. */
+static void
+io_aggregation_initialize( void )
+{
+    io_aggregation_max_size = SCOREP_Env_GetIoAggregationMaxSize();
+    if ( io_aggregation_max_size == 0 || !SCOREP_IsTracingEnabled() )
+    {
+        return;
+    }
+    if ( SCOREP_IsUnwindingEnabled() )
+    {
+        UTILS_WARNING( "Ignoring SCOREP_IO_AGGREGATION_MAX_SIZE, aggregation of I/O "
+                       "operations is not available if unwinding is enabled." );
+        return;
+    }
+    if ( SCOREP_IsProfilingEnabled() )
+    {
+        /* The profile would count one visit per summary operation */
+        UTILS_WARNING( "Ignoring SCOREP_IO_AGGREGATION_MAX_SIZE, aggregation of I/O "
+                       "operations is not available if profiling is enabled." );
+        return;
+    }
+
+    double ticks_per_ns = SCOREP_Timer_GetClockResolutionEstimate() / 1e9;
+    io_aggregation_window = SCOREP_Env_GetIoAggregationWindow() * ticks_per_ns;
+
+    io_aggregation_operations_attribute = SCOREP_Definitions_NewAttribute(
+        "IO_AGGREGATED_OPERATIONS",
+        "Number of I/O operations in this summary operation",
+        SCOREP_ATTRIBUTE_TYPE_UINT64 );
+    io_aggregation_time_attribute = SCOREP_Definitions_NewAttribute(
+        "IO_AGGREGATED_TIME",
+        "Total duration in ticks of the I/O operations in this summary operation",
+        SCOREP_ATTRIBUTE_TYPE_UINT64 );
+
+    uint32_t max_class = io_aggregation_size_class( io_aggregation_max_size );
+    for ( uint32_t i = 0; i <= max_class; i++ )
+    {
+        uint64_t min_size = i ? UINT64_C( 1 ) << ( i - 1 ) : 0;
+        uint64_t max_size = i ? ( min_size << 1 ) - 1 : 0;
+        char     name[ 64 ];
+        snprintf( name, sizeof( name ), "IO_AGGREGATED_SIZE_%" PRIu64 "_%" PRIu64,
+                  min_size, max_size );
+        io_aggregation_size_attributes[ i ] = SCOREP_Definitions_NewAttribute(
+            name,
+            "Number of I/O operations in this summary operation with a request size in this range",
+            SCOREP_ATTRIBUTE_TYPE_UINT64 );
+    }
+
+    scorep_io_mgmt_aggregation_enabled = true;
+}
+
 SCOREP_IoFileHandle
 SCOREP_IoMgmt_GetIoFileHandle( const char* pathname )
 {
     char  buf[ PATH_MAX ];
     char* res = NULL;
 
+    size_t   path_length = strlen( pathname );
+    uint32_t path_hash   = jenkins_hash( pathname, path_length, 0 );
+    bool     cacheable   = path_length < IO_FILE_PATH_CACHE_MAX_PATH;
+    uint32_t generation  = UTILS_Atomic_LoadN_uint32( &io_file_path_cache_generation,
+                                                      UTILS_ATOMIC_ACQUIRE );
+
+    SCOREP_IoFileHandle value = SCOREP_INVALID_IO_FILE;
+    if ( cacheable && io_file_path_cache_lookup( pathname, path_hash, generation, &value ) )
+    {
+        return value;
+    }
+
 #if HAVE( POSIX_REALPATH )
     res = realpath( pathname, buf );
 #endif
@@ -751,6 +1249,9 @@ SCOREP_IoMgmt_GetIoFileHandle( const char* pathname )
          * or failed to determine canonicalized absolute pathname
          */
         res = ( char* )pathname;
+
+        /* The resolution may succeed later, e.g., after the file was created */
+        cacheable = false;
     }
 
     io_file_table_key_t key = {
@@ -758,8 +1259,12 @@ SCOREP_IoMgmt_GetIoFileHandle( const char* pathname )
         .string_value = res
     };
 
-    SCOREP_IoFileHandle value = SCOREP_INVALID_IO_FILE;
     io_file_table_get_and_insert( key, NULL, &value );
+
+    if ( cacheable )
+    {
+        io_file_path_cache_insert( pathname, path_length, path_hash, generation, value );
+    }
     return value;
 }
 
@@ -781,12 +1286,16 @@ io_mgmt_subsystem_register( size_t subsystemId )
 static SCOREP_ErrorCode
 io_mgmt_subsystem_init( void )
 {
+    io_aggregation_initialize();
+
     return SCOREP_Platform_MountInfoInitialize();
 }
 
 static void
 io_mgmt_subsystem_finalize( void )
 {
+    scorep_io_mgmt_aggregation_enabled = false;
+
     SCOREP_Platform_MountInfoFinalize();
 }
 
@@ -811,11 +1320,32 @@ io_mgmt_subsystem_init_location( SCOREP_Location* location,
     return SCOREP_SUCCESS;
 }
 
+/** Writes the pending summary operation before the location is deactivated */
+static void
+io_mgmt_subsystem_deactivate_cpu_location( SCOREP_Location*        location,
+                                           SCOREP_Location*        parent,
+                                           SCOREP_CPULocationPhase phase )
+{
+    if ( phase != SCOREP_CPU_LOCATION_PHASE_EVENTS
+         || !scorep_io_mgmt_aggregation_enabled )
+    {
+        return;
+    }
+
+    io_mgmt_location_data* data =
+        SCOREP_Location_GetSubsystemData( location, io_mgmt_subsystem_id );
+    if ( data )
+    {
+        flush_aggregated_operation( location, data );
+    }
+}
+
 const SCOREP_Subsystem SCOREP_Subsystem_IoManagement =
 {
-    .subsystem_name          = "I/O Management",
-    .subsystem_register      = &io_mgmt_subsystem_register,
-    .subsystem_init          = &io_mgmt_subsystem_init,
-    .subsystem_finalize      = &io_mgmt_subsystem_finalize,
-    .subsystem_init_location = &io_mgmt_subsystem_init_location,
+    .subsystem_name                    = "I/O Management",
+    .subsystem_register                = &io_mgmt_subsystem_register,
+    .subsystem_init                    = &io_mgmt_subsystem_init,
+    .subsystem_finalize                = &io_mgmt_subsystem_finalize,
+    .subsystem_init_location           = &io_mgmt_subsystem_init_location,
+    .subsystem_deactivate_cpu_location = &io_mgmt_subsystem_deactivate_cpu_location,
 };
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2013, 2015-2016, 2019-2020,
+ * Copyright (c) 2009-2013, 2015-2016, 2019-2020, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -273,6 +273,11 @@ disable_recording( SCOREP_Location*    location,
                    SCOREP_RegionHandle regionHandle,
                    uint64_t*           metricValues )
 {
+    /* The duty cycle uses its own region, see extrapolate_node() */
+    if ( regionHandle != SCOREP_GetDutyCycleOffRegion() )
+    {
+        scorep_profile_record_off_region = regionHandle;
+    }
     SCOREP_Profile_Enter( location,
                           timestamp,
                           regionHandle,
@@ -653,6 +658,20 @@ SCOREP_Profile_Process( void )
         while ( node != NULL );
     }
 
+    /* Store the ratio of recorded time of the duty-cycle measurement mode,
+       which applies to all locations of this process */
+    double coverage = SCOREP_GetRecordingCoverage();
+    for ( node = scorep_profile.first_root_node; node != NULL; node = node->next_sibling )
+    {
+        if ( node->node_type == SCOREP_PROFILE_NODE_THREAD_ROOT )
+        {
+            scorep_profile_type_get_location_data( node->type_specific_data )->recording_coverage = coverage;
+        }
+    }
+
+    /* The per-location steps are distributed over these worker threads */
+    scorep_profile_create_workers( scorep_profile_get_number_of_threads() );
+
     /* Substitute collapse nodes by normal region nodes */
     scorep_profile_process_collapse();
 
@@ -688,6 +707,8 @@ SCOREP_Profile_Process( void )
         scorep_profile_init_num_threads_metric();
         scorep_profile_cluster_same_location();
     }
+
+    scorep_profile_destroy_workers();
 }
 
 
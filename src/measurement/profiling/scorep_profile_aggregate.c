@@ -28,6 +28,8 @@
 
 #include <UTILS_Error.h>
 
+extern bool scorep_profile_latency_histograms;
+
 /* **************************************************************************************
  * static function
  ***************************************************************************************/
@@ -199,6 +201,15 @@ scorep_profile_init_layout( const scorep_cube_writing_data* writeSet,
         layout->metric_list = SCOREP_CUBE_METRIC_NONE;
     }
 
+    /* Percentiles can not be summed over threads, thus, they are only written
+       for formats which keep the threads apart */
+    if ( scorep_profile_latency_histograms &&
+         writeSet->format != SCOREP_PROFILE_OUTPUT_THREAD_SUM &&
+         writeSet->format != SCOREP_PROFILE_OUTPUT_THREAD_TUPLE )
+    {
+        layout->metric_list += SCOREP_CUBE_METRIC_LATENCY;
+    }
+
     switch ( writeSet->format )
     {
         case SCOREP_PROFILE_OUTPUT_CUBE4:
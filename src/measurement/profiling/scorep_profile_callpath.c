@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2011,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2011, 2016,
+ * Copyright (c) 2009-2011, 2016, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2011,
@@ -60,6 +60,31 @@
 #include <SCOREP_Definitions.h>
 #include <scorep_profile_location.h>
 #include <scorep_profile_converter.h>
+#include <scorep_profile_process.h>
+
+#include <stdlib.h>
+
+/**
+   A subtree of a worker thread whose callpath does not yet exist in the
+   master thread.
+ */
+typedef struct
+{
+    scorep_profile_node* master;
+    scorep_profile_node* current;
+} unmatched_subtree;
+
+/**
+   The unmatched subtrees of one worker thread, in the order of a depth-first
+   traversal.
+ */
+typedef struct
+{
+    scorep_profile_node* thread_root;
+    unmatched_subtree*   subtrees;
+    size_t               size;
+    size_t               capacity;
+} unmatched_subtree_list;
 
 static bool
 compare_first_enter_time( scorep_profile_node* node_a,
@@ -68,15 +93,17 @@ compare_first_enter_time( scorep_profile_node* node_a,
     return node_a->first_enter_time > node_b->first_enter_time;
 }
 
+static void
+sort_location( scorep_profile_node* threadRoot,
+               void*                param )
+{
+    scorep_profile_sort_subtree( threadRoot, compare_first_enter_time );
+}
+
 static void
 sort_tree( void )
 {
-    scorep_profile_node* root = scorep_profile.first_root_node;
-    while ( root != NULL )
-    {
-        scorep_profile_sort_subtree( root, compare_first_enter_time );
-        root = root->next_sibling;
-    }
+    scorep_profile_for_all_locations( &sort_location, NULL );
 }
 
 /**
@@ -188,6 +215,71 @@ match_callpath( SCOREP_Profile_LocationData* location,
     }
 }
 
+/**
+   Matches a node to the existing child nodes of a given master, without
+   modifying the master thread. Thus, it can be called for several worker
+   threads concurrently. If the callpath of @a current exists in the master,
+   its callpath handle is copied and the children are processed recursively.
+   Else @a current is appended to @a unmatched.
+ */
+static void
+match_existing_callpath( scorep_profile_node*    master,
+                         scorep_profile_node*    current,
+                         unmatched_subtree_list* unmatched )
+{
+    /* Find a matching node in the master thread */
+    scorep_profile_node* match = master->first_child;
+    while ( ( match != NULL ) &&
+            ( ( match->node_type != current->node_type ) ||
+              ( !scorep_profile_compare_type_data( current->type_specific_data,
+                                                   match->type_specific_data,
+                                                   current->node_type ) ) ) )
+    {
+        match = match->next_sibling;
+    }
+
+    if ( match == NULL || match->callpath_handle == SCOREP_INVALID_CALLPATH )
+    {
+        if ( unmatched->size == unmatched->capacity )
+        {
+            unmatched->capacity = unmatched->capacity ? 2 * unmatched->capacity : 16;
+            unmatched->subtrees = realloc( unmatched->subtrees,
+                                           unmatched->capacity * sizeof( *unmatched->subtrees ) );
+            UTILS_ASSERT( unmatched->subtrees );
+        }
+        unmatched->subtrees[ unmatched->size ].master  = master;
+        unmatched->subtrees[ unmatched->size ].current = current;
+        unmatched->size++;
+        return;
+    }
+
+    /* Copy callpath handle */
+    current->callpath_handle = match->callpath_handle;
+
+    /* Process children */
+    for ( scorep_profile_node* child = current->first_child;
+          child != NULL;
+          child = child->next_sibling )
+    {
+        match_existing_callpath( match, child, unmatched );
+    }
+}
+
+static void
+match_existing_callpaths_of_location( uint32_t index,
+                                      void*    arg )
+{
+    unmatched_subtree_list* unmatched = &( ( unmatched_subtree_list* )arg )[ index ];
+    scorep_profile_node*    master    = scorep_profile.first_root_node;
+
+    for ( scorep_profile_node* child = unmatched->thread_root->first_child;
+          child != NULL;
+          child = child->next_sibling )
+    {
+        match_existing_callpath( master, child, unmatched );
+    }
+}
+
 /**
    Walks through the master thread and assigns new callpath ids.
  */
@@ -217,13 +309,15 @@ scorep_profile_assign_callpath_to_master( void )
 
 /**
    Traverses all threads and matches their callpaths to the master thread.
+   First, all worker threads are matched concurrently against the callpaths
+   that already exist in the master thread. Afterwards, the remaining subtrees
+   are added to the master thread serially, in the order of the threads. This
+   results in the same master tree as matching the threads one after another.
  */
 void
 scorep_profile_assign_callpath_to_workers( void )
 {
     scorep_profile_node*         master   = scorep_profile.first_root_node;
-    scorep_profile_node*         thread   = NULL;
-    scorep_profile_node*         child    = NULL;
     SCOREP_Profile_LocationData* location = NULL;
 
     if ( master == NULL )
@@ -231,22 +325,39 @@ scorep_profile_assign_callpath_to_workers( void )
         return;
     }
     location = scorep_profile_type_get_location_data( master->type_specific_data );
-    thread   = master->next_sibling;
 
-    /* For each worker thread ... */
-    while ( thread != NULL )
+    uint32_t num_workers = 0;
+    for ( scorep_profile_node* thread = master->next_sibling;
+          thread != NULL;
+          thread = thread->next_sibling )
     {
-        child = thread->first_child;
+        num_workers++;
+    }
 
-        /* For each subtree in the worker thread ... */
-        while ( child != NULL )
-        {
-            /* match callpath */
-            match_callpath( location, master, child );
+    unmatched_subtree_list* unmatched = calloc( num_workers, sizeof( *unmatched ) );
+    UTILS_ASSERT( num_workers == 0 || unmatched );
 
-            child = child->next_sibling;
-        }
+    uint32_t i = 0;
+    for ( scorep_profile_node* thread = master->next_sibling;
+          thread != NULL;
+          thread = thread->next_sibling )
+    {
+        unmatched[ i++ ].thread_root = thread;
+    }
+
+    /* For each worker thread, match existing callpaths */
+    scorep_profile_parallel_for( num_workers, match_existing_callpaths_of_location, unmatched );
 
-        thread = thread->next_sibling;
+    /* For each worker thread, add the missing callpaths to the master */
+    for ( i = 0; i < num_workers; i++ )
+    {
+        for ( size_t j = 0; j < unmatched[ i ].size; j++ )
+        {
+            match_callpath( location,
+                            unmatched[ i ].subtrees[ j ].master,
+                            unmatched[ i ].subtrees[ j ].current );
+        }
+        free( unmatched[ i ].subtrees );
     }
+    free( unmatched );
 }
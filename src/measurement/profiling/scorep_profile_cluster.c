@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2013, 2015, 2020,
+ * Copyright (c) 2009-2013, 2015, 2020, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -57,6 +57,7 @@
 #include "SCOREP_Environment.h"
 #include <scorep_ipc.h>
 #include <SCOREP_Thread_Mgmt.h>
+#include <jenkins_hash.h>
 #include <math.h>                      /* sqrt() and log10() */
 #include <float.h>                     /* DBL_MAX */
 #include <string.h>                    /* strlen() */
@@ -161,7 +162,8 @@ typedef struct scorep_cluster_t
 {
     scorep_profile_node*       root;               /* Root call path of the cluster */
     uint32_t                   cluster_id;         /* Cluster id. 0 if not defined yet */
-    uint32_t                   hash;               /* The hash of the associated tree */
+    uint64_t                   hash;               /* The structural hash of the associated
+                                                      tree, see calculate_hash() */
     scorep_cluster_distance_t* d;                  /* List of distances from all
                                                       the equivalent groups that
                                                       appear later in the list */
@@ -269,8 +271,9 @@ static scorep_profile_node* cluster_parent = NULL;
 
 
 /* Some prototypes */
-static uint32_t
-calculate_hash( scorep_profile_node* path );
+static uint64_t
+calculate_hash( scorep_profile_node*       path,
+                SCOREP_Profile_ClusterMode clusteringMode );
 
 static void
 calculate_derived_metrics( scorep_cluster_t*    cluster,
@@ -280,11 +283,13 @@ static void
 post_process_derived_metrics( scorep_cluster_t* cluster );
 
 
+#if HAVE( SCOREP_DEBUG )
 static int
 compare_call_trees( scorep_profile_node* a,
                     scorep_profile_node* b,
                     uint32_t             itCntA,
                     uint32_t             itCntB );
+#endif /* HAVE( SCOREP_DEBUG ) */
 
 static void
 add_iter_to_clustering( SCOREP_Profile_LocationData* location,
@@ -1172,11 +1177,9 @@ init_cluster( scorep_cluster_t* cluster )
     /* Let's do the sorting upfront */
     sort_subtree( cluster->root );
 
-    /* Calculate hash value */
-    cluster->hash = calculate_hash( cluster->root );
-
-    /* The node in the root is always different, so remove it from the hash */
-    cluster->hash -= scorep_profile_node_hash( cluster->root );
+    /* Calculate the structural hash bottom-up, once per iteration. The node in
+       the root is always different, thus it is not part of the hash. */
+    cluster->hash = calculate_hash( cluster->root, scorep_profile_get_cluster_mode() );
 
     /* Calculate derived metrics */
     calculate_derived_metrics( cluster, cluster->root );
@@ -1210,24 +1213,23 @@ insert_cluster( SCOREP_Location*                 location,
         ;
     }
 
-    /* Compare the clusters call tree with all clusters with an equal
-       hash value
+    /* The hash covers everything compare_call_trees() looks at, thus equal
+       hashes identify equivalent call trees, up to a collision of the 64-bit
+       hash. Debug builds verify this with the full comparison.
      */
-    for (; NULL != list && list->head->hash == cluster->hash;
-         last = &( list->next ), list = *last )
-    {
-        if ( 0 == compare_call_trees( list->head->root, cluster->root,
-                                      list->head->iteration_count,
-                                      cluster->iteration_count ) )
-        {
-            //fprintf( stderr, "insert_cluster: Trees match\n" );
-            /* Insert cluster */
-            cluster->next = list->head;
-            list->head    = cluster;
-            return list;
-        }
-
-        //fprintf( stderr, "insert_cluster: Trees don't match\n" );
+    if ( NULL != list && list->head->hash == cluster->hash )
+    {
+#if HAVE( SCOREP_DEBUG )
+        UTILS_BUG_ON( 0 != compare_call_trees( list->head->root, cluster->root,
+                                               list->head->iteration_count,
+                                               cluster->iteration_count ),
+                      "Structural hash collision of two call trees: %" PRIu64,
+                      cluster->hash );
+#endif /* HAVE( SCOREP_DEBUG ) */
+        /* Insert cluster */
+        cluster->next = list->head;
+        list->head    = cluster;
+        return list;
     }
     /*  scorep_cntl_msg("No match found, creating new list");*/
     /* List not found, create new list */
@@ -1422,9 +1424,9 @@ add_iter_to_clustering( SCOREP_Profile_LocationData* location,
                 cl_b        = cl_b->next;
             }
 
-            UTILS_DEBUG( "cl_a: iteration_count: %d, hash: %d, cluster_id: %d",
+            UTILS_DEBUG( "cl_a: iteration_count: %d, hash: %" PRIu64 ", cluster_id: %d",
                          cl_a->iteration_count, cl_a->hash, cl_a->cluster_id );
-            UTILS_DEBUG( "cl_b: iteration_count: %d, hash: %d, cluster_id: %d",
+            UTILS_DEBUG( "cl_b: iteration_count: %d, hash: %" PRIu64 ", cluster_id: %d",
                          cl_b->iteration_count, cl_b->hash, cl_b->cluster_id );
 
             /* Add up metric values from the two clusters in cl_a */
@@ -1616,6 +1618,7 @@ consider_visit_count( int clusterMode, scorep_profile_node* node )
     return false;
 }
 
+#if HAVE( SCOREP_DEBUG )
 /**
    Compares the structure of two call trees according to the structural
    clustering mode. The clustering mode can be set via the environment
@@ -1785,36 +1788,57 @@ compare_call_trees( scorep_profile_node* a, scorep_profile_node* b,
     /* No difference was found */
     return 0;
 }
+#endif /* HAVE( SCOREP_DEBUG ) */
 
 /**
-   Calculate a hash value based on the nodeids and the structure of the tree.
-   Also set mpi_in_subtree value in each node of the tree.
-   @param path The root node of the profile tree.
+   Combines @a value into the ordered hash @a hash.
+ */
+static inline uint64_t
+hash_combine( uint64_t hash,
+              uint64_t value )
+{
+    uint32_t key[ 2 ] = { ( uint32_t )value, ( uint32_t )( value >> 32 ) };
+    uint32_t pc       = ( uint32_t )hash;
+    uint32_t pb       = ( uint32_t )( hash >> 32 );
+    jenkins_hashword2( key, 2, &pc, &pb );
+    return pc + ( ( uint64_t )pb << 32 );
+}
+
+/**
+   Calculates a Merkle hash of the subtree below @a path, bottom-up. Each child
+   contributes its own node hash and the hash of its subtree, in the sorted
+   order of the children. The hash covers exactly what compare_call_trees()
+   compares in the given clustering mode: subtrees without MPI are skipped in
+   the MPI modes and visit counts are included where they matter. The node
+   @a path itself is not part of the hash, as for the root of an iteration and
+   for the thread start nodes of fork children.
+   Also sets the mpi_in_subtree value in each node of the tree.
+   @param path           The root node of the subtree.
+   @param clusteringMode The clustering mode.
    @returns the hash value.
  */
-static uint32_t
-calculate_hash( scorep_profile_node* path )
+static uint64_t
+calculate_hash( scorep_profile_node*       path,
+                SCOREP_Profile_ClusterMode clusteringMode )
 {
-    uint32_t                   val = 0;
-    uint32_t                   ch, used_ch;
-    scorep_profile_node*       curr;
-    SCOREP_Profile_ClusterMode clustering_mode = scorep_profile_get_cluster_mode();
+    uint64_t             hash = 0;
+    scorep_profile_node* curr;
 
-    if ( SCOREP_PROFILE_CLUSTER_NONE == clustering_mode )
+    if ( SCOREP_PROFILE_CLUSTER_NONE == clusteringMode )
     {
-        return scorep_profile_node_hash( path ); /* this is subtracted later, so this is 0 */
+        return 0;
     }
     scorep_profile_set_mpi_in_subtree( path, is_mpi_node( path ) );
 
     /* No need to sort the children, they should be sorted by now */
 
     /* Calculate hash for children */
-    for ( curr = path->first_child, ch = 0, used_ch = 0; NULL != curr; curr = curr->next_sibling, ch++ )
+    for ( curr = path->first_child; NULL != curr; curr = curr->next_sibling )
     {
         /* The call also sets mpi_in_subtree in the child */
-        int child_val = calculate_hash( curr );
+        uint64_t child_hash = calculate_hash( curr, clusteringMode );
         /* In these modes, only the subtrees with MPI count */
-        if ( SCOREP_PROFILE_CLUSTER_MPI <= clustering_mode && !scorep_profile_is_mpi_in_subtree( curr ) )
+        if ( SCOREP_PROFILE_CLUSTER_MPI <= clusteringMode && !scorep_profile_is_mpi_in_subtree( curr ) )
         {
             continue;
         }
@@ -1822,15 +1846,14 @@ calculate_hash( scorep_profile_node* path )
         {
             scorep_profile_set_mpi_in_subtree( path, true );
         }
-        val += ++used_ch;
-        val  = ( val >> 1 ) | ( val << 31 );
-        val += child_val;
+        hash = hash_combine( hash, scorep_profile_node_hash( curr ) );
+        hash = hash_combine( hash, child_hash );
     }
 
     /* Calculate hash for fork children */
     if ( scorep_profile_is_fork_node( path ) )
     {
-        int thread_count = 1;
+        uint64_t thread_count = 1;
         for ( scorep_profile_node* root = scorep_profile.first_root_node;
               root != NULL;
               root = root->next_sibling )
@@ -1842,9 +1865,9 @@ calculate_hash( scorep_profile_node* path )
             }
             thread_count++;
 
-            int child_val = calculate_hash( curr ) - scorep_profile_node_hash( curr );
+            uint64_t child_hash = calculate_hash( curr, clusteringMode );
             /* In these modes, only the subtrees with MPI count */
-            if ( SCOREP_PROFILE_CLUSTER_MPI <= clustering_mode &&
+            if ( SCOREP_PROFILE_CLUSTER_MPI <= clusteringMode &&
                  !scorep_profile_is_mpi_in_subtree( curr ) )
             {
                 continue;
@@ -1853,22 +1876,18 @@ calculate_hash( scorep_profile_node* path )
             {
                 scorep_profile_set_mpi_in_subtree( path, true );
             }
-            val += thread_count + 1;
-            val  = ( val >> 1 ) | ( val << 31 );
-            val += child_val;
+            hash = hash_combine( hash, thread_count );
+            hash = hash_combine( hash, child_hash );
         }
     }
 
     /* Calculate hash from local data */
-    if ( consider_visit_count( clustering_mode, path ) )
+    if ( consider_visit_count( clusteringMode, path ) )
     {
-        val += path->count;
-        val  = ( val >> 1 ) | ( val << 31 );
+        hash = hash_combine( hash, path->count );
     }
 
-    /* Add the nodeid of the current node */
-    val += scorep_profile_node_hash( path );
-    return val;
+    return hash;
 }
 
 /**
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012,
+ * Copyright (c) 2009-2012, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -46,6 +46,7 @@
 #include <scorep_profile_node.h>
 #include <scorep_profile_definition.h>
 #include <scorep_profile_location.h>
+#include <scorep_profile_process.h>
 #include <SCOREP_Types.h>
 #include <SCOREP_Definitions.h>
 #include <stdio.h>
@@ -66,6 +67,13 @@ substitute_collapse( scorep_profile_node* node, void* param )
     }
 }
 
+static void
+substitute_collapse_in_location( scorep_profile_node* threadRoot,
+                                 void*                param )
+{
+    scorep_profile_for_all( threadRoot, &substitute_collapse, NULL );
+}
+
 void
 scorep_profile_process_collapse( void )
 {
@@ -89,12 +97,5 @@ scorep_profile_process_collapse( void )
                                                                    SCOREP_PARADIGM_USER,
                                                                    SCOREP_REGION_UNKNOWN );
 
-    for ( scorep_profile_node* current = scorep_profile.first_root_node;
-          current != NULL;
-          current = current->next_sibling )
-    {
-        scorep_profile_for_all( current,
-                                &substitute_collapse,
-                                NULL );
-    }
+    scorep_profile_for_all_locations( &substitute_collapse_in_location, NULL );
 }
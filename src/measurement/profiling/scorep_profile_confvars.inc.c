@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012, 2015,
+ * Copyright (c) 2009-2012, 2015, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -92,6 +92,21 @@ bool scorep_profile_enable_clustering;
  */
 bool scorep_profile_enable_core_files;
 
+/**
+   Stores whether the Cube4 writer extrapolates duty-cycle measurements
+ */
+bool scorep_profile_extrapolate_duty_cycle;
+
+/**
+   Stores whether a latency histogram is recorded for each call path
+ */
+bool scorep_profile_latency_histograms;
+
+/**
+   Stores the number of threads for the post-processing and writing of the profile
+ */
+uint64_t scorep_profile_processing_threads;
+
 
 /**
    Option table for output format configuration.
@@ -304,6 +319,54 @@ static const SCOREP_ConfigVariable scorep_profile_confvars[] = {
         "stack at these points. It is not recommended to enable this feature for "
         "large scale measurements."
     },
+    {
+        "extrapolate_duty_cycle",
+        SCOREP_CONFIG_TYPE_BOOL,
+        &scorep_profile_extrapolate_duty_cycle,
+        NULL,
+        "false",
+        "Extrapolate visits and times of duty-cycle measurements in Cube4 profiles",
+        "If the duty-cycle measurement mode is active (see "
+        "`SCOREP_DUTY_CYCLE_PERIOD`), the visits and inclusive times of every "
+        "call path are divided by the ratio of the recorded time per "
+        "location, while the `DUTY CYCLE OFF` region is dropped. Time in "
+        "which the user switched recording off is neither included in this "
+        "ratio nor extrapolated. The "
+        "profile is marked with the `Score-P::DutyCycle::Extrapolated` "
+        "attribute and the ratio is stored in the "
+        "`Score-P::DutyCycle::Coverage` attribute. Minimum and maximum "
+        "times and other metrics are not extrapolated."
+    },
+    {
+        "latency_histograms",
+        SCOREP_CONFIG_TYPE_BOOL,
+        &scorep_profile_latency_histograms,
+        NULL,
+        "false",
+        "Record a duration histogram for each call path",
+        "Each call path records its inclusive durations in a histogram with "
+        "four logarithmic buckets per power of two, which needs an "
+        "additional kilobyte of memory per call path. The Cube4 profile "
+        "gets the metrics `latency_p50`, `latency_p90`, `latency_p99`, and "
+        "`latency_max`, which are estimated from the histogram with a "
+        "relative error of at most 25%. The metrics are not written for the "
+        "`THREAD_SUM` and `THREAD_TUPLE` formats."
+    },
+    {
+        "processing_threads",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &scorep_profile_processing_threads,
+        NULL,
+        "0",
+        "Number of threads that post-process and write the profile at finalization",
+        "The steps of the post-processing that handle each location "
+        "separately run in parallel on this number of threads, including the "
+        "finalizing thread. At most one thread per location of the process "
+        "is used. The Cube4 writer uses this number of threads to compute the "
+        "metric values, and an additional thread to write the file while the "
+        "next values are collected. The default 0 uses one thread per online "
+        "CPU, 1 processes and writes everything serially."
+    },
     SCOREP_CONFIG_TERMINATOR
 };
 
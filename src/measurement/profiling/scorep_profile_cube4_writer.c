@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2016, 2019, 2022,
+ * Copyright (c) 2009-2016, 2019, 2022, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -42,6 +42,7 @@
 #include <scorep_profile_cube4_writer.h>
 #include <sys/stat.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include <SCOREP_RuntimeManagement.h>
 #include <SCOREP_Memory.h>
@@ -56,6 +57,7 @@
 #include <scorep_profile_location.h>
 #include <scorep_profile_aggregate.h>
 #include <scorep_profile_task_init.h>
+#include <scorep_profile_process.h>
 #include <scorep_ipc.h>
 #include <scorep_system_tree_sequence.h>
 #include <scorep_status.h>
@@ -66,6 +68,7 @@
 
 extern SCOREP_MetricHandle scorep_profile_migration_loss_metric;
 extern SCOREP_MetricHandle scorep_profile_migration_win_metric;
+extern bool                scorep_profile_extrapolate_duty_cycle;
 
 extern void
 scorep_cluster_write_cube4( scorep_cube_writing_data* writeData );
@@ -277,6 +280,32 @@ get_visits_value( scorep_profile_node* node, void* data )
     return node->count;
 }
 
+/**
+   Returns a percentile of the inclusive time per visit for @a node.
+   This functions are given to scorep_profile_write_cube_metric.
+   @param node Pointer to a node which should return the metric value.
+   @param data Pointer to the requested percentile as fraction.
+   @returns the estimated percentile of @a node in seconds.
+ */
+static double
+get_latency_value( scorep_profile_node* node, void* data )
+{
+    if ( node->latency_histogram == NULL || node->count == 0 )
+    {
+        return 0.0;
+    }
+
+    /* The histogram reports the upper bound of a bucket, which may exceed
+       the exact maximum */
+    uint64_t ticks = scorep_profile_get_latency_percentile( node->latency_histogram,
+                                                            *( double* )data );
+    if ( ticks > node->inclusive_time.max )
+    {
+        ticks = node->inclusive_time.max;
+    }
+    return ( ( double )ticks ) / ( ( double )SCOREP_Timer_GetClockResolution() );
+}
+
 /**
    Returns the visits for @a node as a TAU tuple.
    This functions are given to scorep_profile_write_cube_metric.
@@ -536,60 +565,146 @@ get_sparse_tuple_value_from_uint64( scorep_profile_node* node, void* data )
     return scorep_cube_type_tau_atomic_zero;
 }
 
+/* *****************************************************************************
+   Bitstrings of callpaths with values
+*******************************************************************************/
+
 /**
-   Returns a truth value whether a sparse double metric value exists in  @a node.
-   This functions are given to set_bitstring_for_metric.
-   @param node  Pointer to a node which should return the metric value.
-   @param data  Pointer to a metric handle specifying the desired metric.
-   @returns the value of the specified metric if it has an entry in the node.
-            Otherwise 0 is returned.
+   Number of callpaths for which one task computes the bitstrings of the sparse
+   metrics. A multiple of 8, thus, tasks write to distinct bytes.
  */
-static uint64_t
-has_sparse_double_value( scorep_profile_node* node, void* data )
+#define SCOREP_PROFILE_CUBE4_BITS_PER_TASK 512
+
+/**
+   Returns the index of the unified definition of the local sparse metric
+   @a metric, if it is written as sparse metric. Otherwise UINT32_MAX.
+ */
+static uint32_t
+get_sparse_metric_index( scorep_cube_writing_data* writeSet,
+                         SCOREP_MetricHandle       metric )
 {
-    SCOREP_MetricHandle metric = *( SCOREP_MetricHandle* )data;
-    if ( SCOREP_MetricHandle_GetProfilingType( metric ) == SCOREP_METRIC_PROFILING_TYPE_MAX )
+    uint32_t unified = SCOREP_MetricHandle_GetUnifiedId( metric );
+    if ( unified >= writeSet->num_unified_metrics ||
+         writeSet->metric_map[ unified ] != metric )
     {
-        return 1;
+        return UINT32_MAX;
     }
-
-    return ( uint64_t )( get_sparse_double_value( node, data ) == 0 ? 0 : 1 );
+    return unified;
 }
 
+/**
+   Sets the bits of a range of callpaths in the bitstrings of all sparse
+   metrics, and in the bitstring of callpaths with a node. A bit is set if a
+   local thread has a non-zero value for this callpath.
+   @param index Index of the range of SCOREP_PROFILE_CUBE4_BITS_PER_TASK
+                callpaths.
+   @param arg   The scorep_cube_writing_data.
+ */
 static void
-set_bitstring_for_metric(
-    scorep_cube_writing_data*      writeSet,
-    SCOREP_Ipc_Group*              comm,
-    scorep_profile_get_uint64_func getValue,
-    void*                          funcData )
+set_sparse_bits_for_callpaths( uint32_t index,
+                               void*    arg )
 {
-    scorep_profile_node* node = NULL;
+    scorep_cube_writing_data* writeSet = arg;
+    size_t                    bytes    = SCOREP_Bitstring_GetByteSize( writeSet->callpath_number );
 
-    /* Create empty bitstring */
-    uint8_t* bits = malloc( SCOREP_Bitstring_GetByteSize( writeSet->callpath_number ) );
-    UTILS_ASSERT( bits );
-    SCOREP_Bitstring_Clear( bits, writeSet->callpath_number );
+    uint64_t first = ( uint64_t )index * SCOREP_PROFILE_CUBE4_BITS_PER_TASK;
+    uint64_t last  = first + SCOREP_PROFILE_CUBE4_BITS_PER_TASK;
+    if ( last > writeSet->callpath_number )
+    {
+        last = writeSet->callpath_number;
+    }
 
-    /* Iterate over all unified callpathes */
-    for ( uint64_t cp_index = 0; cp_index < writeSet->callpath_number; cp_index++ )
+    for ( uint64_t cp_index = first; cp_index < last; cp_index++ )
     {
         for ( uint64_t thread_index = 0;
               thread_index < writeSet->local_threads; thread_index++ )
         {
-            uint64_t node_index = thread_index * writeSet->callpath_number + cp_index;
-            node = writeSet->id_2_node[ node_index ];
-            if ( ( node != NULL ) && ( getValue( node, funcData ) != 0 ) )
+            uint64_t             node_index = thread_index * writeSet->callpath_number + cp_index;
+            scorep_profile_node* node       = writeSet->id_2_node[ node_index ];
+            if ( node == NULL )
+            {
+                continue;
+            }
+            SCOREP_Bitstring_Set( writeSet->node_bit_vector, cp_index );
+
+            for ( scorep_profile_sparse_metric_int* current = node->first_int_sparse;
+                  current != NULL; current = current->next_metric )
             {
-                SCOREP_Bitstring_Set( bits, cp_index );
+                uint32_t unified = get_sparse_metric_index( writeSet, current->metric );
+                if ( unified != UINT32_MAX &&
+                     get_sparse_uint64_value( node, &current->metric ) != 0 )
+                {
+                    SCOREP_Bitstring_Set( writeSet->sparse_bit_vectors + unified * bytes,
+                                          cp_index );
+                }
+            }
+            for ( scorep_profile_sparse_metric_double* current = node->first_double_sparse;
+                  current != NULL; current = current->next_metric )
+            {
+                uint32_t unified = get_sparse_metric_index( writeSet, current->metric );
+                if ( unified != UINT32_MAX &&
+                     get_sparse_double_value( node, &current->metric ) != 0 )
+                {
+                    SCOREP_Bitstring_Set( writeSet->sparse_bit_vectors + unified * bytes,
+                                          cp_index );
+                }
             }
         }
     }
+}
+
+/**
+   Computes the bitstrings of the local callpaths with values for all sparse
+   metrics in one traversal of the profile, instead of one traversal per
+   metric.
+   @param writeSet Structure containing write data.
+ */
+static void
+init_sparse_bit_vectors( scorep_cube_writing_data* writeSet )
+{
+    size_t bytes = SCOREP_Bitstring_GetByteSize( writeSet->callpath_number );
+
+    writeSet->node_bit_vector = malloc( bytes );
+    UTILS_ASSERT( writeSet->node_bit_vector );
+    SCOREP_Bitstring_Clear( writeSet->node_bit_vector, writeSet->callpath_number );
+
+    writeSet->sparse_bit_vectors = calloc( writeSet->num_unified_metrics, bytes );
+    UTILS_ASSERT( writeSet->num_unified_metrics == 0 || writeSet->sparse_bit_vectors );
+
+    scorep_profile_parallel_for( ( writeSet->callpath_number + SCOREP_PROFILE_CUBE4_BITS_PER_TASK - 1 )
+                                 / SCOREP_PROFILE_CUBE4_BITS_PER_TASK,
+                                 set_sparse_bits_for_callpaths,
+                                 writeSet );
+}
+
+/**
+   Combines the bitstrings of callpaths with values of a sparse metric from
+   all ranks.
+   @param writeSet  Structure containing write data.
+   @param comm      Communicator of all ranks.
+   @param metric    The local handle of the metric.
+   @param unified   Index of the unified definition of @a metric.
+ */
+static void
+set_bitstring_for_metric( scorep_cube_writing_data* writeSet,
+                          SCOREP_Ipc_Group*         comm,
+                          SCOREP_MetricHandle       metric,
+                          uint32_t                  unified )
+{
+    const uint8_t* bits = writeSet->sparse_bit_vectors +
+                          unified * SCOREP_Bitstring_GetByteSize( writeSet->callpath_number );
+
+    /* Every node has a value for double metrics of profiling type MAX */
+    if ( SCOREP_MetricHandle_GetValueType( metric ) == SCOREP_METRIC_VALUE_DOUBLE &&
+         SCOREP_MetricHandle_GetProfilingType( metric ) == SCOREP_METRIC_PROFILING_TYPE_MAX )
+    {
+        bits = writeSet->node_bit_vector;
+    }
 
     SCOREP_IpcGroup_Allreduce( comm,
-                               bits, writeSet->bit_vector,
+                               ( void* )bits, writeSet->bit_vector,
                                ( writeSet->callpath_number + 7 ) / 8,
                                SCOREP_IPC_UNSIGNED_CHAR, SCOREP_IPC_BOR );
-    free( bits );
 }
 
 /**
@@ -613,112 +728,364 @@ set_bitstring_for_unknown_metric( scorep_cube_writing_data* writeSet,
     free( bits );
 }
 
+/* *****************************************************************************
+   Pipelined writing of metric values
+*******************************************************************************/
+
+/**
+   Maximum size in bytes of the values that the root rank collects at once.
+   The rows of several callpaths are gathered together up to this size.
+ */
+#define SCOREP_PROFILE_CUBE4_CHUNK_SIZE ( 4 * 1024 * 1024 )
+
+/**
+   Number of callpaths for which one task computes the local values.
+ */
+#define SCOREP_PROFILE_CUBE4_ROWS_PER_TASK 64
+
+/**
+   Defines a function type which writes one row of values to Cube.
+   @param myCube The Cube object.
+   @param metric The Cube metric of the row.
+   @param cnode  The Cube callpath of the row.
+   @param values The values of all locations.
+ */
+typedef void
+( * scorep_profile_write_row_func )( cube_t*      myCube,
+                                     cube_metric* metric,
+                                     cube_cnode*  cnode,
+                                     void*        values );
+
+/**
+   A chunk of rows gathered on the root rank, which is written to Cube by the
+   background thread.
+ */
+typedef struct
+{
+    scorep_cube_writing_data*     write_set;
+    scorep_profile_write_row_func write_row;
+    cube_metric*                  metric;
+    uint8_t*                      known_cnodes; /**< Set for the first chunk of a
+                                                     metric, freed after use */
+    size_t                        value_size;
+    uint32_t*                     callpaths;    /**< Callpath of every row */
+    uint32_t                      num_rows;
+    void*                         values;       /**< The values of all rows of
+                                                     one rank after another */
+} scorep_profile_cube4_chunk;
+
+/**
+   The chunks are double buffered. While one is written, the next is gathered.
+   Only used on the root rank.
+ */
+static struct
+{
+    SCOREP_AsyncWorker*        worker;
+    scorep_profile_cube4_chunk chunks[ 2 ];
+    uint32_t                   next_chunk;
+    uint32_t                   max_rows;
+    void*                      row;
+} chunk_writer;
+
+/**
+   Returns the number of rows that are gathered at once. It is the same on all
+   ranks.
+ */
+static uint32_t
+get_rows_per_chunk( scorep_cube_writing_data* writeSet,
+                    size_t                    valueSize )
+{
+    size_t rows = SCOREP_PROFILE_CUBE4_CHUNK_SIZE / ( writeSet->global_items * valueSize );
+    return rows > 0 ? rows : 1;
+}
+
+static void
+init_chunk_writer( scorep_cube_writing_data* writeSet )
+{
+    chunk_writer.max_rows   = get_rows_per_chunk( writeSet, sizeof( uint64_t ) );
+    chunk_writer.next_chunk = 0;
+
+    /* A chunk holds at least one row of the largest value type */
+    size_t row_size = writeSet->global_items * sizeof( cube_type_tau_atomic );
+    size_t max_size = SCOREP_PROFILE_CUBE4_CHUNK_SIZE;
+    if ( max_size < row_size )
+    {
+        max_size = row_size;
+    }
+    for ( uint32_t i = 0; i < 2; i++ )
+    {
+        chunk_writer.chunks[ i ].callpaths = malloc( chunk_writer.max_rows * sizeof( uint32_t ) );
+        chunk_writer.chunks[ i ].values    = malloc( max_size );
+        UTILS_ASSERT( chunk_writer.chunks[ i ].callpaths );
+        UTILS_ASSERT( chunk_writer.chunks[ i ].values );
+    }
+    chunk_writer.row = malloc( row_size );
+    UTILS_ASSERT( chunk_writer.row );
+
+    chunk_writer.worker = scorep_profile_create_async_worker();
+}
+
+static void
+finalize_chunk_writer( void )
+{
+    SCOREP_AsyncWorker_Destroy( chunk_writer.worker );
+    chunk_writer.worker = NULL;
+
+    for ( uint32_t i = 0; i < 2; i++ )
+    {
+        free( chunk_writer.chunks[ i ].callpaths );
+        free( chunk_writer.chunks[ i ].values );
+    }
+    free( chunk_writer.row );
+}
+
+/**
+   Writes the rows of a chunk to Cube. Runs on the background thread, which
+   is the only thread that uses the Cube object while the chunk writer
+   exists.
+   @param index Ignored.
+   @param arg   The scorep_profile_cube4_chunk.
+ */
+static void
+write_chunk( uint32_t index,
+             void*    arg )
+{
+    scorep_profile_cube4_chunk* chunk    = arg;
+    scorep_cube_writing_data*   writeSet = chunk->write_set;
+
+    if ( chunk->known_cnodes != NULL )
+    {
+        /* Initialize writing of a new metric */
+        cube_set_known_cnodes_for_metric( writeSet->my_cube, chunk->metric,
+                                          ( char* )chunk->known_cnodes );
+        free( chunk->known_cnodes );
+        chunk->known_cnodes = NULL;
+    }
+
+    for ( uint32_t row = 0; row < chunk->num_rows; row++ )
+    {
+        /* Collect the values of one callpath from the blocks of all ranks */
+        char* values = chunk->values;
+        if ( chunk->num_rows > 1 )
+        {
+            values = chunk_writer.row;
+            for ( uint32_t rank = 0; rank < writeSet->ranks_number; rank++ )
+            {
+                size_t items  = writeSet->items_per_rank[ rank ];
+                size_t offset = writeSet->offsets_per_rank[ rank ];
+                memcpy( values + offset * chunk->value_size,
+                        ( char* )chunk->values
+                        + ( offset * chunk->num_rows + row * items ) * chunk->value_size,
+                        items * chunk->value_size );
+            }
+        }
+
+        cube_cnode* cnode = cube_get_cnode( writeSet->my_cube, chunk->callpaths[ row ] );
+        chunk->write_row( writeSet->my_cube, chunk->metric, cnode, values );
+    }
+}
+
+/**
+   Returns the chunk buffer for the next gather. The previous use of this
+   buffer is finished, because starting the last chunk waited for it.
+ */
+static scorep_profile_cube4_chunk*
+get_next_chunk( void )
+{
+    scorep_profile_cube4_chunk* chunk = &chunk_writer.chunks[ chunk_writer.next_chunk ];
+    chunk_writer.next_chunk = 1 - chunk_writer.next_chunk;
+    return chunk;
+}
+
 
 /* *INDENT-OFF* */
 
 /**
    @def SCOREP_PROFILE_WRITE_CUBE_METRIC
    Code to write metric values in cube format. Used to reduce code replication.
+   The callpaths with values are processed in chunks. For every chunk, the
+   local values are computed on the worker threads, gathered on the root rank,
+   and written by the background thread while the next chunk is gathered.
  */
 #define SCOREP_PROFILE_WRITE_CUBE_METRIC( type, TYPE, NUMBER, cube_type, zero )                          \
-    static void                                                                                          \
-    write_cube_##cube_type(                                                                              \
-        scorep_cube_writing_data * writeSet,                                                             \
-        SCOREP_Ipc_Group * comm,                                                                         \
-        cube_metric * metric,                                                                            \
-        scorep_profile_get_##cube_type##_func getValue,                                                  \
-        void* funcData )                                                                                 \
+    typedef struct                                                                                       \
     {                                                                                                    \
-        scorep_profile_node* node              = NULL;                                                   \
-        cube_cnode*          cnode             = NULL;                                                   \
-        type*                aggregated_values = NULL;                                                   \
-        type*                local_values      = NULL;                                                   \
-        type*                global_values     = NULL;                                                   \
-        if ( writeSet->callpath_number == 0 ) {                                                          \
-            return; }                                                                                    \
+        scorep_cube_writing_data*             write_set;                                                 \
+        scorep_profile_get_##cube_type##_func get_value;                                                 \
+        void*                                 func_data;                                                 \
+        const uint32_t*                       callpaths;                                                 \
+        type*                                 values;                                                    \
+        uint32_t                              num_rows;                                                  \
+    } row_task_##cube_type;                                                                              \
                                                                                                          \
-        local_values      = ( type* )malloc( writeSet->local_threads * sizeof( type ) );                 \
-        aggregated_values = ( type* )malloc( writeSet->local_items * sizeof( type ) );                   \
-        UTILS_ASSERT( local_values );                                                                    \
-        UTILS_ASSERT( aggregated_values );                                                               \
+    static void                                                                                          \
+    write_row_##cube_type( cube_t* myCube, cube_metric* metric, cube_cnode* cnode, void* values )        \
+    {                                                                                                    \
+        cube_write_sev_row_of_##cube_type( myCube, metric, cnode, ( type* )values );                     \
+    }                                                                                                    \
                                                                                                          \
-        if ( writeSet->my_rank == writeSet->root_rank )                                                  \
-        {                                                                                                \
-            /* Array of all values for one metric for one callpath for all locations */                  \
-            global_values = ( type* )malloc( writeSet->global_items * sizeof( type ) );                  \
+    static void                                                                                          \
+    build_rows_##cube_type( uint32_t index, void* arg )                                                  \
+    {                                                                                                    \
+        row_task_##cube_type*     task     = arg;                                                        \
+        scorep_cube_writing_data* writeSet = task->write_set;                                            \
+        type*                     thread_values =                                                        \
+            ( type* )malloc( writeSet->local_threads * sizeof( type ) );                                 \
+        UTILS_ASSERT( thread_values );                                                                   \
                                                                                                          \
-            /* Initialize writing of a new metric */                                                     \
-            cube_set_known_cnodes_for_metric( writeSet->my_cube, metric,                                 \
-                                              ( char* )writeSet->bit_vector );                           \
-        }                                                                                                \
-        /* Iterate over all unified callpathes */                                                        \
-        for ( uint64_t cp_index = 0; cp_index < writeSet->callpath_number; cp_index++ )                  \
+        uint32_t first = index * SCOREP_PROFILE_CUBE4_ROWS_PER_TASK;                                     \
+        uint32_t last  = first + SCOREP_PROFILE_CUBE4_ROWS_PER_TASK;                                     \
+        if ( last > task->num_rows ) {                                                                   \
+            last = task->num_rows; }                                                                     \
+        for ( uint32_t row = first; row < last; row++ )                                                  \
         {                                                                                                \
-            if ( !SCOREP_Bitstring_IsSet( writeSet->bit_vector, cp_index ) )                             \
-            {                                                                                            \
-                continue;                                                                                \
-            }                                                                                            \
+            uint64_t cp_index = task->callpaths[ row ];                                                  \
             for ( uint64_t thread_index = 0;                                                             \
                   thread_index < writeSet->local_threads; thread_index++ )                               \
             {                                                                                            \
                 uint64_t node_index = thread_index * writeSet->callpath_number + cp_index;               \
-                node = writeSet->id_2_node[ node_index ];                                                \
+                scorep_profile_node* node = writeSet->id_2_node[ node_index ];                           \
                 if ( node != NULL )                                                                      \
                 {                                                                                        \
-                    local_values[ thread_index ] = getValue( node, funcData );                           \
+                    thread_values[ thread_index ] = task->get_value( node, task->func_data );            \
                 }                                                                                        \
                 else                                                                                     \
                 {                                                                                        \
-                    local_values[ thread_index ] = zero;                                                 \
+                    thread_values[ thread_index ] = zero;                                                \
                 }                                                                                        \
             }                                                                                            \
+            type* row_values        = &task->values[ row * writeSet->local_items ];                      \
+            type* local_values      = thread_values;                                                     \
+            type* aggregated_values = row_values;                                                        \
             scorep_profile_aggregate_##type( &local_values,                                              \
                                              &aggregated_values,                                         \
                                              writeSet );                                                 \
-            /* Collect data from all processes */                                                        \
-            SCOREP_IpcGroup_Barrier( comm );                                                             \
-            if ( writeSet->same_thread_num )                                                             \
+            /* Without aggregation, the pointers are swapped */                                          \
+            if ( aggregated_values != row_values )                                                       \
             {                                                                                            \
-                SCOREP_IpcGroup_Gather( comm, aggregated_values, global_values,                          \
-                                        writeSet->local_items * NUMBER,                                  \
-                                        SCOREP_IPC_##TYPE, writeSet->root_rank );                        \
+                memcpy( row_values, aggregated_values, writeSet->local_items * sizeof( type ) );         \
             }                                                                                            \
-            else                                                                                         \
+        }                                                                                                \
+        free( thread_values );                                                                           \
+    }                                                                                                    \
+                                                                                                         \
+    static void                                                                                          \
+    write_cube_##cube_type(                                                                              \
+        scorep_cube_writing_data * writeSet,                                                             \
+        SCOREP_Ipc_Group * comm,                                                                         \
+        cube_metric * metric,                                                                            \
+        scorep_profile_get_##cube_type##_func getValue,                                                  \
+        void* funcData )                                                                                 \
+    {                                                                                                    \
+        if ( writeSet->callpath_number == 0 ) {                                                          \
+            return; }                                                                                    \
+                                                                                                         \
+        /* Collect the callpaths with values, the same on all ranks */                                   \
+        uint32_t* callpaths     = ( uint32_t* )malloc( writeSet->callpath_number * sizeof( uint32_t ) ); \
+        uint32_t  num_callpaths = 0;                                                                     \
+        UTILS_ASSERT( callpaths );                                                                       \
+        for ( uint32_t cp_index = 0; cp_index < writeSet->callpath_number; cp_index++ )                  \
+        {                                                                                                \
+            if ( SCOREP_Bitstring_IsSet( writeSet->bit_vector, cp_index ) )                              \
             {                                                                                            \
-                uint32_t* items_per_rank = writeSet->items_per_rank;                                     \
-                if ( NUMBER != 1 && writeSet->my_rank == writeSet->root_rank )                           \
+                callpaths[ num_callpaths++ ] = cp_index;                                                 \
+            }                                                                                            \
+        }                                                                                                \
+                                                                                                         \
+        uint32_t rows_per_chunk = get_rows_per_chunk( writeSet, sizeof( type ) );                        \
+        type*    local_values   =                                                                        \
+            ( type* )malloc( rows_per_chunk * writeSet->local_items * sizeof( type ) );                  \
+        UTILS_ASSERT( local_values );                                                                    \
+                                                                                                         \
+        int* items_per_rank = NULL;                                                                      \
+        if ( !writeSet->same_thread_num && writeSet->my_rank == writeSet->root_rank )                    \
+        {                                                                                                \
+            items_per_rank = ( int* )malloc( writeSet->ranks_number * sizeof( int ) );                   \
+            UTILS_ASSERT( items_per_rank );                                                              \
+        }                                                                                                \
+                                                                                                         \
+        row_task_##cube_type task;                                                                       \
+        task.write_set = writeSet;                                                                       \
+        task.get_value = getValue;                                                                       \
+        task.func_data = funcData;                                                                       \
+        task.values    = local_values;                                                                   \
+                                                                                                         \
+        uint32_t first = 0;                                                                              \
+        do                                                                                               \
+        {                                                                                                \
+            uint32_t num_rows = num_callpaths - first;                                                   \
+            if ( num_rows > rows_per_chunk ) {                                                           \
+                num_rows = rows_per_chunk; }                                                             \
+                                                                                                         \
+            scorep_profile_cube4_chunk* chunk = NULL;                                                    \
+            if ( writeSet->my_rank == writeSet->root_rank )                                              \
+            {                                                                                            \
+                chunk = get_next_chunk();                                                                \
+            }                                                                                            \
+                                                                                                         \
+            if ( num_rows > 0 )                                                                          \
+            {                                                                                            \
+                /* Compute the local values of all rows of this chunk */                                 \
+                task.callpaths = &callpaths[ first ];                                                    \
+                task.num_rows  = num_rows;                                                               \
+                scorep_profile_parallel_for( ( num_rows + SCOREP_PROFILE_CUBE4_ROWS_PER_TASK - 1 )       \
+                                             / SCOREP_PROFILE_CUBE4_ROWS_PER_TASK,                       \
+                                             build_rows_##cube_type, &task );                            \
+                                                                                                         \
+                /* Collect data from all processes */                                                    \
+                SCOREP_IpcGroup_Barrier( comm );                                                         \
+                if ( writeSet->same_thread_num )                                                         \
                 {                                                                                        \
-                    items_per_rank = ( uint32_t* )malloc( writeSet->ranks_number * sizeof( uint32_t ) ); \
-                    UTILS_ASSERT( items_per_rank );                                                      \
-                    for ( uint32_t rank = 0; rank < writeSet->ranks_number; rank++ )                     \
-                    {                                                                                    \
-                        items_per_rank[ rank ] = writeSet->items_per_rank[ rank ] * NUMBER;              \
-                    }                                                                                    \
+                    SCOREP_IpcGroup_Gather( comm, local_values, chunk ? chunk->values : NULL,            \
+                                            writeSet->local_items * num_rows * NUMBER,                   \
+                                            SCOREP_IPC_##TYPE, writeSet->root_rank );                    \
                 }                                                                                        \
-                SCOREP_IpcGroup_Gatherv( comm,                                                           \
-                                         aggregated_values,                                              \
-                                         writeSet->local_items * NUMBER,                                 \
-                                         global_values, items_per_rank,                                  \
-                                         SCOREP_IPC_##TYPE, writeSet->root_rank );                       \
-                if ( NUMBER != 1 && writeSet->my_rank == writeSet->root_rank )                           \
+                else                                                                                     \
                 {                                                                                        \
-                    free( items_per_rank );                                                              \
+                    if ( items_per_rank )                                                                \
+                    {                                                                                    \
+                        for ( uint32_t rank = 0; rank < writeSet->ranks_number; rank++ )                 \
+                        {                                                                                \
+                            items_per_rank[ rank ] =                                                     \
+                                writeSet->items_per_rank[ rank ] * num_rows * NUMBER;                    \
+                        }                                                                                \
+                    }                                                                                    \
+                    SCOREP_IpcGroup_Gatherv( comm,                                                       \
+                                             local_values,                                               \
+                                             writeSet->local_items * num_rows * NUMBER,                  \
+                                             chunk ? chunk->values : NULL, items_per_rank,               \
+                                             SCOREP_IPC_##TYPE, writeSet->root_rank );                   \
                 }                                                                                        \
             }                                                                                            \
                                                                                                          \
-            /* Write data for one callpath */                                                            \
-            if ( writeSet->my_rank == writeSet->root_rank )                                              \
+            /* Write the chunk in the background */                                                      \
+            if ( chunk )                                                                                 \
             {                                                                                            \
-                cnode = cube_get_cnode( writeSet->my_cube, cp_index );                                   \
-                cube_write_sev_row_of_##cube_type( writeSet->my_cube, metric,                            \
-                                                   cnode, global_values );                               \
+                chunk->write_set    = writeSet;                                                          \
+                chunk->write_row    = write_row_##cube_type;                                             \
+                chunk->metric       = metric;                                                            \
+                chunk->known_cnodes = NULL;                                                              \
+                chunk->value_size   = sizeof( type );                                                    \
+                chunk->num_rows     = num_rows;                                                          \
+                memcpy( chunk->callpaths, &callpaths[ first ], num_rows * sizeof( uint32_t ) );          \
+                if ( first == 0 )                                                                        \
+                {                                                                                        \
+                    size_t bytes = SCOREP_Bitstring_GetByteSize( writeSet->callpath_number );            \
+                    chunk->known_cnodes = ( uint8_t* )malloc( bytes );                                   \
+                    UTILS_ASSERT( chunk->known_cnodes );                                                 \
+                    memcpy( chunk->known_cnodes, writeSet->bit_vector, bytes );                          \
+                }                                                                                        \
+                SCOREP_AsyncWorker_Start( chunk_writer.worker, write_chunk, chunk );                     \
             }                                                                                            \
+                                                                                                         \
+            first += num_rows;                                                                           \
         }                                                                                                \
+        while ( first < num_callpaths );                                                                 \
                                                                                                          \
         /* Clean up */                                                                                   \
-        free( global_values );                                                                           \
+        free( items_per_rank );                                                                          \
         free( local_values );                                                                            \
-        free( aggregated_values );                                                                       \
+        free( callpaths );                                                                               \
     }
 
 /* *INDENT-ON* */
@@ -795,6 +1162,8 @@ delete_cube_writing_data( scorep_cube_writing_data* writeSet )
     free( writeSet->metric_map );
     free( writeSet->unified_metric_map );
     free( writeSet->bit_vector );
+    free( writeSet->sparse_bit_vectors );
+    free( writeSet->node_bit_vector );
     if ( writeSet->my_cube != NULL )
     {
         cube_free( writeSet->my_cube );
@@ -813,6 +1182,8 @@ delete_cube_writing_data( scorep_cube_writing_data* writeSet )
     writeSet->metric_map         = NULL;
     writeSet->unified_metric_map = NULL;
     writeSet->bit_vector         = NULL;
+    writeSet->sparse_bit_vectors = NULL;
+    writeSet->node_bit_vector    = NULL;
 }
 
 /**
@@ -837,6 +1208,8 @@ init_cube_writing_data( scorep_cube_writing_data*   writeSet,
     writeSet->metric_map         = NULL;
     writeSet->unified_metric_map = NULL;
     writeSet->bit_vector         = NULL;
+    writeSet->sparse_bit_vectors = NULL;
+    writeSet->node_bit_vector    = NULL;
 
     /* ------------------------------------ Start initializing */
 
@@ -1082,6 +1455,90 @@ cleanup:
     }
 }
 
+/* *****************************************************************************
+   Duty-cycle extrapolation
+*******************************************************************************/
+
+/**
+   Scales the visits and inclusive times of @a node and its subtree by
+   @a factor after the time spent in the duty-cycle-off region was removed.
+   The time the user switched recording off is kept, but not scaled.
+   @param node        Root of the subtree that is extrapolated.
+   @param factor      Inverse of the ratio of recorded time.
+   @param dutyOffTime Accumulates the time spent in the duty-cycle-off
+                      region in the subtree of @a node before scaling.
+   @param userOffTime Accumulates the time spent in the recording-off
+                      region in the subtree of @a node.
+ */
+static void
+extrapolate_node( scorep_profile_node* node,
+                  double               factor,
+                  uint64_t*            dutyOffTime,
+                  uint64_t*            userOffTime )
+{
+    if ( node->node_type == SCOREP_PROFILE_NODE_REGULAR_REGION )
+    {
+        SCOREP_RegionHandle region =
+            scorep_profile_type_get_region_handle( node->type_specific_data );
+        if ( region == SCOREP_GetDutyCycleOffRegion() )
+        {
+            *dutyOffTime            += node->inclusive_time.sum;
+            node->inclusive_time.sum = 0;
+            node->count              = 0;
+            return;
+        }
+        if ( region == scorep_profile_record_off_region )
+        {
+            *userOffTime += node->inclusive_time.sum;
+            return;
+        }
+    }
+
+    uint64_t duty_off_time = 0;
+    uint64_t user_off_time = 0;
+    for ( scorep_profile_node* child = node->first_child;
+          child != NULL; child = child->next_sibling )
+    {
+        extrapolate_node( child, factor, &duty_off_time, &user_off_time );
+    }
+
+    uint64_t off_time = duty_off_time + user_off_time;
+    uint64_t on_time  = node->inclusive_time.sum > off_time
+                        ? node->inclusive_time.sum - off_time : 0;
+    node->inclusive_time.sum = ( uint64_t )( on_time * factor + 0.5 ) + user_off_time;
+    node->count              = ( uint64_t )( node->count * factor + 0.5 );
+
+    *dutyOffTime += duty_off_time;
+    *userOffTime += user_off_time;
+}
+
+/**
+   Extrapolates the call trees of all locations of this process to the
+   full measurement duration, using the ratio of recorded time stored
+   for each location.
+ */
+static void
+extrapolate_duty_cycle( void )
+{
+    for ( scorep_profile_node* root = scorep_profile.first_root_node;
+          root != NULL; root = root->next_sibling )
+    {
+        if ( root->node_type != SCOREP_PROFILE_NODE_THREAD_ROOT )
+        {
+            continue;
+        }
+        double coverage =
+            scorep_profile_type_get_location_data( root->type_specific_data )->recording_coverage;
+        if ( coverage <= 0.0 || coverage >= 1.0 )
+        {
+            continue;
+        }
+        uint64_t duty_off_time = 0;
+        uint64_t user_off_time = 0;
+        extrapolate_node( root, 1.0 / coverage, &duty_off_time, &user_off_time );
+    }
+}
+
 /* *****************************************************************************
    Main writer function
 *******************************************************************************/
@@ -1112,6 +1569,11 @@ scorep_profile_write_cube4( SCOREP_Profile_OutputFormat format )
         comm = scorep_system_tree_seq_get_ipc_group();
     }
 
+    if ( scorep_profile_extrapolate_duty_cycle )
+    {
+        extrapolate_duty_cycle();
+    }
+
     if ( !init_cube_writing_data( &write_set, format, comm ) )
     {
         return;
@@ -1148,6 +1610,11 @@ scorep_profile_write_cube4( SCOREP_Profile_OutputFormat format )
             cube_def_attr( write_set.my_cube, "Score-P::DefinitionCounters::InterruptGenerator", buffer );
         }
 
+        sprintf( buffer, "%f", SCOREP_GetRecordingCoverage() );
+        cube_def_attr( write_set.my_cube, "Score-P::DutyCycle::Coverage", buffer );
+        cube_def_attr( write_set.my_cube, "Score-P::DutyCycle::Extrapolated",
+                       scorep_profile_extrapolate_duty_cycle ? "true" : "false" );
+
         add_default_spec_file( write_set.my_cube );
     }
 
@@ -1168,6 +1635,14 @@ scorep_profile_write_cube4( SCOREP_Profile_OutputFormat format )
     /* Write clustering mappings */
     scorep_cluster_write_cube4( &write_set );
 
+    /* The values are computed on worker threads, at most one per location,
+       and written to Cube by a background thread */
+    scorep_profile_create_workers( write_set.local_threads );
+    if ( write_set.my_rank == write_set.root_rank )
+    {
+        init_chunk_writer( &write_set );
+    }
+
     /* -------------------------------- dense metrics */
     /* Write implicit time and visits */
     UTILS_DEBUG_PRINTF( SCOREP_DEBUG_PROFILE, "Writing runtime" );
@@ -1216,6 +1691,21 @@ scorep_profile_write_cube4( SCOREP_Profile_OutputFormat format )
             write_cube_uint64( &write_set, comm, scorep_get_hits_handle(),
                                &get_hits_value, NULL );
         }
+
+        if ( layout.metric_list & SCOREP_CUBE_METRIC_LATENCY )
+        {
+            static double percentiles[ SCOREP_CUBE_LATENCY_NUM_METRICS ] = {
+                [ SCOREP_CUBE_LATENCY_P50 ] = 0.5,
+                [ SCOREP_CUBE_LATENCY_P90 ] = 0.9,
+                [ SCOREP_CUBE_LATENCY_P99 ] = 0.99,
+                [ SCOREP_CUBE_LATENCY_MAX ] = 1.0
+            };
+            for ( uint32_t i = 0; i < SCOREP_CUBE_LATENCY_NUM_METRICS; i++ )
+            {
+                write_cube_doubles( &write_set, comm, scorep_get_latency_handle( i ),
+                                    &get_latency_value, &percentiles[ i ] );
+            }
+        }
     }
 
     if ( layout.metric_list & SCOREP_CUBE_METRIC_NUM_THREADS )
@@ -1305,6 +1795,8 @@ scorep_profile_write_cube4( SCOREP_Profile_OutputFormat format )
     {
         cube_metric* metric = NULL; /* Only used on rank 0 */
 
+        init_sparse_bit_vectors( &write_set );
+
         for ( uint32_t unified = 0; unified < write_set.num_unified_metrics; unified++ )
         {
             if ( !check_if_metric_shall_be_written( &write_set,
@@ -1354,8 +1846,8 @@ scorep_profile_write_cube4( SCOREP_Profile_OutputFormat format )
                     {
                         set_bitstring_for_metric( &write_set,
                                                   comm,
-                                                  &get_sparse_uint64_value,
-                                                  &write_set.metric_map[ unified ] );
+                                                  write_set.metric_map[ unified ],
+                                                  unified );
                     }
                     if ( layout.sparse_metric_type == SCOREP_CUBE_DATA_TUPLE )
                     {
@@ -1384,8 +1876,8 @@ scorep_profile_write_cube4( SCOREP_Profile_OutputFormat format )
                     {
                         set_bitstring_for_metric( &write_set,
                                                   comm,
-                                                  &has_sparse_double_value,
-                                                  &write_set.metric_map[ unified ] );
+                                                  write_set.metric_map[ unified ],
+                                                  unified );
                     }
                     if ( layout.sparse_metric_type == SCOREP_CUBE_DATA_TUPLE )
                     {
@@ -1413,6 +1905,13 @@ scorep_profile_write_cube4( SCOREP_Profile_OutputFormat format )
             }
         }
     }
+
+    /* Wait until all values are written */
+    if ( write_set.my_rank == write_set.root_rank )
+    {
+        finalize_chunk_writer();
+    }
+    scorep_profile_destroy_workers();
     UTILS_DEBUG_PRINTF( SCOREP_DEBUG_PROFILE, "Profile writing done" );
 
     /* Clean up */
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012, 2016,
+ * Copyright (c) 2009-2012, 2016, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -67,6 +67,9 @@ typedef struct
     /* available on all processes after definition mapping creation */
     scorep_profile_node** id_2_node;                /**< maps global sequence number */
     SCOREP_MetricHandle*  metric_map;               /**< map sequence no to handle */
+    uint8_t*              sparse_bit_vectors;       /**< Local callpaths with values
+                                                         per sparse metric */
+    uint8_t*              node_bit_vector;          /**< Local callpaths with nodes */
 
     /* Use only on root process */
     cube_t* my_cube;                                /**< Cube object that is created */
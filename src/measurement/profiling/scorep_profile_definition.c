@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012, 2015, 2019,
+ * Copyright (c) 2009-2012, 2015, 2019, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -76,6 +76,7 @@ scorep_profile_definition scorep_profile =
     NULL,      /* first_root_node      */
     false,     /* has_collapse_node    */
     0,         /* reached_depth        */
+    false,     /* threads_expanded     */
     false,     /* is_initialized       */
     false,     /* reinitialize         */
     0,         /* max_callpath_depth   */
@@ -88,6 +89,12 @@ scorep_profile_definition scorep_profile =
  */
 uint32_t scorep_profile_number_of_program_args = 0;
 
+/**
+    The region which represents the time while recording was disabled. Known
+    after the first disable recording event.
+ */
+SCOREP_RegionHandle scorep_profile_record_off_region = SCOREP_INVALID_REGION;
+
 /*----------------------------------------------------------------------------------------
    Constructors / destructors
    -------------------------------------------------------------------------------------*/
@@ -102,6 +109,7 @@ scorep_profile_init_definition( void )
     /* Store configuration */
     scorep_profile.has_collapse_node  = false;
     scorep_profile.reached_depth      = 0;
+    scorep_profile.threads_expanded   = false;
     scorep_profile.max_callpath_depth = scorep_profile_max_callpath_depth;
 }
 
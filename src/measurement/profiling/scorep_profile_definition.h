@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012, 2015, 2019,
+ * Copyright (c) 2009-2012, 2015, 2019, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -89,6 +89,13 @@ typedef struct
      */
     uint64_t reached_depth;
 
+    /**
+       True after the thread start nodes were expanded. Afterwards, merging
+       subtrees does not need to look for thread start nodes in the trees of
+       other locations.
+     */
+    bool threads_expanded;
+
     /**
        Flag wether the profile is initialized
      */
@@ -134,6 +141,12 @@ extern scorep_profile_definition scorep_profile;
 extern uint32_t scorep_profile_number_of_program_args;
 
 
+/**
+    The region which represents the time while recording was disabled.
+ */
+extern SCOREP_RegionHandle scorep_profile_record_off_region;
+
+
 /* **************************************************************************************
    Functions
 ****************************************************************************************/
@@ -165,7 +165,11 @@ scorep_profile_exit( SCOREP_Profile_LocationData* location,
 
         /* Update metrics */
         node->last_exit_time = timestamp;
-        scorep_profile_update_dense_metric( &node->inclusive_time, timestamp );
+        uint64_t duration = scorep_profile_update_dense_metric( &node->inclusive_time, timestamp );
+        if ( node->latency_histogram != NULL )
+        {
+            scorep_profile_update_latency_histogram( node->latency_histogram, duration );
+        }
         for ( uint32_t i = 0; i < SCOREP_Metric_GetNumberOfStrictlySynchronousMetrics(); i++ )
         {
             scorep_profile_update_dense_metric( &node->dense_metrics[ i ], metrics ? metrics[ i ] : 0 );
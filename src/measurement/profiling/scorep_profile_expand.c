@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012,
+ * Copyright (c) 2009-2012, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -51,9 +51,23 @@
 #include <scorep_profile_definition.h>
 #include <scorep_profile_location.h>
 #include <scorep_profile_debug.h>
+#include <scorep_profile_process.h>
 
 #include <stdlib.h>
 
+/**
+   Nesting level of a location. Locations on the same level are expanded
+   concurrently, after all locations of lower levels.
+ */
+typedef struct
+{
+    scorep_profile_node* thread_root;
+    uint32_t             level;
+} location_level;
+
+#define LEVEL_UNKNOWN     UINT32_MAX
+#define LEVEL_IN_PROGRESS ( UINT32_MAX - 1 )
+
 /**
    Finds or creates a child of parent which matches type and adds inclusive metrics from
    source.
@@ -145,6 +159,25 @@ sum_children( scorep_profile_node* parent )
     }
 }
 
+/**
+   Returns the node where the thread of a thread start node was created.
+   @param threadStart Pointer to a node of type @ref SCOREP_PROFILE_NODE_THREAD_START.
+ */
+static scorep_profile_node*
+get_creation_point( scorep_profile_node* threadStart )
+{
+    scorep_profile_node* creation_point =
+        scorep_profile_type_get_fork_node( threadStart->type_specific_data );
+    /* If the creation point happend at another thread start node, follow the
+       chain until we find a node that is not a thread start */
+    while ( ( creation_point != NULL ) &&
+            ( creation_point->node_type == SCOREP_PROFILE_NODE_THREAD_START ) )
+    {
+        creation_point = scorep_profile_type_get_fork_node( creation_point->type_specific_data );
+    }
+    return creation_point;
+}
+
 /**
     Replaces a node of type @ref SCOREP_PROFILE_NODE_THREAD_START with the callpath
     from the creation point.
@@ -167,14 +200,7 @@ expand_thread_start( SCOREP_Profile_LocationData* location,
     UTILS_ASSERT( thread_root != NULL ); /* Thread activation without location creation */
     UTILS_ASSERT( thread_root->node_type == SCOREP_PROFILE_NODE_THREAD_ROOT );
 
-    creation_point = scorep_profile_type_get_fork_node( thread_start->type_specific_data );
-    /* If the creation point happend at another thread start node, follow the
-       chain until we find a node that is not a thread start */
-    while ( ( creation_point != NULL ) &&
-            ( creation_point->node_type == SCOREP_PROFILE_NODE_THREAD_START ) )
-    {
-        creation_point = scorep_profile_type_get_fork_node( creation_point->type_specific_data );
-    }
+    creation_point = get_creation_point( thread_start );
 
     /* Separate the thread_start node from the profile */
     scorep_profile_remove_node( thread_start );
@@ -238,24 +264,162 @@ expand_thread_root( scorep_profile_node* thread_root )
     sum_children( thread_root );
 }
 
+static void
+expand_location( uint32_t index,
+                 void*    arg )
+{
+    expand_thread_root( ( ( scorep_profile_node** )arg )[ index ] );
+}
+
+static int
+compare_location_level( const void* a,
+                        const void* b )
+{
+    uintptr_t root_a = ( uintptr_t )( ( const location_level* )a )->thread_root;
+    uintptr_t root_b = ( uintptr_t )( ( const location_level* )b )->thread_root;
+    return ( root_a > root_b ) - ( root_a < root_b );
+}
+
+/**
+   Determines the nesting level of a location. A location has level 0 if none
+   of its threads was created by another location, else its level is one more
+   than the maximum level of the creating locations.
+   @param levels    The levels of all locations, sorted by their thread root.
+   @param numLevels The number of locations.
+   @param location  The location whose level is determined.
+ */
+static uint32_t
+get_level( location_level* levels,
+           uint32_t        numLevels,
+           location_level* location )
+{
+    if ( location->level != LEVEL_UNKNOWN )
+    {
+        return location->level;
+    }
+    location->level = LEVEL_IN_PROGRESS;
+
+    uint32_t level = 0;
+    for ( scorep_profile_node* thread_start = location->thread_root->first_child;
+          thread_start != NULL;
+          thread_start = thread_start->next_sibling )
+    {
+        if ( thread_start->node_type != SCOREP_PROFILE_NODE_THREAD_START )
+        {
+            continue;
+        }
+        scorep_profile_node* creator = get_creation_point( thread_start );
+        if ( creator == NULL )
+        {
+            continue;
+        }
+        while ( creator->parent != NULL )
+        {
+            creator = creator->parent;
+        }
+
+        location_level  key   = { creator, 0 };
+        location_level* found = bsearch( &key, levels, numLevels,
+                                         sizeof( *levels ), compare_location_level );
+        if ( found == NULL || found == location )
+        {
+            continue;
+        }
+        uint32_t creator_level = get_level( levels, numLevels, found );
+        /* Cycles should not exist, ignore them */
+        if ( creator_level != LEVEL_IN_PROGRESS && creator_level + 1 > level )
+        {
+            level = creator_level + 1;
+        }
+    }
+
+    location->level = level;
+    return level;
+}
+
 /**
    Expands all threads. All nodes of type @ref SCOREP_PROFILE_NODE_THREAD_START
    in the profile are substituted by the callpath to the node where the thread was
    activated. In OpenMP this is the callpath which contained the parallel region
    statement.
+   Expanding a location reads the callpaths of the locations which created its
+   threads. Thus, the locations are expanded in the order of their nesting
+   level. Locations on the same level are expanded concurrently.
  */
 void
 scorep_profile_expand_threads( void )
 {
-    scorep_profile_node* thread_root = scorep_profile.first_root_node;
-    while ( thread_root != NULL )
+    uint32_t num_locations = 0;
+    for ( scorep_profile_node* thread_root = scorep_profile.first_root_node;
+          thread_root != NULL;
+          thread_root = thread_root->next_sibling )
     {
         if ( thread_root->node_type == SCOREP_PROFILE_NODE_THREAD_ROOT )
         {
-            expand_thread_root( thread_root );
+            num_locations++;
+        }
+    }
+
+    location_level*       levels = calloc( num_locations, sizeof( *levels ) );
+    scorep_profile_node** wave   = calloc( num_locations, sizeof( *wave ) );
+
+    /* If allocation fails, we expand the locations serially in list order */
+    if ( levels == NULL || wave == NULL )
+    {
+        for ( scorep_profile_node* thread_root = scorep_profile.first_root_node;
+              thread_root != NULL;
+              thread_root = thread_root->next_sibling )
+        {
+            if ( thread_root->node_type == SCOREP_PROFILE_NODE_THREAD_ROOT )
+            {
+                expand_thread_root( thread_root );
+            }
         }
-        thread_root = thread_root->next_sibling;
     }
+    else
+    {
+        uint32_t i = 0;
+        for ( scorep_profile_node* thread_root = scorep_profile.first_root_node;
+              thread_root != NULL;
+              thread_root = thread_root->next_sibling )
+        {
+            if ( thread_root->node_type == SCOREP_PROFILE_NODE_THREAD_ROOT )
+            {
+                levels[ i ].thread_root = thread_root;
+                levels[ i ].level       = LEVEL_UNKNOWN;
+                i++;
+            }
+        }
+        qsort( levels, num_locations, sizeof( *levels ), compare_location_level );
+
+        uint32_t max_level = 0;
+        for ( i = 0; i < num_locations; i++ )
+        {
+            uint32_t level = get_level( levels, num_locations, &levels[ i ] );
+            if ( level > max_level )
+            {
+                max_level = level;
+            }
+        }
+
+        for ( uint32_t level = 0; level <= max_level; level++ )
+        {
+            uint32_t wave_size = 0;
+            for ( i = 0; i < num_locations; i++ )
+            {
+                if ( levels[ i ].level == level )
+                {
+                    wave[ wave_size++ ] = levels[ i ].thread_root;
+                }
+            }
+            scorep_profile_parallel_for( wave_size, expand_location, wave );
+        }
+    }
+
+    free( levels );
+    free( wave );
+
+    scorep_profile.threads_expanded = true;
 }
 
 /**
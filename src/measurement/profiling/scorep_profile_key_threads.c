@@ -7,6 +7,9 @@
  * Copyright (c) 2017,
  * Forschungszentrum Juelich GmbH, Germany
  *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
  * This software may be modified and distributed under the terms of
  * a BSD-style license. See the COPYING file in the package base
  * directory for details.
@@ -36,6 +39,7 @@
 #include <scorep_profile_definition.h>
 #include <scorep_profile_event_base.h>
 #include <scorep_profile_location.h>
+#include <scorep_profile_process.h>
 
 #include <SCOREP_Definitions.h>
 #include <UTILS_Error.h>
@@ -429,6 +433,17 @@ calculate_key_locations( scorep_profile_sync_iterator* iterator )
     }
 }
 
+static void
+init_num_threads_metric_in_location( scorep_profile_node* threadRoot,
+                                     void*                param )
+{
+    SCOREP_Profile_LocationData* location =
+        scorep_profile_type_get_location_data( threadRoot->type_specific_data );
+    scorep_profile_for_all( threadRoot,
+                            &add_num_threads_metric,
+                            location );
+}
+
 /* **************************************************************************************
  * external visible functions
  ***************************************************************************************/
@@ -448,16 +463,7 @@ scorep_profile_init_num_threads_metric( void )
                                       SCOREP_METRIC_PROFILING_TYPE_EXCLUSIVE,
                                       SCOREP_INVALID_METRIC );
 
-    for ( scorep_profile_node* current = scorep_profile.first_root_node;
-          current != NULL;
-          current = current->next_sibling )
-    {
-        SCOREP_Profile_LocationData* location =
-            scorep_profile_type_get_location_data( current->type_specific_data );
-        scorep_profile_for_all( current,
-                                &add_num_threads_metric,
-                                location );
-    }
+    scorep_profile_for_all_locations( &init_num_threads_metric_in_location, NULL );
 }
 
 void
@@ -156,6 +156,7 @@ scorep_profile_create_location_data( SCOREP_Location* locationData )
     location->location_data         = locationData;
     location->migration_sum         = 1;
     location->migration_win         = 0;
+    location->recording_coverage    = 1.0;
 
     return location;
 }
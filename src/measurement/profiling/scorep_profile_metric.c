@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2013, 2016,
+ * Copyright (c) 2009-2013, 2016, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -38,6 +38,7 @@
 
 #include <config.h>
 #include <stddef.h>
+#include <string.h>
 
 #include "SCOREP_Memory.h"
 
@@ -74,7 +75,7 @@ scorep_profile_init_dense_metric_array( scorep_profile_dense_metric* metric,
 }
 
 /* Updates the statistics of one dense metric on an exit event. */
-void
+uint64_t
 scorep_profile_update_dense_metric( scorep_profile_dense_metric* metric,
                                     uint64_t                     end_value )
 {
@@ -91,6 +92,8 @@ scorep_profile_update_dense_metric( scorep_profile_dense_metric* metric,
         metric->max = diff;
     }
     metric->squares += ( diff * diff );
+
+    return diff;
 }
 
 /* Copies the value of a dense metric to another dense metric. */
@@ -123,6 +126,140 @@ scorep_profile_merge_dense_metric( scorep_profile_dense_metric* destination,
     destination->intermediate_sum += source->intermediate_sum;
 }
 
+/* ***************************************************************************************
+   Latency histograms
+*****************************************************************************************/
+
+#define SUB_BUCKETS ( UINT64_C( 1 ) << SCOREP_PROFILE_LATENCY_SUB_BUCKET_BITS )
+
+/* Number of set bits, without relying on compiler builtins. */
+static inline uint32_t
+population_count( uint64_t value )
+{
+    value = value - ( ( value >> 1 ) & UINT64_C( 0x5555555555555555 ) );
+    value = ( value & UINT64_C( 0x3333333333333333 ) ) +
+            ( ( value >> 2 ) & UINT64_C( 0x3333333333333333 ) );
+    value = ( value + ( value >> 4 ) ) & UINT64_C( 0x0f0f0f0f0f0f0f0f );
+    return ( value * UINT64_C( 0x0101010101010101 ) ) >> 56;
+}
+
+/* Position of the most significant set bit of a non-zero value. */
+static inline uint32_t
+most_significant_bit( uint64_t value )
+{
+    value |= value >> 1;
+    value |= value >> 2;
+    value |= value >> 4;
+    value |= value >> 8;
+    value |= value >> 16;
+    value |= value >> 32;
+    return population_count( value ) - 1;
+}
+
+/*
+ * Durations below 2 * SUB_BUCKETS get one bucket each. Larger durations are
+ * shifted right until SUB_BITS + 1 significant bits remain, and these bits
+ * select the bucket within the exponent group. Or-ing in SUB_BUCKETS lets
+ * small durations take the same path with a shift of zero.
+ */
+static inline uint32_t
+latency_bucket( uint64_t duration )
+{
+    uint32_t shift = most_significant_bit( duration | SUB_BUCKETS )
+                     - SCOREP_PROFILE_LATENCY_SUB_BUCKET_BITS;
+    return shift * SUB_BUCKETS + ( duration >> shift );
+}
+
+/* Largest duration which falls into @a bucket. */
+static uint64_t
+latency_bucket_upper_bound( uint32_t bucket )
+{
+    if ( bucket < 2 * SUB_BUCKETS )
+    {
+        return bucket;
+    }
+    uint32_t shift    = bucket / SUB_BUCKETS - 1;
+    uint64_t mantissa = bucket - shift * SUB_BUCKETS;
+    return ( ( mantissa + 1 ) << shift ) - 1;
+}
+
+void
+scorep_profile_init_latency_histogram( uint32_t* histogram )
+{
+    memset( histogram, 0, SCOREP_PROFILE_LATENCY_BUCKETS * sizeof( *histogram ) );
+}
+
+void
+scorep_profile_update_latency_histogram( uint32_t* histogram,
+                                         uint64_t  duration )
+{
+    uint32_t* bucket = &histogram[ latency_bucket( duration ) ];
+    *bucket += ( *bucket != UINT32_MAX );
+}
+
+void
+scorep_profile_copy_latency_histogram( uint32_t*       destination,
+                                       const uint32_t* source )
+{
+    memcpy( destination, source, SCOREP_PROFILE_LATENCY_BUCKETS * sizeof( *destination ) );
+}
+
+void
+scorep_profile_merge_latency_histogram( uint32_t*       destination,
+                                        const uint32_t* source )
+{
+    for ( uint32_t i = 0; i < SCOREP_PROFILE_LATENCY_BUCKETS; i++ )
+    {
+        uint64_t sum = ( uint64_t )destination[ i ] + source[ i ];
+        destination[ i ] = sum > UINT32_MAX ? UINT32_MAX : sum;
+    }
+}
+
+void
+scorep_profile_subtract_latency_histogram( uint32_t*       minuend,
+                                           const uint32_t* subtrahend )
+{
+    for ( uint32_t i = 0; i < SCOREP_PROFILE_LATENCY_BUCKETS; i++ )
+    {
+        minuend[ i ] = minuend[ i ] > subtrahend[ i ] ? minuend[ i ] - subtrahend[ i ] : 0;
+    }
+}
+
+uint64_t
+scorep_profile_get_latency_percentile( const uint32_t* histogram,
+                                       double          fraction )
+{
+    uint64_t total = 0;
+    for ( uint32_t i = 0; i < SCOREP_PROFILE_LATENCY_BUCKETS; i++ )
+    {
+        total += histogram[ i ];
+    }
+    if ( total == 0 )
+    {
+        return 0;
+    }
+
+    uint64_t rank = ( uint64_t )( fraction * total + 0.5 );
+    if ( rank == 0 )
+    {
+        rank = 1;
+    }
+
+    uint64_t seen   = 0;
+    uint32_t bucket = 0;
+    for (; bucket < SCOREP_PROFILE_LATENCY_BUCKETS - 1; bucket++ )
+    {
+        seen += histogram[ bucket ];
+        if ( seen >= rank )
+        {
+            break;
+        }
+    }
+    return latency_bucket_upper_bound( bucket );
+}
+
+#undef SUB_BUCKETS
+
 /* ***************************************************************************************
    Sparse metrics for integer values
 *****************************************************************************************/
@@ -146,8 +146,9 @@ scorep_profile_init_dense_metric_array( scorep_profile_dense_metric* metric,
  *  @param metric    Pointer to the dense metric instance which should be updated.
  *  @param end_value The end metrics value of the intervall which is added to the
  *                   statistics.
+ *  @returns the difference which was added to the statistics.
  */
-void
+uint64_t
 scorep_profile_update_dense_metric( scorep_profile_dense_metric* metric,
                                     uint64_t                     end_value );
 
@@ -173,6 +174,81 @@ void
 scorep_profile_merge_dense_metric( scorep_profile_dense_metric* destination,
                                    scorep_profile_dense_metric* source );
 
+/* ***************************************************************************************
+   Functions for latency histograms
+*****************************************************************************************/
+
+/**
+ *  Number of bits of a duration below its most significant bit which select the
+ *  sub-bucket in the latency histogram. Each power of two is split into
+ *  2^SCOREP_PROFILE_LATENCY_SUB_BUCKET_BITS buckets, which bounds the relative
+ *  error of a reported percentile.
+ */
+#define SCOREP_PROFILE_LATENCY_SUB_BUCKET_BITS 2
+
+/**
+ *  Number of buckets of a latency histogram, which covers the full range of
+ *  64 bit durations.
+ */
+#define SCOREP_PROFILE_LATENCY_BUCKETS \
+    ( ( 65 - SCOREP_PROFILE_LATENCY_SUB_BUCKET_BITS ) << SCOREP_PROFILE_LATENCY_SUB_BUCKET_BITS )
+
+/**
+ *  Resets all buckets of a latency histogram.
+ *  @param histogram Pointer to an array of @ref SCOREP_PROFILE_LATENCY_BUCKETS counters.
+ */
+void
+scorep_profile_init_latency_histogram( uint32_t* histogram );
+
+/**
+ *  Counts one occurrence of @a duration in the logarithmic bucket it falls into.
+ *  The bucket index is computed without branches.
+ *  @param histogram Pointer to the histogram which is updated.
+ *  @param duration  The duration in ticks.
+ */
+void
+scorep_profile_update_latency_histogram( uint32_t* histogram,
+                                         uint64_t  duration );
+
+/**
+ *  Copies the content of the histogram @a source to @a destination.
+ *  @param destination Pointer to the histogram which is overwritten.
+ *  @param source      Pointer to the histogram which is copied.
+ */
+void
+scorep_profile_copy_latency_histogram( uint32_t*       destination,
+                                       const uint32_t* source );
+
+/**
+ *  Adds the counts of @a source to @a destination. Counters saturate instead of
+ *  wrapping around.
+ *  @param destination Pointer to the histogram to which the counts are added.
+ *  @param source      Pointer to the histogram which counts are added.
+ */
+void
+scorep_profile_merge_latency_histogram( uint32_t*       destination,
+                                        const uint32_t* source );
+
+/**
+ *  Removes the counts of @a subtrahend from @a minuend. Counters saturate at zero.
+ *  @param minuend    Pointer to the histogram from which the counts are removed.
+ *  @param subtrahend Pointer to the histogram which counts are removed.
+ */
+void
+scorep_profile_subtract_latency_histogram( uint32_t*       minuend,
+                                           const uint32_t* subtrahend );
+
+/**
+ *  Estimates a percentile of the recorded durations. The upper bound of the
+ *  bucket which contains the requested rank is returned.
+ *  @param histogram Pointer to the histogram.
+ *  @param fraction  The requested percentile as fraction in the range (0, 1].
+ *  @returns the estimated duration in ticks, or 0 if the histogram is empty.
+ */
+uint64_t
+scorep_profile_get_latency_percentile( const uint32_t* histogram,
+                                       double          fraction );
+
 /* ***************************************************************************************
    Functions for sparse integer metrics.
 *****************************************************************************************/
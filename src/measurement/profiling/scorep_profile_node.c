@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2013, 2015-2018,
+ * Copyright (c) 2009-2013, 2015-2018, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -54,6 +54,8 @@
 
 #include <SCOREP_Metric_Management.h>
 
+extern bool scorep_profile_latency_histograms;
+
 /* ***************************************************************************************
    Creation / Destruction
 *****************************************************************************************/
@@ -92,6 +94,10 @@ scorep_profile_create_node( SCOREP_Profile_LocationData* location,
     scorep_profile_init_dense_metric( &node->inclusive_time );
     scorep_profile_init_dense_metric_array( node->dense_metrics,
                                             SCOREP_Metric_GetNumberOfStrictlySynchronousMetrics() );
+    if ( node->latency_histogram != NULL )
+    {
+        scorep_profile_init_latency_histogram( node->latency_histogram );
+    }
 
     return node;
 }
@@ -256,6 +262,19 @@ scorep_profile_alloc_node( SCOREP_Profile_LocationData* location,
         new_node->dense_metrics = NULL;
     }
 
+    /* Reserve space for the latency histogram. Like the dense metrics it stays
+       with the node if the node is recycled. */
+    if ( scorep_profile_latency_histograms )
+    {
+        new_node->latency_histogram = ( uint32_t* )
+                                      SCOREP_Location_AllocForProfile( location->location_data,
+                                                                       SCOREP_PROFILE_LATENCY_BUCKETS * sizeof( uint32_t ) );
+    }
+    else
+    {
+        new_node->latency_histogram = NULL;
+    }
+
     scorep_profile_set_task_context( new_node, context );
 
     return new_node;
@@ -328,6 +347,11 @@ scorep_profile_copy_all_dense_metrics( scorep_profile_node* destination,
 
     /* Copy dense metric values */
     scorep_profile_copy_dense_metric( &destination->inclusive_time, &source->inclusive_time );
+    if ( destination->latency_histogram != NULL && source->latency_histogram != NULL )
+    {
+        scorep_profile_copy_latency_histogram( destination->latency_histogram,
+                                               source->latency_histogram );
+    }
     for ( uint32_t i = 0; i < SCOREP_Metric_GetNumberOfStrictlySynchronousMetrics(); i++ )
     {
         scorep_profile_copy_dense_metric( &destination->dense_metrics[ i ],
@@ -631,6 +655,11 @@ scorep_profile_merge_node_inclusive( scorep_profile_node* destination,
 
     /* Merge dense metrics */
     scorep_profile_merge_dense_metric( &destination->inclusive_time, &source->inclusive_time );
+    if ( destination->latency_histogram != NULL && source->latency_histogram != NULL )
+    {
+        scorep_profile_merge_latency_histogram( destination->latency_histogram,
+                                                source->latency_histogram );
+    }
     for ( i = 0; i < SCOREP_Metric_GetNumberOfStrictlySynchronousMetrics(); i++ )
     {
         scorep_profile_merge_dense_metric( &destination->dense_metrics[ i ],
@@ -727,6 +756,11 @@ scorep_profile_subtract_node( scorep_profile_node* minuend,
     minuend->count                  -= subtrahend->count;
     minuend->inclusive_time.sum     -= subtrahend->inclusive_time.sum;
     minuend->inclusive_time.squares -= subtrahend->inclusive_time.squares;
+    if ( minuend->latency_histogram != NULL && subtrahend->latency_histogram != NULL )
+    {
+        scorep_profile_subtract_latency_histogram( minuend->latency_histogram,
+                                                   subtrahend->latency_histogram );
+    }
     for ( uint64_t i = 0; i < SCOREP_Metric_GetNumberOfStrictlySynchronousMetrics(); i++ )
     {
         minuend->dense_metrics[ i ].sum     -= subtrahend->dense_metrics[ i ].sum;
@@ -818,8 +852,10 @@ scorep_profile_merge_subtree( SCOREP_Profile_LocationData* location,
     assert( destination );
     assert( source );
 
-    /* Handle forked subtrees */
-    if ( scorep_profile_is_fork_node( source ) )
+    /* Handle forked subtrees. After the expansion no thread start nodes are
+       left. Then, the trees of other locations must not be searched, because
+       they might be processed concurrently. */
+    if ( !scorep_profile.threads_expanded && scorep_profile_is_fork_node( source ) )
     {
         if ( scorep_profile_is_fork_node( destination ) )
         {
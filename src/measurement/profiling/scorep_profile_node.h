@@ -142,6 +142,7 @@ typedef struct scorep_profile_node_struct
     scorep_profile_sparse_metric_double* first_double_sparse;
     scorep_profile_sparse_metric_int*    first_int_sparse;
     scorep_profile_dense_metric          inclusive_time;
+    uint32_t*                            latency_histogram; // NULL if disabled
     uint64_t                             count;            // For dense metrics
     uint64_t                             hits;             // For samples
     uint64_t                             first_enter_time; // Required by Scalasca
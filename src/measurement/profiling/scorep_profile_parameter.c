@@ -4,7 +4,7 @@
  * Copyright (c) 2016,
  * Technische Universitaet Darmstadt, Germany
  *
- * Copyright (c) 2016-2018,
+ * Copyright (c) 2016-2018, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2019,
@@ -27,6 +27,7 @@
 #include <scorep_profile_converter.h>
 #include <scorep_profile_definition.h>
 #include <scorep_profile_location.h>
+#include <scorep_profile_process.h>
 
 #include <string.h>
 #include <stdlib.h>
@@ -36,6 +37,9 @@
 static void
 traverse_rec( scorep_profile_node* node );
 
+static void
+traverse_node( scorep_profile_node* node );
+
 /**
  * Checks whether @a node has children that are parameter nodes.
  */
@@ -156,6 +160,27 @@ create_parameters_rec( SCOREP_Location*     location,
    @param node  The node which get changed.
  */
 static void
+traverse_node( scorep_profile_node* node )
+{
+    if ( has_parameter_children( node ) )
+    {
+        SCOREP_RegionHandle  region = scorep_profile_type_get_region_handle( node->type_specific_data );
+        scorep_profile_node* parent = node->parent;
+        scorep_profile_remove_node( node );
+        SCOREP_Location* location = scorep_profile_get_location_of_node( parent )->location_data;
+        create_parameters_rec( location, node, parent, region );
+    }
+    else
+    {
+        traverse_rec( node->first_child );
+    }
+}
+
+/**
+   Calls traverse_node() for @a node and all its siblings.
+   @param node  The first node of a sibling list.
+ */
+static void
 traverse_rec( scorep_profile_node* node )
 {
     for ( scorep_profile_node* next = node;
@@ -164,18 +189,7 @@ traverse_rec( scorep_profile_node* node )
     {
         /* node might be removed, thus, store next element first */
         next = node->next_sibling;
-        if ( has_parameter_children( node ) )
-        {
-            SCOREP_RegionHandle  region = scorep_profile_type_get_region_handle( node->type_specific_data );
-            scorep_profile_node* parent = node->parent;
-            scorep_profile_remove_node( node );
-            SCOREP_Location* location = scorep_profile_get_location_of_node( parent )->location_data;
-            create_parameters_rec( location, node, parent, region );
-        }
-        else
-        {
-            traverse_rec( node->first_child );
-        }
+        traverse_node( node );
     }
 }
 
@@ -228,28 +242,35 @@ substitute_dynamic_instances_in_node( scorep_profile_node* node,
     }
 }
 
-/* ***************************************************************************************
-   Main algorithm function
-*****************************************************************************************/
-
-void
-scorep_profile_process_parameters( void )
+/**
+   Processes the parameter nodes of one location.
+   @param threadRoot The root node of the location.
+   @param param      unused.
+ */
+static void
+process_parameters_in_location( scorep_profile_node* threadRoot,
+                                void*                param )
 {
     /*
      * We first special handle the DYNAMIC regions instance parameter, so that
      * the clustering still works, this is the old parameter handling, by changing
      * the call node type with a new region
      */
-    scorep_profile_node* node = scorep_profile.first_root_node;
-    while ( node != NULL )
-    {
-        scorep_profile_for_all( node, substitute_dynamic_instances_in_node, NULL );
-        node = node->next_sibling;
-    }
+    scorep_profile_for_all( threadRoot, substitute_dynamic_instances_in_node, NULL );
 
     /*
      * Special traversal, because we need to be able to cut subtrees and we will
      * replace nodes
      */
-    traverse_rec( scorep_profile.first_root_node );
+    traverse_node( threadRoot );
+}
+
+/* ***************************************************************************************
+   Main algorithm function
+*****************************************************************************************/
+
+void
+scorep_profile_process_parameters( void )
+{
+    scorep_profile_for_all_locations( &process_parameters_in_location, NULL );
 }
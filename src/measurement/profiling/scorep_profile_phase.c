@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2011,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2011,
+ * Copyright (c) 2009-2011, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2011,
@@ -50,6 +50,7 @@
 #include <scorep_profile_node.h>
 #include <scorep_profile_definition.h>
 #include <scorep_profile_location.h>
+#include <scorep_profile_process.h>
 
 
 /**
@@ -139,27 +140,30 @@ search_subtree_for_phases( SCOREP_Profile_LocationData* location,
     }
 }
 
+/**
+   Moves the phases of one location to its thread root.
+ */
+static void
+process_phases_in_location( scorep_profile_node* threadRoot,
+                            void*                param )
+{
+    SCOREP_Profile_LocationData* location =
+        scorep_profile_type_get_location_data( threadRoot->type_specific_data );
+
+    /* Phases that are alread at the root level need no processing
+       Thus, process only children of them. Hereby, we assume that
+       theads are already expanded */
+    for ( scorep_profile_node* child = threadRoot->first_child;
+          child != NULL;
+          child = child->next_sibling )
+    {
+        search_subtree_for_phases( location, threadRoot, child );
+    }
+}
+
 /* Post-processing for phases */
 void
 scorep_profile_process_phases( void )
 {
-    scorep_profile_node*         thread_root = scorep_profile.first_root_node;
-    scorep_profile_node*         child       = NULL;
-    SCOREP_Profile_LocationData* location;
-
-    while ( thread_root != NULL )
-    {
-        /* Phases that are alread at the root level need no processing
-           Thus, process only children of them. Hereby, we assume that
-           theads are already expanded */
-
-        child = thread_root->first_child;
-        while ( child != NULL )
-        {
-            location = scorep_profile_type_get_location_data( thread_root->type_specific_data );
-            search_subtree_for_phases( location, thread_root, child );
-            child = child->next_sibling;
-        }
-        thread_root = thread_root->next_sibling;
-    }
+    scorep_profile_for_all_locations( &process_phases_in_location, NULL );
 }
@@ -4,6 +4,9 @@
  * Copyright (c) 2015,
  * Technische Universität Darmstadt, Darmstadt, Germany
  *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
  * This software may be modified and distributed under the terms of
  * a BSD-style license. See the COPYING file in the package base
  * directory for details.
@@ -21,15 +24,37 @@
 #include <config.h>
 #include <scorep_profile_node.h>
 #include <scorep_profile_definition.h>
+#include <scorep_profile_process.h>
 
 #include <SCOREP_Definitions.h>
 #include <UTILS_Error.h>
 
+#include <stdlib.h>
+
+/**
+   The locations which are merged into a cluster representative, but
+   whose merge was deferred.
+ */
+typedef struct
+{
+    scorep_profile_node*  representative;
+    scorep_profile_node** sources;
+    uint32_t              size;
+    uint32_t              capacity;
+} pending_merges;
+
 /* **************************************************************************************
  * static functions
  ***************************************************************************************/
+/**
+   Compares the structure of two sorted trees. @a exact is cleared if the
+   trees match only in the common prefix of the child lists, i.e., if merging
+   @a rootB into @a rootA would add new nodes.
+ */
 static bool
-compare_structure( scorep_profile_node* rootA, scorep_profile_node* rootB )
+compare_structure( scorep_profile_node* rootA,
+                   scorep_profile_node* rootB,
+                   bool*                exact )
 {
     if ( rootA == NULL && rootB == NULL )
     {
@@ -58,11 +83,15 @@ compare_structure( scorep_profile_node* rootA, scorep_profile_node* rootB )
          child_a = child_a->next_sibling,
          child_b = child_b->next_sibling )
     {
-        if ( !compare_structure( child_a, child_b ) )
+        if ( !compare_structure( child_a, child_b, exact ) )
         {
             return false;
         }
     }
+    if ( child_a != NULL || child_b != NULL )
+    {
+        *exact = false;
+    }
     return true;
 }
 
@@ -79,33 +108,111 @@ merge_locations( scorep_profile_node* destination,
     scorep_profile_merge_subtree( location, destination, source );
 }
 
+
+static void
+sort_location( scorep_profile_node* threadRoot,
+               void*                param )
+{
+    scorep_profile_sort_subtree( threadRoot, &scorep_profile_compare_nodes );
+}
+
+
+static void
+flush_pending_merges( pending_merges* pending )
+{
+    for ( uint32_t i = 0; i < pending->size; i++ )
+    {
+        merge_locations( pending->representative, pending->sources[ i ] );
+    }
+    pending->size = 0;
+}
+
+
+static void
+flush_pending_merges_of_cluster( uint32_t index,
+                                 void*    arg )
+{
+    pending_merges* pending = &( ( pending_merges* )arg )[ index ];
+    flush_pending_merges( pending );
+    free( pending->sources );
+}
+
 /* **************************************************************************************
  * interface functions
  ***************************************************************************************/
 
+/**
+   Merges every location into the first location with the same calltree
+   structure. Merges which do not change the structure of the representative
+   are deferred, because they do not influence later comparisons. They are
+   performed concurrently for all representatives at the end.
+ */
 void
 scorep_profile_cluster_same_location( void )
 {
+    /* Make sure everything is sorted. This is required for comparison */
+    scorep_profile_for_all_locations( &sort_location, NULL );
+
+    uint32_t num_roots = 0;
+    for ( scorep_profile_node* root = scorep_profile.first_root_node;
+          root != NULL;
+          root = root->next_sibling )
+    {
+        num_roots++;
+    }
+    if ( num_roots == 0 )
+    {
+        return;
+    }
+
+    /* Indexed by the position of the representative in the root list */
+    pending_merges* pending = calloc( num_roots, sizeof( *pending ) );
+    UTILS_ASSERT( pending );
+
+    uint32_t num_clusters = 0;
     for ( scorep_profile_node* root = scorep_profile.first_root_node;
           root != NULL; )
     {
         scorep_profile_node* next = root->next_sibling;
 
-        /* Make sure everything is sorted. This is required for comparison */
-        scorep_profile_sort_subtree( root, &scorep_profile_compare_nodes );
-
+        uint32_t index = 0;
         for ( scorep_profile_node* cluster = scorep_profile.first_root_node;
               cluster != root;
-              cluster = cluster->next_sibling )
+              cluster = cluster->next_sibling, index++ )
         {
-            if ( compare_structure( cluster, root ) )
+            bool exact = true;
+            if ( compare_structure( cluster, root, &exact ) )
             {
                 scorep_profile_remove_node( root );
-                merge_locations( cluster, root );
+                pending_merges* merges = &pending[ index ];
+                if ( exact )
+                {
+                    if ( merges->size == merges->capacity )
+                    {
+                        merges->capacity = merges->capacity ? 2 * merges->capacity : 16;
+                        merges->sources  = realloc( merges->sources,
+                                                    merges->capacity * sizeof( *merges->sources ) );
+                        UTILS_ASSERT( merges->sources );
+                    }
+                    merges->sources[ merges->size++ ] = root;
+                }
+                else
+                {
+                    /* Keep the order of the merges into this cluster */
+                    flush_pending_merges( merges );
+                    merge_locations( cluster, root );
+                }
                 break;
             }
         }
+        if ( index == num_clusters )
+        {
+            pending[ num_clusters++ ].representative = root;
+        }
 
         root = next;
     }
+
+    scorep_profile_parallel_for( num_clusters, flush_pending_merges_of_cluster, pending );
+    free( pending );
 }
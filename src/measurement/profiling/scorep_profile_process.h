@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012, 2018,
+ * Copyright (c) 2009-2012, 2018, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -38,10 +38,69 @@
  * @file
  * @brief Contains the declaration of functions for post-processing a profile.
  *
+ * Steps that only touch the call tree of one location run in parallel on a
+ * pool of worker threads that exists during post-processing. The worker
+ * threads are no locations, thus, memory is allocated from the location
+ * whose tree is processed.
  *
- *
  */
 
+#include <SCOREP_WorkerPool.h>
+#include <scorep_profile_node.h>
+
+/**
+   Type of the functions that process the call tree of one location.
+   @param threadRoot The root node of the location.
+   @param param      The parameter passed to scorep_profile_for_all_locations().
+ */
+typedef void ( scorep_profile_location_func_t )( scorep_profile_node* threadRoot,
+                                                 void*                param );
+
+/**
+   Creates the worker threads for the post-processing or writing. Their number
+   is set by SCOREP_PROFILING_PROCESSING_THREADS.
+   @param maxThreads Upper bound for the number of threads, 0 means no bound.
+ */
+void
+scorep_profile_create_workers( uint32_t maxThreads );
+
+/**
+   Terminates the worker threads of the post-processing or writing.
+ */
+void
+scorep_profile_destroy_workers( void );
+
+/**
+   Creates a background thread to overlap the profile output with
+   communication, unless SCOREP_PROFILING_PROCESSING_THREADS is 1.
+   @returns the new thread, or NULL if output is written synchronously.
+ */
+SCOREP_AsyncWorker*
+scorep_profile_create_async_worker( void );
+
+/**
+   Calls @a func for every root node of the profile. Different root nodes are
+   processed concurrently, thus, @a func must only modify the tree of
+   @a threadRoot and must not add or remove root nodes.
+   @param func  The function to call.
+   @param param A parameter passed to every call of @a func.
+ */
+void
+scorep_profile_for_all_locations( scorep_profile_location_func_t* func,
+                                  void*                           param );
+
+/**
+   Calls @a func for every index in [0, @a count) on the worker threads of the
+   post-processing.
+   @param count Number of tasks.
+   @param func  The function to call.
+   @param param A parameter passed to every call of @a func.
+ */
+void
+scorep_profile_parallel_for( uint32_t               count,
+                             SCOREP_WorkerPool_Func func,
+                             void*                  param );
+
 
 /**
    Substitutes collapse nodes by regular region nodes for a region named "COLLAPSE".
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012, 2015,
+ * Copyright (c) 2009-2012, 2015, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -52,9 +52,15 @@
 #include <scorep_profile_location.h>
 #include <scorep_profile_event_base.h>
 #include <scorep_profile_node.h>
+#include <scorep_profile_process.h>
+
+#include <UTILS_Mutex.h>
 
 #include <string.h>
 
+/* Protects the lazy registration of the artificial root regions */
+static UTILS_Mutex root_region_lock = UTILS_MUTEX_INIT;
+
 static void
 visit_to_switches( scorep_profile_node* node,
                    void*                param )
@@ -163,127 +169,136 @@ change_root_node( SCOREP_Profile_LocationData* location,
     return program_root;
 }
 
+/**
+   Returns the region of an artificial root node, which is registered on the
+   first call.
+   @param region   Pointer to the variable which stores the region handle.
+   @param name     The name of the region.
+   @param paradigm The paradigm of the region.
+ */
+static SCOREP_RegionHandle
+get_root_region( SCOREP_RegionHandle* region,
+                 const char*          name,
+                 SCOREP_ParadigmType  paradigm )
+{
+    UTILS_MutexLock( &root_region_lock );
+    if ( *region == SCOREP_INVALID_REGION )
+    {
+        *region = SCOREP_Definitions_NewRegion( name,
+                                                NULL,
+                                                SCOREP_INVALID_SOURCE_FILE,
+                                                SCOREP_INVALID_LINE_NO,
+                                                SCOREP_INVALID_LINE_NO,
+                                                paradigm,
+                                                SCOREP_REGION_ARTIFICIAL );
+    }
+    SCOREP_RegionHandle result = *region;
+    UTILS_MutexUnlock( &root_region_lock );
+    return result;
+}
 
-void
-scorep_profile_process_tasks( void )
+
+/**
+   Moves the instances of threads, kernels and tasks of one location below
+   artificial root nodes.
+   @param thread_root The root node of the location.
+   @param param       unused.
+ */
+static void
+process_tasks_in_location( scorep_profile_node* thread_root,
+                           void*                param )
 {
-    scorep_profile_node*         thread_root = scorep_profile.first_root_node;
-    SCOREP_Profile_LocationData* location    = NULL;
+    scorep_profile_node* next                           = NULL;
+    scorep_profile_node* node                           = thread_root->first_child;
+    scorep_profile_node* program_root_with_tasks_node   = NULL;
+    scorep_profile_node* program_root_with_threads_node = NULL;
+    scorep_profile_node* program_root_with_kernels_node = NULL;
+    SCOREP_Profile_LocationData* location =
+        scorep_profile_type_get_location_data( thread_root->type_specific_data );
 
-    /* Loop over all threads on a process. */
-    while ( thread_root != NULL )
+    /* Loop over regions that would appear as roots in a calltree if no further processing is applied.
+     * That covers the program root, pthread functions, tasks and GPU location activities.
+     */
+    while ( node != NULL )
     {
-        scorep_profile_node* next                           = NULL;
-        scorep_profile_node* node                           = thread_root->first_child;
-        scorep_profile_node* program_root_with_tasks_node   = NULL;
-        scorep_profile_node* program_root_with_threads_node = NULL;
-        scorep_profile_node* program_root_with_kernels_node = NULL;
-        location = scorep_profile_type_get_location_data( thread_root->type_specific_data );
-
-        /* Loop over regions that would appear as roots in a calltree if no further processing is applied.
-         * That covers the program root, pthread functions, tasks and GPU location activities.
-         */
-        while ( node != NULL )
+        next = node->next_sibling;
+        if ( node->node_type == SCOREP_PROFILE_NODE_REGULAR_REGION )
         {
-            next = node->next_sibling;
-            if ( node->node_type == SCOREP_PROFILE_NODE_REGULAR_REGION )
+            SCOREP_RegionHandle region_handle = scorep_profile_type_get_region_handle( node->type_specific_data );
+            /* The program root doesn't have to be touched as it is the intended primary root
+             * node of the profile calltree. The remaining instances create on their thread_root
+             * a local subtree of the form:
+             * program_root ->artifical node(THREADS,KERNELS or TASKS)->recorded instances of threads,kernels,tasks
+             */
+            if ( region_handle != SCOREP_GetProgramRegion() )
             {
-                SCOREP_RegionHandle region_handle = scorep_profile_type_get_region_handle( node->type_specific_data );
-                /* The program root doesn't have to be touched as it is the intended primary root
-                 * node of the profile calltree. The remaining instances create on their thread_root
-                 * a local subtree of the form:
-                 * program_root ->artifical node(THREADS,KERNELS or TASKS)->recorded instances of threads,kernels,tasks
-                 */
-                if ( region_handle != SCOREP_GetProgramRegion() )
-                {
-                    SCOREP_LocationType location_type = SCOREP_Location_GetType( location->location_data );
-
-                    if ( location_type == SCOREP_LOCATION_TYPE_CPU_THREAD )
-                    {
-                        /* Register the region handle on first visit. */
-                        static SCOREP_RegionHandle program_root_with_threads_node_region = SCOREP_INVALID_REGION;
-                        if ( program_root_with_threads_node_region == SCOREP_INVALID_REGION )
-                        {
-                            program_root_with_threads_node_region = SCOREP_Definitions_NewRegion( "THREADS",
-                                                                                                  NULL,
-                                                                                                  SCOREP_INVALID_SOURCE_FILE,
-                                                                                                  SCOREP_INVALID_LINE_NO,
-                                                                                                  SCOREP_INVALID_LINE_NO,
-                                                                                                  SCOREP_PARADIGM_PTHREAD,
-                                                                                                  SCOREP_REGION_ARTIFICIAL );
-                        }
-                        program_root_with_threads_node = change_root_node( location,
-                                                                           program_root_with_threads_node,
-                                                                           program_root_with_threads_node_region,
-                                                                           SCOREP_PROFILE_NODE_TASK_ROOT,
-                                                                           node,
-                                                                           true );
-                    }
-                    if ( location_type == SCOREP_LOCATION_TYPE_GPU )
-                    {
-                        /* Register the region handle on first visit. */
-                        static SCOREP_RegionHandle program_root_with_kernels_node_region = SCOREP_INVALID_REGION;
-                        if ( program_root_with_kernels_node_region == SCOREP_INVALID_REGION )
-                        {
-                            program_root_with_kernels_node_region = SCOREP_Definitions_NewRegion( "KERNELS",
-                                                                                                  NULL,
-                                                                                                  SCOREP_INVALID_SOURCE_FILE,
-                                                                                                  SCOREP_INVALID_LINE_NO,
-                                                                                                  SCOREP_INVALID_LINE_NO,
-                                                                                                  SCOREP_RegionHandle_GetParadigmType( region_handle ),
-                                                                                                  SCOREP_REGION_ARTIFICIAL );
-                        }
+                SCOREP_LocationType location_type = SCOREP_Location_GetType( location->location_data );
 
-                        program_root_with_kernels_node = change_root_node( location,
-                                                                           program_root_with_kernels_node,
-                                                                           program_root_with_kernels_node_region,
-                                                                           SCOREP_PROFILE_NODE_TASK_ROOT,
-                                                                           node,
-                                                                           true );
-                    }
+                if ( location_type == SCOREP_LOCATION_TYPE_CPU_THREAD )
+                {
+                    /* Register the region handle on first visit. */
+                    static SCOREP_RegionHandle program_root_with_threads_node_region = SCOREP_INVALID_REGION;
+                    program_root_with_threads_node = change_root_node( location,
+                                                                       program_root_with_threads_node,
+                                                                       get_root_region( &program_root_with_threads_node_region,
+                                                                                        "THREADS",
+                                                                                        SCOREP_PARADIGM_PTHREAD ),
+                                                                       SCOREP_PROFILE_NODE_TASK_ROOT,
+                                                                       node,
+                                                                       true );
                 }
-            }
-            if ( node->node_type == SCOREP_PROFILE_NODE_TASK_ROOT )
-            {
-                SCOREP_RegionHandle region_handle = scorep_profile_type_get_region_handle( node->type_specific_data );
-                /* Register the region handle on first visit. */
-                static SCOREP_RegionHandle program_root_with_tasks_node_region = SCOREP_INVALID_REGION;
-                if ( program_root_with_tasks_node_region == SCOREP_INVALID_REGION )
+                if ( location_type == SCOREP_LOCATION_TYPE_GPU )
                 {
-                    program_root_with_tasks_node_region = SCOREP_Definitions_NewRegion( "TASKS",
-                                                                                        NULL,
-                                                                                        SCOREP_INVALID_SOURCE_FILE,
-                                                                                        SCOREP_INVALID_LINE_NO,
-                                                                                        SCOREP_INVALID_LINE_NO,
-                                                                                        SCOREP_RegionHandle_GetParadigmType( region_handle ),
-                                                                                        SCOREP_REGION_ARTIFICIAL );
+                    /* Register the region handle on first visit. */
+                    static SCOREP_RegionHandle program_root_with_kernels_node_region = SCOREP_INVALID_REGION;
+                    program_root_with_kernels_node = change_root_node( location,
+                                                                       program_root_with_kernels_node,
+                                                                       get_root_region( &program_root_with_kernels_node_region,
+                                                                                        "KERNELS",
+                                                                                        SCOREP_RegionHandle_GetParadigmType( region_handle ) ),
+                                                                       SCOREP_PROFILE_NODE_TASK_ROOT,
+                                                                       node,
+                                                                       true );
                 }
-
-                program_root_with_tasks_node = change_root_node( location,
-                                                                 program_root_with_tasks_node,
-                                                                 program_root_with_tasks_node_region,
-                                                                 SCOREP_PROFILE_NODE_TASK_ROOT,
-                                                                 node,
-                                                                 false );
             }
-
-            node = next;
-        }
-
-        /* If tasks, threads or kernels local subtrees were created, add them to the thread_root. */
-        if ( program_root_with_tasks_node != NULL )
-        {
-            scorep_profile_add_child( thread_root, program_root_with_tasks_node );
         }
-        if ( program_root_with_threads_node != NULL )
+        if ( node->node_type == SCOREP_PROFILE_NODE_TASK_ROOT )
         {
-            scorep_profile_add_child( thread_root, program_root_with_threads_node );
-        }
-        if ( program_root_with_kernels_node != NULL )
-        {
-            scorep_profile_add_child( thread_root, program_root_with_kernels_node );
+            SCOREP_RegionHandle region_handle = scorep_profile_type_get_region_handle( node->type_specific_data );
+            /* Register the region handle on first visit. */
+            static SCOREP_RegionHandle program_root_with_tasks_node_region = SCOREP_INVALID_REGION;
+            program_root_with_tasks_node = change_root_node( location,
+                                                             program_root_with_tasks_node,
+                                                             get_root_region( &program_root_with_tasks_node_region,
+                                                                              "TASKS",
+                                                                              SCOREP_RegionHandle_GetParadigmType( region_handle ) ),
+                                                             SCOREP_PROFILE_NODE_TASK_ROOT,
+                                                             node,
+                                                             false );
         }
 
-        thread_root = thread_root->next_sibling;
+        node = next;
+    }
+
+    /* If tasks, threads or kernels local subtrees were created, add them to the thread_root. */
+    if ( program_root_with_tasks_node != NULL )
+    {
+        scorep_profile_add_child( thread_root, program_root_with_tasks_node );
     }
+    if ( program_root_with_threads_node != NULL )
+    {
+        scorep_profile_add_child( thread_root, program_root_with_threads_node );
+    }
+    if ( program_root_with_kernels_node != NULL )
+    {
+        scorep_profile_add_child( thread_root, program_root_with_kernels_node );
+    }
+}
+
+
+void
+scorep_profile_process_tasks( void )
+{
+    /* Loop over all threads on a process. */
+    scorep_profile_for_all_locations( &process_tasks_in_location, NULL );
 }
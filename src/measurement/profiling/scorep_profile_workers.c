@@ -0,0 +1,125 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ * @file
+ *
+ * Worker threads for the post-processing and writing of the profile.
+ */
+
+#include <config.h>
+
+#include <UTILS_Error.h>
+
+#include <scorep_profile_definition.h>
+#include <scorep_profile_process.h>
+
+#include <stdlib.h>
+
+/**
+   Number of threads for the post-processing, set by
+   SCOREP_PROFILING_PROCESSING_THREADS.
+ */
+extern uint64_t scorep_profile_processing_threads;
+
+static SCOREP_WorkerPool* profile_workers;
+
+typedef struct
+{
+    scorep_profile_node**           roots;
+    scorep_profile_location_func_t* func;
+    void*                           param;
+} for_all_locations_arg;
+
+
+static void
+process_location( uint32_t index,
+                  void*    arg )
+{
+    for_all_locations_arg* for_all = arg;
+    for_all->func( for_all->roots[ index ], for_all->param );
+}
+
+
+void
+scorep_profile_create_workers( uint32_t maxThreads )
+{
+    UTILS_BUG_ON( profile_workers != NULL, "Profile workers exist already." );
+    profile_workers = SCOREP_WorkerPool_Create( scorep_profile_processing_threads,
+                                                maxThreads );
+}
+
+
+void
+scorep_profile_destroy_workers( void )
+{
+    SCOREP_WorkerPool_Destroy( profile_workers );
+    profile_workers = NULL;
+}
+
+
+SCOREP_AsyncWorker*
+scorep_profile_create_async_worker( void )
+{
+    if ( scorep_profile_processing_threads == 1 )
+    {
+        return NULL;
+    }
+    return SCOREP_AsyncWorker_Create();
+}
+
+
+void
+scorep_profile_for_all_locations( scorep_profile_location_func_t* func,
+                                  void*                           param )
+{
+    uint32_t num_roots = 0;
+    for ( scorep_profile_node* root = scorep_profile.first_root_node;
+          root != NULL;
+          root = root->next_sibling )
+    {
+        num_roots++;
+    }
+    if ( num_roots == 0 )
+    {
+        return;
+    }
+
+    /* Distribute the root nodes by their index in the list */
+    for_all_locations_arg for_all;
+    for_all.roots = malloc( num_roots * sizeof( *for_all.roots ) );
+    UTILS_ASSERT( for_all.roots );
+    for_all.func  = func;
+    for_all.param = param;
+
+    uint32_t i = 0;
+    for ( scorep_profile_node* root = scorep_profile.first_root_node;
+          root != NULL;
+          root = root->next_sibling )
+    {
+        for_all.roots[ i++ ] = root;
+    }
+
+    SCOREP_WorkerPool_ParallelFor( profile_workers, num_roots,
+                                   process_location, &for_all );
+
+    free( for_all.roots );
+}
+
+
+void
+scorep_profile_parallel_for( uint32_t               count,
+                             SCOREP_WorkerPool_Func func,
+                             void*                  param )
+{
+    SCOREP_WorkerPool_ParallelFor( profile_workers, count, func, param );
+}
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2013, 2015-2019, 2022,
+ * Copyright (c) 2009-2013, 2015-2019, 2022, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -166,6 +166,7 @@ static cube_metric* time_min_handle;
 static cube_metric* visits_handle;
 static cube_metric* num_threads_handle;
 static cube_metric* hits_handle;
+static cube_metric* latency_handles[ SCOREP_CUBE_LATENCY_NUM_METRICS ];
 
 /**
    Node type definition for temporary internal system tree structure for Cube definition
@@ -530,6 +531,13 @@ scorep_get_num_threads_handle( void )
     return num_threads_handle;
 }
 
+cube_metric*
+scorep_get_latency_handle( scorep_cube_latency_metric metric )
+{
+    UTILS_ASSERT( metric < SCOREP_CUBE_LATENCY_NUM_METRICS );
+    return latency_handles[ metric ];
+}
+
 /* ****************************************************************************
  * Internal definition writer functions
  *****************************************************************************/
@@ -592,6 +600,34 @@ write_metric_definitions( cube_t*                       myCube,
                                         "@mirror@scorep_metrics.html#hits",
                                         "Number of hits", NULL, CUBE_METRIC_EXCLUSIVE );
         }
+
+        if ( layout->metric_list & SCOREP_CUBE_METRIC_LATENCY )
+        {
+            latency_handles[ SCOREP_CUBE_LATENCY_P50 ] =
+                cube_def_met( myCube, "Latency Median", "latency_p50",
+                              "MAXDOUBLE", "sec", "",
+                              "@mirror@scorep_metrics.html#latency",
+                              "Estimated median of the inclusive time per visit",
+                              NULL, CUBE_METRIC_EXCLUSIVE );
+            latency_handles[ SCOREP_CUBE_LATENCY_P90 ] =
+                cube_def_met( myCube, "Latency 90th Percentile", "latency_p90",
+                              "MAXDOUBLE", "sec", "",
+                              "@mirror@scorep_metrics.html#latency",
+                              "Estimated 90th percentile of the inclusive time per visit",
+                              NULL, CUBE_METRIC_EXCLUSIVE );
+            latency_handles[ SCOREP_CUBE_LATENCY_P99 ] =
+                cube_def_met( myCube, "Latency 99th Percentile", "latency_p99",
+                              "MAXDOUBLE", "sec", "",
+                              "@mirror@scorep_metrics.html#latency",
+                              "Estimated 99th percentile of the inclusive time per visit",
+                              NULL, CUBE_METRIC_EXCLUSIVE );
+            latency_handles[ SCOREP_CUBE_LATENCY_MAX ] =
+                cube_def_met( myCube, "Latency Maximum", "latency_max",
+                              "MAXDOUBLE", "sec", "",
+                              "@mirror@scorep_metrics.html#latency",
+                              "Maximum of the inclusive time per visit",
+                              NULL, CUBE_METRIC_EXCLUSIVE );
+        }
     }
     else
     {
@@ -94,9 +94,23 @@ typedef enum
     SCOREP_CUBE_METRIC_NONE         = 0,
     SCOREP_CUBE_METRIC_VISITS       = 1,
     SCOREP_CUBE_METRIC_NUM_THREADS  = 2,
-    SCOREP_CUBE_METRIC_TASK_METRICS = 4
+    SCOREP_CUBE_METRIC_TASK_METRICS = 4,
+    SCOREP_CUBE_METRIC_LATENCY      = 8
 } scorep_cube_metric_list;
 
+/**
+ * Lists the metrics which are derived from the latency histograms.
+ */
+typedef enum
+{
+    SCOREP_CUBE_LATENCY_P50,
+    SCOREP_CUBE_LATENCY_P90,
+    SCOREP_CUBE_LATENCY_P99,
+    SCOREP_CUBE_LATENCY_MAX,
+
+    SCOREP_CUBE_LATENCY_NUM_METRICS
+} scorep_cube_latency_metric;
+
 /**
  * Defines the CUBE format for definitions.
  */
@@ -295,4 +309,10 @@ scorep_get_min_time_handle( void );
 cube_metric*
 scorep_get_num_threads_handle( void );
 
+/**
+   Returns the handle used for the latency metric @a metric.
+ */
+cube_metric*
+scorep_get_latency_handle( scorep_cube_latency_metric metric );
+
 #endif /* SCOREP_DEFINITION_CUBE4_H */
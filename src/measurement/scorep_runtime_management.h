@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2013,
+ * Copyright (c) 2009-2013, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -40,6 +40,7 @@
  */
 
 #include <SCOREP_Location.h>
+#include <UTILS_Atomic.h>
 #include <stdbool.h>
 
 
@@ -90,6 +91,42 @@ void
 SCOREP_OnTracingBufferFlushEnd( uint64_t timestamp );
 
 
+/**
+ * Timestamp of the next switch of the duty-cycle measurement mode, 0 if this
+ * mode is not active. Read by all threads, thus only accessed atomically.
+ */
+extern uint64_t scorep_duty_cycle_next_switch;
+
+
+/**
+ * Switches recording off at the end of a duty-cycle burst, or on again at
+ * the begin of the next burst. Only the master thread switches, and only
+ * outside of parallel regions.
+ *
+ * @return True if recording was switched.
+ */
+bool
+scorep_duty_cycle_switch( SCOREP_Location* location,
+                          uint64_t         timestamp );
+
+
+/**
+ * Called for region enter and exit events, before the event is processed.
+ *
+ * @return True if recording was switched, the event needs a new timestamp.
+ */
+static inline bool
+scorep_duty_cycle_check( SCOREP_Location* location,
+                         uint64_t         timestamp )
+{
+    uint64_t next_switch =
+        UTILS_Atomic_LoadN_uint64( &scorep_duty_cycle_next_switch, UTILS_ATOMIC_RELAXED );
+    return next_switch
+           && timestamp >= next_switch
+           && scorep_duty_cycle_switch( location, timestamp );
+}
+
+
 /**
  * Returns the directory the application was started in. May abort if
  * directory cannot be obtained.
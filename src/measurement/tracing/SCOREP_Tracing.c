@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2016, 2019-2020,
+ * Copyright (c) 2009-2016, 2019-2020, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -52,17 +52,29 @@
 #include <SCOREP_Timer_Utils.h>
 #include "scorep_tracing_internal.h"
 #include <SCOREP_Definitions.h>
+#include <SCOREP_Events.h>
 #include "scorep_tracing_definitions.h"
 #include <scorep_clock_synchronization.h>
 #include "scorep_tracing_internal.h"
 
 #include <SCOREP_Substrates_Management.h>
 #include <scorep_substrates_definition.h>
+#include <SCOREP_WorkerPool.h>
 
 #define SCOREP_DEBUG_MODULE_NAME TRACING
 #include <UTILS_Debug.h>
 
+#include <UTILS_Atomic.h>
+#include <UTILS_Mutex.h>
+
 #include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 static OTF2_Archive* scorep_otf2_archive;
 
@@ -76,11 +88,78 @@ static bool event_files_opened;
 size_t scorep_tracing_substrate_id;
 
 
+uint64_t scorep_tracing_min_duration_ticks;
+
+
+uint64_t scorep_tracing_ring_dump_threshold_ticks;
+
+
+/* Number of flight-recorder dumps requested so far. Each location compares
+ * this with the number of dumps it has already served. */
+static uint32_t ring_dump_requests;
+
+
+/* Set by the first fatal signal which writes the trace ring buffers */
+static bool ring_aborting;
+
+
+/* The per-buffer data of the OTF2 memory callbacks */
+typedef struct tracing_buffer tracing_buffer;
+struct tracing_buffer
+{
+    SCOREP_Allocator_PageManager* page_manager;
+
+    /* In flight recorder mode, OTF2 holds only the chunk it currently writes
+     * to. The filled chunks before it are kept in the ring, which is written
+     * to the event file of the location on a dump, see ring_keep_chunk(). */
+    void*           chunk;
+    uint64_t        chunk_size;
+    char*           ring;
+    uint32_t        ring_capacity;
+    uint32_t        ring_oldest;
+    uint32_t        ring_fill;
+    /* Number of dumps this buffer was already written for */
+    uint32_t        ring_dumps;
+    /* Set once the event files are opened */
+    char*           ring_file;
+    bool            ring_file_created;
+    tracing_buffer* ring_next;
+};
+
+
+/* All buffers with a ring, for ring_abort_signal_handler() */
+static tracing_buffer* ring_buffers;
+static UTILS_Mutex     ring_buffers_lock = UTILS_MUTEX_INIT;
+
+
+/* A location whose event writer is closed by SCOREP_Tracing_FinalizeEventWriters() */
+typedef struct
+{
+    SCOREP_Location*    location;
+    SCOREP_LocationDef* definition;
+    /* Set by the final buffer flush, if any, 0 otherwise */
+    uint64_t            flush_end;
+} event_writer_task;
+
+
+/* Non-NULL while the event writers are closed. The end of their final
+ * buffer flushes is then reported by the calling thread afterwards, as the
+ * writers may be closed by worker threads. */
+static event_writer_task* event_writer_tasks;
+static uint32_t           num_event_writer_tasks;
+
+
 /** @todo croessel in OTF2_Archive_Open we need to specify an event
     chunk size and a definition chunk size. */
 #define SCOREP_TRACING_CHUNK_SIZE ( 1024 * 1024 )
 
 
+/* Event chunk size in flight recorder mode. A requested dump is served at the
+ * next chunk boundary, thus smaller chunks let a dump follow its trigger
+ * more closely. This is the smallest chunk size OTF2 accepts. */
+#define SCOREP_TRACING_RING_CHUNK_SIZE ( 256 * 1024 )
+
+
 #include "scorep_tracing_confvars.inc.c"
 
 SCOREP_StringHandle scorep_tracing_cct_file      = SCOREP_INVALID_STRING;
@@ -108,7 +187,8 @@ static OTF2_FileSubstrate
 scorep_tracing_get_file_substrate( void )
 {
 #if HAVE( OTF2_SUBSTRATE_SION )
-    if ( scorep_tracing_use_sion )
+    /* The flight recorder writes the event files itself, see ring_write() */
+    if ( scorep_tracing_use_sion && !scorep_tracing_ring_size )
     {
         return OTF2_SUBSTRATE_SION;
     }
@@ -118,6 +198,107 @@ scorep_tracing_get_file_substrate( void )
 }
 
 
+/**
+ * Appends the filled chunks of the ring to the event file of the location,
+ * the oldest first, and empties the ring. Uses only async-signal-safe calls,
+ * see ring_abort_signal_handler().
+ */
+static bool
+ring_write( tracing_buffer* buffer )
+{
+    int flags = O_WRONLY | O_CREAT | ( buffer->ring_file_created ? O_APPEND : O_TRUNC );
+    int fd    = open( buffer->ring_file, flags, 0666 );
+    if ( fd < 0 )
+    {
+        return false;
+    }
+    buffer->ring_file_created = true;
+
+    bool success = true;
+    for ( uint32_t i = 0; success && i < buffer->ring_fill; i++ )
+    {
+        uint32_t    slot  = ( buffer->ring_oldest + i ) % buffer->ring_capacity;
+        const char* chunk = buffer->ring + ( uint64_t )slot * buffer->chunk_size;
+        uint64_t    done  = 0;
+        while ( done < buffer->chunk_size )
+        {
+            ssize_t ret = write( fd, chunk + done, buffer->chunk_size - done );
+            if ( ret < 0 && errno != EINTR )
+            {
+                success = false;
+                break;
+            }
+            done += ret < 0 ? 0 : ret;
+        }
+    }
+    close( fd );
+
+    buffer->ring_oldest = 0;
+    buffer->ring_fill   = 0;
+    return success;
+}
+
+
+/**
+ * Keeps the chunk OTF2 just filled in the ring of a buffer in flight recorder
+ * mode. If the ring is full, only its oldest chunk is overwritten. On a
+ * requested dump and at the end of the measurement, the ring is written to
+ * the trace.
+ */
+static void
+ring_keep_chunk( tracing_buffer* buffer,
+                 uint64_t        locationId,
+                 bool            final )
+{
+    uint32_t slot = ( buffer->ring_oldest + buffer->ring_fill ) % buffer->ring_capacity;
+    if ( buffer->ring_fill == buffer->ring_capacity )
+    {
+        buffer->ring_oldest = ( buffer->ring_oldest + 1 ) % buffer->ring_capacity;
+    }
+    else
+    {
+        buffer->ring_fill++;
+    }
+    memcpy( buffer->ring + ( uint64_t )slot * buffer->chunk_size, buffer->chunk, buffer->chunk_size );
+
+    /* Before the event files are opened, nothing can be written */
+    if ( !event_files_opened || locationId == OTF2_UNDEFINED_LOCATION )
+    {
+        return;
+    }
+    if ( !buffer->ring_file )
+    {
+        const char* dir    = SCOREP_GetExperimentDirName();
+        size_t      length = strlen( dir ) + sizeof( "/traces/.evt" ) + 20;
+        char*       file   = malloc( length );
+        UTILS_BUG_ON( !file, "Cannot allocate trace ring buffer file name." );
+        /* The event file of the location in the OTF2 archive */
+        snprintf( file, length, "%s/traces/%" PRIu64 ".evt", dir, locationId );
+        buffer->ring_file = file;
+    }
+
+    uint32_t requests =
+        UTILS_Atomic_LoadN_uint32( &ring_dump_requests, UTILS_ATOMIC_RELAXED );
+    if ( buffer->ring_dumps == requests && !final )
+    {
+        return;
+    }
+    buffer->ring_dumps = requests;
+    if ( !final )
+    {
+        SCOREP_Status_OnOtf2Flush();
+    }
+
+    UTILS_DEBUG_PRINTF( SCOREP_DEBUG_TRACING,
+                        "[%d]: dumping %" PRIu32 " trace ring buffer chunks\n",
+                        SCOREP_Status_GetRank(), buffer->ring_fill );
+    if ( !ring_write( buffer ) )
+    {
+        UTILS_ERROR_POSIX( "Cannot write trace ring buffer to '%s'", buffer->ring_file );
+    }
+}
+
+
 static OTF2_FlushType
 scorep_on_trace_pre_flush( void*         userData,
                            OTF2_FileType fileType,
@@ -125,7 +306,9 @@ scorep_on_trace_pre_flush( void*         userData,
                            void*         callerData,
                            bool          final )
 {
-    if ( fileType == OTF2_FILETYPE_EVENTS )
+    bool ring_mode = scorep_tracing_ring_size && fileType == OTF2_FILETYPE_EVENTS;
+
+    if ( fileType == OTF2_FILETYPE_EVENTS && !ring_mode )
     {
         if ( !event_files_opened )
         {
@@ -143,7 +326,7 @@ scorep_on_trace_pre_flush( void*         userData,
                         fileType == OTF2_FILETYPE_LOCAL_DEFS ? "Def" : "Evt",
                         fileType == OTF2_FILETYPE_GLOBAL_DEFS ? 0 : locationId );
 
-    if ( fileType == OTF2_FILETYPE_EVENTS && !final )
+    if ( fileType == OTF2_FILETYPE_EVENTS && !final && !ring_mode )
     {
         /* A buffer flush happen in an event buffer before the end of the measurement */
 
@@ -176,7 +359,16 @@ scorep_on_trace_pre_flush( void*         userData,
         UTILS_ASSERT( err == OTF2_SUCCESS && user_data );
 
         SCOREP_Location* location = ( SCOREP_Location* )user_data;
-        SCOREP_Location_EnsureGlobalId( location );
+        if ( ring_mode )
+        {
+            /* OTF2 drops the chunk, scorep_tracing_chunk_free_all() keeps a
+             * copy in the ring */
+            do_flush = OTF2_NO_FLUSH;
+        }
+        if ( do_flush == OTF2_FLUSH || ( ring_mode && event_files_opened ) )
+        {
+            SCOREP_Location_EnsureGlobalId( location );
+        }
         scorep_rewind_stack_delete( location );
     }
 
@@ -191,9 +383,25 @@ scorep_on_trace_post_flush( void*         userData,
 {
     uint64_t timestamp = SCOREP_Timer_GetClockTicks();
 
-    if ( fileType == OTF2_FILETYPE_EVENTS )
+    /* In flight recorder mode, the buffer flush record written by OTF2 marks
+     * the dropped or dumped events, the flush region is not entered. */
+    if ( fileType == OTF2_FILETYPE_EVENTS && !scorep_tracing_ring_size )
     {
-        SCOREP_OnTracingBufferFlushEnd( timestamp );
+        if ( event_writer_tasks )
+        {
+            for ( uint32_t i = 0; i < num_event_writer_tasks; i++ )
+            {
+                if ( event_writer_tasks[ i ].definition->global_location_id == locationId )
+                {
+                    event_writer_tasks[ i ].flush_end = timestamp;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            SCOREP_OnTracingBufferFlushEnd( timestamp );
+        }
     }
 
     return timestamp;
@@ -227,14 +435,47 @@ scorep_tracing_chunk_allocate( void*         userData,
 {
     UTILS_DEBUG_ENTRY( "chunk size: %" PRIu64, chunkSize );
 
-    if ( !*perBufferData )
+    tracing_buffer* buffer = *perBufferData;
+    if ( !buffer )
     {
+        buffer = calloc( 1, sizeof( *buffer ) );
+        UTILS_BUG_ON( !buffer, "Cannot allocate trace buffer data." );
         /* This manager has a pre-allocated page, which is much smaller
            than the chunksize, which is wasted now */
-        *perBufferData = SCOREP_Memory_CreateTracingPageManager( OTF2_FILETYPE_EVENTS == fileType );
+        buffer->page_manager = SCOREP_Memory_CreateTracingPageManager( OTF2_FILETYPE_EVENTS == fileType );
+        buffer->ring_dumps   = UTILS_Atomic_LoadN_uint32( &ring_dump_requests, UTILS_ATOMIC_RELAXED );
+        *perBufferData       = buffer;
     }
 
-    void* chunk = SCOREP_Allocator_Alloc( *perBufferData, chunkSize );
+    bool ring_mode = OTF2_FILETYPE_EVENTS == fileType && scorep_tracing_ring_size;
+    if ( ring_mode )
+    {
+        /* In flight recorder mode, refuse a second chunk, thus OTF2 flushes
+         * every filled chunk. ring_keep_chunk() then recycles only the
+         * oldest chunk of the ring. */
+        if ( buffer->chunk )
+        {
+            return NULL;
+        }
+        if ( !buffer->ring )
+        {
+            buffer->ring_capacity = scorep_tracing_ring_size / chunkSize;
+            buffer->ring          = malloc( ( uint64_t )buffer->ring_capacity * chunkSize );
+            UTILS_BUG_ON( !buffer->ring, "Cannot allocate trace ring buffer." );
+            buffer->chunk_size = chunkSize;
+
+            UTILS_MutexLock( &ring_buffers_lock );
+            buffer->ring_next = ring_buffers;
+            ring_buffers      = buffer;
+            UTILS_MutexUnlock( &ring_buffers_lock );
+        }
+    }
+
+    void* chunk = SCOREP_Allocator_Alloc( buffer->page_manager, chunkSize );
+    if ( ring_mode )
+    {
+        buffer->chunk = chunk;
+    }
 
     /* ignore allocation failures, OTF2 will flush and free chunks */
 #if HAVE( UTILS_DEBUG )
@@ -258,17 +499,38 @@ scorep_tracing_chunk_free_all( void*         userData,
     UTILS_DEBUG_ENTRY( "%s", final ? "final" : "intermediate" );
 
     /* maybe we were called without one allocate */
-    if ( !*perBufferData )
+    tracing_buffer* buffer = *perBufferData;
+    if ( !buffer )
     {
         return;
     }
 
+    if ( buffer->chunk )
+    {
+        ring_keep_chunk( buffer, locationId, final );
+        buffer->chunk = NULL;
+    }
+
     /* drop all used pages */
-    SCOREP_Allocator_Free( *perBufferData );
+    SCOREP_Allocator_Free( buffer->page_manager );
 
     if ( final )
     {
-        SCOREP_Memory_DeleteTracingPageManager( *perBufferData, OTF2_FILETYPE_EVENTS == fileType );
+        if ( buffer->ring )
+        {
+            UTILS_MutexLock( &ring_buffers_lock );
+            tracing_buffer** it = &ring_buffers;
+            while ( *it != buffer )
+            {
+                it = &( *it )->ring_next;
+            }
+            *it = buffer->ring_next;
+            UTILS_MutexUnlock( &ring_buffers_lock );
+            free( buffer->ring );
+            free( buffer->ring_file );
+        }
+        SCOREP_Memory_DeleteTracingPageManager( buffer->page_manager, OTF2_FILETYPE_EVENTS == fileType );
+        free( buffer );
         *perBufferData = NULL;
     }
 }
@@ -307,6 +569,54 @@ scorep_tracing_otf2_error_callback( void*          userData,
 #endif
 
 
+void
+SCOREP_Tracing_TriggerDump( void )
+{
+    UTILS_Atomic_AddFetch_uint32( &ring_dump_requests, 1, UTILS_ATOMIC_RELAXED );
+}
+
+
+static void
+ring_dump_signal_handler( int signum )
+{
+    SCOREP_Tracing_TriggerDump();
+}
+
+
+/* Signals which terminate the program abnormally, see
+ * SCOREP_TRACING_RING_DUMP_ON_ABORT */
+static const int ring_abort_signals[] = { SIGABRT, SIGBUS, SIGFPE, SIGILL, SIGSEGV };
+
+
+static void
+ring_abort_signal_handler( int signum )
+{
+    /* Finalizing the measurement is not async-signal-safe, it allocates
+     * memory, takes locks, and communicates. Only write the chunks the
+     * locations have already filled, without definitions. The chunks a
+     * location currently writes to are lost. */
+    if ( !UTILS_Atomic_ExchangeN_bool( &ring_aborting, true, UTILS_ATOMIC_SEQUENTIAL_CONSISTENT ) )
+    {
+        for ( tracing_buffer* buffer = ring_buffers; buffer; buffer = buffer->ring_next )
+        {
+            if ( buffer->ring_file && buffer->ring_fill )
+            {
+                ring_write( buffer );
+            }
+        }
+    }
+
+    struct sigaction action;
+    memset( &action, 0, sizeof( action ) );
+    action.sa_handler = SIG_DFL;
+    sigemptyset( &action.sa_mask );
+    sigaction( signum, &action, NULL );
+
+    /* Delivered with the default action after this handler returns */
+    raise( signum );
+}
+
+
 void
 SCOREP_Tracing_Initialize( size_t substrateId )
 {
@@ -334,10 +644,23 @@ SCOREP_Tracing_Initialize( size_t substrateId )
             scorep_tracing_max_procs_per_sion_file );
     }
 
+    uint64_t event_chunk_size = SCOREP_TRACING_CHUNK_SIZE;
+    if ( scorep_tracing_ring_size )
+    {
+        event_chunk_size = SCOREP_TRACING_RING_CHUNK_SIZE;
+#if HAVE( OTF2_SUBSTRATE_SION )
+        if ( scorep_tracing_use_sion )
+        {
+            UTILS_WARNING( "SCOREP_TRACING_USE_SION is not supported together with "
+                           "SCOREP_TRACING_RING_SIZE, using one file per location." );
+        }
+#endif
+    }
+
     scorep_otf2_archive = OTF2_Archive_Open( SCOREP_GetExperimentDirName(),
                                              "traces",
                                              OTF2_FILEMODE_WRITE,
-                                             SCOREP_TRACING_CHUNK_SIZE,
+                                             event_chunk_size,
                                              OTF2_UNDEFINED_UINT64,
                                              scorep_tracing_get_file_substrate(),
                                              OTF2_COMPRESSION_NONE );
@@ -360,6 +683,71 @@ SCOREP_Tracing_Initialize( size_t substrateId )
     }
 
     tracing_init_attributes();
+
+    scorep_tracing_min_duration_ticks = 0;
+    if ( scorep_tracing_min_duration )
+    {
+        scorep_tracing_min_duration_ticks =
+            ( double )scorep_tracing_min_duration * SCOREP_Timer_GetClockResolutionEstimate() / 1e9;
+        if ( 0 == scorep_tracing_min_duration_ticks )
+        {
+            scorep_tracing_min_duration_ticks = 1;
+        }
+    }
+
+    scorep_tracing_ring_dump_threshold_ticks = 0;
+    if ( scorep_tracing_ring_size )
+    {
+        if ( scorep_tracing_ring_size < SCOREP_TRACING_RING_CHUNK_SIZE )
+        {
+            UTILS_WARNING( "SCOREP_TRACING_RING_SIZE is smaller than the trace "
+                           "chunk size, using %d bytes.", SCOREP_TRACING_RING_CHUNK_SIZE );
+            scorep_tracing_ring_size = SCOREP_TRACING_RING_CHUNK_SIZE;
+        }
+
+        if ( scorep_tracing_ring_dump_threshold )
+        {
+            scorep_tracing_ring_dump_threshold_ticks =
+                ( double )scorep_tracing_ring_dump_threshold * SCOREP_Timer_GetClockResolutionEstimate() / 1e9;
+            if ( 0 == scorep_tracing_ring_dump_threshold_ticks )
+            {
+                scorep_tracing_ring_dump_threshold_ticks = 1;
+            }
+        }
+
+        if ( scorep_tracing_ring_dump_signal )
+        {
+            struct sigaction action;
+            memset( &action, 0, sizeof( action ) );
+            action.sa_handler = ring_dump_signal_handler;
+            action.sa_flags   = SA_RESTART;
+            sigemptyset( &action.sa_mask );
+            if ( sigaction( ( int )scorep_tracing_ring_dump_signal, &action, NULL ) != 0 )
+            {
+                UTILS_WARNING( "Cannot install handler for SCOREP_TRACING_RING_DUMP_SIGNAL=%" PRIu64 ".",
+                               scorep_tracing_ring_dump_signal );
+            }
+        }
+
+        if ( scorep_tracing_ring_dump_on_abort )
+        {
+            struct sigaction action;
+            memset( &action, 0, sizeof( action ) );
+            action.sa_handler = ring_abort_signal_handler;
+            action.sa_flags   = SA_RESETHAND;
+            sigemptyset( &action.sa_mask );
+            for ( size_t i = 0; i < sizeof( ring_abort_signals ) / sizeof( ring_abort_signals[ 0 ] ); i++ )
+            {
+                /* Do not replace handlers of the application */
+                struct sigaction old_action;
+                if ( sigaction( ring_abort_signals[ i ], NULL, &old_action ) == 0
+                     && old_action.sa_handler == SIG_DFL )
+                {
+                    sigaction( ring_abort_signals[ i ], &action, NULL );
+                }
+            }
+        }
+    }
 }
 
 
@@ -417,6 +805,51 @@ SCOREP_Tracing_GetEventWriter( void )
 }
 
 
+static void
+add_rewound_regions_properties( SCOREP_Location*    locationData,
+                                SCOREP_TracingData* tracingData )
+{
+    static const char prefix[] = "TRACING_MIN_DURATION::";
+
+    for ( uint32_t i = 0; i < tracingData->rewound_regions_capacity; i++ )
+    {
+        scorep_tracing_rewound_region* rewound_region = &tracingData->rewound_regions[ i ];
+        if ( rewound_region->visits == 0 )
+        {
+            continue;
+        }
+
+        const char* region_name = SCOREP_RegionHandle_GetName( rewound_region->region );
+        size_t      name_length = sizeof( prefix ) + strlen( region_name );
+        char*       name        = malloc( name_length );
+        UTILS_ASSERT( name );
+        snprintf( name, name_length, "%s%s", prefix, region_name );
+
+        /* two 20-digit numbers plus the keys */
+        SCOREP_Location_AddLocationProperty( locationData, name, 64,
+                                             "visits=%" PRIu64 ";ticks=%" PRIu64,
+                                             rewound_region->visits,
+                                             rewound_region->duration );
+        free( name );
+    }
+}
+
+
+/* Returns the pool which finalizes the files of @a numLocations locations,
+ * or NULL if they shall be written one after another. */
+static SCOREP_WorkerPool*
+create_finalize_workers( uint32_t numLocations )
+{
+    /* With SIONlib, all locations of a process share one file */
+    if ( scorep_tracing_get_file_substrate() != OTF2_SUBSTRATE_POSIX )
+    {
+        return NULL;
+    }
+    return SCOREP_WorkerPool_Create( scorep_tracing_finalize_threads,
+                                     numLocations );
+}
+
+
 static bool
 scorep_trace_finalize_event_writer_cb( SCOREP_Location* locationData,
                                        void*            userData )
@@ -438,18 +871,37 @@ scorep_trace_finalize_event_writer_cb( SCOREP_Location* locationData,
     /* update number of events */
     location_definition->number_of_events = number_of_events;
 
-    /* close the event writer */
+    /* store the aggregates of the minimum-duration filter, this creates
+     * definitions, thus it is not done by the worker threads */
+    add_rewound_regions_properties( locationData, tracing_data );
+
+    event_writer_task* task = &event_writer_tasks[ num_event_writer_tasks++ ];
+    task->location   = locationData;
+    task->definition = location_definition;
+    task->flush_end  = 0;
+
+    return false;
+}
+
+
+static void
+close_event_writer( uint32_t index,
+                    void*    arg )
+{
+    event_writer_task*  task         = &event_writer_tasks[ index ];
+    SCOREP_TracingData* tracing_data = scorep_tracing_get_trace_data( task->location );
+
+    /* close the event writer, this flushes the remaining events */
     OTF2_ErrorCode ret = OTF2_Archive_CloseEvtWriter( scorep_otf2_archive,
                                                       tracing_data->otf_writer );
     if ( OTF2_SUCCESS != ret )
     {
         UTILS_FATAL( "Could not finalize OTF2 event writer %" PRIu64 ": %s",
-                     location_definition->global_location_id,
+                     task->definition->global_location_id,
                      OTF2_Error_GetDescription( ret ) );
     }
 
     tracing_data->otf_writer = NULL;
-    return false;
 }
 
 
@@ -458,9 +910,39 @@ SCOREP_Tracing_FinalizeEventWriters( void )
 {
     UTILS_ASSERT( scorep_otf2_archive );
 
+    uint32_t num_locations = SCOREP_Location_GetCountOfLocations();
+    event_writer_tasks = calloc( num_locations ? num_locations : 1,
+                                 sizeof( *event_writer_tasks ) );
+    UTILS_ASSERT( event_writer_tasks );
+    num_event_writer_tasks = 0;
+
     SCOREP_Location_ForAll( scorep_trace_finalize_event_writer_cb,
                             NULL );
 
+    SCOREP_WorkerPool* workers = create_finalize_workers( num_event_writer_tasks );
+    SCOREP_WorkerPool_ParallelFor( workers, num_event_writer_tasks,
+                                   close_event_writer, NULL );
+    SCOREP_WorkerPool_Destroy( workers );
+
+    /* Report the final flushes in the order of the locations, with
+     * non-decreasing timestamps */
+    event_writer_task* tasks     = event_writer_tasks;
+    uint64_t           timestamp = 0;
+    event_writer_tasks = NULL;
+    for ( uint32_t i = 0; i < num_event_writer_tasks; i++ )
+    {
+        if ( tasks[ i ].flush_end != 0 )
+        {
+            if ( tasks[ i ].flush_end > timestamp )
+            {
+                timestamp = tasks[ i ].flush_end;
+            }
+            SCOREP_OnTracingBufferFlushEnd( timestamp );
+        }
+    }
+    free( tasks );
+    num_event_writer_tasks = 0;
+
     OTF2_ErrorCode err = OTF2_Archive_CloseEvtFiles( scorep_otf2_archive );
     if ( OTF2_SUCCESS != err )
     {
@@ -470,6 +952,36 @@ SCOREP_Tracing_FinalizeEventWriters( void )
 }
 
 
+static void
+write_local_definitions( uint32_t index,
+                         void*    arg )
+{
+    SCOREP_LocationDef** locations  = arg;
+    SCOREP_LocationDef*  definition = locations[ index ];
+
+    OTF2_DefWriter* local_definition_writer = OTF2_Archive_GetDefWriter(
+        scorep_otf2_archive,
+        definition->global_location_id );
+    if ( !local_definition_writer )
+    {
+        /* aborts */
+        SCOREP_Memory_HandleOutOfMemory();
+    }
+
+    scorep_tracing_write_mappings( local_definition_writer );
+    scorep_tracing_write_clock_offsets( local_definition_writer );
+    scorep_tracing_write_local_definitions( local_definition_writer );
+
+    OTF2_ErrorCode ret = OTF2_Archive_CloseDefWriter( scorep_otf2_archive,
+                                                      local_definition_writer );
+    if ( OTF2_SUCCESS != ret )
+    {
+        UTILS_FATAL( "Could not finalize OTF2 definition writer: %s",
+                     OTF2_Error_GetDescription( ret ) );
+    }
+}
+
+
 static void
 write_definitions( void )
 {
@@ -507,30 +1019,22 @@ write_definitions( void )
         UTILS_FATAL( "Could not open OTF2 definition files: %s",
                      OTF2_Error_GetDescription( ret ) );
     }
+    uint32_t             num_locations = scorep_local_definition_manager.location.counter;
+    SCOREP_LocationDef** locations     = calloc( num_locations ? num_locations : 1,
+                                                 sizeof( *locations ) );
+    UTILS_ASSERT( locations );
+    uint32_t i = 0;
     SCOREP_DEFINITIONS_MANAGER_FOREACH_DEFINITION_BEGIN( &scorep_local_definition_manager, Location, location )
     {
-        OTF2_DefWriter* local_definition_writer = OTF2_Archive_GetDefWriter(
-            scorep_otf2_archive,
-            definition->global_location_id );
-        if ( !local_definition_writer )
-        {
-            /* aborts */
-            SCOREP_Memory_HandleOutOfMemory();
-        }
-
-        scorep_tracing_write_mappings( local_definition_writer );
-        scorep_tracing_write_clock_offsets( local_definition_writer );
-        scorep_tracing_write_local_definitions( local_definition_writer );
-
-        ret = OTF2_Archive_CloseDefWriter( scorep_otf2_archive,
-                                           local_definition_writer );
-        if ( OTF2_SUCCESS != ret )
-        {
-            UTILS_FATAL( "Could not finalize OTF2 definition writer: %s",
-                         OTF2_Error_GetDescription( ret ) );
-        }
+        locations[ i++ ] = definition;
     }
     SCOREP_DEFINITIONS_MANAGER_FOREACH_DEFINITION_END();
+
+    SCOREP_WorkerPool* workers = create_finalize_workers( i );
+    SCOREP_WorkerPool_ParallelFor( workers, i, write_local_definitions, locations );
+    SCOREP_WorkerPool_Destroy( workers );
+    free( locations );
+
     ret = OTF2_Archive_CloseDefFiles( scorep_otf2_archive );
     if ( OTF2_SUCCESS != ret )
     {
@@ -86,5 +86,15 @@ SCOREP_Tracing_FinalizeEventWriters( void );
 void
 SCOREP_Tracing_Write( void );
 
+/**
+ *  Requests a dump of the trace ring buffers of all locations, if the
+ *  flight recorder mode is active. Each location flushes its ring buffer
+ *  the next time it is full, instead of dropping it.
+ *
+ *  Async-signal-safe.
+ */
+void
+SCOREP_Tracing_TriggerDump( void );
+
 
 #endif /* SCOREP_TRACING_H */
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2013, 2015-2018, 2020, 2022,
+ * Copyright (c) 2009-2013, 2015-2018, 2020, 2022, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -49,6 +49,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 
 #include <UTILS_Error.h>
@@ -135,6 +136,9 @@ disable_recording( SCOREP_Location*    location,
                                      timestamp,
                                      OTF2_MEASUREMENT_OFF );
 
+    /* Region instances with a gap must not be removed by the minimum-duration filter */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_MEASUREMENT_ON_OFF );
+
     /* flush the attribute list for this location */
     OTF2_AttributeList_RemoveAllAttributes( tracing_data->otf_attribute_list );
 }
@@ -266,6 +270,193 @@ leave( SCOREP_Location*    location,
 }
 
 
+/**
+ * Rewind points of the minimum-duration filter are identified by their
+ * nesting depth, counting down from UINT32_MAX to not collide with the
+ * region ids used by user rewind regions.
+ */
+#define MIN_DURATION_REWIND_ID( depth ) ( UINT32_MAX - ( depth ) )
+
+
+static void
+add_rewound_region( SCOREP_TracingData* tracingData,
+                    SCOREP_Location*    location,
+                    SCOREP_RegionHandle regionHandle,
+                    uint64_t            duration )
+{
+    uint32_t region_id = SCOREP_LOCAL_HANDLE_TO_ID( regionHandle, Region );
+    if ( region_id >= tracingData->rewound_regions_capacity )
+    {
+        uint32_t capacity = tracingData->rewound_regions_capacity ? tracingData->rewound_regions_capacity : 64;
+        while ( capacity <= region_id )
+        {
+            capacity *= 2;
+        }
+
+        scorep_tracing_rewound_region* rewound_regions =
+            SCOREP_Location_AllocForMisc( location,
+                                          capacity * sizeof( *rewound_regions ) );
+        memset( rewound_regions, 0, capacity * sizeof( *rewound_regions ) );
+        if ( tracingData->rewound_regions )
+        {
+            memcpy( rewound_regions,
+                    tracingData->rewound_regions,
+                    tracingData->rewound_regions_capacity * sizeof( *rewound_regions ) );
+        }
+        tracingData->rewound_regions          = rewound_regions;
+        tracingData->rewound_regions_capacity = capacity;
+    }
+
+    scorep_tracing_rewound_region* rewound_region = &tracingData->rewound_regions[ region_id ];
+    rewound_region->region = regionHandle;
+    rewound_region->visits++;
+    rewound_region->duration += duration;
+}
+
+
+/**
+ * Removes the current region instance from the trace buffer, if it is shorter
+ * than SCOREP_TRACING_MIN_DURATION and did not contain any events which
+ * must be kept.
+ *
+ * @return True if the region instance was removed, i.e., the leave event
+ *         must not be written.
+ */
+static bool
+rewind_short_region( SCOREP_Location*    location,
+                     uint64_t            timestamp,
+                     SCOREP_RegionHandle regionHandle )
+{
+    SCOREP_TracingData* tracing_data = scorep_tracing_get_trace_data( location );
+
+    if ( tracing_data->min_duration_depth == 0 )
+    {
+        return false;
+    }
+    uint32_t id = MIN_DURATION_REWIND_ID( --tracing_data->min_duration_depth );
+
+    /* The rewind point is gone after a buffer flush or when an enclosing
+     * user rewind region was left */
+    if ( !tracing_data->rewind_stack || tracing_data->rewind_stack->id != id )
+    {
+        return false;
+    }
+
+    uint32_t id_pop;
+    uint64_t entertimestamp;
+    bool     paradigm_affected[ SCOREP_REWIND_PARADIGM_MAX ];
+    scorep_rewind_stack_pop( location, &id_pop, &entertimestamp, paradigm_affected );
+
+    bool do_rewind = timestamp - entertimestamp < scorep_tracing_min_duration_ticks;
+    for ( int i = 0; do_rewind && i < SCOREP_REWIND_PARADIGM_MAX; i++ )
+    {
+        do_rewind = !paradigm_affected[ i ];
+    }
+
+    if ( do_rewind )
+    {
+        OTF2_EvtWriter_Rewind( tracing_data->otf_writer, id );
+        add_rewound_region( tracing_data, location, regionHandle, timestamp - entertimestamp );
+    }
+    OTF2_EvtWriter_ClearRewindPoint( tracing_data->otf_writer, id );
+
+    return do_rewind;
+}
+
+
+/**
+ * Requests a dump of the trace ring buffers when a region instance lasted
+ * longer than SCOREP_TRACING_RING_DUMP_THRESHOLD.
+ */
+static void
+ring_dump_on_enter( SCOREP_Location* location,
+                    uint64_t         timestamp )
+{
+    SCOREP_TracingData* tracing_data = scorep_tracing_get_trace_data( location );
+    if ( tracing_data->ring_depth == tracing_data->ring_enter_timestamps_capacity )
+    {
+        uint32_t  capacity   = tracing_data->ring_depth ? 2 * tracing_data->ring_depth : 64;
+        uint64_t* timestamps =
+            SCOREP_Location_AllocForMisc( location, capacity * sizeof( *timestamps ) );
+        if ( tracing_data->ring_enter_timestamps )
+        {
+            memcpy( timestamps,
+                    tracing_data->ring_enter_timestamps,
+                    tracing_data->ring_depth * sizeof( *timestamps ) );
+        }
+        tracing_data->ring_enter_timestamps          = timestamps;
+        tracing_data->ring_enter_timestamps_capacity = capacity;
+    }
+    tracing_data->ring_enter_timestamps[ tracing_data->ring_depth++ ] = timestamp;
+}
+
+
+static void
+ring_dump_on_leave( SCOREP_Location* location,
+                    uint64_t         timestamp )
+{
+    SCOREP_TracingData* tracing_data = scorep_tracing_get_trace_data( location );
+    if ( tracing_data->ring_depth == 0 )
+    {
+        return;
+    }
+
+    uint64_t enter_timestamp = tracing_data->ring_enter_timestamps[ --tracing_data->ring_depth ];
+    if ( timestamp - enter_timestamp >= scorep_tracing_ring_dump_threshold_ticks )
+    {
+        SCOREP_Tracing_TriggerDump();
+    }
+}
+
+
+static void
+enter_region( SCOREP_Location*    location,
+              uint64_t            timestamp,
+              SCOREP_RegionHandle regionHandle,
+              uint64_t*           metricValues )
+{
+    if ( scorep_tracing_ring_dump_threshold_ticks )
+    {
+        ring_dump_on_enter( location, timestamp );
+    }
+
+    if ( scorep_tracing_min_duration_ticks )
+    {
+        SCOREP_TracingData* tracing_data = scorep_tracing_get_trace_data( location );
+        uint32_t            id           = MIN_DURATION_REWIND_ID( tracing_data->min_duration_depth++ );
+
+        /* The rewind point also covers the metrics written with the enter.
+         * The id is unique on the stack, as it is consumed by the leave of
+         * this region, thus skip the search. */
+        OTF2_EvtWriter_StoreRewindPoint( tracing_data->otf_writer, id );
+        scorep_rewind_stack_push_unique( location, id, timestamp );
+    }
+
+    enter( location, timestamp, regionHandle, metricValues );
+}
+
+
+static void
+leave_region( SCOREP_Location*    location,
+              uint64_t            timestamp,
+              SCOREP_RegionHandle regionHandle,
+              uint64_t*           metricValues )
+{
+    if ( scorep_tracing_ring_dump_threshold_ticks )
+    {
+        ring_dump_on_leave( location, timestamp );
+    }
+
+    if ( scorep_tracing_min_duration_ticks
+         && rewind_short_region( location, timestamp, regionHandle ) )
+    {
+        return;
+    }
+
+    leave( location, timestamp, regionHandle, metricValues );
+}
+
+
 static void
 calling_context_enter( SCOREP_Location*            location,
                        uint64_t                    timestamp,
@@ -823,9 +1014,7 @@ rma_win_create( SCOREP_Location*       location,
                                  timestamp,
                                  SCOREP_LOCAL_HANDLE_TO_ID( windowHandle, RmaWindow ) );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -841,9 +1030,7 @@ rma_win_destroy( SCOREP_Location*       location,
                                   timestamp,
                                   SCOREP_LOCAL_HANDLE_TO_ID( windowHandle, RmaWindow ) );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -858,9 +1045,7 @@ rma_collective_begin( SCOREP_Location*    location,
                                        NULL,
                                        timestamp );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -886,9 +1071,7 @@ rma_collective_end( SCOREP_Location*       location,
                                      bytesSent,
                                      bytesReceived );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -908,9 +1091,7 @@ rma_group_sync( SCOREP_Location*       location,
                                  SCOREP_LOCAL_HANDLE_TO_ID( windowHandle, RmaWindow ),
                                  SCOREP_LOCAL_HANDLE_TO_ID( groupHandle, Group ) );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -942,9 +1123,7 @@ rma_request_lock( SCOREP_Location*       location,
                                    lockId,
                                    scorep_tracing_lock_type_to_otf2( lockType ) );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -976,9 +1155,7 @@ rma_acquire_lock( SCOREP_Location*       location,
                                    lockId,
                                    scorep_tracing_lock_type_to_otf2( lockType ) );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -1010,9 +1187,7 @@ rma_try_lock( SCOREP_Location*       location,
                                lockId,
                                scorep_tracing_lock_type_to_otf2( lockType ) );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -1042,9 +1217,7 @@ rma_release_lock( SCOREP_Location*       location,
                                    remote_rank,
                                    lockId );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -1064,9 +1237,7 @@ rma_sync( SCOREP_Location*       location,
                             remote,
                             scorep_tracing_rma_sync_type_to_otf2( syncType ) );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -1082,9 +1253,7 @@ rma_wait_change( SCOREP_Location*       location,
                                   timestamp,
                                   SCOREP_LOCAL_HANDLE_TO_ID( windowHandle, RmaWindow ) );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -1106,9 +1275,7 @@ rma_put( SCOREP_Location*       location,
                            bytes,
                            matchingId );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -1130,9 +1297,7 @@ rma_get( SCOREP_Location*       location,
                            bytes,
                            matchingId );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -1158,9 +1323,7 @@ rma_atomic( SCOREP_Location*       location,
                               bytesReceived,
                               matchingId );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -1178,9 +1341,7 @@ rma_op_complete_blocking( SCOREP_Location*       location,
                                           SCOREP_LOCAL_HANDLE_TO_ID( windowHandle, RmaWindow ),
                                           matchingId );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -1198,9 +1359,7 @@ rma_op_complete_non_blocking( SCOREP_Location*       location,
                                              SCOREP_LOCAL_HANDLE_TO_ID( windowHandle, RmaWindow ),
                                              matchingId );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -1218,9 +1377,7 @@ rma_op_test( SCOREP_Location*       location,
                               SCOREP_LOCAL_HANDLE_TO_ID( windowHandle, RmaWindow ),
                               matchingId );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -1238,9 +1395,7 @@ rma_op_complete_remote( SCOREP_Location*       location,
                                         SCOREP_LOCAL_HANDLE_TO_ID( windowHandle, RmaWindow ),
                                         matchingId );
 
-    /*
-     * scorep_rewind_set_affected_paradigm ?
-     */
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_RMA );
 }
 
 
@@ -1263,6 +1418,8 @@ io_create_handle( SCOREP_Location*      location,
                                    scorep_tracing_io_access_mode_to_otf2( mode ),
                                    scorep_tracing_io_creation_flags_to_otf2( creationFlags ),
                                    scorep_tracing_io_status_flags_to_otf2( statusFlags ) );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1279,6 +1436,8 @@ io_destroy_handle( SCOREP_Location*      location,
                                     attribute_list,
                                     timestamp,
                                     SCOREP_LOCAL_HANDLE_TO_ID( handle, IoHandle ) );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1299,6 +1458,8 @@ io_duplicate_handle( SCOREP_Location*      location,
                                       SCOREP_LOCAL_HANDLE_TO_ID( oldHandle, IoHandle ),
                                       SCOREP_LOCAL_HANDLE_TO_ID( newHandle, IoHandle ),
                                       scorep_tracing_io_status_flags_to_otf2( statusFlags ) );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1321,6 +1482,8 @@ io_seek( SCOREP_Location*      location,
                            offsetRequest,
                            scorep_tracing_io_seek_option_to_otf2( whence ),
                            offsetResult );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1339,6 +1502,8 @@ io_change_status_flags( SCOREP_Location*      location,
                                         timestamp,
                                         SCOREP_LOCAL_HANDLE_TO_ID( handle, IoHandle ),
                                         scorep_tracing_io_status_flags_to_otf2( statusFlags ) );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1357,6 +1522,8 @@ io_delete_file( SCOREP_Location*      location,
                                  timestamp,
                                  SCOREP_IoMgmt_GetParadigmId( ioParadigm ),
                                  SCOREP_LOCAL_HANDLE_TO_ID( ioFile, IoFile ) );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1392,6 +1559,8 @@ io_operation_begin( SCOREP_Location*       location,
                                      scorep_tracing_io_operation_flag_to_otf2( operationFlags ),
                                      bytesRequest,
                                      matchingId );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1410,6 +1579,8 @@ io_operation_issued( SCOREP_Location*      location,
                                       timestamp,
                                       SCOREP_LOCAL_HANDLE_TO_ID( handle, IoHandle ),
                                       matchingId );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1428,6 +1599,8 @@ io_operation_test( SCOREP_Location*      location,
                                     timestamp,
                                     SCOREP_LOCAL_HANDLE_TO_ID( handle, IoHandle ),
                                     matchingId );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1454,6 +1627,8 @@ io_operation_complete( SCOREP_Location*       location,
                                         SCOREP_LOCAL_HANDLE_TO_ID( handle, IoHandle ),
                                         bytesResult,
                                         matchingId );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1472,6 +1647,8 @@ io_operation_cancelled( SCOREP_Location*      location,
                                          timestamp,
                                          SCOREP_LOCAL_HANDLE_TO_ID( handle, IoHandle ),
                                          matchingId );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1490,6 +1667,8 @@ io_acquire_lock( SCOREP_Location*      location,
                                   timestamp,
                                   SCOREP_LOCAL_HANDLE_TO_ID( handle, IoHandle ),
                                   scorep_tracing_lock_type_to_otf2( lockType ) );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1508,6 +1687,8 @@ io_release_lock( SCOREP_Location*      location,
                                   timestamp,
                                   SCOREP_LOCAL_HANDLE_TO_ID( handle, IoHandle ),
                                   scorep_tracing_lock_type_to_otf2( lockType ) );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -1526,6 +1707,8 @@ io_try_lock( SCOREP_Location*      location,
                               timestamp,
                               SCOREP_LOCAL_HANDLE_TO_ID( handle, IoHandle ),
                               scorep_tracing_lock_type_to_otf2( lockType ) );
+
+    scorep_rewind_set_affected_paradigm( location, SCOREP_REWIND_PARADIGM_IO );
 }
 
 
@@ -2150,8 +2333,8 @@ const static SCOREP_Substrates_Callback substrate_callbacks[ SCOREP_SUBSTRATES_N
     {
         SCOREP_ASSIGN_SUBSTRATE_CALLBACK( ProgramBegin,                      PROGRAM_BEGIN,                         program_begin ),
         SCOREP_ASSIGN_SUBSTRATE_CALLBACK( ProgramEnd,                        PROGRAM_END,                           program_end ),
-        SCOREP_ASSIGN_SUBSTRATE_CALLBACK( EnterRegion,                       ENTER_REGION,                          enter ),
-        SCOREP_ASSIGN_SUBSTRATE_CALLBACK( ExitRegion,                        EXIT_REGION,                           leave ),
+        SCOREP_ASSIGN_SUBSTRATE_CALLBACK( EnterRegion,                       ENTER_REGION,                          enter_region ),
+        SCOREP_ASSIGN_SUBSTRATE_CALLBACK( ExitRegion,                        EXIT_REGION,                           leave_region ),
         SCOREP_ASSIGN_SUBSTRATE_CALLBACK( Sample,                            SAMPLE,                                sample ),
         SCOREP_ASSIGN_SUBSTRATE_CALLBACK( CallingContextEnter,               CALLING_CONTEXT_ENTER,                 calling_context_enter ),
         SCOREP_ASSIGN_SUBSTRATE_CALLBACK( CallingContextExit,                CALLING_CONTEXT_EXIT,                  calling_context_leave ),
@@ -64,10 +64,16 @@ SCOREP_Tracing_CreateLocationData( SCOREP_Location* locationData )
     SCOREP_TracingData* new_data
         = SCOREP_Location_AllocForMisc( locationData, sizeof( *new_data ) );
 
-    new_data->otf_writer         = 0;
-    new_data->rewind_stack       = 0;
-    new_data->rewind_free_list   = 0;
-    new_data->otf_attribute_list = OTF2_AttributeList_New();
+    new_data->otf_writer                     = 0;
+    new_data->rewind_stack                   = 0;
+    new_data->rewind_free_list               = 0;
+    new_data->min_duration_depth             = 0;
+    new_data->rewound_regions                = NULL;
+    new_data->rewound_regions_capacity       = 0;
+    new_data->ring_enter_timestamps          = NULL;
+    new_data->ring_depth                     = 0;
+    new_data->ring_enter_timestamps_capacity = 0;
+    new_data->otf_attribute_list             = OTF2_AttributeList_New();
     UTILS_BUG_ON( NULL == new_data->otf_attribute_list,
                   "Couldn't create event attribute list." );
 
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2014, 2019,
+ * Copyright (c) 2009-2014, 2019, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -75,6 +75,37 @@ scorep_rewind_stack_find( SCOREP_Location* location,
 }
 
 
+/**
+ * Push the id with it's timestamp on top of the stack, without searching
+ * for a previous entry of this id.
+ */
+void
+scorep_rewind_stack_push_unique( SCOREP_Location* location,
+                                 uint32_t         id,
+                                 uint64_t         entertimestamp )
+{
+    SCOREP_TracingData*  tracing_data = scorep_tracing_get_trace_data( location );
+    scorep_rewind_stack* stack_item   = tracing_data->rewind_free_list;
+    if ( stack_item )
+    {
+        tracing_data->rewind_free_list = stack_item->prev;
+    }
+    else
+    {
+        stack_item = SCOREP_Location_AllocForMisc( location,
+                                                   sizeof( *stack_item ) );
+    }
+    stack_item->id             = id;
+    stack_item->entertimestamp = entertimestamp;
+    for ( int i = 0; i < SCOREP_REWIND_PARADIGM_MAX; i++ )
+    {
+        stack_item->paradigm_affected[ i ] = false;
+    }
+    stack_item->prev           = tracing_data->rewind_stack;
+    tracing_data->rewind_stack = stack_item;
+}
+
+
 /**
  * Save the id of the rewind region handle with it's timestamp on the stack.
  * It's not a real stack, the elements are unique, no multiple id is allowed.
@@ -93,9 +124,14 @@ scorep_rewind_stack_push( SCOREP_Location* location,
     /* If the id was stored before, then */
     if ( scorep_rewind_stack_find( location, id ) )
     {
-        /* Search for the id in the stack */
+        /* Search for the id in the stack. The paradigm flags of the entries
+         * above it also apply to it, see scorep_rewind_set_affected_paradigm() */
         while ( stack_item && stack_item->id != id )
         {
+            for ( int i = 0; i < SCOREP_REWIND_PARADIGM_MAX; i++ )
+            {
+                stack_item->prev->paradigm_affected[ i ] |= stack_item->paradigm_affected[ i ];
+            }
             last_stack_item = stack_item;
             stack_item      = stack_item->prev;
         }
@@ -113,24 +149,8 @@ scorep_rewind_stack_push( SCOREP_Location* location,
     else
     {
         /* else, push the new id on top of the stack */
-        stack_item = tracing_data->rewind_free_list;
-        if ( stack_item )
-        {
-            tracing_data->rewind_free_list = stack_item->prev;
-        }
-        else
-        {
-            stack_item = SCOREP_Location_AllocForMisc( location,
-                                                       sizeof( *stack_item ) );
-        }
-        stack_item->id             = id;
-        stack_item->entertimestamp = entertimestamp;
-        for ( int i = 0; i < SCOREP_REWIND_PARADIGM_MAX; i++ )
-        {
-            stack_item->paradigm_affected[ i ] = false;
-        }
-        stack_item->prev = stack_head;
-        stack_head       = stack_item;
+        scorep_rewind_stack_push_unique( location, id, entertimestamp );
+        return;
     }
 
     tracing_data->rewind_stack = stack_head;
@@ -162,6 +182,16 @@ scorep_rewind_stack_pop( SCOREP_Location* location,
         stack_item = stack_head;
         stack_head = stack_head->prev;
 
+        /* The enclosing entry inherits the flags, see
+         * scorep_rewind_set_affected_paradigm() */
+        if ( stack_head )
+        {
+            for ( int i = 0; i < SCOREP_REWIND_PARADIGM_MAX; i++ )
+            {
+                stack_head->paradigm_affected[ i ] |= stack_item->paradigm_affected[ i ];
+            }
+        }
+
         stack_item->prev               = tracing_data->rewind_free_list;
         tracing_data->rewind_free_list = stack_item;
     }
@@ -194,20 +224,19 @@ scorep_rewind_stack_delete( SCOREP_Location* location )
 }
 
 /**
- * Set paradigm event flag for all current rewind regions.
+ * Set paradigm event flag for all current rewind regions. Only the top entry
+ * is flagged, scorep_rewind_stack_pop() passes the flags on to the enclosing
+ * entry. Thus, an entry is affected if it or any entry above it is flagged.
  */
 void
 scorep_rewind_set_affected_paradigm( SCOREP_Location* location, SCOREP_Rewind_Paradigm paradigm )
 {
     UTILS_ASSERT( paradigm < SCOREP_REWIND_PARADIGM_MAX );
 
-    SCOREP_TracingData*  tracing_data = scorep_tracing_get_trace_data( location );
-    scorep_rewind_stack* stack_item   = tracing_data->rewind_stack;
-
-    while ( stack_item )
+    scorep_rewind_stack* stack_head =
+        scorep_tracing_get_trace_data( location )->rewind_stack;
+    if ( stack_head )
     {
-        stack_item->paradigm_affected[ paradigm ] = true;
-
-        stack_item = stack_item->prev;
+        stack_head->paradigm_affected[ paradigm ] = true;
     }
 }
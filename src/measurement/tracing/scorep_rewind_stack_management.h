@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2013,
+ * Copyright (c) 2009-2013, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -56,6 +56,9 @@ typedef enum
     SCOREP_REWIND_PARADIGM_THREAD_FORK_JOIN,
     SCOREP_REWIND_PARADIGM_THREAD_CREATE_WAIT,
     SCOREP_REWIND_PARADIGM_THREAD_LOCKING,
+    SCOREP_REWIND_PARADIGM_RMA,
+    SCOREP_REWIND_PARADIGM_IO,
+    SCOREP_REWIND_PARADIGM_MEASUREMENT_ON_OFF,
     SCOREP_REWIND_PARADIGM_MAX
 } SCOREP_Rewind_Paradigm;
 
@@ -102,6 +105,21 @@ scorep_rewind_stack_push( SCOREP_Location* location,
                           uint64_t         entertimestamp );
 
 
+/**
+ * Push the id with it's timestamp on top of the stack, without searching the
+ * stack for this id first. The caller guarantees that the id is not on the
+ * stack, e.g., as it is derived from the current nesting depth.
+ *
+ * @param  location         Location where to push the id.
+ * @param  id               The identification number of the rewind region.
+ * @param  entertimestamp   Time stamp, when the rewind region was entered.
+ */
+void
+scorep_rewind_stack_push_unique( SCOREP_Location* location,
+                                 uint32_t         id,
+                                 uint64_t         entertimestamp );
+
+
 /**
  * Removes the head element from the stack and returns the removed id and
  * timestamp of the original enter event for the rewind region.
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2015, 2024,
+ * Copyright (c) 2009-2015, 2024, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -44,6 +44,12 @@
 
 bool     scorep_tracing_use_sion;
 uint64_t scorep_tracing_max_procs_per_sion_file;
+uint64_t scorep_tracing_min_duration;
+uint64_t scorep_tracing_ring_size;
+uint64_t scorep_tracing_ring_dump_signal;
+uint64_t scorep_tracing_ring_dump_threshold;
+bool     scorep_tracing_ring_dump_on_abort;
+uint64_t scorep_tracing_finalize_threads;
 /* Need to initialize variable, as it is not guaranteed that it will be set by
  * the config system, if unwinding is not supported.
  */
@@ -72,6 +78,106 @@ static const SCOREP_ConfigVariable scorep_tracing_confvars[] = {
         "files to fulfill this constraint. E.g., having 4 processes and setting "
         "the maximum to 3 would result in 2 files each holding 2 processes."
     },
+    {
+        "min_duration",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &scorep_tracing_min_duration,
+        NULL,
+        "0",
+        "Minimum duration in nanoseconds of region instances kept in the trace",
+        "Each region enter stores a rewind point in the trace buffer. If the "
+        "region is left before this duration has passed and no communication, "
+        "threading, I/O, or recording on/off events happened in between, the "
+        "trace buffer is rewound, removing this region instance and all nested "
+        "events.\n"
+        "The number of removed instances and their accumulated duration are "
+        "recorded per region as location properties in the trace.\n"
+        "A value of 0 disables this filter."
+    },
+    {
+        "ring_size",
+        SCOREP_CONFIG_TYPE_SIZE,
+        &scorep_tracing_ring_size,
+        NULL,
+        "0",
+        "Size of the per-location trace ring buffer (flight recorder mode)",
+        "If non-zero, the events of each location are kept in a ring of "
+        "trace chunks of 256 KiB with this total size. When it is full, "
+        "only the oldest chunk is overwritten, thus the most recent events "
+        "are kept. The remaining events are written at the end of the "
+        "measurement.\n"
+        "A dump can be requested via the signal given in "
+        "`SCOREP_TRACING_RING_DUMP_SIGNAL`, via `SCOREP_TRACE_DUMP()` from the "
+        "user instrumentation, or via `SCOREP_TRACING_RING_DUMP_THRESHOLD`. "
+        "Then each location writes the filled chunks of its ring to the "
+        "trace the next time it completes a chunk. The dump covers the "
+        "chunks since the last dump of the location, thus at most this "
+        "size.\n"
+        "The ring buffers can also be written if the program is terminated "
+        "by a fatal signal, see `SCOREP_TRACING_RING_DUMP_ON_ABORT`.\n"
+        "Definitions are not affected by dropped events and are always "
+        "written completely. The event files are written by Score-P "
+        "directly, thus `SCOREP_TRACING_USE_SION` is ignored.\n"
+        "A value of 0 disables the flight recorder mode."
+    },
+    {
+        "ring_dump_signal",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &scorep_tracing_ring_dump_signal,
+        NULL,
+        "0",
+        "Signal number which requests a dump of the trace ring buffers",
+        "Installs a handler for this signal, e.g., the number of SIGUSR2, "
+        "which requests a dump of the trace ring buffers of all locations.\n"
+        "Only effective if `SCOREP_TRACING_RING_SIZE` is set. A value of 0 "
+        "does not install a handler."
+    },
+    {
+        "ring_dump_threshold",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &scorep_tracing_ring_dump_threshold,
+        NULL,
+        "0",
+        "Region duration in nanoseconds which requests a dump of the trace ring buffers",
+        "If a region instance lasts at least this duration, a dump of the "
+        "trace ring buffers of all locations is requested.\n"
+        "Only effective if `SCOREP_TRACING_RING_SIZE` is set. A value of 0 "
+        "disables this trigger."
+    },
+    {
+        "ring_dump_on_abort",
+        SCOREP_CONFIG_TYPE_BOOL,
+        &scorep_tracing_ring_dump_on_abort,
+        NULL,
+        "false",
+        "Write the trace ring buffers if the program is terminated by a fatal signal",
+        "Installs handlers for SIGABRT, SIGBUS, SIGFPE, SIGILL, and SIGSEGV, "
+        "unless the application already handles them, which write the "
+        "already filled trace chunks of all locations to their event files "
+        "with async-signal-safe calls only. Then the signal is raised again "
+        "with its default action.\n"
+        "The measurement is not finalized, thus the chunks the locations "
+        "currently write to, the definitions, and the anchor file are "
+        "missing. The trace can not be read by regular tools, but the "
+        "event files can be recovered.\n"
+        "Only effective if `SCOREP_TRACING_RING_SIZE` is set."
+    },
+    {
+        "finalize_threads",
+        SCOREP_CONFIG_TYPE_NUMBER,
+        &scorep_tracing_finalize_threads,
+        NULL,
+        "0",
+        "Number of threads which write the trace files of the locations of a process at the end of the measurement",
+        "The event writers of all locations of a process are closed, which "
+        "flushes their remaining events, and their local definitions are "
+        "written by up to this number of threads, including the main thread.\n"
+        "A value of 0 uses one thread per online CPU. A value of 1 writes the "
+        "files one after another, which may be preferable on file systems "
+        "that handle many concurrent writers badly.\n"
+        "Only effective with the POSIX file substrate, with SIONlib the files "
+        "are always written by one thread."
+    },
     SCOREP_CONFIG_TERMINATOR
 };
 
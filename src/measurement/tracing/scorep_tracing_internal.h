@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2015, 2019, 2020,
+ * Copyright (c) 2009-2015, 2019, 2020, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -52,6 +52,23 @@
 extern bool     scorep_tracing_use_sion;
 extern uint64_t scorep_tracing_max_procs_per_sion_file;
 extern bool     scorep_tracing_convert_calling_context;
+extern uint64_t scorep_tracing_min_duration;
+
+/**
+ * SCOREP_TRACING_MIN_DURATION converted to timer ticks, 0 if disabled.
+ */
+extern uint64_t scorep_tracing_min_duration_ticks;
+
+extern uint64_t scorep_tracing_ring_size;
+extern uint64_t scorep_tracing_ring_dump_signal;
+extern uint64_t scorep_tracing_ring_dump_threshold;
+extern bool     scorep_tracing_ring_dump_on_abort;
+
+/**
+ * SCOREP_TRACING_RING_DUMP_THRESHOLD converted to timer ticks, 0 if disabled
+ * or if the flight recorder mode is off.
+ */
+extern uint64_t scorep_tracing_ring_dump_threshold_ticks;
 
 extern SCOREP_AttributeHandle scorep_tracing_pid_attribute;
 extern SCOREP_AttributeHandle scorep_tracing_tid_attribute;
@@ -67,6 +84,16 @@ extern SCOREP_AttributeHandle scorep_tracing_offset_attribute;
  */
 extern size_t scorep_tracing_substrate_id;
 
+/**
+ * Aggregate of the region instances removed by the minimum-duration filter.
+ */
+typedef struct scorep_tracing_rewound_region
+{
+    SCOREP_RegionHandle region;
+    uint64_t            visits;
+    uint64_t            duration;
+} scorep_tracing_rewound_region;
+
 typedef struct SCOREP_TracingData SCOREP_TracingData;
 struct SCOREP_TracingData
 {
@@ -74,6 +101,17 @@ struct SCOREP_TracingData
     scorep_rewind_stack* rewind_stack;
     scorep_rewind_stack* rewind_free_list;
     OTF2_AttributeList*  otf_attribute_list;
+
+    /** Current nesting depth of the rewind points of the minimum-duration filter */
+    uint32_t                       min_duration_depth;
+    /** Aggregates of rewound region instances, indexed by the local region id */
+    scorep_tracing_rewound_region* rewound_regions;
+    uint32_t                       rewound_regions_capacity;
+
+    /** Enter timestamps of the current region stack for the dump threshold */
+    uint64_t* ring_enter_timestamps;
+    uint32_t  ring_depth;
+    uint32_t  ring_enter_timestamps_capacity;
 };
 
 
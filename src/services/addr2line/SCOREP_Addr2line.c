@@ -4,6 +4,9 @@
  * Copyright (c) 2021-2022,
  * Forschungszentrum Juelich GmbH, Germany
  *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
  * This software may be modified and distributed under the terms of
  * a BSD-style license.  See the COPYING file in the package base
  * directory for details.
@@ -22,6 +25,7 @@
 #include <config.h>
 
 #include <SCOREP_Addr2line.h>
+#include "scorep_addr2line_cache.h"
 
 #include <inttypes.h>
 #include <stddef.h>
@@ -37,7 +41,6 @@
 
 #include <SCOREP_RuntimeManagement.h>
 #include <SCOREP_Memory.h>
-#include <SCOREP_ReaderWriterLock.h>
 
 #include <UTILS_Atomic.h>
 #include <UTILS_Error.h>
@@ -90,6 +93,7 @@ static uintptr_t* lt_begin_addrs;
     bfd*        abfd; \
     asymbol**   symbols; \
     const char* name; \
+    scorep_addr2line_cache* cache; \
     uint16_t    token
 typedef struct lt_object lt_object;
 struct lt_object
@@ -230,6 +234,7 @@ fill_lt_arrays_cb( struct dl_phdr_info* info, size_t unused, void* cnt )
     lt_objects[ insert ].abfd      = abfd;
     lt_objects[ insert ].symbols   = symbols;
     lt_objects[ insert ].name      = name;
+    lt_objects[ insert ].cache     = scorep_addr2line_cache_create( info );
     lt_objects[ insert ].token     = SCOREP_ADDR2LINE_LT_OBJECT_TOKEN;
 
     UTILS_DEBUG( "Use %s: base=%" PRIuPTR "; begin=%" PRIuPTR "; end=%" PRIuPTR "",
@@ -393,6 +398,57 @@ static void section_iterator( bfd* abfd, asection* section, void* payload );
 /* *INDENT-ON* */
 
 
+/* Single-address lookup of @a offset in @a so. Consults the cache of the
+   shared object first and stores libbfd results there. */
+static void
+lookup_addr_cached( lt_object*   so,
+                    uintptr_t    offset,
+                    bool*        sclFound,
+                    const char** sclFileName,
+                    const char** sclFunctionName,
+                    unsigned*    sclLineNo )
+{
+    scorep_addr2line_cache_entry entry;
+    if ( scorep_addr2line_cache_lookup( so->cache, offset, &entry ) )
+    {
+        *sclFound = entry.found;
+        if ( entry.found )
+        {
+            *sclFileName     = entry.file_name;
+            *sclFunctionName = entry.function_name;
+            *sclLineNo       = entry.line_no;
+        }
+        return;
+    }
+
+    bool         found_end_addr_unused;
+    lookup_bfd_t data = {
+        .begin_addr           = offset,
+        .end_addr             = 0,
+        .symbols              = so->symbols,
+        .scl_found_begin_addr = sclFound,
+        .scl_found_end_addr   = &found_end_addr_unused,
+        .scl_file_name        = sclFileName,
+        .scl_function_name    = sclFunctionName,
+        .scl_begin_lno        = sclLineNo,
+        .scl_end_lno          = NULL
+    };
+    *( data.scl_found_begin_addr ) = false;
+    *( data.scl_found_end_addr )   = false;
+
+    bfd_map_over_sections( so->abfd, section_iterator, &data );
+
+    entry.found = *sclFound;
+    if ( entry.found )
+    {
+        entry.file_name     = *sclFileName;
+        entry.function_name = *sclFunctionName;
+        entry.line_no       = *sclLineNo;
+    }
+    scorep_addr2line_cache_insert( so->cache, offset, &entry );
+}
+
+
 void
 SCOREP_Addr2line_LookupSo( uintptr_t    programCounterAddr,
                            /* shared object OUT parameters */
@@ -443,22 +499,8 @@ SCOREP_Addr2line_SoLookupAddr( uintptr_t    offset,
     *soFileName = so_handle->name;
     *soToken    = so_handle->token;
 
-    bool         scl_found_unused;
-    lookup_bfd_t data = {
-        .begin_addr           = offset,
-        .end_addr             = 0,
-        .symbols              = so_handle->symbols,
-        .scl_found_begin_addr = sclFound,
-        .scl_found_end_addr   = &scl_found_unused,
-        .scl_file_name        = sclFileName,
-        .scl_function_name    = sclFunctionName,
-        .scl_begin_lno        = sclLineNo,
-        .scl_end_lno          = NULL
-    };
-    *( data.scl_found_begin_addr ) = false;
-    *( data.scl_found_end_addr )   = false;
-
-    bfd_map_over_sections( so_handle->abfd, section_iterator, &data );
+    lookup_addr_cached( so_handle, offset,
+                        sclFound, sclFileName, sclFunctionName, sclLineNo );
 }
 
 
@@ -540,22 +582,8 @@ SCOREP_Addr2line_LookupAddr( uintptr_t    programCounterAddr,
         *soBaseAddr = handle->base_addr;
         *soToken    = handle->token;
 
-        bool         found_end_addr_unused;
-        lookup_bfd_t data = {
-            .begin_addr           = programCounterAddr - handle->base_addr,
-            .end_addr             = 0,
-            .symbols              = handle->symbols,
-            .scl_found_begin_addr = sclFound,
-            .scl_found_end_addr   = &found_end_addr_unused,
-            .scl_file_name        = sclFileName,
-            .scl_function_name    = sclFunctionName,
-            .scl_begin_lno        = sclLineNo,
-            .scl_end_lno          = NULL
-        };
-        *( data.scl_found_begin_addr ) = false;
-        *( data.scl_found_end_addr )   = false;
-
-        bfd_map_over_sections( handle->abfd, section_iterator, &data );
+        lookup_addr_cached( handle, programCounterAddr - handle->base_addr,
+                            sclFound, sclFileName, sclFunctionName, sclLineNo );
     }
     else
     {
@@ -688,78 +716,131 @@ struct rt_object
 
 
 /* Runtime-loaded shared objects correspond to a sorted singly linked list
-   for lookup and a free list. List access and modification needs (RW) locking.
+   that is only accessed by writers (objopen/objclose), serialized by a
+   mutex. After every modification, writers publish an immutable snapshot
+   of the list as sorted arrays. Lookups binary-search the current snapshot
+   without locking (RCU-style). Replaced snapshots might still be in use by
+   concurrent lookups, thus they are retired and freed at finalization only;
+   dlopen/dlclose events are rare.
    We bfd-lookup (addr - base_addr) if addr in [begin_addr, end_addr]. */
 /* Must not be static as accessed from ld_audit library */
-rt_object* scorep_rt_objects_head     = NULL;
-unsigned   scorep_rt_object_count     = 0;
-uintptr_t  scorep_rt_objects_min_addr = UINTPTR_MAX;
-uintptr_t  scorep_rt_objects_max_addr = 0;
-struct rwlock
-{
-    SCOREP_ALIGNAS( SCOREP_CACHELINESIZE ) int16_t pending;
-    int16_t     departing;
-    int16_t     release_n_readers;
-    int16_t     release_writer;
-    UTILS_Mutex writer_mutex;
-} scorep_rt_objects_rwlock =
+rt_object*  scorep_rt_objects_head  = NULL;
+unsigned    scorep_rt_object_count  = 0;
+UTILS_Mutex scorep_rt_objects_mutex = UTILS_MUTEX_INIT;
+
+typedef struct rt_snapshot rt_snapshot;
+struct rt_snapshot
 {
-    .pending           = 0,
-    .departing         = 0,
-    .release_n_readers = 0,
-    .release_writer    = 0,
-    .writer_mutex      = UTILS_MUTEX_INIT
+    size_t       count;
+    uintptr_t    min_addr;
+    uintptr_t    max_addr;
+    uintptr_t*   begin_addrs; /* sorted */
+    rt_object**  objects;     /* same order as begin_addrs */
+    rt_snapshot* next;        /* retired snapshots */
 };
+static rt_snapshot* rt_objects_snapshot;
+static rt_snapshot* rt_objects_retired_snapshots;
 
 
-static lt_object*
-lookup_so( uintptr_t addr )
+/* Returns the number of elements in the sorted array @a beginAddrs that
+   are <= @a addr, i.e., the candidate is at index return value - 1. */
+static inline size_t
+count_begin_addrs_le( const uintptr_t* beginAddrs,
+                      size_t           count,
+                      uintptr_t        addr )
 {
-    /* addr to be in [begin_addr, end_addr] of shared object representation */
-
-    /* search linearly in loadtime objects */
-    if ( lt_object_count > 0
-         && addr >= lt_begin_addrs[ 0 ]
-         && addr <= lt_objects[ lt_object_count - 1 ].end_addr )
+    size_t low = 0;
+    while ( count > 0 )
     {
-        size_t i = 0;
-        while ( i < lt_object_count - 1
-                && lt_begin_addrs[ i + 1 ] < addr )
+        size_t half = count / 2;
+        if ( beginAddrs[ low + half ] <= addr )
         {
-            ++i;
+            low   += half + 1;
+            count -= half + 1;
         }
-        if ( lt_objects[ i ].end_addr > addr )
+        else
         {
-            /* found addr in loadtime objects */
-            return &lt_objects[ i ];
+            count = half;
         }
     }
+    return low;
+}
+
 
-    /* search linearly in runtime objects */
-    SCOREP_RWLock_ReaderLock( &scorep_rt_objects_rwlock.pending,
-                              &scorep_rt_objects_rwlock.release_n_readers );
-    if ( scorep_rt_objects_head != NULL
-         && addr >= scorep_rt_objects_min_addr
-         && addr <= scorep_rt_objects_max_addr )
+/* Called with scorep_rt_objects_mutex held. */
+static void
+publish_rt_snapshot( void )
+{
+    rt_snapshot* snapshot = NULL;
+    if ( scorep_rt_object_count > 0 )
     {
-        rt_object* rt_obj = scorep_rt_objects_head;
-        while ( rt_obj->next
-                && rt_obj->next->begin_addr < addr )
+        /* one allocation for the snapshot and its two arrays */
+        snapshot = malloc( sizeof( *snapshot )
+                           + scorep_rt_object_count * ( sizeof( uintptr_t ) + sizeof( rt_object* ) ) );
+        UTILS_BUG_ON( snapshot == NULL, "Failed to allocate runtime object snapshot." );
+        snapshot->begin_addrs = ( uintptr_t* )( snapshot + 1 );
+        snapshot->objects     = ( rt_object** )( snapshot->begin_addrs + scorep_rt_object_count );
+        snapshot->min_addr    = UINTPTR_MAX;
+        snapshot->max_addr    = 0;
+        snapshot->next        = NULL;
+
+        size_t n = 0;
+        for ( rt_object* obj = scorep_rt_objects_head; obj; obj = obj->next, n++ )
         {
-            rt_obj = rt_obj->next;
+            snapshot->begin_addrs[ n ] = obj->begin_addr;
+            snapshot->objects[ n ]     = obj;
+            if ( obj->begin_addr < snapshot->min_addr )
+            {
+                snapshot->min_addr = obj->begin_addr;
+            }
+            if ( obj->end_addr > snapshot->max_addr )
+            {
+                snapshot->max_addr = obj->end_addr;
+            }
         }
-        if ( rt_obj->end_addr > addr )
+        UTILS_BUG_ON( n != scorep_rt_object_count, "Inconsistent runtime object count." );
+        snapshot->count = n;
+    }
+
+    rt_snapshot* old = rt_objects_snapshot;
+    UTILS_Atomic_StoreN_void_ptr( &rt_objects_snapshot, snapshot,
+                                  UTILS_ATOMIC_RELEASE );
+    if ( old )
+    {
+        old->next                    = rt_objects_retired_snapshots;
+        rt_objects_retired_snapshots = old;
+    }
+}
+
+
+static lt_object*
+lookup_so( uintptr_t addr )
+{
+    /* addr to be in [begin_addr, end_addr] of shared object representation */
+
+    /* binary search in loadtime objects */
+    size_t i = count_begin_addrs_le( lt_begin_addrs, lt_object_count, addr );
+    if ( i > 0 && lt_objects[ i - 1 ].end_addr > addr )
+    {
+        /* found addr in loadtime objects */
+        return &lt_objects[ i - 1 ];
+    }
+
+    /* binary search in the current snapshot of runtime objects */
+    rt_snapshot* snapshot = UTILS_Atomic_LoadN_void_ptr( &rt_objects_snapshot,
+                                                         UTILS_ATOMIC_ACQUIRE );
+    if ( snapshot != NULL
+         && addr >= snapshot->min_addr
+         && addr <= snapshot->max_addr )
+    {
+        i = count_begin_addrs_le( snapshot->begin_addrs, snapshot->count, addr );
+        if ( i > 0 && snapshot->objects[ i - 1 ]->end_addr > addr )
         {
             /* found addr in runtime objects */
-            SCOREP_RWLock_ReaderUnlock( &scorep_rt_objects_rwlock.pending,
-                                        &scorep_rt_objects_rwlock.departing,
-                                        &scorep_rt_objects_rwlock.release_writer );
-            return ( lt_object* )rt_obj;
+            return ( lt_object* )snapshot->objects[ i - 1 ];
         }
     }
-    SCOREP_RWLock_ReaderUnlock( &scorep_rt_objects_rwlock.pending,
-                                &scorep_rt_objects_rwlock.departing,
-                                &scorep_rt_objects_rwlock.release_writer );
+
     /* addr neither found in loadtime nor runtime objects */
     return NULL;
 }
@@ -856,6 +937,7 @@ SCOREP_Addr2line_Finalize( void )
     const char* exe_name = SCOREP_GetExecutableName( &unused );
     for ( size_t i = 0; i < lt_object_count; i++ )
     {
+        scorep_addr2line_cache_finalize( lt_objects[ i ].cache );
         free( lt_objects[ i ].symbols );
         bfd_close( lt_objects[ i ].abfd );
         if ( strcmp( lt_objects[ i ].name, exe_name ) != 0 )
@@ -870,6 +952,7 @@ SCOREP_Addr2line_Finalize( void )
     /* No need to lock as we are in serial context */
     while ( scorep_rt_objects_head )
     {
+        scorep_addr2line_cache_finalize( scorep_rt_objects_head->cache );
         free( scorep_rt_objects_head->symbols );
         bfd_close( scorep_rt_objects_head->abfd );
         free( ( char* )scorep_rt_objects_head->name );
@@ -877,13 +960,24 @@ SCOREP_Addr2line_Finalize( void )
     }
     scorep_rt_object_count = 0;
 
+    free( rt_objects_snapshot );
+    rt_objects_snapshot = NULL;
+    while ( rt_objects_retired_snapshots )
+    {
+        rt_snapshot* next = rt_objects_retired_snapshots->next;
+        free( rt_objects_retired_snapshots );
+        rt_objects_retired_snapshots = next;
+    }
+
     while ( scorep_rt_objects_dlclosed_head )
     {
+        scorep_addr2line_cache_finalize( scorep_rt_objects_dlclosed_head->cache );
         free( scorep_rt_objects_dlclosed_head->symbols );
         bfd_close( scorep_rt_objects_dlclosed_head->abfd );
         free( ( char* )scorep_rt_objects_dlclosed_head->name );
         scorep_rt_objects_dlclosed_head = scorep_rt_objects_dlclosed_head->next;
     }
+    scorep_addr2line_cache_reset();
 
     UTILS_DEBUG_EXIT();
 }
@@ -1028,6 +1122,7 @@ insert_rt_object_cb( struct dl_phdr_info* info, size_t unused, void* data )
     new->abfd         = abfd;
     new->symbols      = symbols;
     new->name         = UTILS_CStr_dup( name );
+    new->cache        = scorep_addr2line_cache_create( info );
     new->token        = ++scorep_rt_objopen_calls_tracked;
     new->begin_addr   = begin_addr_min;
     new->next         = NULL;
@@ -1037,10 +1132,7 @@ insert_rt_object_cb( struct dl_phdr_info* info, size_t unused, void* data )
     bitset_set( scorep_rt_objects_loaded, new->token );
 
     /* add shared object into sorted (by begin_addr) singly-linked list */
-    SCOREP_RWLock_WriterLock( &scorep_rt_objects_rwlock.writer_mutex,
-                              &scorep_rt_objects_rwlock.pending,
-                              &scorep_rt_objects_rwlock.departing,
-                              &scorep_rt_objects_rwlock.release_writer );
+    UTILS_MutexLock( &scorep_rt_objects_mutex );
     if ( !scorep_rt_objects_head
          || scorep_rt_objects_head->begin_addr > begin_addr_min )
     {
@@ -1059,18 +1151,8 @@ insert_rt_object_cb( struct dl_phdr_info* info, size_t unused, void* data )
         obj->next = new;
     }
     scorep_rt_object_count++;
-    /* update rt address interval */
-    if ( new->begin_addr < scorep_rt_objects_min_addr )
-    {
-        scorep_rt_objects_min_addr = new->begin_addr;
-    }
-    if ( new->end_addr > scorep_rt_objects_max_addr )
-    {
-        scorep_rt_objects_max_addr = new->end_addr;
-    }
-    SCOREP_RWLock_WriterUnlock( &scorep_rt_objects_rwlock.writer_mutex,
-                                &scorep_rt_objects_rwlock.pending,
-                                &scorep_rt_objects_rwlock.release_n_readers );
+    publish_rt_snapshot();
+    UTILS_MutexUnlock( &scorep_rt_objects_mutex );
 
     UTILS_DEBUG( "Insert %s; base=%" PRIuPTR "; begin=%" PRIuPTR "; "
                  "end=%" PRIuPTR "; cookie=%" PRIuPTR "",
@@ -1117,10 +1199,7 @@ scorep_la_objclose( uintptr_t* cookie /* corresponds to la_objopen */ )
         UTILS_BUG_ON( !scorep_rt_objects_head );
 
         rt_object* remove = NULL;
-        SCOREP_RWLock_WriterLock( &scorep_rt_objects_rwlock.writer_mutex,
-                                  &scorep_rt_objects_rwlock.pending,
-                                  &scorep_rt_objects_rwlock.departing,
-                                  &scorep_rt_objects_rwlock.release_writer );
+        UTILS_MutexLock( &scorep_rt_objects_mutex );
         rt_object** obj = &scorep_rt_objects_head;
         while ( *obj && ( *obj )->audit_cookie != *cookie )
         {
@@ -1130,9 +1209,7 @@ scorep_la_objclose( uintptr_t* cookie /* corresponds to la_objopen */ )
         {
             UTILS_DEBUG_EXIT( "Audit cookie %ld not found. Likely that it provided no symbols",
                               *cookie );
-            SCOREP_RWLock_WriterUnlock( &scorep_rt_objects_rwlock.writer_mutex,
-                                        &scorep_rt_objects_rwlock.pending,
-                                        &scorep_rt_objects_rwlock.release_n_readers );
+            UTILS_MutexUnlock( &scorep_rt_objects_mutex );
             return;
         }
 
@@ -1151,29 +1228,8 @@ scorep_la_objclose( uintptr_t* cookie /* corresponds to la_objopen */ )
 
         bitset_clear( scorep_rt_objects_loaded, remove->token );
         scorep_rt_object_count--;
-        /* update rt address interval */
-        if ( remove->begin_addr == scorep_rt_objects_min_addr
-             || remove->end_addr == scorep_rt_objects_max_addr )
-        {
-            scorep_rt_objects_min_addr = UINTPTR_MAX;
-            scorep_rt_objects_max_addr = 0;
-            rt_object* rto = scorep_rt_objects_head;
-            while ( rto )
-            {
-                if ( rto->begin_addr < scorep_rt_objects_min_addr )
-                {
-                    scorep_rt_objects_min_addr = rto->begin_addr;
-                }
-                if ( rto->end_addr > scorep_rt_objects_max_addr )
-                {
-                    scorep_rt_objects_max_addr = rto->end_addr;
-                }
-                rto = rto->next;
-            }
-        }
-        SCOREP_RWLock_WriterUnlock( &scorep_rt_objects_rwlock.writer_mutex,
-                                    &scorep_rt_objects_rwlock.pending,
-                                    &scorep_rt_objects_rwlock.release_n_readers );
+        publish_rt_snapshot();
+        UTILS_MutexUnlock( &scorep_rt_objects_mutex );
 
         UTILS_DEBUG( "dlclose %s; cookie=%" PRIuPTR "", remove->name, *cookie );
 
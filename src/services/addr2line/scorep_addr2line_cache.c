@@ -0,0 +1,636 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ */
+
+/**
+ * @file
+ *
+ * @brief Implements the in-memory and the persistent cache of source code
+ * locations resolved by SCOREP_Addr2line.
+ *
+ * A persistent cache file holds a header, an array of records sorted by
+ * offset, and a string table. String references are offsets into the
+ * string table. The file is written in native byte order as it is meant
+ * to be shared between runs on the same system. Writers hold a POSIX
+ * record lock on a lock file next to the cache file, merge their results
+ * with the current file, and replace it atomically via rename. Thus
+ * processes writing the same file concurrently neither corrupt it nor
+ * lose each other's results. Only found locations are stored, as a failed
+ * resolution may succeed in a later run, e.g., with debug information
+ * installed.
+ */
+
+#include <config.h>
+
+#include "scorep_addr2line_cache.h"
+
+#include <SCOREP_Environment.h>
+#include <SCOREP_Memory.h>
+#include <SCOREP_FastHashtab.h>
+
+#include <UTILS_Atomic.h>
+#include <UTILS_Error.h>
+#include <UTILS_IO.h>
+
+#define SCOREP_DEBUG_MODULE_NAME ADDR2LINE
+#include <UTILS_Debug.h>
+
+#include <jenkins_hash.h>
+
+#include <elf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+#define CACHE_FILE_MAGIC      "SCPA2L1"
+#define CACHE_FILE_SUFFIX     ".scorep-a2l"
+#define CACHE_LOCK_SUFFIX     ".lock"
+#define CACHE_FILE_NO_STRING  UINT64_MAX
+
+typedef struct cache_file_header
+{
+    char     magic[ 8 ];
+    uint64_t n_records;
+    uint64_t strings_size;
+} cache_file_header;
+
+typedef struct cache_file_record
+{
+    uint64_t offset;
+    uint64_t file_name;     /* offset into string table */
+    uint64_t function_name; /* offset into string table */
+    uint32_t line_no;
+    uint32_t found;
+} cache_file_record;
+
+
+/* Results resolved during this run */
+typedef struct new_record new_record;
+struct new_record
+{
+    new_record*                  next;
+    uintptr_t                    offset;
+    scorep_addr2line_cache_entry entry;
+};
+
+
+struct scorep_addr2line_cache
+{
+    char*                    build_id; /* hex string, NULL if none */
+
+    /* mapped persistent cache file */
+    void*                    map;
+    size_t                   map_size;
+    const cache_file_record* records;
+    uint64_t                 n_records;
+    const char*              strings;
+    uint64_t                 strings_size;
+
+    /* lock-free stack of results resolved during this run */
+    new_record*              new_records;
+};
+
+
+/* Type declarations for MONOTONIC_HASH_TABLE */
+typedef struct result_table_key_t
+{
+    const scorep_addr2line_cache* cache;
+    uintptr_t                     offset;
+} result_table_key_t;
+typedef new_record* result_table_value_t;
+
+/* Requirements for MONOTONIC_HASH_TABLE:                                    */
+#define RESULT_TABLE_HASH_EXPONENT 12
+
+static inline uint32_t
+result_table_bucket_idx( result_table_key_t key )
+{
+    uint32_t hash = jenkins_hash( &key.cache, sizeof( key.cache ), 0 );
+    hash = jenkins_hash( &key.offset, sizeof( key.offset ), hash );
+    return hash & hashmask( RESULT_TABLE_HASH_EXPONENT );
+}
+
+static inline bool
+result_table_equals( result_table_key_t key1,
+                     result_table_key_t key2 )
+{
+    return key1.cache == key2.cache && key1.offset == key2.offset;
+}
+
+static inline void*
+result_table_allocate_chunk( size_t chunkSize )
+{
+    return SCOREP_Memory_AlignedAllocForMisc( SCOREP_CACHELINESIZE, chunkSize );
+}
+
+static inline void
+result_table_free_chunk( void* chunk )
+{
+}
+
+static inline result_table_value_t
+result_table_value_ctor( result_table_key_t* key,
+                         void*               ctorData )
+{
+    scorep_addr2line_cache* cache  = ( scorep_addr2line_cache* )key->cache;
+    new_record*             record = SCOREP_Memory_AllocForMisc( sizeof( *record ) );
+    record->offset = key->offset;
+    record->entry  = *( const scorep_addr2line_cache_entry* )ctorData;
+
+    record->next = UTILS_Atomic_LoadN_void_ptr( &( cache->new_records ),
+                                                UTILS_ATOMIC_RELAXED );
+    while ( !UTILS_Atomic_CompareExchangeN_void_ptr( &( cache->new_records ),
+                                                     &( record->next ),
+                                                     record,
+                                                     true,
+                                                     UTILS_ATOMIC_RELEASE,
+                                                     UTILS_ATOMIC_RELAXED ) )
+    {
+    }
+    return record;
+}
+
+/* nPairsPerChunk: 16+8 bytes per pair, 0 wasted bytes on x86-64 in 128 bytes */
+SCOREP_HASH_TABLE_MONOTONIC( result_table,
+                             5,
+                             hashsize( RESULT_TABLE_HASH_EXPONENT ) );
+
+#undef RESULT_TABLE_HASH_EXPONENT
+
+
+/* Returns the GNU build-id of the shared object as hex string or NULL. */
+static char*
+get_build_id( struct dl_phdr_info* info )
+{
+    for ( int i = 0; i < info->dlpi_phnum; i++ )
+    {
+        const ElfW( Phdr )* phdr = &info->dlpi_phdr[ i ];
+        if ( phdr->p_type != PT_NOTE )
+        {
+            continue;
+        }
+
+        size_t      align = phdr->p_align == 8 ? 8 : 4;
+        const char* note  = ( const char* )( info->dlpi_addr + phdr->p_vaddr );
+        const char* end   = note + phdr->p_memsz;
+        while ( note + sizeof( ElfW( Nhdr ) ) <= end )
+        {
+            const ElfW( Nhdr )* nhdr = ( const ElfW( Nhdr )* )note;
+            const char*          name = note + sizeof( *nhdr );
+            const unsigned char* desc = ( const unsigned char* )name
+                                        + ( ( nhdr->n_namesz + align - 1 ) & ~( align - 1 ) );
+            if ( ( const char* )desc + nhdr->n_descsz > end )
+            {
+                break;
+            }
+            if ( nhdr->n_type == NT_GNU_BUILD_ID
+                 && nhdr->n_namesz == 4
+                 && memcmp( name, "GNU", 4 ) == 0
+                 && nhdr->n_descsz > 0 )
+            {
+                char* build_id = malloc( 2 * nhdr->n_descsz + 1 );
+                UTILS_BUG_ON( build_id == NULL, "Failed to allocate build-id." );
+                for ( size_t j = 0; j < nhdr->n_descsz; j++ )
+                {
+                    sprintf( build_id + 2 * j, "%02x", desc[ j ] );
+                }
+                return build_id;
+            }
+            note = ( const char* )desc + ( ( nhdr->n_descsz + align - 1 ) & ~( align - 1 ) );
+        }
+    }
+    return NULL;
+}
+
+
+/* Returns the path of the persistent cache file of @a buildId, or NULL if
+   persistence is disabled. Free the result. */
+static char*
+get_cache_file_name( const char* buildId )
+{
+    const char* dir = SCOREP_Env_GetAddr2lineCacheDir();
+    if ( buildId == NULL || dir == NULL || *dir == '\0' )
+    {
+        return NULL;
+    }
+
+    char* file_name = malloc( strlen( buildId ) + sizeof( CACHE_FILE_SUFFIX ) );
+    UTILS_BUG_ON( file_name == NULL, "Failed to allocate cache file name." );
+    sprintf( file_name, "%s" CACHE_FILE_SUFFIX, buildId );
+    char* path = UTILS_IO_JoinPath( 2, dir, file_name );
+    free( file_name );
+    return path;
+}
+
+
+/* Maps the persistent cache file at @a path into @a cache, if valid. */
+static void
+map_cache_file_at( scorep_addr2line_cache* cache,
+                   const char*             path )
+{
+    int fd = open( path, O_RDONLY );
+    if ( fd == -1 )
+    {
+        UTILS_DEBUG( "No cache file %s", path );
+        return;
+    }
+
+    struct stat st;
+    void*       map = MAP_FAILED;
+    if ( fstat( fd, &st ) == 0 && ( size_t )st.st_size >= sizeof( cache_file_header ) )
+    {
+        map = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    }
+    close( fd );
+    if ( map == MAP_FAILED )
+    {
+        UTILS_WARNING( "Ignoring unreadable address-to-line cache file %s", path );
+        return;
+    }
+
+    /* validate before use, the file might be from another version */
+    const cache_file_header* header = map;
+    size_t                   size   = st.st_size;
+    size_t                   needed = sizeof( *header );
+    bool                     valid  = memcmp( header->magic, CACHE_FILE_MAGIC, sizeof( header->magic ) ) == 0
+                                      && header->n_records <= ( size - needed ) / sizeof( cache_file_record );
+    if ( valid )
+    {
+        needed += header->n_records * sizeof( cache_file_record );
+        valid   = header->strings_size == size - needed
+                  && ( header->strings_size == 0
+                       || ( ( const char* )map )[ size - 1 ] == '\0' );
+    }
+    if ( !valid )
+    {
+        UTILS_WARNING( "Ignoring invalid address-to-line cache file %s", path );
+        munmap( map, size );
+        return;
+    }
+
+    cache->map          = map;
+    cache->map_size     = size;
+    cache->records      = ( const cache_file_record* )( header + 1 );
+    cache->n_records    = header->n_records;
+    cache->strings      = ( const char* )( cache->records + cache->n_records );
+    cache->strings_size = header->strings_size;
+    UTILS_DEBUG( "Mapped %" PRIu64 " cached results from %s", cache->n_records, path );
+}
+
+
+static void
+map_cache_file( scorep_addr2line_cache* cache )
+{
+    char* path = get_cache_file_name( cache->build_id );
+    if ( path != NULL )
+    {
+        map_cache_file_at( cache, path );
+        free( path );
+    }
+}
+
+
+/* Opens and locks the lock file of the cache file @a path. Returns the file
+   descriptor, -1 if locking failed. Closing it releases the lock. */
+static int
+lock_cache_file( const char* path )
+{
+    char* lock_path = malloc( strlen( path ) + sizeof( CACHE_LOCK_SUFFIX ) );
+    UTILS_BUG_ON( lock_path == NULL, "Failed to allocate lock file name." );
+    sprintf( lock_path, "%s" CACHE_LOCK_SUFFIX, path );
+
+    int fd = open( lock_path, O_RDWR | O_CREAT, 0666 );
+    if ( fd != -1 )
+    {
+        struct flock lock;
+        memset( &lock, 0, sizeof( lock ) );
+        lock.l_type   = F_WRLCK;
+        lock.l_whence = SEEK_SET;
+        int ret;
+        while ( ( ret = fcntl( fd, F_SETLKW, &lock ) ) == -1 && errno == EINTR )
+        {
+        }
+        if ( ret == -1 )
+        {
+            close( fd );
+            fd = -1;
+        }
+    }
+    if ( fd == -1 )
+    {
+        UTILS_WARNING( "Could not lock address-to-line cache file %s, "
+                       "results of concurrent writers may get lost", lock_path );
+    }
+    free( lock_path );
+    return fd;
+}
+
+
+scorep_addr2line_cache*
+scorep_addr2line_cache_create( struct dl_phdr_info* info )
+{
+    scorep_addr2line_cache* cache = calloc( 1, sizeof( *cache ) );
+    UTILS_BUG_ON( cache == NULL, "Failed to allocate address-to-line cache." );
+    cache->build_id = get_build_id( info );
+    map_cache_file( cache );
+    return cache;
+}
+
+
+/* Returns the string at @a offset of the string table, or NULL if there is
+   none or the offset does not refer to a NUL-terminated string inside the
+   table. */
+static inline const char*
+file_string( const scorep_addr2line_cache* cache,
+             uint64_t                      offset )
+{
+    if ( offset == CACHE_FILE_NO_STRING
+         || offset >= cache->strings_size
+         || memchr( cache->strings + offset, '\0', cache->strings_size - offset ) == NULL )
+    {
+        return NULL;
+    }
+    return cache->strings + offset;
+}
+
+
+bool
+scorep_addr2line_cache_lookup( scorep_addr2line_cache*       cache,
+                               uintptr_t                     offset,
+                               scorep_addr2line_cache_entry* entry )
+{
+    /* binary search in the persistent results */
+    size_t low  = 0;
+    size_t high = cache->n_records;
+    while ( low < high )
+    {
+        size_t mid = low + ( high - low ) / 2;
+        if ( cache->records[ mid ].offset < offset )
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    /* Files written by earlier versions may hold failed resolutions, which
+       are ignored to resolve them again */
+    if ( low < cache->n_records && cache->records[ low ].offset == offset
+         && cache->records[ low ].found )
+    {
+        const cache_file_record* record = &cache->records[ low ];
+        entry->found         = record->found;
+        entry->file_name     = file_string( cache, record->file_name );
+        entry->function_name = file_string( cache, record->function_name );
+        entry->line_no       = record->line_no;
+        return true;
+    }
+
+    /* results of this run */
+    result_table_key_t key    = { .cache = cache, .offset = offset };
+    new_record*        record = NULL;
+    if ( result_table_get( key, &record ) )
+    {
+        *entry = record->entry;
+        return true;
+    }
+    return false;
+}
+
+
+void
+scorep_addr2line_cache_insert( scorep_addr2line_cache*             cache,
+                               uintptr_t                           offset,
+                               const scorep_addr2line_cache_entry* entry )
+{
+    scorep_addr2line_cache_entry stored = *entry;
+    if ( !stored.found )
+    {
+        stored.file_name     = NULL;
+        stored.function_name = NULL;
+        stored.line_no       = 0;
+    }
+
+    result_table_key_t key    = { .cache = cache, .offset = offset };
+    new_record*        unused = NULL;
+    result_table_get_and_insert( key, &stored, &unused );
+}
+
+
+typedef struct merged_record
+{
+    uintptr_t                    offset;
+    scorep_addr2line_cache_entry entry;
+} merged_record;
+
+
+static int
+compare_merged_records( const void* a,
+                        const void* b )
+{
+    uintptr_t offset_a = ( ( const merged_record* )a )->offset;
+    uintptr_t offset_b = ( ( const merged_record* )b )->offset;
+    return ( offset_a > offset_b ) - ( offset_a < offset_b );
+}
+
+
+/* Appends @a string to the string table unless it equals the previously
+   appended one, which is common for file names. */
+static uint64_t
+append_string( char**      strings,
+               size_t*     size,
+               size_t*     capacity,
+               uint64_t*   lastOffset,
+               const char* string )
+{
+    if ( string == NULL )
+    {
+        return CACHE_FILE_NO_STRING;
+    }
+    if ( *lastOffset != CACHE_FILE_NO_STRING
+         && strcmp( *strings + *lastOffset, string ) == 0 )
+    {
+        return *lastOffset;
+    }
+
+    size_t length = strlen( string ) + 1;
+    if ( *size + length > *capacity )
+    {
+        *capacity = 2 * ( *size + length );
+        *strings  = realloc( *strings, *capacity );
+        UTILS_BUG_ON( *strings == NULL, "Failed to allocate string table." );
+    }
+    memcpy( *strings + *size, string, length );
+    *lastOffset = *size;
+    *size      += length;
+    return *lastOffset;
+}
+
+
+static void
+write_cache_file( scorep_addr2line_cache* cache,
+                  const char*             path )
+{
+    size_t n_new = 0;
+    for ( new_record* record = cache->new_records; record; record = record->next )
+    {
+        n_new += record->entry.found;
+    }
+    if ( n_new == 0 )
+    {
+        /* nothing to add to the file */
+        return;
+    }
+
+    /* Other processes may have written the file since it was mapped, thus
+       merge with its current version while holding the lock */
+    int                    lock_fd = lock_cache_file( path );
+    scorep_addr2line_cache current;
+    memset( &current, 0, sizeof( current ) );
+    map_cache_file_at( &current, path );
+
+    /* merge persistent and new results, sorted by offset without duplicates */
+    size_t         n_merged = current.n_records + n_new;
+    merged_record* merged   = malloc( n_merged * sizeof( *merged ) );
+    UTILS_BUG_ON( merged == NULL, "Failed to allocate address-to-line records." );
+    size_t n = 0;
+    for ( new_record* record = cache->new_records; record; record = record->next )
+    {
+        if ( !record->entry.found )
+        {
+            continue;
+        }
+        merged[ n ].offset  = record->offset;
+        merged[ n++ ].entry = record->entry;
+    }
+    for ( uint64_t i = 0; i < current.n_records; i++ )
+    {
+        if ( !current.records[ i ].found )
+        {
+            continue;
+        }
+        merged[ n ].offset                = current.records[ i ].offset;
+        merged[ n ].entry.found           = current.records[ i ].found;
+        merged[ n ].entry.file_name       = file_string( &current, current.records[ i ].file_name );
+        merged[ n ].entry.function_name   = file_string( &current, current.records[ i ].function_name );
+        merged[ n++ ].entry.line_no       = current.records[ i ].line_no;
+    }
+    n_merged = n;
+    qsort( merged, n_merged, sizeof( *merged ), compare_merged_records );
+
+    cache_file_record* records = malloc( n_merged * sizeof( *records ) );
+    UTILS_BUG_ON( records == NULL, "Failed to allocate address-to-line records." );
+    char*    strings         = NULL;
+    size_t   strings_size    = 0;
+    size_t   strings_cap     = 0;
+    uint64_t last_file       = CACHE_FILE_NO_STRING;
+    uint64_t last_function   = CACHE_FILE_NO_STRING;
+    uint64_t n_records       = 0;
+    for ( size_t i = 0; i < n_merged; i++ )
+    {
+        if ( n_records > 0 && records[ n_records - 1 ].offset == merged[ i ].offset )
+        {
+            continue;
+        }
+        cache_file_record* record = &records[ n_records++ ];
+        record->offset        = merged[ i ].offset;
+        record->found         = merged[ i ].entry.found;
+        record->line_no       = merged[ i ].entry.line_no;
+        record->file_name     = append_string( &strings, &strings_size, &strings_cap,
+                                               &last_file, merged[ i ].entry.file_name );
+        record->function_name = append_string( &strings, &strings_size, &strings_cap,
+                                               &last_function, merged[ i ].entry.function_name );
+    }
+    free( merged );
+
+    cache_file_header header;
+    memset( &header, 0, sizeof( header ) );
+    memcpy( header.magic, CACHE_FILE_MAGIC, sizeof( header.magic ) );
+    header.n_records    = n_records;
+    header.strings_size = strings_size;
+
+    /* write to a process-private file and rename, which is atomic for
+       readers which do not take the lock */
+    char* tmp_path = malloc( strlen( path ) + 32 );
+    UTILS_BUG_ON( tmp_path == NULL, "Failed to allocate cache file name." );
+    sprintf( tmp_path, "%s.%ld.tmp", path, ( long )getpid() );
+    FILE* file    = fopen( tmp_path, "wb" );
+    bool  success = file != NULL
+                     && fwrite( &header, sizeof( header ), 1, file ) == 1
+                     && fwrite( records, sizeof( *records ), n_records, file ) == n_records
+                     && fwrite( strings, 1, strings_size, file ) == strings_size;
+    if ( file != NULL && fclose( file ) != 0 )
+    {
+        success = false;
+    }
+    if ( success && rename( tmp_path, path ) == 0 )
+    {
+        UTILS_DEBUG( "Wrote %" PRIu64 " results to %s", n_records, path );
+    }
+    else
+    {
+        UTILS_WARNING( "Could not write address-to-line cache file %s", path );
+        unlink( tmp_path );
+    }
+    if ( lock_fd != -1 )
+    {
+        close( lock_fd );
+    }
+
+    free( tmp_path );
+    free( strings );
+    free( records );
+    if ( current.map )
+    {
+        munmap( current.map, current.map_size );
+    }
+}
+
+
+void
+scorep_addr2line_cache_finalize( scorep_addr2line_cache* cache )
+{
+    if ( cache == NULL )
+    {
+        return;
+    }
+
+    char* path = get_cache_file_name( cache->build_id );
+    if ( path != NULL && cache->new_records != NULL )
+    {
+        write_cache_file( cache, path );
+    }
+    free( path );
+
+    if ( cache->map )
+    {
+        munmap( cache->map, cache->map_size );
+    }
+    free( cache->build_id );
+    /* The result table still refers to the cache by address, but is only
+       accessed again by scorep_addr2line_cache_reset(). */
+    free( cache );
+}
+
+
+void
+scorep_addr2line_cache_reset( void )
+{
+    /* chunks and records live in misc memory */
+    result_table_free_chunks();
+}
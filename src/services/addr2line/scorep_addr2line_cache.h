@@ -0,0 +1,100 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ */
+
+#ifndef SCOREP_ADDR2LINE_CACHE_H
+#define SCOREP_ADDR2LINE_CACHE_H
+
+/**
+ * @file
+ *
+ * @brief Cache of source code locations resolved by SCOREP_Addr2line.
+ *
+ * Results of single-address lookups are kept in memory for the duration
+ * of the measurement, per shared object and offset. If the shared object
+ * carries a GNU build-id and `SCOREP_ADDR2LINE_CACHE_DIR` is set, results
+ * are additionally persisted in a file per build-id. These files are
+ * memory-mapped by later runs and by other processes on the same node,
+ * which then skip the libbfd lookup for all addresses resolved before.
+ */
+
+#include <link.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+
+typedef struct scorep_addr2line_cache scorep_addr2line_cache;
+
+
+/** Result of a single-address lookup. */
+typedef struct scorep_addr2line_cache_entry
+{
+    bool        found;
+    const char* file_name;
+    const char* function_name;
+    unsigned    line_no;
+} scorep_addr2line_cache_entry;
+
+
+/** Creates the cache of the shared object described by @a info. Maps
+ *  the persistent cache file of the object's build-id, if available.
+ *
+ *  @param info  The dl_iterate_phdr information of the shared object.
+ *
+ *  @return The new cache, never NULL.
+ */
+scorep_addr2line_cache*
+scorep_addr2line_cache_create( struct dl_phdr_info* info );
+
+
+/** Looks up the result for @a offset. Can be called concurrently.
+ *
+ *  @param cache   The cache of the shared object.
+ *  @param offset  The offset into the shared object.
+ *  @param entry   Set to the cached result, if found.
+ *
+ *  @return True if @a offset was resolved before.
+ */
+bool
+scorep_addr2line_cache_lookup( scorep_addr2line_cache*       cache,
+                               uintptr_t                     offset,
+                               scorep_addr2line_cache_entry* entry );
+
+
+/** Stores the result for @a offset. Can be called concurrently. The
+ *  strings need to be valid until scorep_addr2line_cache_finalize().
+ *
+ *  @param cache   The cache of the shared object.
+ *  @param offset  The offset into the shared object.
+ *  @param entry   The result of the libbfd lookup.
+ */
+void
+scorep_addr2line_cache_insert( scorep_addr2line_cache*             cache,
+                               uintptr_t                           offset,
+                               const scorep_addr2line_cache_entry* entry );
+
+
+/** Writes new results to the persistent cache file, if any, and releases
+ *  @a cache and the mapped file. Must be called before the strings passed to
+ *  scorep_addr2line_cache_insert() become invalid.
+ *
+ *  @param cache  The cache of the shared object.
+ */
+void
+scorep_addr2line_cache_finalize( scorep_addr2line_cache* cache );
+
+
+/** Forgets all in-memory results. To be called after all caches were
+ *  finalized, in serial context. */
+void
+scorep_addr2line_cache_reset( void );
+
+
+#endif /* SCOREP_ADDR2LINE_CACHE_H */
@@ -4,7 +4,7 @@
  * Copyright (c) 2015,
  * Forschungszentrum Juelich GmbH, Germany
  *
- * Copyright (c) 2019,
+ * Copyright (c) 2019, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * This software may be modified and distributed under the terms of
@@ -33,6 +33,13 @@
  * SCOREP_Timer_GetClockTicks(). They must not be used by clients of
  * SCOREP_Timer_Ticks.h.
  */
+/* The auto timer selects a timer at initialization, based on a short
+ * benchmark against a wall clock. */
+#if !HAVE( BACKEND_SCOREP_TIMER_FIXED ) && \
+    ( HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME ) || HAVE( BACKEND_SCOREP_TIMER_GETTIMEOFDAY ) )
+# define HAVE_SCOREP_TIMER_AUTO 1
+#endif
+
 typedef uint64_t timer_type;
 enum timer_type
 {
@@ -72,8 +79,43 @@ enum timer_type
     TIMER_CLOCK_GETTIME,
 #endif /* BACKEND_SCOREP_TIMER_CLOCK_GETTIME */
 
+#if HAVE( SCOREP_TIMER_AUTO )
+    TIMER_AUTO,
+#endif /* SCOREP_TIMER_AUTO */
+
     TIMER_INVALID
 };
 
 
+/* If configured with --with-timer, SCOREP_TIMER_FIXED is the only
+ * selectable timer and SCOREP_Timer_GetClockTicks() reads it without
+ * runtime dispatch. */
+#if HAVE( BACKEND_SCOREP_TIMER_FIXED )
+# if HAVE( BACKEND_SCOREP_TIMER_FIXED_BGL )
+#  define SCOREP_TIMER_FIXED TIMER_BGL
+# elif HAVE( BACKEND_SCOREP_TIMER_FIXED_BGP )
+#  define SCOREP_TIMER_FIXED TIMER_BGP
+# elif HAVE( BACKEND_SCOREP_TIMER_FIXED_BGQ )
+#  define SCOREP_TIMER_FIXED TIMER_BGQ
+# elif HAVE( BACKEND_SCOREP_TIMER_FIXED_MINGW )
+#  define SCOREP_TIMER_FIXED TIMER_MINGW
+# elif HAVE( BACKEND_SCOREP_TIMER_FIXED_AIX )
+#  define SCOREP_TIMER_FIXED TIMER_AIX
+# elif HAVE( BACKEND_SCOREP_TIMER_FIXED_MAC )
+#  define SCOREP_TIMER_FIXED TIMER_MAC
+# elif HAVE( BACKEND_SCOREP_TIMER_FIXED_TSC )
+#  define SCOREP_TIMER_FIXED TIMER_TSC
+# elif HAVE( BACKEND_SCOREP_TIMER_FIXED_GETTIMEOFDAY )
+#  define SCOREP_TIMER_FIXED TIMER_GETTIMEOFDAY
+# elif HAVE( BACKEND_SCOREP_TIMER_FIXED_CLOCK_GETTIME )
+#  define SCOREP_TIMER_FIXED TIMER_CLOCK_GETTIME
+# else
+#  error "Unknown timer fixed at build time."
+# endif
+# define SCOREP_TIMER_SELECTABLE( TIMER ) HAVE( BACKEND_SCOREP_TIMER_FIXED_ ## TIMER )
+#else /* !BACKEND_SCOREP_TIMER_FIXED */
+# define SCOREP_TIMER_SELECTABLE( TIMER ) 1
+#endif /* !BACKEND_SCOREP_TIMER_FIXED */
+
+
 #endif /* SCOREP_TIMER_AVAIL_H */
@@ -4,7 +4,7 @@
  * Copyright (c) 2015,
  * Forschungszentrum Juelich GmbH, Germany
  *
- * Copyright (c) 2019,
+ * Copyright (c) 2019, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * This software may be modified and distributed under the terms of
@@ -94,8 +94,13 @@ SCOREP_Timer_GetClockTicks( void )
     /* TODO: 1. Convert from static inline to macro to enforce inlining. PGI
      * needs to be extracted into additional function call.
      * 2. Use computed goto instead of switch if available. */
+#if HAVE( BACKEND_SCOREP_TIMER_FIXED )
+    /* Constant condition, compilers reduce the switch to the single case. */
+    switch ( SCOREP_TIMER_FIXED )
+#else /* !BACKEND_SCOREP_TIMER_FIXED */
     extern timer_type scorep_timer;
     switch ( scorep_timer )
+#endif /* !BACKEND_SCOREP_TIMER_FIXED */
     {
 #if HAVE( BACKEND_SCOREP_TIMER_BGL )
         case TIMER_BGL:
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012,
+ * Copyright (c) 2009-2012, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -74,6 +74,19 @@ uint64_t
 SCOREP_Timer_GetClockResolution( void );
 
 
+/**
+ * Estimate of the clock resolution, which can be used during the measurement,
+ * e.g., to convert user-given durations to clock ticks. Unlike
+ * SCOREP_Timer_GetClockResolution(), an interpolated frequency is not
+ * checked across processes. It is interpolated once during
+ * SCOREP_Timer_Initialize(), over a period of at least one millisecond.
+ *
+ * @return Estimated clock resolution in ticks/second.
+ */
+uint64_t
+SCOREP_Timer_GetClockResolutionEstimate( void );
+
+
 /**
  * @return true if we have a global clock, e.g. on Blue Gene systems. Usually false.
  */
@@ -81,4 +94,20 @@ bool
 SCOREP_Timer_ClockIsGlobal( void );
 
 
+/**
+ * @return The name of the timer used during measurement, as accepted by
+ * SCOREP_TIMER. With SCOREP_TIMER=auto, the name of the selected timer.
+ */
+const char*
+SCOREP_Timer_GetName( void );
+
+
+/**
+ * @return The cost of one SCOREP_Timer_GetClockTicks() call in nanoseconds
+ * as measured by the automatic timer selection, or 0 if not measured.
+ */
+double
+SCOREP_Timer_GetReadCost( void );
+
+
 #endif /* SCOREP_TIMER_UTILS_H */
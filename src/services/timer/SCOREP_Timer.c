@@ -4,7 +4,7 @@
  * Copyright (c) 2015-2016, 2019,
  * Forschungszentrum Juelich GmbH, Germany
  *
- * Copyright (c) 2019,
+ * Copyright (c) 2019, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * This software may be modified and distributed under the terms of
@@ -35,6 +35,14 @@
 #include <math.h>
 #endif  /* HAVE( BACKEND_SCOREP_TIMER_TSC ) && ! HAVE( SCOREP_ARMV8_TSC ) */
 
+#if HAVE( SCOREP_TIMER_AUTO )
+#include <UTILS_IO.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#endif  /* HAVE( SCOREP_TIMER_AUTO ) */
+
 /* *INDENT-OFF* */
 /* *INDENT-ON*  */
 
@@ -70,6 +78,15 @@ static uint64_t timer_cmp_freq;
 double scorep_ticks_to_nsec_mac;
 #endif  /* BACKEND_SCOREP_TIMER_MAC */
 
+/* Nanoseconds per SCOREP_Timer_GetClockTicks() call, 0 if not measured */
+static double read_cost_ns;
+
+/* Ticks per second, estimated once at initialization */
+static uint64_t clock_resolution_estimate;
+
+static uint64_t
+clock_resolution( bool estimate );
+
 #include "scorep_timer_confvars.inc.c"
 
 void
@@ -79,6 +96,241 @@ SCOREP_Timer_Register( void )
 }
 
 
+#if HAVE( BACKEND_SCOREP_TIMER_TSC ) && ( HAVE( SCOREP_X86_64_TSC ) || HAVE( SCOREP_X86_32_TSC ) )
+static const char proc_cpuinfo[] = "/proc/cpuinfo";
+
+/* Returns true if /proc/cpuinfo reports nonstop_tsc and constant_tsc.
+ * @a readable is set to false if the file could not be read. */
+static bool
+cpuinfo_reports_invariant_tsc( bool* readable )
+{
+    FILE* fp = fopen( proc_cpuinfo, "r" );
+    *readable = fp != NULL;
+    if ( fp == NULL )
+    {
+        return false;
+    }
+
+    char*            line                     = NULL;
+    size_t           length                   = 0;
+    bool             constant_and_nonstop_tsc = false;
+    SCOREP_ErrorCode status;
+    while ( ( status = UTILS_IO_GetLine( &line, &length, fp ) ) == SCOREP_SUCCESS )
+    {
+        if ( strstr( line, "nonstop_tsc" ) != NULL &&
+             strstr( line, "constant_tsc" ) != NULL )
+        {
+            constant_and_nonstop_tsc = true;
+            break;
+        }
+    }
+    if ( !constant_and_nonstop_tsc && status != SCOREP_ERROR_END_OF_BUFFER )
+    {
+        *readable = false;
+    }
+    free( line );
+    fclose( fp );
+    return constant_and_nonstop_tsc;
+}
+#endif  /* HAVE( BACKEND_SCOREP_TIMER_TSC ) && x86 */
+
+
+#if HAVE( SCOREP_TIMER_AUTO )
+/* Timers coarser than this are only selected if there is no finer one. */
+#define AUTO_MAX_RESOLUTION_NS 100.0
+/* Minimal duration of the benchmark per timer. */
+#define AUTO_BENCHMARK_NS      UINT64_C( 200000 )
+
+
+static uint64_t
+wall_clock_ns( void )
+{
+# if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+    struct timespec time;
+    int             result = clock_gettime( SCOREP_TIMER_CLOCK_GETTIME_CLK_ID, &time );
+    UTILS_ASSERT( result == 0 );
+    return ( uint64_t )time.tv_sec * UINT64_C( 1000000000 ) + ( uint64_t )time.tv_nsec;
+# else  /* HAVE( BACKEND_SCOREP_TIMER_GETTIMEOFDAY ) */
+    struct timeval tp;
+    gettimeofday( &tp, 0 );
+    return ( uint64_t )tp.tv_sec * UINT64_C( 1000000000 ) + ( uint64_t )tp.tv_usec * UINT64_C( 1000 );
+# endif
+}
+
+
+/* Reads the selected timer back-to-back for AUTO_BENCHMARK_NS and derives
+ * the cost per read and the resolution, i.e., the smallest observed
+ * increment, in nanoseconds. Returns false if the timer went backwards. */
+static bool
+benchmark_timer( double* readCostNs,
+                 double* resolutionNs )
+{
+    uint64_t n_reads    = 0;
+    uint64_t min_delta  = UINT64_MAX;
+    uint64_t wall_begin = wall_clock_ns();
+    uint64_t first      = SCOREP_Timer_GetClockTicks();
+    uint64_t previous   = first;
+    uint64_t wall_end;
+    do
+    {
+        for ( int i = 0; i < 100; i++ )
+        {
+            uint64_t now = SCOREP_Timer_GetClockTicks();
+            if ( now < previous )
+            {
+                return false;
+            }
+            if ( now > previous && now - previous < min_delta )
+            {
+                min_delta = now - previous;
+            }
+            previous = now;
+        }
+        n_reads += 100;
+        wall_end = wall_clock_ns();
+    }
+    while ( wall_end - wall_begin < AUTO_BENCHMARK_NS );
+
+    double elapsed_ns = wall_end - wall_begin;
+    *readCostNs   = elapsed_ns / n_reads;
+    *resolutionNs = INFINITY;
+    if ( previous > first && min_delta != UINT64_MAX )
+    {
+        *resolutionNs = min_delta * elapsed_ns / ( previous - first );
+    }
+    return true;
+}
+
+
+# if HAVE( BACKEND_SCOREP_TIMER_TSC )
+#  if HAVE( SCOREP_X86_64_TSC ) || HAVE( SCOREP_X86_32_TSC )
+/* Linux checks the synchronization of the TSC across all cores at boot and
+ * at runtime. An unsynchronized TSC is marked unstable and is no longer
+ * offered as clock source. */
+static bool
+kernel_offers_tsc_clocksource( void )
+{
+    FILE* fp = fopen( "/sys/devices/system/clocksource/clocksource0/available_clocksource", "r" );
+    if ( fp == NULL )
+    {
+        return false;
+    }
+    char*  line   = NULL;
+    size_t length = 0;
+    bool   found  = false;
+    if ( UTILS_IO_GetLine( &line, &length, fp ) == SCOREP_SUCCESS )
+    {
+        for ( char* source = strtok( line, " \n" ); source; source = strtok( NULL, " \n" ) )
+        {
+            if ( strcmp( source, "tsc" ) == 0 )
+            {
+                found = true;
+                break;
+            }
+        }
+    }
+    free( line );
+    fclose( fp );
+    return found;
+}
+#  endif /* HAVE( SCOREP_X86_64_TSC ) || HAVE( SCOREP_X86_32_TSC ) */
+
+
+/* Is the tsc invariant and synchronized across cores? */
+static bool
+tsc_is_reliable( void )
+{
+#  if HAVE( SCOREP_X86_64_TSC ) || HAVE( SCOREP_X86_32_TSC )
+    bool cpuinfo_readable;
+    return cpuinfo_reports_invariant_tsc( &cpuinfo_readable )
+           && kernel_offers_tsc_clocksource();
+#  elif HAVE( SCOREP_ARMV8_TSC ) || HAVE( SCOREP_POWERPC64_TSC ) || HAVE( SCOREP_POWERPC32_TSC )
+    /* The generic timer and the time base are architecturally synchronized
+     * and run at a constant frequency. */
+    return true;
+#  else
+    return false;
+#  endif
+}
+# endif /* BACKEND_SCOREP_TIMER_TSC */
+
+
+/* Returns the first portable timer, in a fixed order of preference, which
+ * has a resolution of at most AUTO_MAX_RESOLUTION_NS, or the finest one if
+ * none qualifies. The order follows the usual read costs. Every process
+ * makes the choice on its own, before any communication is possible, thus
+ * it does not compare measured read costs, which are subject to noise and
+ * could let processes pick different timers. The measured resolutions are
+ * orders of magnitude away from the threshold, they only sort out coarse
+ * clocks. */
+static timer_type
+select_timer_auto( void )
+{
+    static const timer_type candidates[] = {
+# if HAVE( BACKEND_SCOREP_TIMER_TSC )
+        TIMER_TSC,
+# endif /* BACKEND_SCOREP_TIMER_TSC */
+# if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+        TIMER_CLOCK_GETTIME,
+# endif /* BACKEND_SCOREP_TIMER_CLOCK_GETTIME */
+# if HAVE( BACKEND_SCOREP_TIMER_GETTIMEOFDAY )
+        TIMER_GETTIMEOFDAY,
+# endif /* BACKEND_SCOREP_TIMER_GETTIMEOFDAY */
+    };
+
+    timer_type best            = TIMER_INVALID;
+    double     best_cost       = INFINITY;
+    double     best_resolution = INFINITY;
+    for ( size_t i = 0; i < sizeof( candidates ) / sizeof( candidates[ 0 ] ); i++ )
+    {
+# if HAVE( BACKEND_SCOREP_TIMER_TSC )
+        if ( candidates[ i ] == TIMER_TSC && !tsc_is_reliable() )
+        {
+            continue;
+        }
+# endif /* BACKEND_SCOREP_TIMER_TSC */
+
+        double cost;
+        double resolution;
+        scorep_timer = candidates[ i ];
+        if ( !benchmark_timer( &cost, &resolution ) )
+        {
+            continue;
+        }
+
+        if ( resolution <= AUTO_MAX_RESOLUTION_NS )
+        {
+            best      = candidates[ i ];
+            best_cost = cost;
+            break;
+        }
+        if ( resolution < best_resolution )
+        {
+            best            = candidates[ i ];
+            best_cost       = cost;
+            best_resolution = resolution;
+        }
+    }
+
+    if ( best == TIMER_INVALID )
+    {
+        /* All timers went backwards during the benchmark, take the last one,
+         * which is the most conservative. */
+        best         = candidates[ sizeof( candidates ) / sizeof( candidates[ 0 ] ) - 1 ];
+        scorep_timer = best;
+        UTILS_WARNING( "Automatic timer selection failed, using \'%s\'.",
+                       SCOREP_Timer_GetName() );
+    }
+    else
+    {
+        scorep_timer = best;
+        read_cost_ns = best_cost;
+    }
+    return best;
+}
+#endif  /* SCOREP_TIMER_AUTO */
+
+
 void
 SCOREP_Timer_Initialize( void )
 {
@@ -87,6 +339,18 @@ SCOREP_Timer_Initialize( void )
         return;
     }
 
+#if HAVE( BACKEND_SCOREP_TIMER_FIXED )
+    UTILS_BUG_ON( scorep_timer != SCOREP_TIMER_FIXED,
+                  "Only the timer fixed at build time can be selected." );
+#endif /* BACKEND_SCOREP_TIMER_FIXED */
+
+#if HAVE( SCOREP_TIMER_AUTO )
+    if ( scorep_timer == TIMER_AUTO )
+    {
+        scorep_timer = select_timer_auto();
+    }
+#endif  /* SCOREP_TIMER_AUTO */
+
     switch ( scorep_timer )
     {
 #if HAVE( BACKEND_SCOREP_TIMER_BGL )
@@ -150,43 +414,34 @@ SCOREP_Timer_Initialize( void )
             /* Check for nonstop_tsc and constant_tsc in /proc/cpuinfo.
              * This seems to be relevant for x86 CPUs only. It is known for
              * Fujitsu and Power8 systems to not provide this info. */
-            FILE*            fp;
-            char*            line           = NULL;
-            size_t           length         = 0;
-            char             proc_cpuinfo[] = "/proc/cpuinfo";
-            SCOREP_ErrorCode status;
-
-            fp = fopen( proc_cpuinfo, "r" );
-            if ( fp == NULL )
+            bool cpuinfo_readable;
+            if ( !cpuinfo_reports_invariant_tsc( &cpuinfo_readable ) )
             {
-                UTILS_ERROR_POSIX( "Cannot check for \'nonstop_tsc\' and \'constant_tsc\' "
-                                   "in %s. Switch to a timer different from "
-                                   "\'tsc\' if you have issues with timings.", proc_cpuinfo );
-            }
-            else
-            {
-                bool constant_and_nonstop_tsc = false;
-                while ( ( status = UTILS_IO_GetLine( &line, &length, fp ) ) == SCOREP_SUCCESS )
+                if ( !cpuinfo_readable )
                 {
-                    if ( strstr( line, "nonstop_tsc" ) != NULL &&
-                         strstr( line, "constant_tsc" ) != NULL )
-                    {
-                        constant_and_nonstop_tsc = true;
-                        break;
-                    }
+#   if HAVE( BACKEND_SCOREP_TIMER_FIXED_TSC )
+                    UTILS_FATAL( "Cannot check for \'nonstop_tsc\' and \'constant_tsc\' "
+                                 "in %s, but this installation reads the tsc timer "
+                                 "unconditionally. Use an installation configured without "
+                                 "\'--with-timer=tsc\' on this system.", proc_cpuinfo );
+#   endif       /* BACKEND_SCOREP_TIMER_FIXED_TSC */
+                    UTILS_ERROR_POSIX( "Cannot check for \'nonstop_tsc\' and \'constant_tsc\' "
+                                       "in %s. Switch to a timer different from "
+                                       "\'tsc\' if you have issues with timings.", proc_cpuinfo );
                 }
-                if ( !constant_and_nonstop_tsc )
+                else
                 {
-                    if ( status != SCOREP_ERROR_END_OF_BUFFER )
-                    {
-                        UTILS_ERROR( status, "Error reading %s for timer consistency check.", proc_cpuinfo );
-                    }
+#   if HAVE( BACKEND_SCOREP_TIMER_FIXED_TSC )
+                    UTILS_FATAL( "From %s, could not determine if tsc timer is (\'nonstop_tsc\' "
+                                 "&& \'constant_tsc\'), but this installation reads the tsc "
+                                 "timer unconditionally. Use an installation configured without "
+                                 "\'--with-timer=tsc\' on this system.", proc_cpuinfo );
+#   endif       /* BACKEND_SCOREP_TIMER_FIXED_TSC */
                     UTILS_WARNING( "From %s, could not determine if tsc timer is (\'nonstop_tsc\' "
                                    "&& \'constant_tsc\'). Timings likely to be unreliable. "
                                    "Switch to a timer different from SCOREP_TIMER=\'tsc\' if you have "
                                    "issues with timings.", proc_cpuinfo );
                 }
-                free( line );
             }
 #  endif    /* HAVE( SCOREP_X86_64_TSC ) || HAVE( SCOREP_X86_32_TSC ) */
 
@@ -231,15 +486,46 @@ SCOREP_Timer_Initialize( void )
             UTILS_FATAL( "Invalid timer selected, shouldn't happen." );
     }
 
+    /* The tsc timer interpolates its frequency, this blocks for about one
+     * millisecond. Do it once, users may ask for the estimate repeatedly. */
+    clock_resolution_estimate = clock_resolution( true );
+
     is_initialized = true;
 }
 
 
-uint64_t
-SCOREP_Timer_GetClockResolution( void )
+#if HAVE( BACKEND_SCOREP_TIMER_TSC ) && !HAVE( SCOREP_ARMV8_TSC )
+/* Interpolates the frequency over the time since initialization, but at least
+ * over one millisecond. Neither cached nor checked across processes. */
+static uint64_t
+tsc_frequency_estimate( void )
+{
+    uint64_t timer_tsc_t1;
+    uint64_t timer_cmp_t1;
+    do
+    {
+        timer_tsc_t1 = SCOREP_Timer_GetClockTicks();
+#  if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+        struct timespec time;
+        int             result = clock_gettime( SCOREP_TIMER_CLOCK_GETTIME_CLK_ID, &time );
+        UTILS_ASSERT( result == 0 );
+        timer_cmp_t1 = ( uint64_t )time.tv_sec * UINT64_C( 1000000000 ) + ( uint64_t )time.tv_nsec;
+#  else  /* HAVE( BACKEND_SCOREP_TIMER_GETTIMEOFDAY ) */
+        struct timeval tp;
+        gettimeofday( &tp, 0 );
+        timer_cmp_t1 =  ( uint64_t )tp.tv_sec * UINT64_C( 1000000 ) + ( uint64_t )tp.tv_usec;
+#  endif
+    }
+    while ( ( timer_cmp_t1 - timer_cmp_t0 ) * 1000 < timer_cmp_freq );
+
+    return ( double )( timer_tsc_t1 - timer_tsc_t0 ) / ( timer_cmp_t1 - timer_cmp_t0 ) * timer_cmp_freq;
+}
+#endif  /* HAVE( BACKEND_SCOREP_TIMER_TSC ) && ! HAVE( SCOREP_ARMV8_TSC ) */
+
+
+static uint64_t
+clock_resolution( bool estimate )
 {
-    UTILS_BUG_ON( !( SCOREP_IS_MEASUREMENT_PHASE( POST ) ),
-                  "Do not call SCOREP_Timer_GetClockResolution before finalization." );
     switch ( scorep_timer )
     {
 #if HAVE( BACKEND_SCOREP_TIMER_BGL )
@@ -280,6 +566,11 @@ SCOREP_Timer_GetClockResolution( void )
             asm ( "mrs %[result], CNTFRQ_EL0\n\t" :[ result ] "=r" ( timer_tsc_freq ) );
             return ( uint64_t )timer_tsc_freq;
 # else      /* ! HAVE( SCOREP_ARMV8_TSC ) */
+            if ( estimate )
+            {
+                return tsc_frequency_estimate();
+            }
+
             uint64_t timer_tsc_t1 = SCOREP_Timer_GetClockTicks();
             /* Either BACKEND_SCOREP_TIMER_CLOCK_GETTIME or
              * BACKEND_SCOREP_TIMER_GETTIMEOFDAY are available, see check in
@@ -422,6 +713,24 @@ SCOREP_Timer_GetClockResolution( void )
 }
 
 
+uint64_t
+SCOREP_Timer_GetClockResolution( void )
+{
+    UTILS_BUG_ON( !( SCOREP_IS_MEASUREMENT_PHASE( POST ) ),
+                  "Do not call SCOREP_Timer_GetClockResolution before finalization." );
+    return clock_resolution( false );
+}
+
+
+uint64_t
+SCOREP_Timer_GetClockResolutionEstimate( void )
+{
+    UTILS_BUG_ON( !is_initialized,
+                  "Do not call SCOREP_Timer_GetClockResolutionEstimate before initialization." );
+    return clock_resolution_estimate;
+}
+
+
 bool
 SCOREP_Timer_ClockIsGlobal( void )
 {
@@ -476,3 +785,24 @@ SCOREP_Timer_ClockIsGlobal( void )
             UTILS_FATAL( "Invalid timer selected, shouldn't happen." );
     }
 }
+
+
+const char*
+SCOREP_Timer_GetName( void )
+{
+    for ( const SCOREP_ConfigType_SetEntry* entry = timer_table; entry->name; entry++ )
+    {
+        if ( entry->value == scorep_timer )
+        {
+            return entry->name;
+        }
+    }
+    return "invalid";
+}
+
+
+double
+SCOREP_Timer_GetReadCost( void )
+{
+    return read_cost_ns;
+}
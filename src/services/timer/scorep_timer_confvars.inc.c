@@ -4,7 +4,7 @@
  * Copyright (c) 2015,
  * Forschungszentrum Juelich GmbH, Germany
  *
- * Copyright (c) 2019,
+ * Copyright (c) 2019, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * This software may be modified and distributed under the terms of
@@ -29,7 +29,7 @@
 #include <stddef.h>
 
 static const SCOREP_ConfigType_SetEntry timer_table[] = {
-#if HAVE( BACKEND_SCOREP_TIMER_BGL )
+#if HAVE( BACKEND_SCOREP_TIMER_BGL ) && SCOREP_TIMER_SELECTABLE( BGL )
     {
         "bgl",
         TIMER_BGL,
@@ -37,7 +37,7 @@ static const SCOREP_ConfigType_SetEntry timer_table[] = {
     },
 #endif /* BACKEND_SCOREP_TIMER_BGL */
 
-#if HAVE( BACKEND_SCOREP_TIMER_BGP )
+#if HAVE( BACKEND_SCOREP_TIMER_BGP ) && SCOREP_TIMER_SELECTABLE( BGP )
     {
         "bgp",
         TIMER_BGP,
@@ -45,7 +45,7 @@ static const SCOREP_ConfigType_SetEntry timer_table[] = {
     },
 #endif /* BACKEND_SCOREP_TIMER_BGP */
 
-#if HAVE( BACKEND_SCOREP_TIMER_BGQ )
+#if HAVE( BACKEND_SCOREP_TIMER_BGQ ) && SCOREP_TIMER_SELECTABLE( BGQ )
     {
         "bgq",
         TIMER_BGQ,
@@ -53,7 +53,7 @@ static const SCOREP_ConfigType_SetEntry timer_table[] = {
     },
 #endif /* BACKEND_SCOREP_TIMER_BGQ */
 
-#if HAVE( BACKEND_SCOREP_TIMER_MINGW )
+#if HAVE( BACKEND_SCOREP_TIMER_MINGW ) && SCOREP_TIMER_SELECTABLE( MINGW )
     {
         "mingw",
         TIMER_MINGW,
@@ -61,7 +61,7 @@ static const SCOREP_ConfigType_SetEntry timer_table[] = {
     },
 #endif /* BACKEND_SCOREP_TIMER_MINGW */
 
-#if HAVE( BACKEND_SCOREP_TIMER_AIX )
+#if HAVE( BACKEND_SCOREP_TIMER_AIX ) && SCOREP_TIMER_SELECTABLE( AIX )
     {
         "aix",
         TIMER_AIX,
@@ -69,7 +69,7 @@ static const SCOREP_ConfigType_SetEntry timer_table[] = {
     },
 #endif /* BACKEND_SCOREP_TIMER_AIX */
 
-#if HAVE( BACKEND_SCOREP_TIMER_MAC )
+#if HAVE( BACKEND_SCOREP_TIMER_MAC ) && SCOREP_TIMER_SELECTABLE( MAC )
     {
         "mac",
         TIMER_MAC,
@@ -77,7 +77,7 @@ static const SCOREP_ConfigType_SetEntry timer_table[] = {
     },
 #endif /* BACKEND_SCOREP_TIMER_MAC */
 
-#if HAVE( BACKEND_SCOREP_TIMER_TSC )
+#if HAVE( BACKEND_SCOREP_TIMER_TSC ) && SCOREP_TIMER_SELECTABLE( TSC )
     {
         "tsc",
         TIMER_TSC,
@@ -85,7 +85,7 @@ static const SCOREP_ConfigType_SetEntry timer_table[] = {
     },
 #endif /* BACKEND_SCOREP_TIMER_TSC */
 
-#if HAVE( BACKEND_SCOREP_TIMER_GETTIMEOFDAY )
+#if HAVE( BACKEND_SCOREP_TIMER_GETTIMEOFDAY ) && SCOREP_TIMER_SELECTABLE( GETTIMEOFDAY )
     {
         "gettimeofday",
         TIMER_GETTIMEOFDAY,
@@ -93,7 +93,7 @@ static const SCOREP_ConfigType_SetEntry timer_table[] = {
     },
 #endif /* BACKEND_SCOREP_TIMER_GETTIMEOFDAY */
 
-#if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME )
+#if HAVE( BACKEND_SCOREP_TIMER_CLOCK_GETTIME ) && SCOREP_TIMER_SELECTABLE( CLOCK_GETTIME )
     {
         "clock_gettime",
         TIMER_CLOCK_GETTIME,
@@ -101,6 +101,18 @@ static const SCOREP_ConfigType_SetEntry timer_table[] = {
     },
 #endif /* BACKEND_SCOREP_TIMER_CLOCK_GETTIME */
 
+#if HAVE( SCOREP_TIMER_AUTO )
+    {
+        "auto",
+        TIMER_AUTO,
+        "Selects the first of tsc, clock_gettime, and gettimeofday with "
+        "sufficient resolution. The tsc timer is only considered if it is "
+        "invariant and synchronized across cores. The choice does not depend "
+        "on measured read costs, thus all processes on equal nodes select "
+        "the same timer."
+    },
+#endif /* SCOREP_TIMER_AUTO */
+
     { NULL, 0, NULL }
 };
 
@@ -1,7 +1,7 @@
 /*
  * This file is part of the Score-P software (http://www.score-p.org)
  *
- * Copyright (c) 2015,
+ * Copyright (c) 2015, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * This software may be modified and distributed under the terms of
@@ -21,11 +21,33 @@
  * Sampling setup
  */
 
+/**
+ * Reuse the unchanged outer part of the previously unwound stack.
+ */
+bool scorep_unwinding_incremental;
+
 /**
  * Array of configuration variables.
  * They are registered to the measurement system and are filled during
  * until the initialization function is called.
  */
 static const SCOREP_ConfigVariable scorep_unwinding_confvars[] = {
+    {
+        "incremental",
+        SCOREP_CONFIG_TYPE_BOOL,
+        &scorep_unwinding_incremental,
+        NULL,
+        "false",
+        "Stop unwinding at frames known from the previous unwinding",
+        "Each location remembers the stack pointer and instruction address of "
+        "all frames of the last unwound stack. Unwinding stops as soon as a "
+        "frame and its caller match this cached stack and the remaining "
+        "frames, including their calling-context nodes, are taken from the "
+        "cache.\n"
+        "Frames are identified only by their stack pointer and instruction "
+        "address. A function which returned and was re-entered from a "
+        "different call path with an identical stack layout may thus be "
+        "attributed to the previous call path."
+    },
     SCOREP_CONFIG_TERMINATOR
 };
@@ -1,7 +1,7 @@
 /*
  * This file is part of the Score-P software (http://www.score-p.org)
  *
- * Copyright (c) 2015, 2017,
+ * Copyright (c) 2015, 2017, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * This software may be modified and distributed under the terms of
@@ -331,15 +331,18 @@ get_unused( SCOREP_Unwinding_CpuLocationData* unwindData )
  * @param[inout] stack  The top of the stack.
  * @param region        The region to push
  * @param ip            The instruction address inside the @p region
+ * @param sp            The stack pointer of this frame
  */
 static void
 push_stack( SCOREP_Unwinding_CpuLocationData* unwindData,
             scorep_unwinding_frame**          stack,
             scorep_unwinding_region*          region,
-            uint64_t                          ip )
+            uint64_t                          ip,
+            uint64_t                          sp )
 {
     scorep_unwinding_frame* frame = get_unused( unwindData );
     frame->ip     = ip;
+    frame->sp     = sp;
     frame->region = region;
     frame->next   = *stack;
     *stack        = frame;
@@ -384,6 +387,111 @@ get_current_ip( SCOREP_Unwinding_CpuLocationData* unwindData )
     return ip;
 }
 
+/** Gets the stack pointer from the current stack frame
+ *
+ *  @param unwindData             Unwinding data of the location
+ */
+static uint64_t
+get_current_sp( SCOREP_Unwinding_CpuLocationData* unwindData )
+{
+    unw_word_t sp;
+    int        ret = unw_get_reg( &unwindData->cursor, UNW_REG_SP, &sp );
+    if ( ret < 0 )
+    {
+        UTILS_DEBUG( "Could not get SP register (unw_get_reg() returned %s)", unw_strerror( ret ) );
+        return 0;
+    }
+    return sp;
+}
+
+/**
+ * Looks for the frame with stack pointer @a sp and instruction address @a ip
+ * in the cached stack.
+ *
+ * As we step outwards the stack pointer grows, thus @a cacheIndex is only
+ * moved outwards too and the whole unwinding visits each cached frame at
+ * most once.
+ *
+ * @param unwindData        Unwinding data of the location
+ * @param[inout] cacheIndex Innermost cached frame which may still match
+ * @param sp                Stack pointer of the current frame
+ * @param ip                Instruction address of the current frame
+ *
+ * @return Index of the matching cached frame or -1.
+ */
+static int64_t
+find_cached_frame( SCOREP_Unwinding_CpuLocationData* unwindData,
+                   int64_t*                          cacheIndex,
+                   uint64_t                          sp,
+                   uint64_t                          ip )
+{
+    while ( *cacheIndex >= 0 && unwindData->cached_stack[ *cacheIndex ].sp < sp )
+    {
+        ( *cacheIndex )--;
+    }
+    if ( *cacheIndex >= 0
+         && unwindData->cached_stack[ *cacheIndex ].sp == sp
+         && unwindData->cached_stack[ *cacheIndex ].ip == ip )
+    {
+        return *cacheIndex;
+    }
+    return -1;
+}
+
+/**
+ * Stores the new frames of @a stack in the cached stack. The outermost
+ * @a cached_stack_reused frames were taken from the cache and are kept,
+ * including their calling context nodes.
+ *
+ * @param unwindData    Unwinding data of the location
+ * @param stack         The current stack, outermost frame first
+ */
+static void
+update_cached_stack( SCOREP_Unwinding_CpuLocationData* unwindData,
+                     scorep_unwinding_frame*           stack )
+{
+    uint32_t depth = 0;
+    for ( scorep_unwinding_frame* frame = stack; frame; frame = frame->next )
+    {
+        depth++;
+    }
+
+    if ( depth > unwindData->cached_stack_capacity )
+    {
+        uint32_t capacity = unwindData->cached_stack_capacity ? unwindData->cached_stack_capacity : 64;
+        while ( capacity < depth )
+        {
+            capacity *= 2;
+        }
+
+        /* Misc memory can't be freed, the old cache is simply dropped */
+        scorep_unwinding_cached_frame* cached_stack =
+            SCOREP_Location_AllocForMisc( unwindData->location,
+                                          capacity * sizeof( *cached_stack ) );
+        memcpy( cached_stack,
+                unwindData->cached_stack,
+                unwindData->cached_stack_reused * sizeof( *cached_stack ) );
+        unwindData->cached_stack          = cached_stack;
+        unwindData->cached_stack_capacity = capacity;
+    }
+
+    uint32_t                index = 0;
+    scorep_unwinding_frame* frame = stack;
+    for (; index < unwindData->cached_stack_reused; index++ )
+    {
+        frame = frame->next;
+    }
+    for (; frame; frame = frame->next, index++ )
+    {
+        scorep_unwinding_cached_frame* cached_frame = &unwindData->cached_stack[ index ];
+        cached_frame->sp             = frame->sp;
+        cached_frame->ip             = frame->ip;
+        cached_frame->region         = frame->region;
+        cached_frame->unwind_context = NULL;
+    }
+    unwindData->cached_stack_depth = depth;
+}
+
 /** Creates the current stack out of the unwind cursor
  *
  *  @param unwindData             Unwinding data of the location
@@ -471,6 +579,12 @@ get_current_stack( SCOREP_Unwinding_CpuLocationData* unwindData )
 {
     scorep_unwinding_frame* current_stack = NULL;
 
+    /* For incremental unwinding: the innermost cached frame which may still
+     * match and a matching cached frame whose caller needs to match too */
+    int64_t cache_index = ( int64_t )unwindData->cached_stack_depth - 1;
+    int64_t candidate   = -1;
+    unwindData->cached_stack_reused = 0;
+
     UTILS_DEBUG_ENTRY();
 
     int ret = 1;
@@ -489,6 +603,31 @@ get_current_stack( SCOREP_Unwinding_CpuLocationData* unwindData )
             break;
         }
 
+        uint64_t sp     = 0;
+        int64_t  cached = -1;
+        if ( scorep_unwinding_incremental )
+        {
+            sp     = get_current_sp( unwindData );
+            cached = find_cached_frame( unwindData, &cache_index, sp, ip - use_prev_instr );
+
+            /* The candidate and its caller are unchanged since the last
+             * unwinding, take the remaining frames from the cache */
+            if ( candidate >= 0 && cached == candidate - 1 )
+            {
+                for (; cached >= 0; cached-- )
+                {
+                    scorep_unwinding_cached_frame* cached_frame = &unwindData->cached_stack[ cached ];
+                    push_stack( unwindData, &current_stack,
+                                cached_frame->region,
+                                cached_frame->ip,
+                                cached_frame->sp );
+                }
+                unwindData->cached_stack_reused = candidate + 1;
+                UTILS_DEBUG( " Break on cached frame %" PRIi64, candidate );
+                break;
+            }
+        }
+
         /* lock-up the region by the IP */
         scorep_unwinding_region* region = get_region( unwindData, &unwindData->cursor, ip );
 
@@ -500,7 +639,18 @@ get_current_stack( SCOREP_Unwinding_CpuLocationData* unwindData )
         }
 
         /* Honor this frame in the backtrace */
-        push_stack( unwindData, &current_stack, region, ip - use_prev_instr );
+        push_stack( unwindData, &current_stack, region, ip - use_prev_instr, sp );
+
+        if ( cached == 0 )
+        {
+            /* The outermost cached frame has no caller to check */
+            unwindData->cached_stack_reused = 1;
+            UTILS_DEBUG( " Break on outermost cached frame" );
+            break;
+        }
+        /* Skipped frames are not in the cache, thus the candidate is only
+           replaced by honored frames */
+        candidate = cached;
 
         /* Break if this is a compiler-specific fork region */
         if ( region->is_fork )
@@ -525,6 +675,11 @@ get_current_stack( SCOREP_Unwinding_CpuLocationData* unwindData )
         UTILS_DEBUG( "unwinding %s: unw_step() returned 0" );
     }
 
+    if ( scorep_unwinding_incremental )
+    {
+        update_cached_stack( unwindData, current_stack );
+    }
+
     return current_stack;
 }
 
@@ -893,6 +1048,29 @@ scorep_unwinding_cpu_handle_enter( SCOREP_Unwinding_CpuLocationData* unwindData,
     *unwindDistance = 1;
     scorep_unwinding_calling_context_tree_node* unwind_context = &unwindData->calling_context_root;
 
+    /* When descending from the root, the calling context nodes of the
+       frames are remembered in the cached stack */
+    bool     update_cache = scorep_unwinding_incremental && !unwindData->augmented_stack;
+    uint32_t cached_depth = 0;
+    if ( update_cache
+         && instrumentedRegionHandle == SCOREP_INVALID_REGION
+         && !new_surrogates
+         && unwindData->cached_stack_reused > 0
+         && unwindData->cached_stack[ unwindData->cached_stack_reused - 1 ].unwind_context )
+    {
+        /* A plain sample, no augmented frames are needed, thus skip the
+           descent for all frames taken from the cache */
+        while ( cached_depth < unwindData->cached_stack_reused )
+        {
+            scorep_unwinding_frame* frame = current_stack;
+            current_stack = current_stack->next;
+            put_unused( unwindData, frame );
+            cached_depth++;
+        }
+        unwind_context   = unwindData->cached_stack[ cached_depth - 1 ].unwind_context;
+        *unwindDistance += cached_depth;
+    }
+
     /* If we have instrumented regions on the stack, determine the unwind context
      * and the tail of the current unwind stack. */
     if ( unwindData->augmented_stack )
@@ -957,6 +1135,10 @@ scorep_unwinding_cpu_handle_enter( SCOREP_Unwinding_CpuLocationData* unwindData,
                                  unwindDistance,
                                  current_stack->ip,
                                  current_stack->region->handle );
+        if ( update_cache )
+        {
+            unwindData->cached_stack[ cached_depth++ ].unwind_context = unwind_context;
+        }
 
         /* We want to enter an instrumented region, thus we need to create
            the augmented stack, thus convert the current frame to an augmented
@@ -1155,6 +1337,8 @@ scorep_unwinding_cpu_deactivate( SCOREP_Unwinding_CpuLocationData* unwindData )
     SCOREP_Location_DeactivateCpuSample( unwindData->location,
                                          unwindData->previous_calling_context );
     unwindData->previous_calling_context = SCOREP_INVALID_CALLING_CONTEXT;
+    unwindData->cached_stack_depth       = 0;
+    unwindData->cached_stack_reused      = 0;
 }
 
 void
@@ -39,6 +39,9 @@
 /** Our subsystem id, used to address our per-location unwinding data */
 extern size_t scorep_unwinding_subsystem_id;
 
+/** Whether to reuse the unchanged part of the last unwound stack */
+extern bool scorep_unwinding_incremental;
+
 
 /**
  * A record of this type associates the start instruction of a function
@@ -98,11 +101,30 @@ typedef struct scorep_unwinding_frame
     struct scorep_unwinding_frame* next;
     /** The instruction address for this frame */
     uint64_t                       ip;
+    /** The stack pointer of this frame, only used for incremental unwinding */
+    uint64_t                       sp;
     /** The region for this frame */
     scorep_unwinding_region*       region;
 } scorep_unwinding_frame;
 
 
+/**
+ * A frame of the last unwound stack, used for incremental unwinding.
+ */
+typedef struct scorep_unwinding_cached_frame
+{
+    /** The stack pointer of this frame */
+    uint64_t                                    sp;
+    /** The instruction address for this frame */
+    uint64_t                                    ip;
+    /** The region for this frame */
+    scorep_unwinding_region*                    region;
+    /** The calling context node reached by descending from the root
+     *  through this frame, NULL if not known */
+    scorep_unwinding_calling_context_tree_node* unwind_context;
+} scorep_unwinding_cached_frame;
+
+
 /**
  * Object for a replaced region in the augmented stack.
  */
@@ -206,6 +228,16 @@ typedef struct SCOREP_Unwinding_CpuLocationData
     /** Last known calling context */
     SCOREP_CallingContextHandle previous_calling_context;
 
+    /** The last unwound stack, outermost frame first */
+    scorep_unwinding_cached_frame* cached_stack;
+    /** Number of frames in @a cached_stack */
+    uint32_t                       cached_stack_depth;
+    /** Number of allocated frames in @a cached_stack */
+    uint32_t                       cached_stack_capacity;
+    /** Number of outermost frames of the last unwinding taken from
+     *  @a cached_stack */
+    uint32_t                       cached_stack_reused;
+
     /* Below is storage normally allocated on the stack.
        As they are rather big, we allocate them in the per-location data.
        None of these variables are used in recursive calls. */
@@ -4,7 +4,7 @@
  * Copyright (c) 2013, 2019-2020, 2022-2024,
  * Forschungszentrum Juelich GmbH, Germany
  *
- * Copyright (c) 2013-2016, 2019, 2021,
+ * Copyright (c) 2013-2016, 2019, 2021, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * This software may be modified and distributed under the terms of
@@ -187,8 +187,102 @@ write_tcollect_file_rules( void*       userData,
 
 #if HAVE_BACKEND(SCOREP_COMPILER_INSTRUMENTATION_XRAY_PLUGIN)
 
+#if HAVE(POSIX_PIPES)
+
+/**
+ * Lists the names of the functions defined in the given objects via nm
+ * @param objects Space separated list of object files and static libraries
+ * @param demangle Whether to list demangled names
+ * @return The names in symbol table order, empty on error
+ */
+static std::vector<std::string> listFunctionSymbols(const std::string &objects, bool demangle) {
+    std::vector<std::string> names;
+    std::string command = SCOREP_NM " -p --defined-only" + std::string(demangle ? " -C" : "") + objects
+                          + " 2>/dev/null";
+    FILE *console = popen(command.c_str(), "r");
+    if (console == NULL) {
+        return names;
+    }
+    char line[4096];
+    while (fgets(line, sizeof(line), console)) {
+        // "<value> <type> <name>", the demangled name may contain spaces
+        std::istringstream fields(line);
+        std::string value;
+        std::string type;
+        std::string name;
+        fields >> value >> type;
+        std::getline(fields >> std::ws, name);
+        if (type.size() == 1 && std::string("TtWw").find(type[0]) != std::string::npos && !name.empty()) {
+            names.push_back(name);
+        }
+    }
+    pclose(console);
+    return names;
+}
+
+/**
+ * Adds the functions defined in the given objects and static libraries to the converter
+ * @param objects Space separated list of object files and static libraries
+ */
+static void addObjectSymbols(XRayPlugin::FilterConverter &conv, const std::string &objects) {
+    std::vector<std::string> mangled = listFunctionSymbols(objects, false);
+    std::vector<std::string> demangled = listFunctionSymbols(objects, true);
+    if (mangled.size() == demangled.size()) {
+        conv.addSymbols(mangled, demangled);
+    }
+}
+
+/**
+ * Adds the functions defined in the source file, the objects, and the static libraries on the command line to the
+ * converter, so that demangled filter rules can be resolved to the mangled names XRay uses. The object of the
+ * source file does not exist before it is compiled with the converted list, thus the source file is compiled once
+ * without instrumentation into a temporary object. This is only done if the filter needs the symbols, see
+ * FilterConverter::needsSymbols().
+ */
+static void addXraySymbols(XRayPlugin::FilterConverter &conv, SCOREP_Instrumenter_CmdLine &cmdLine,
+                           const std::string &inputFile) {
+    std::stringstream objects;
+    for (const std::string &file: *cmdLine.getInputFiles()) {
+        if (is_object_file(file) || is_library(file, false)) {
+            objects << " " << file;
+        }
+    }
+    objects << cmdLine.getLibraryFiles(false);
+    if (objects.str().find_first_not_of(' ') != std::string::npos) {
+        addObjectSymbols(conv, objects.str());
+    }
+
+    if (inputFile.empty() || is_object_file(inputFile) || is_library(inputFile, false)
+        || !conv.needsSymbols()) {
+        return;
+    }
+    std::string object = remove_extension(remove_path(inputFile)) + ".scorep_xray_symbols_"
+                         + create_random_string() + ".o";
+    std::string command = SCOREP_Instrumenter_InstallData::getCompilerEnvironmentVars()
+                          + cmdLine.getCompilerName()
+                          + " " + cmdLine.getFlagsBeforeInterpositionLib()
+                          + " " + cmdLine.getFlagsAfterInterpositionLib()
+                          + " -c " + inputFile
+                          + " -o " + object;
+    if (cmdLine.getVerbosity() >= 1) {
+        std::cerr << command << std::endl;
+        if (cmdLine.isDryRun()) {
+            return;
+        }
+    }
+    if (system((command + " >/dev/null 2>&1").c_str()) == 0) {
+        addObjectSymbols(conv, " " + object);
+    } else {
+        UTILS_WARNING("Could not compile '%s' to resolve the demangled names of the instrumentation filter.",
+                      inputFile.c_str());
+    }
+    remove(object.c_str());
+}
+
+#endif
+
 inline void addXrayFlags(std::string &flags, SCOREP_Instrumenter_CmdLine &cmdLine, XRayPlugin::Config xrayConfig,
-                         const std::vector<std::string> &userArgs) {
+                         const std::vector<std::string> &userArgs, const std::string &inputFile) {
     flags += " --compiler-arg=-fxray-instruction-threshold=" + std::to_string(xrayConfig.instructionThreshold);
 
     // Now check for user instrument filters
@@ -196,6 +290,10 @@ inline void addXrayFlags(std::string &flags, SCOREP_Instrumenter_CmdLine &cmdLin
     if (!filter_files.empty()) {
         for (const std::string &filter_file: filter_files) {
             XRayPlugin::FilterConverter conv(filter_file);
+            conv.addSourceFile(inputFile);
+#if HAVE(POSIX_PIPES)
+            addXraySymbols(conv, cmdLine, inputFile);
+#endif
             std::string outPath(filter_file + ".scorep_xray_autoconvert_" + create_random_string() + ".txt");
             bool success = conv.saveAsXRay(outPath);
             if (!success) {
@@ -330,7 +428,7 @@ std::string SCOREP_Instrumenter_CompilerAdapter::getConfigToolFlag(SCOREP_Instru
         FILTER_LLVM_PLUGIN
         OPTIONS_LLVM_PLUGIN
 #elif HAVE_BACKEND(SCOREP_COMPILER_INSTRUMENTATION_CC_XRAY_PLUGIN)
-        addXrayFlags(flags, cmdLine, xrayConfig, m_xray_plugin_args);
+        addXrayFlags(flags, cmdLine, xrayConfig, m_xray_plugin_args, inputFile);
 #endif
     } else if (is_cpp_file(inputFile)) {
 #if HAVE_BACKEND(SCOREP_COMPILER_INSTRUMENTATION_CXX_GCC_PLUGIN)
@@ -341,7 +439,7 @@ std::string SCOREP_Instrumenter_CompilerAdapter::getConfigToolFlag(SCOREP_Instru
         FILTER_LLVM_PLUGIN
         OPTIONS_LLVM_PLUGIN
 #elif HAVE_BACKEND(SCOREP_COMPILER_INSTRUMENTATION_CXX_XRAY_PLUGIN)
-        addXrayFlags(flags, cmdLine, xrayConfig, m_xray_plugin_args);
+        addXrayFlags(flags, cmdLine, xrayConfig, m_xray_plugin_args, inputFile);
 #endif  /* SCOREP_BACKEND_COMPILER_CXX_INTEL */
     } else if (is_fortran_file(inputFile)) {
 #if HAVE_BACKEND(SCOREP_COMPILER_INSTRUMENTATION_FC_GCC_PLUGIN)
@@ -352,7 +450,7 @@ std::string SCOREP_Instrumenter_CompilerAdapter::getConfigToolFlag(SCOREP_Instru
         FILTER_LLVM_PLUGIN
         OPTIONS_LLVM_PLUGIN
 #elif HAVE_BACKEND(SCOREP_COMPILER_INSTRUMENTATION_FC_XRAY_PLUGIN)
-        addXrayFlags(flags, cmdLine, xrayConfig, m_xray_plugin_args);
+        addXrayFlags(flags, cmdLine, xrayConfig, m_xray_plugin_args, inputFile);
 #endif  /* SCOREP_BACKEND_COMPILER_FC_INTEL */
     } else if (is_cuda_file(inputFile)) {
 #if HAVE_BACKEND(SCOREP_COMPILER_INSTRUMENTATION_CXX_LLVM_PLUGIN)
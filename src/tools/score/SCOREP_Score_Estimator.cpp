@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2016, 2019,
+ * Copyright (c) 2009-2016, 2019, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -49,17 +49,27 @@
 #include "SCOREP_Score_Types.hpp"
 #include <SCOREP_Filter.h>
 #include <scorep_tools_utils.hpp>
+#if HAVE( XRAY_PLUGIN_SUPPORT )
+#include <scorep_xray_filter_converter.hpp>
+#endif
 #include <math.h>
 #include <fstream>
 #include <iomanip>
+#include <sstream>
 #include <deque>
 #include <limits>
 #include <algorithm>
+#if HAVE( SCORE_THREADS )
+#include <thread>
+#endif
 
 using namespace std;
 
 #define SCOREP_SCORE_BUFFER_SIZE 128
 
+/* Memory for one block of call path rows, see SCOREP_Score_Estimator::calculate */
+#define SCOREP_SCORE_ROWS_MEMORY ( 256 * 1024 * 1024 )
+
 /* **************************************************************************************
                                                                        internal functions
 ****************************************************************************************/
@@ -192,6 +202,27 @@ get_user_readable_byte_no( uint64_t bytes )
     return result.str();
 }
 
+/**
+ * Returns the instrumentation method of a region of the given paradigm, as
+ * used in the calibration file, or an empty string if the overhead of this
+ * paradigm is not predicted.
+ */
+static string
+get_instrumentation_method( const string& paradigm )
+{
+    if ( paradigm == "compiler" || paradigm == "user" )
+    {
+        return paradigm;
+    }
+    if ( paradigm == "mpi" || paradigm == "shmem" || paradigm == "pthread" ||
+         paradigm == "memory" || paradigm == "io" ||
+         0 == paradigm.compare( 0, 8, "libwrap:" ) )
+    {
+        return "library";
+    }
+    return "";
+}
+
 // Compare functions for the stable sort depending on sorting type
 static bool
 compare_maxbuffer( SCOREP_Score_Group* const& a, SCOREP_Score_Group* const& b )
@@ -244,6 +275,7 @@ SCOREP_Score_Estimator::SCOREP_Score_Estimator( SCOREP_Score_Profile*    profile
     , m_bytes_per_num_parameter( 0 )
     , m_bytes_per_str_parameter( 0 )
     , m_bytes_per_hit( 0 )
+    , m_has_overhead( false )
     , m_total_time( 0 )
     , m_max_buf( 0 )
     , m_total_buf( 0 )
@@ -696,6 +728,66 @@ SCOREP_Score_Estimator::initializeFilter( const string& filterFile )
     m_has_filter = true;
 }
 
+void
+SCOREP_Score_Estimator::initializeOverhead( const string& calibrationFile,
+                                            const string& substrates )
+{
+    ifstream calibration( calibrationFile.c_str() );
+    if ( !calibration )
+    {
+        cerr << "ERROR: Failed to open '" << calibrationFile << "'" << endl;
+        exit( EXIT_FAILURE );
+    }
+
+    /* Each line has the format <method> <substrates> <ns per visit> */
+    map< string, double > cost_per_method;
+    string                line;
+    while ( getline( calibration, line ) )
+    {
+        if ( line.empty() || line[ 0 ] == '#' )
+        {
+            continue;
+        }
+        istringstream fields( line );
+        string        method;
+        string        line_substrates;
+        double        cost;
+        if ( !( fields >> method >> line_substrates >> cost ) || cost < 0 )
+        {
+            cerr << "ERROR: Invalid line in calibration file '" << calibrationFile
+                 << "': '" << line << "'" << endl;
+            exit( EXIT_FAILURE );
+        }
+        if ( line_substrates == substrates )
+        {
+            cost_per_method[ method ] = cost * 1e-9;
+        }
+    }
+    if ( cost_per_method.empty() )
+    {
+        cerr << "ERROR: No calibration for '" << substrates << "' in '"
+             << calibrationFile << "'" << endl;
+        exit( EXIT_FAILURE );
+    }
+
+    m_overhead_per_visit.assign( m_region_num, 0 );
+    for ( uint64_t region = 0; region < m_region_num; region++ )
+    {
+        string method = get_instrumentation_method( m_profile->getRegionParadigm( region ) );
+        if ( method.empty() )
+        {
+            continue;
+        }
+        map< string, double >::const_iterator it = cost_per_method.find( method );
+        if ( it != cost_per_method.end() )
+        {
+            m_overhead_per_visit[ region ] = it->second;
+        }
+    }
+
+    m_overhead_substrates = substrates;
+    m_has_overhead        = true;
+}
 
 uint64_t
 SCOREP_Score_Estimator::bytesPerVisit( uint64_t region )
@@ -722,9 +814,47 @@ SCOREP_Score_Estimator::bytesPerVisit( uint64_t region )
 
 
 
+/**
+ * The groups of one estimation thread. They cover only the processes
+ * [first_process, first_process + num_processes).
+ */
+struct SCOREP_Score_Estimator::Accumulator
+{
+    uint64_t             first_process;
+    uint64_t             num_processes;
+    SCOREP_Score_Group** groups;
+    SCOREP_Score_Group** regions;
+    SCOREP_Score_Group** filtered;
+};
+
+static SCOREP_Score_Group**
+new_partial_groups( uint64_t num,
+                    uint64_t processes )
+{
+    SCOREP_Score_Group** groups = ( SCOREP_Score_Group** )malloc( num * sizeof( SCOREP_Score_Group* ) );
+    for ( uint64_t i = 0; i < num; i++ )
+    {
+        groups[ i ] = new SCOREP_Score_Group( i, processes, "" );
+    }
+    return groups;
+}
+
+static void
+merge_groups( SCOREP_Score_Group** groups,
+              SCOREP_Score_Group** partialGroups,
+              uint64_t             num,
+              uint64_t             firstProcess )
+{
+    for ( uint64_t i = 0; i < num; i++ )
+    {
+        groups[ i ]->merge( *partialGroups[ i ], firstProcess );
+    }
+}
+
 void
-SCOREP_Score_Estimator::calculate( bool showRegions,
-                                   bool useMangled )
+SCOREP_Score_Estimator::calculate( bool     showRegions,
+                                   bool     useMangled,
+                                   uint32_t numThreads )
 {
     /* we need access to this predicate in our operator() */
     m_show_regions = showRegions;
@@ -733,10 +863,134 @@ SCOREP_Score_Estimator::calculate( bool showRegions,
         initialize_regions( useMangled );
     }
 
-    /* Apply region data for each process */
-    for ( uint64_t process = 0; process < m_process_num; process++ )
+    if ( m_has_filter )
+    {
+        m_region_filtered.resize( m_region_num );
+        for ( uint64_t region = 0; region < m_region_num; region++ )
+        {
+            m_region_filtered[ region ] = match_filter( region );
+        }
+    }
+
+    if ( m_process_num == 0 )
+    {
+        return;
+    }
+
+#if HAVE( SCORE_THREADS )
+    if ( numThreads == 0 )
     {
-        m_profile->iterateCalltree( process, *this );
+        numThreads = std::thread::hardware_concurrency();
+    }
+#else
+    numThreads = 1;
+#endif
+    numThreads = max< uint64_t >( 1, min< uint64_t >( numThreads, m_process_num ) );
+
+    /* Each thread accumulates a contiguous range of processes */
+    vector< Accumulator > accumulators( numThreads );
+    for ( uint32_t i = 0; i < numThreads; i++ )
+    {
+        Accumulator& accumulator = accumulators[ i ];
+        accumulator.first_process = m_process_num * i / numThreads;
+        accumulator.num_processes = m_process_num * ( i + 1 ) / numThreads
+                                    - accumulator.first_process;
+        accumulator.groups = new_partial_groups( SCOREP_SCORE_TYPE_NUM,
+                                                 accumulator.num_processes );
+        accumulator.regions = m_show_regions
+                              ? new_partial_groups( m_region_num, accumulator.num_processes )
+                              : NULL;
+        accumulator.filtered = m_has_filter
+                               ? new_partial_groups( SCOREP_SCORE_TYPE_NUM, accumulator.num_processes )
+                               : NULL;
+    }
+
+    /* Stream the profile in blocks of call paths with bounded memory. The
+     * next block is loaded while the threads process the current one. */
+    uint64_t bytes_per_callpath = m_process_num * ( 2 * sizeof( uint64_t ) + sizeof( double ) );
+    uint64_t block_size         = max< uint64_t >( 1, SCOREP_SCORE_ROWS_MEMORY / bytes_per_callpath );
+    uint64_t num_callpaths      = m_profile->getNumberOfCallpaths();
+
+    SCOREP_Score_CallpathRows rows[ 2 ];
+    uint32_t                  current = 0;
+    m_profile->loadCallpathRows( 0, min( block_size, num_callpaths ), rows[ current ] );
+    for ( uint64_t first = 0; first < num_callpaths; first += block_size )
+    {
+        uint64_t next_first = first + block_size;
+        uint64_t next_size  = next_first < num_callpaths
+                              ? min( block_size, num_callpaths - next_first )
+                              : 0;
+#if HAVE( SCORE_THREADS )
+        vector< std::thread > workers;
+        for ( uint32_t i = 0; i < numThreads; i++ )
+        {
+            workers.emplace_back( &SCOREP_Score_Estimator::estimate_rows, this,
+                                  std::cref( rows[ current ] ), &accumulators[ i ] );
+        }
+        if ( next_size )
+        {
+            m_profile->loadCallpathRows( next_first, next_size, rows[ 1 - current ] );
+        }
+        for ( auto& worker : workers )
+        {
+            worker.join();
+        }
+#else
+        estimate_rows( rows[ current ], &accumulators[ 0 ] );
+        if ( next_size )
+        {
+            m_profile->loadCallpathRows( next_first, next_size, rows[ 1 - current ] );
+        }
+#endif
+        current = 1 - current;
+    }
+
+    for ( auto& accumulator : accumulators )
+    {
+        merge_groups( m_groups, accumulator.groups,
+                      SCOREP_SCORE_TYPE_NUM, accumulator.first_process );
+        delete_groups( accumulator.groups, SCOREP_SCORE_TYPE_NUM );
+        if ( m_show_regions )
+        {
+            merge_groups( m_regions, accumulator.regions,
+                          m_region_num, accumulator.first_process );
+            delete_groups( accumulator.regions, m_region_num );
+        }
+        if ( m_has_filter )
+        {
+            merge_groups( m_filtered, accumulator.filtered,
+                          SCOREP_SCORE_TYPE_NUM, accumulator.first_process );
+            delete_groups( accumulator.filtered, SCOREP_SCORE_TYPE_NUM );
+        }
+    }
+}
+
+void
+SCOREP_Score_Estimator::estimate_rows( const SCOREP_Score_CallpathRows& rows,
+                                       Accumulator*                     accumulator )
+{
+    for ( uint64_t process = accumulator->first_process;
+          process < accumulator->first_process + accumulator->num_processes;
+          process++ )
+    {
+        for ( uint64_t i = 0; i < rows.m_num_callpaths; i++ )
+        {
+            const SCOREP_Score_Callpath& callpath =
+                m_profile->getCallpath( rows.m_first_callpath + i );
+            uint64_t index = i * m_process_num + process;
+
+            update_groups( accumulator->groups,
+                           accumulator->regions,
+                           accumulator->filtered,
+                           process - accumulator->first_process,
+                           callpath.m_region,
+                           callpath.m_parent_region,
+                           rows.m_visits[ index ],
+                           rows.m_time[ index ],
+                           rows.m_hits[ index ],
+                           callpath.m_num_parameters,
+                           callpath.m_str_parameters );
+        }
     }
 }
 
@@ -784,6 +1038,16 @@ SCOREP_Score_Estimator::printGroups( void )
              << endl << endl;
     }
 
+    if ( m_has_overhead )
+    {
+        double overhead = ( m_has_filter ? m_filtered : m_groups )[ SCOREP_SCORE_TYPE_ALL ]->getOverhead();
+        cout.setf( ios::fixed, ios::floatfield );
+        cout << "Predicted measurement overhead (" << m_overhead_substrates << "): "
+             << setprecision( 2 ) << overhead << "s ("
+             << setprecision( 1 ) << 100.0 / m_total_time * overhead
+             << "% of the measured time)" << endl << endl;
+    }
+
     m_groups[ SCOREP_SCORE_TYPE_ALL ]->updateWidths( m_widths );
     sortEntries( m_groups, SCOREP_SCORE_TYPE_NUM );
 
@@ -797,12 +1061,17 @@ SCOREP_Score_Estimator::printGroups( void )
     }
     cout << " " << setw( m_widths.m_time ) << "time[s]"
          << " time[%]"
-         << " " << setw( m_widths.m_time_per_visit ) << "time/visit[us]"
-         << "  region"
+         << " " << setw( m_widths.m_time_per_visit ) << "time/visit[us]";
+    if ( m_has_overhead )
+    {
+        cout << " " << setw( m_widths.m_overhead ) << "overhead[s]"
+             << " ovh[%]";
+    }
+    cout << "  region"
          << endl;
     for ( uint64_t i = 0; i < SCOREP_SCORE_TYPE_NUM; i++ )
     {
-        m_groups[ i ]->print( m_total_time, m_widths, m_profile->hasHits() );
+        m_groups[ i ]->print( m_total_time, m_widths, m_profile->hasHits(), m_has_overhead );
     }
 
     if ( m_has_filter )
@@ -812,7 +1081,7 @@ SCOREP_Score_Estimator::printGroups( void )
         cout << endl;
         for ( uint64_t i = 0; i < SCOREP_SCORE_TYPE_NUM; i++ )
         {
-            m_filtered[ i ]->print( m_total_time, m_widths, m_profile->hasHits() );
+            m_filtered[ i ]->print( m_total_time, m_widths, m_profile->hasHits(), m_has_overhead );
         }
     }
 }
@@ -825,7 +1094,7 @@ SCOREP_Score_Estimator::printRegions( void )
     cout << endl;
     for ( uint64_t i = 0; i < m_region_num; i++ )
     {
-        m_regions[ i ]->print( m_total_time, m_widths, m_profile->hasHits() );
+        m_regions[ i ]->print( m_total_time, m_widths, m_profile->hasHits(), m_has_overhead );
     }
 }
 
@@ -835,11 +1104,29 @@ SCOREP_Score_Estimator::generateFilterFile( double   minBufferPercentage,
                                             uint64_t minVisits,
                                             double   minBufferAbsolute,
                                             bool     filterUSR,
-                                            bool     filterCOM )
+                                            bool     filterCOM,
+                                            double   maxOverheadPercentage )
 
 {
     const auto sorting_name = sortEntries( m_regions, m_region_num );
 
+    const bool     by_overhead        = maxOverheadPercentage >= 0;
+    vector< bool > selected;
+    double         remaining_overhead = 0;
+    if ( by_overhead )
+    {
+        selected = select_overhead_filter( maxOverheadPercentage, minVisits,
+                                           filterUSR, filterCOM );
+        remaining_overhead = ( m_has_filter ? m_filtered : m_groups )[ SCOREP_SCORE_TYPE_ALL ]->getOverhead();
+        for ( uint64_t i = 0; i < m_region_num; i++ )
+        {
+            if ( selected[ i ] )
+            {
+                remaining_overhead -= m_regions[ i ]->getOverhead();
+            }
+        }
+    }
+
     const auto filter_file_name = "initial_scorep.filter";
 
     // avoid overwriting existing file by using the renaming scheme also used
@@ -864,15 +1151,25 @@ SCOREP_Score_Estimator::generateFilterFile( double   minBufferPercentage,
                 << "#  - check selected functions for relevancy\n"
                 << "#    (w.r.t. your knowledge of the application)\n"
                 << "#\n"
-                << "# Generated with the following parameters:\n"
-                << "#  - A region has to use at least " << minBufferPercentage << "% of the estimated trace buffer.\n"
-                << "#  - A region has to have a time/visits value of less than " << maxTimePerVisits << " us.\n";
+                << "# Generated with the following parameters:\n";
+    if ( by_overhead )
+    {
+        filter_file << "#  - The regions with the largest predicted overhead (" << m_overhead_substrates << ") are\n"
+                    << "#    selected until the remaining overhead is at most " << maxOverheadPercentage << "% of\n"
+                    << "#    the measured time. The predicted remaining overhead is "
+                    << 100.0 / m_total_time * remaining_overhead << "%.\n";
+    }
+    else
+    {
+        filter_file << "#  - A region has to use at least " << minBufferPercentage << "% of the estimated trace buffer.\n"
+                    << "#  - A region has to have a time/visits value of less than " << maxTimePerVisits << " us.\n";
+    }
     // Add the following lines if the parameters are explicitly set
     if ( minVisits > 0 )
     {
         filter_file << "#  - A region has to have at least " << minVisits << " visits.\n";
     }
-    if ( minBufferAbsolute > 0 )
+    if ( minBufferAbsolute > 0 && !by_overhead )
     {
         filter_file << "#  - A region has to use at least " << minBufferAbsolute << "M of memory.\n";
     }
@@ -903,6 +1200,14 @@ SCOREP_Score_Estimator::generateFilterFile( double   minBufferPercentage,
                 << "  EXCLUDE" << endl;
     for ( uint64_t i = 0; i < m_region_num; i++ )
     {
+        if ( by_overhead )
+        {
+            if ( selected[ i ] )
+            {
+                filter_file << m_regions[ i ]->generateFilterEntry( m_total_time, m_widths ) << endl;
+            }
+            continue;
+        }
         const auto temp = m_regions[ i ]->getFilterCandidate( m_max_buf,
                                                               m_total_time,
                                                               m_widths,
@@ -948,20 +1253,87 @@ SCOREP_Score_Estimator::generateFilterFile( double   minBufferPercentage,
         exit( EXIT_FAILURE );
         return;
     }
+
+    // The same selection as XRay attribute list, which removes the sleds of the functions at compile time
+    string xray_file_name           = "initial_scorep_xray.txt";
+    string moved_existing_xray_file = "";
+    bool   has_xray_file            = false;
+#if HAVE( XRAY_PLUGIN_SUPPORT )
+    moved_existing_xray_file = backup_existing_file( xray_file_name );
+    XRayPlugin::FilterConverter converter( filter_file_name );
+    has_xray_file = converter.saveAsXRay( xray_file_name );
+    if ( !has_xray_file )
+    {
+        revert_file_backup( moved_existing_xray_file, xray_file_name );
+    }
+#endif
+
     cout << "\n\nAn initial filter file template has been generated: '" << filter_file_name << "'\n\n";
+    if ( by_overhead && remaining_overhead > maxOverheadPercentage / 100 * m_total_time )
+    {
+        cout << "The overhead target of " << maxOverheadPercentage << "% cannot be reached by filtering\n"
+             << "the selected region types. The predicted remaining overhead is "
+             << setprecision( 1 ) << 100.0 / m_total_time * remaining_overhead << "%.\n\n";
+    }
     if ( moved_existing_file != "" )
     {
         cout << "Moved existing filter file to: '" << moved_existing_file << "'\n\n";
     }
+    if ( has_xray_file && moved_existing_xray_file != "" )
+    {
+        cout << "Moved existing XRay attribute list to: '" << moved_existing_xray_file << "'\n\n";
+    }
     cout << "To use this file for filtering at run-time, set the respective Score-P variable:\n\n"
          << "    SCOREP_FILTERING_FILE=" << filter_file_name << "\n\n"
          << "For compile-time filtering 'scorep' has to be provided with the '--instrument-filter' option:\n\n"
          << "    $ scorep --instrument-filter=" << filter_file_name << "\n\n"
-         << "Compile-time filtering depends on support in the used Score-P installation.\n\n"
-         << "The filter file is annotated with comments, please check if the selection is\n"
+         << "Compile-time filtering depends on support in the used Score-P installation.\n\n";
+    if ( has_xray_file )
+    {
+        cout << "For compile-time filtering of LLVM XRay instrumentation, the same selection is\n"
+             << "available as attribute list '" << xray_file_name << "':\n\n"
+             << "    $ clang -fxray-instrument -fxray-attr-list=" << xray_file_name << "\n\n";
+    }
+    cout << "The filter file is annotated with comments, please check if the selection is\n"
          << "suitable for your purposes and add or remove functions if needed.\n" << endl;
 }
 
+vector< bool >
+SCOREP_Score_Estimator::select_overhead_filter( double   maxOverheadPercentage,
+                                                uint64_t minVisits,
+                                                bool     filterUSR,
+                                                bool     filterCOM )
+{
+    vector< uint64_t > candidates;
+    for ( uint64_t i = 0; i < m_region_num; i++ )
+    {
+        if ( m_regions[ i ]->isOverheadFilterCandidate( minVisits, filterUSR, filterCOM ) )
+        {
+            candidates.push_back( i );
+        }
+    }
+    std::stable_sort( candidates.begin(), candidates.end(),
+                      [ this ]( uint64_t a, uint64_t b )
+    {
+        return m_regions[ a ]->getOverhead() > m_regions[ b ]->getOverhead();
+    } );
+
+    /* Greedily remove the most expensive regions until the target is met */
+    double         overhead = ( m_has_filter ? m_filtered : m_groups )[ SCOREP_SCORE_TYPE_ALL ]->getOverhead();
+    double         target   = maxOverheadPercentage / 100 * m_total_time;
+    vector< bool > selected( m_region_num, false );
+    for ( uint64_t candidate : candidates )
+    {
+        if ( overhead <= target )
+        {
+            break;
+        }
+        selected[ candidate ] = true;
+        overhead             -= m_regions[ candidate ]->getOverhead();
+    }
+    return selected;
+}
+
 void
 SCOREP_Score_Estimator::generateMaxFilterFile( void )
 
@@ -1129,15 +1501,35 @@ SCOREP_Score_Estimator::operator()( uint64_t process,
                                     uint64_t hits,
                                     uint32_t numParameters,
                                     uint32_t strParameters )
+{
+    update_groups( m_groups, m_regions, m_filtered, process,
+                   region, parentRegion, visits, time, hits,
+                   numParameters, strParameters );
+}
+
+/* ****************************************************** private methods */
+
+void
+SCOREP_Score_Estimator::update_groups( SCOREP_Score_Group** groups,
+                                       SCOREP_Score_Group** regions,
+                                       SCOREP_Score_Group** filtered,
+                                       uint64_t             process,
+                                       uint64_t             region,
+                                       uint64_t             parentRegion,
+                                       uint64_t             visits,
+                                       double               time,
+                                       uint64_t             hits,
+                                       uint32_t             numParameters,
+                                       uint32_t             strParameters )
 {
     if ( visits == 0 && hits == 0 )
     {
         return;
     }
 
-    SCOREP_Score_Type group = m_profile->getGroup( region );
+    SCOREP_Score_Type group    = m_profile->getGroup( region );
+    double            overhead = m_has_overhead ? visits * m_overhead_per_visit[ region ] : 0;
 
-    const string& region_name = m_profile->getRegionName( region );
     if ( m_profile->isDynamicRegion( region ) && parentRegion != -1 )
     {
         /* Attribute bytes, visits, and time to parent node. Only parent contributes and
@@ -1145,11 +1537,11 @@ SCOREP_Score_Estimator::operator()( uint64_t process,
            iteration/instance childs. Note that dynamic regions wont trigger parameters in
            the trace */
         uint64_t bytes = visits * ( m_bytes_per_visits[ parentRegion ] );
-        m_groups[ group ]->updateProcess( process, bytes, visits, 0, time );
-        m_groups[ SCOREP_SCORE_TYPE_ALL ]->updateProcess( process, bytes, visits, 0, time );
+        groups[ group ]->updateProcess( process, bytes, visits, 0, time, overhead );
+        groups[ SCOREP_SCORE_TYPE_ALL ]->updateProcess( process, bytes, visits, 0, time, overhead );
         if ( m_show_regions )
         {
-            m_regions[ parentRegion ]->updateProcess( process, bytes, visits, 0, time );
+            regions[ parentRegion ]->updateProcess( process, bytes, visits, 0, time, overhead );
         }
         return;
     }
@@ -1160,37 +1552,35 @@ SCOREP_Score_Estimator::operator()( uint64_t process,
                                 + strParameters * m_bytes_per_str_parameter )
                      + hits * m_bytes_per_hit;
 
-    m_groups[ group ]->updateProcess( process, bytes, visits, hits, time );
-    m_groups[ SCOREP_SCORE_TYPE_ALL ]->updateProcess( process, bytes, visits, hits, time );
+    groups[ group ]->updateProcess( process, bytes, visits, hits, time, overhead );
+    groups[ SCOREP_SCORE_TYPE_ALL ]->updateProcess( process, bytes, visits, hits, time, overhead );
 
     if ( m_show_regions )
     {
-        m_regions[ region ]->updateProcess( process, bytes, visits, hits, time );
+        regions[ region ]->updateProcess( process, bytes, visits, hits, time, overhead );
     }
 
     if ( m_has_filter )
     {
-        bool do_filter = match_filter( region );
+        bool do_filter = m_region_filtered[ region ];
         if ( m_show_regions )
         {
-            m_regions[ region ]->doFilter( do_filter ?
+            regions[ region ]->doFilter( do_filter ?
                                            SCOREP_SCORE_FILTER_YES :
                                            SCOREP_SCORE_FILTER_NO );
         }
         if ( !do_filter )
         {
-            m_filtered[ group ]->updateProcess( process, bytes, visits, hits, time );
-            m_filtered[ SCOREP_SCORE_TYPE_ALL ]->updateProcess( process, bytes, visits, hits, time );
+            filtered[ group ]->updateProcess( process, bytes, visits, hits, time, overhead );
+            filtered[ SCOREP_SCORE_TYPE_ALL ]->updateProcess( process, bytes, visits, hits, time, overhead );
         }
         else
         {
-            m_filtered[ SCOREP_SCORE_TYPE_FLT ]->updateProcess( process, bytes, visits, hits, time );
+            filtered[ SCOREP_SCORE_TYPE_FLT ]->updateProcess( process, bytes, visits, hits, time, overhead );
         }
     }
 }
 
-/* ****************************************************** private methods */
-
 void
 SCOREP_Score_Estimator::delete_groups( SCOREP_Score_Group** groups,
                                        uint64_t             num )
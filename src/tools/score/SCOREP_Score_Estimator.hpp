@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012, 2019, 2022,
+ * Copyright (c) 2009-2012, 2019, 2022, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -45,6 +45,7 @@
 #include <map>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 /**
  * Possible sorting options for the region display.
@@ -86,15 +87,20 @@ public:
     ~SCOREP_Score_Estimator();
 
     /**
-     * Calculates the group an region data.
+     * Calculates the group an region data. The profile values are loaded
+     * in blocks of call paths for all processes at once, and the processes
+     * are distributed over @a numThreads threads.
      * @param showRegions  Pass true if the user wants to see per region data
      *                     in addition to the groups.
      * @param useMangled   Whether mangled or demangled region names are used for
      *                     display.
+     * @param numThreads   Number of threads used for the estimation, 0 for
+     *                     one per available core.
      */
     void
-    calculate( bool showRegions,
-               bool useMangled );
+    calculate( bool     showRegions,
+               bool     useMangled,
+               uint32_t numThreads = 0 );
 
     /**
      * Returns bytes per visit of for a region
@@ -122,6 +128,10 @@ public:
      * percentage of the the total buffer size, a maximal time per visits
      * in us, a minimum number of visits, an absolute buffer value in MB, and
      * type choices.
+     * If @a maxOverheadPercentage is not negative, the regions with the
+     * largest predicted overhead are selected instead, until the remaining
+     * overhead is at most this percentage of the measured time. The buffer
+     * and time per visit constraints are not used in this case.
      */
     void
     generateFilterFile( double   minBufferPercentage,
@@ -129,7 +139,8 @@ public:
                         uint64_t minVisits,
                         double   minBufferAbsolute,
                         bool     filterUSR,
-                        bool     filterCOM );
+                        bool     filterCOM,
+                        double   maxOverheadPercentage = -1 );
 
     /**
      * Generates a maximal filter file, that includes every filterable region
@@ -145,6 +156,17 @@ public:
     void
     initializeFilter( const std::string& filterFile );
 
+    /**
+     * Reads a calibration file written by scorep-score-calibrate and
+     * enables the prediction of the measurement overhead.
+     * @param calibrationFile  The name of the calibration file.
+     * @param substrates       The enabled substrates, one of "profiling",
+     *                         "tracing", or "both".
+     */
+    void
+    initializeOverhead( const std::string& calibrationFile,
+                        const std::string& substrates );
+
     /**
      * Dumps the event sizes to the screen, Used for debug purposes.
      */
@@ -163,6 +185,48 @@ public:
                 uint32_t strParameters ) override;
 
 private:
+    /**
+     * Partial results of one estimation thread, see calculate().
+     */
+    struct Accumulator;
+
+    /**
+     * Adds the data of one call path of one process to the given groups.
+     * @param groups    The main groups.
+     * @param regions   The per region groups, only used if m_show_regions is set.
+     * @param filtered  The filtered groups, only used if m_has_filter is set.
+     * @param process   The index of the process in the groups.
+     */
+    void
+    update_groups( SCOREP_Score_Group** groups,
+                   SCOREP_Score_Group** regions,
+                   SCOREP_Score_Group** filtered,
+                   uint64_t             process,
+                   uint64_t             region,
+                   uint64_t             parentRegion,
+                   uint64_t             visits,
+                   double               time,
+                   uint64_t             hits,
+                   uint32_t             numParameters,
+                   uint32_t             strParameters );
+
+    /**
+     * Adds the values in @a rows of the processes of @a accumulator to it.
+     */
+    void
+    estimate_rows( const SCOREP_Score_CallpathRows& rows,
+                   Accumulator*                     accumulator );
+
+    /**
+     * Selects the regions for the overhead based filter generation.
+     * @return Whether the region at the same index in m_regions is selected.
+     */
+    std::vector< bool >
+    select_overhead_filter( double   maxOverheadPercentage,
+                            uint64_t minVisits,
+                            bool     filterUSR,
+                            bool     filterCOM );
+
     /**
      * Checks whether @a region is filtered.
      * @param regionId  Specifies the region by its ID.
@@ -304,12 +368,33 @@ private:
      */
     bool m_show_regions;
 
+    /**
+     * Stores the result of match_filter() for each region, if a filter
+     * is used.
+     */
+    std::vector< bool > m_region_filtered;
+
     /* Data used when traversing the calltree */
     uint64_t                m_bytes_per_num_parameter;
     uint64_t                m_bytes_per_str_parameter;
     uint64_t                m_bytes_per_hit;
     std::vector< uint64_t > m_bytes_per_visits;
 
+    /**
+     * True, if a calibration file was read.
+     */
+    bool m_has_overhead;
+
+    /**
+     * The substrates the overhead is predicted for.
+     */
+    std::string m_overhead_substrates;
+
+    /**
+     * Predicted measurement overhead of one visit in seconds, per region.
+     */
+    std::vector< double > m_overhead_per_visit;
+
     /**
      * Stores all events by its name.
      */
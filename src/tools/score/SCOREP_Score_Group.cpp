@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012, 2015,
+ * Copyright (c) 2009-2012, 2015, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -93,6 +93,7 @@ SCOREP_Score_Group::SCOREP_Score_Group( uint64_t      type,
     m_max_buf      = ( uint64_t* )calloc( processes, sizeof( uint64_t ) );
     m_total_buf    = 0;
     m_total_time   = 0;
+    m_overhead     = 0;
     m_name         = name;
     m_mangled_name = name;
     m_file_name    = "";
@@ -114,6 +115,7 @@ SCOREP_Score_Group::SCOREP_Score_Group( uint64_t           type,
     m_max_buf      = ( uint64_t* )calloc( processes, sizeof( uint64_t ) );
     m_total_buf    = 0;
     m_total_time   = 0;
+    m_overhead     = 0;
     m_name         = name;
     m_mangled_name = mangledName;
     m_file_name    = fileName;
@@ -133,13 +135,35 @@ SCOREP_Score_Group::updateProcess( uint64_t process,
                                    uint64_t bytes,
                                    uint64_t numberOfVisits,
                                    uint64_t numberOfHits,
-                                   double   time )
+                                   double   time,
+                                   double   overhead )
 {
     m_total_buf          += bytes;
     m_max_buf[ process ] += bytes;
     m_visits             += numberOfVisits;
     m_hits               += numberOfHits;
     m_total_time         += time;
+    m_overhead           += overhead;
+}
+
+void
+SCOREP_Score_Group::merge( const SCOREP_Score_Group& other,
+                           uint64_t                  firstProcess )
+{
+    for ( uint64_t process = 0; process < other.m_processes; process++ )
+    {
+        m_max_buf[ firstProcess + process ] += other.m_max_buf[ process ];
+    }
+    m_total_buf  += other.m_total_buf;
+    m_visits     += other.m_visits;
+    m_hits       += other.m_hits;
+    m_total_time += other.m_total_time;
+    m_overhead   += other.m_overhead;
+
+    if ( other.m_filter != SCOREP_SCORE_FILTER_UNSPECIFIED )
+    {
+        m_filter = other.m_filter;
+    }
 }
 
 void
@@ -166,6 +190,10 @@ SCOREP_Score_Group::updateWidths( SCOREP_Score_FieldWidths& widths )
 
         str << setprecision( 2 ) << m_total_time / m_visits * 1000000;
         widths.m_time_per_visit = std::max<int>( widths.m_time_per_visit, str.str().size() );
+        str.str( "" );
+
+        str << setprecision( 2 ) << m_overhead;
+        widths.m_overhead = std::max<int>( widths.m_overhead, str.str().size() );
         str.clear();
     }
 }
@@ -173,7 +201,8 @@ SCOREP_Score_Group::updateWidths( SCOREP_Score_FieldWidths& widths )
 void
 SCOREP_Score_Group::print( double                   totalTime,
                            SCOREP_Score_FieldWidths widths,
-                           bool                     withHits )
+                           bool                     withHits,
+                           bool                     withOverhead )
 {
     cout.setf( ios::fixed, ios::floatfield );
     cout.setf( ios::showpoint );
@@ -191,8 +220,13 @@ SCOREP_Score_Group::print( double                   totalTime,
         }
         cout << " " << setw( widths.m_time ) << setprecision( 2 ) << m_total_time
              << " " << setw( 7 )  << setprecision( 1 ) << 100.0 / totalTime * m_total_time
-             << " " << setw( widths.m_time_per_visit ) << setprecision( 2 ) << m_total_time / m_visits * 1000000
-             << left
+             << " " << setw( widths.m_time_per_visit ) << setprecision( 2 ) << m_total_time / m_visits * 1000000;
+        if ( withOverhead )
+        {
+            cout << " " << setw( widths.m_overhead ) << setprecision( 2 ) << m_overhead
+                 << " " << setw( 6 ) << setprecision( 1 ) << 100.0 / totalTime * m_overhead;
+        }
+        cout << left
              << "  " << getDisplayName() << endl;
     }
 }
@@ -275,6 +309,18 @@ SCOREP_Score_Group::getFilterCandidate( uint64_t                 maxBuffer,
     return "";
 }
 
+bool
+SCOREP_Score_Group::isOverheadFilterCandidate( uint64_t minVisits,
+                                               bool     filterUSR,
+                                               bool     filterCOM )
+{
+    return m_filter != SCOREP_SCORE_FILTER_YES
+           && m_overhead > 0
+           && m_visits >= minVisits
+           && ( ( filterUSR && m_type == SCOREP_SCORE_TYPE_USR ) ||
+                ( filterCOM && m_type == SCOREP_SCORE_TYPE_COM ) );
+}
+
 std::string
 SCOREP_Score_Group::getMaxFilterCandidate( double                   totalTime,
                                            SCOREP_Score_FieldWidths widths )
@@ -305,6 +351,12 @@ SCOREP_Score_Group::getTotalTime( void )
     return m_total_time;
 }
 
+double
+SCOREP_Score_Group::getOverhead( void )
+{
+    return m_overhead;
+}
+
 const std::string&
 SCOREP_Score_Group::getName( void )
 {
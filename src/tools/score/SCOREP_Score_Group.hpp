@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012, 2015,
+ * Copyright (c) 2009-2012, 2015, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -59,7 +59,8 @@ struct SCOREP_Score_FieldWidths
         m_visits( 6 ),
         m_hits( 4 ),
         m_time( 7 ),
-        m_time_per_visit( 14 )
+        m_time_per_visit( 14 ),
+        m_overhead( 11 )
     {
     }
 
@@ -92,6 +93,11 @@ struct SCOREP_Score_FieldWidths
      * Stores the required width of the 'time/visit[us]' column.
      */
     int m_time_per_visit;
+
+    /**
+     * Stores the required width of the 'overhead[s]' column.
+     */
+    int m_overhead;
 };
 
 
@@ -139,6 +145,7 @@ public:
      * @param numberOfVisits Number of visits for the new region.
      * @param numberOfHits   Number of hits for the new region.
      * @param time           Sum of time spent in this region in all visits.
+     * @param overhead       Predicted measurement overhead of all visits.
      * @param process        The process num for which the data added.
      */
     void
@@ -146,7 +153,19 @@ public:
                    uint64_t bytes,
                    uint64_t numberOfVisits,
                    uint64_t numberOfHits,
-                   double   time );
+                   double   time,
+                   double   overhead );
+
+    /**
+     * Adds the scoring metrics of @a other, which covers the processes
+     * starting at @a firstProcess, to this group. Takes over the filter
+     * state of @a other, if it was set.
+     * @param other        The group with the partial results.
+     * @param firstProcess The process num of the first process of @a other.
+     */
+    void
+    merge( const SCOREP_Score_Group& other,
+           uint64_t                  firstProcess );
 
     /**
      * Updates the field width to the required values.
@@ -157,13 +176,16 @@ public:
 
     /**
      * Prints the region data to the standard output device.
-     * @param totalTime The total time spend in the application.
-     * @param widths    Field widths used for printing.
+     * @param totalTime    The total time spend in the application.
+     * @param widths       Field widths used for printing.
+     * @param withHits     Whether the hits column is printed.
+     * @param withOverhead Whether the predicted overhead columns are printed.
      */
     void
     print( double                   totalTime,
            SCOREP_Score_FieldWidths widths,
-           bool                     withHits );
+           bool                     withHits,
+           bool                     withOverhead );
 
     /**
      * Returns the formated string for a single filter entry.
@@ -189,6 +211,16 @@ public:
                         bool                     filterUSR,
                         bool                     filterCOM );
 
+    /**
+     * Returns whether the region can be selected by the overhead based
+     * filter generation, i.e., it is not filtered yet, has a predicted
+     * overhead, and fulfills the visits and type constraints.
+     */
+    bool
+    isOverheadFilterCandidate( uint64_t minVisits,
+                               bool     filterUSR,
+                               bool     filterCOM );
+
     /**
      * Returns the region information if the entry is filterable.
      * Otherwise, it returns an empty string.
@@ -211,6 +243,13 @@ public:
     double
     getTotalTime( void );
 
+    /**
+     * Returns the predicted measurement overhead in this group on all
+     * processes.
+     */
+    double
+    getOverhead( void );
+
     /**
      * Returns the name.
      */
@@ -292,6 +331,11 @@ private:
      */
     double m_total_time;
 
+    /**
+     * Stores the predicted measurement overhead for all processes.
+     */
+    double m_overhead;
+
     /**
      * Stores the group name.
      */
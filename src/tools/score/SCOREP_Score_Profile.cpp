@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2013, 2015-2017, 2019,
+ * Copyright (c) 2009-2013, 2015-2017, 2019, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -40,6 +40,7 @@
 #include <Cube.h>
 #include <CubeTypes.h>
 #include <assert.h>
+#include <stdint.h>
 #include <sys/stat.h>
 #include <sstream>
 #include <cctype>
@@ -47,6 +48,30 @@
 using namespace std;
 using namespace cube;
 
+/* Returns the number of occurrences stored in @a value, as for visits and hits. */
+static uint64_t
+get_count_value( const Value* value )
+{
+    if ( value->myDataType() == CUBE_DATA_TYPE_TAU_ATOMIC )
+    {
+        TauAtomicValue* tau_value = ( TauAtomicValue* )value;
+        return tau_value->getN().getUnsignedLong();
+    }
+    return value->getUnsignedLong();
+}
+
+/* Returns the sum stored in @a value, as for time. */
+static double
+get_sum_value( const Value* value )
+{
+    if ( value->myDataType() == CUBE_DATA_TYPE_TAU_ATOMIC )
+    {
+        TauAtomicValue* tau_value = ( TauAtomicValue* )value;
+        return tau_value->getSum().getDouble();
+    }
+    return value->getDouble();
+}
+
 
 SCOREP_Score_Profile::SCOREP_Score_Profile( cube::Cube* cube   ) : m_cube( cube ), m_num_arguments( -1 )
 {
@@ -142,6 +167,29 @@ SCOREP_Score_Profile::SCOREP_Score_Profile( cube::Cube* cube   ) : m_cube( cube
         assert( location_group->get_type() != CUBE_LOCATION_GROUP_TYPE_METRICS );
     }
 
+    // Map each location to the process it contributes to, for loading
+    // the values of all processes at once.
+    unordered_map<LocationGroup*, uint64_t> location_group_processes;
+    for ( uint64_t process = 0; process < m_processes.size(); process++ )
+    {
+        location_group_processes[ m_processes[ process ] ] = process;
+        for ( const auto gpu_context : m_gpu_contexts_of_processes[ m_processes[ process ]->get_name() ] )
+        {
+            location_group_processes[ gpu_context ] = process;
+        }
+    }
+    const vector<Location*>& locations = m_cube->get_locationv();
+    m_location_processes.assign( locations.size(), UINT64_MAX );
+    for ( const auto location : locations )
+    {
+        const auto it = location_group_processes.find( location->get_parent() );
+        if ( it != location_group_processes.end()
+             && location->get_id() < m_location_processes.size() )
+        {
+            m_location_processes[ location->get_id() ] = it->second;
+        }
+    }
+
     m_regions = m_cube->get_regv();
 
     // Make sure the id of the region definitions match their position in the vector
@@ -206,6 +254,7 @@ SCOREP_Score_Profile::SCOREP_Score_Profile( cube::Cube* cube   ) : m_cube( cube
     {
         m_root_regions.insert( roots[ i ]->get_callee()->get_id() );
         calculate_calltree_types( roots[ i ] );
+        collect_callpaths_rec( roots[ i ] );
     }
 
     m_longest_common_path = "";
@@ -425,7 +474,103 @@ SCOREP_Score_Profile::iterateCalltree( uint64_t                      process,
     }
 }
 
+uint64_t
+SCOREP_Score_Profile::getNumberOfCallpaths( void ) const
+{
+    return m_callpaths.size();
+}
+
+const SCOREP_Score_Callpath&
+SCOREP_Score_Profile::getCallpath( uint64_t callpath ) const
+{
+    return m_callpaths[ callpath ];
+}
+
+void
+SCOREP_Score_Profile::loadCallpathRows( uint64_t                   firstCallpath,
+                                        uint64_t                   numCallpaths,
+                                        SCOREP_Score_CallpathRows& rows )
+{
+    uint64_t num_processes = m_processes.size();
+
+    rows.m_first_callpath = firstCallpath;
+    rows.m_num_callpaths  = numCallpaths;
+    rows.m_visits.assign( numCallpaths * num_processes, 0 );
+    rows.m_time.assign( numCallpaths * num_processes, 0.0 );
+    rows.m_hits.assign( numCallpaths * num_processes, 0 );
+
+    for ( uint64_t i = 0; i < numCallpaths; i++ )
+    {
+        Cnode*   node   = m_callpath_cnodes[ firstCallpath + i ];
+        uint64_t offset = i * num_processes;
+
+        load_row( m_visits, CUBE_CALCULATE_EXCLUSIVE, node,
+                  get_count_value, &rows.m_visits[ offset ] );
+        load_row( m_time, CUBE_CALCULATE_INCLUSIVE, node,
+                  get_sum_value, &rows.m_time[ offset ] );
+        if ( m_hits )
+        {
+            load_row( m_hits, CUBE_CALCULATE_EXCLUSIVE, node,
+                      get_count_value, &rows.m_hits[ offset ] );
+        }
+    }
+}
+
 /* **************************************************** private members */
+
+void
+SCOREP_Score_Profile::collect_callpaths_rec( Cnode* node )
+{
+    SCOREP_Score_Callpath callpath;
+    callpath.m_region        = node->get_callee()->get_id();
+    callpath.m_parent_region = -1;
+    if ( node->get_parent() )
+    {
+        callpath.m_parent_region = node->get_parent()->get_callee()->get_id();
+    }
+    callpath.m_num_parameters = node->get_num_parameters().size();
+    callpath.m_str_parameters = node->get_str_parameters().size();
+
+    m_callpaths.push_back( callpath );
+    m_callpath_cnodes.push_back( node );
+
+    for ( uint32_t i = 0; i < node->num_children(); i++ )
+    {
+        collect_callpaths_rec( node->get_child( i ) );
+    }
+}
+
+template<typename T>
+void
+SCOREP_Score_Profile::load_row( Metric*            metric,
+                                CalculationFlavour metricFlavour,
+                                Cnode*             node,
+                                T ( *              convert )( const Value* ),
+                                T*                 row )
+{
+    Value** values = m_cube->get_sevs_adv( metric, metricFlavour,
+                                           node, CUBE_CALCULATE_EXCLUSIVE );
+    if ( !values )
+    {
+        return;
+    }
+
+    for ( uint64_t location = 0; location < m_location_processes.size(); location++ )
+    {
+        if ( !values[ location ] )
+        {
+            continue;
+        }
+        uint64_t process = m_location_processes[ location ];
+        if ( process != UINT64_MAX )
+        {
+            row[ process ] += convert( values[ location ] );
+        }
+        delete values[ location ];
+    }
+    delete[] values;
+}
+
 SCOREP_Score_Type
 SCOREP_Score_Profile::get_definition_type( uint64_t region )
 {
@@ -590,15 +735,7 @@ SCOREP_Score_Profile::get_visits( Cnode*   node,
     {
         return 0;
     }
-    if ( value->myDataType() == CUBE_DATA_TYPE_TAU_ATOMIC )
-    {
-        TauAtomicValue* tau_value = ( TauAtomicValue* )value;
-        return tau_value->getN().getUnsignedLong();
-    }
-    else
-    {
-        return value->getUnsignedLong();
-    }
+    return get_count_value( value );
 }
 
 double
@@ -612,15 +749,7 @@ SCOREP_Score_Profile::get_time( Cnode*   node,
     {
         return 0.0;
     }
-    if ( value->myDataType() == CUBE_DATA_TYPE_TAU_ATOMIC )
-    {
-        TauAtomicValue* tau_value = ( TauAtomicValue* )value;
-        return tau_value->getSum().getDouble();
-    }
-    else
-    {
-        return value->getDouble();
-    }
+    return get_sum_value( value );
 }
 
 uint64_t
@@ -639,13 +768,5 @@ SCOREP_Score_Profile::get_hits( Cnode*   node,
     {
         return 0;
     }
-    if ( value->myDataType() == CUBE_DATA_TYPE_TAU_ATOMIC )
-    {
-        TauAtomicValue* tau_value = ( TauAtomicValue* )value;
-        return tau_value->getN().getUnsignedLong();
-    }
-    else
-    {
-        return value->getUnsignedLong();
-    }
+    return get_count_value( value );
 }
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2013,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2013, 2015, 2019,
+ * Copyright (c) 2009-2013, 2015, 2019, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2013,
@@ -41,6 +41,7 @@
 #include <string>
 #include <set>
 #include <unordered_map>
+#include <vector>
 #include <Cube.h>
 #include "SCOREP_Score_Types.hpp"
 
@@ -58,6 +59,31 @@ public:
                 uint32_t strParameters ) = 0;
 };
 
+/**
+ * Describes one call path of the profile.
+ */
+struct SCOREP_Score_Callpath
+{
+    uint64_t m_region;
+    uint64_t m_parent_region;
+    uint32_t m_num_parameters;
+    uint32_t m_str_parameters;
+};
+
+/**
+ * The values of consecutive call paths for all processes. The values of
+ * the call path m_first_callpath + c and process p are stored at index
+ * c * number of processes + p.
+ */
+struct SCOREP_Score_CallpathRows
+{
+    uint64_t              m_first_callpath;
+    uint64_t              m_num_callpaths;
+    std::vector<uint64_t> m_visits;
+    std::vector<double>   m_time;
+    std::vector<uint64_t> m_hits;
+};
+
 /**
  * This class encapsulates the access of the estimator to the CUBE4 profile.
  */
@@ -196,6 +222,30 @@ public:
     iterateCalltree( uint64_t                      process,
                      SCOREP_Score_CalltreeVisitor& visitor );
 
+    /**
+     * Returns the number of call paths. Call paths are numbered in the
+     * order in which iterateCalltree visits them.
+     */
+    uint64_t
+    getNumberOfCallpaths( void ) const;
+
+    /**
+     * Returns the description of call path @a callpath.
+     */
+    const SCOREP_Score_Callpath&
+    getCallpath( uint64_t callpath ) const;
+
+    /**
+     * Loads visits, time, and hits of the call paths [@a firstCallpath,
+     * @a firstCallpath + @a numCallpaths) for all processes into @a rows.
+     * Each metric is read once per call path for all locations, instead of
+     * once per call path and process as in iterateCalltree.
+     */
+    void
+    loadCallpathRows( uint64_t                   firstCallpath,
+                      uint64_t                   numCallpaths,
+                      SCOREP_Score_CallpathRows& rows );
+
     /**
      * Returns a value >= 0 if the number of program arguments is provided by the cube file.
      * Note: in a future version this function should return independent values per (MPMD) root
@@ -220,6 +270,25 @@ private:
                           SCOREP_Score_CalltreeVisitor& visitor,
                           cube::Cnode*                  node );
 
+    /**
+     * Collects the call paths below @a node in the order of
+     * iterate_calltree_rec.
+     */
+    void
+    collect_callpaths_rec( cube::Cnode* node );
+
+    /**
+     * Adds the values of @a metric for @a node of all locations to the
+     * values of their processes in @a row.
+     */
+    template<typename T>
+    void
+    load_row( cube::Metric*            metric,
+              cube::CalculationFlavour metricFlavour,
+              cube::Cnode*             node,
+              T ( *                    convert )( const cube::Value* ),
+              T*                       row );
+
     /**
      * Checks whether a region is an MPI or OpenMP region.
      * @param regionID  ID of the region for which the type is requested.
@@ -296,6 +365,23 @@ private:
      */
     std::vector<cube::Region*> m_regions;
 
+    /**
+     * Stores the call paths in the order of iterateCalltree.
+     */
+    std::vector<SCOREP_Score_Callpath> m_callpaths;
+
+    /**
+     * Stores the CUBE call path objects, indexed like m_callpaths.
+     */
+    std::vector<cube::Cnode*> m_callpath_cnodes;
+
+    /**
+     * Maps CUBE location ids to the index of the process in m_processes,
+     * whose values include the location. Locations that are ignored for
+     * scoring map to UINT64_MAX.
+     */
+    std::vector<uint64_t> m_location_processes;
+
     /**
      * Stores a mapping of regionIds to region types.
      */
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012, 2016,
+ * Copyright (c) 2009-2012, 2016, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -76,7 +76,10 @@ main( int    argc,
 {
     string                   file_name;
     string                   filter_file;
+    string                   calibration_file;
+    string                   overhead_substrates = "profiling";
     int64_t                  dense_num           = 0;
+    int64_t                  num_threads         = 0;
     bool                     show_regions        = false;
     bool                     use_mangled         = false;
     SCOREP_Score_SortingType sortingby           = SCOREP_SCORE_SORTING_TYPE_MAXBUFFER;
@@ -89,6 +92,7 @@ main( int    argc,
     uint64_t min_visits           = 0;
     double   min_max_buf_absolute = 0;
     bool     filter_com           = false;
+    double   max_overhead_percent = -1;
 
     //--------------------------------------- Parameter options parsing
 
@@ -157,10 +161,56 @@ main( int    argc,
                 exit_fail();
             }
         }
+        else if ( arg == "-j" )
+        {
+            if ( i + 1 < argc )
+            {
+                num_threads = atoi( argv[ i + 1 ] );
+                i++;
+            }
+            else
+            {
+                cerr << "ERROR: Missing number of threads" << endl;
+                exit_fail();
+            }
+        }
         else if ( arg == "-m" )
         {
             use_mangled = true;
         }
+        else if ( arg == "-o" )
+        {
+            if ( i + 1 < argc )
+            {
+                calibration_file = argv[ i + 1 ];
+                i++;
+            }
+            else
+            {
+                cerr << "ERROR: No calibration file specified" << endl;
+                exit_fail();
+            }
+        }
+        else if ( arg == "-O" )
+        {
+            if ( i + 1 < argc )
+            {
+                overhead_substrates = argv[ i + 1 ];
+                if ( overhead_substrates != "profiling" &&
+                     overhead_substrates != "tracing" &&
+                     overhead_substrates != "both" )
+                {
+                    cerr << "ERROR: Unknown substrates choice" << endl;
+                    exit_fail();
+                }
+                i++;
+            }
+            else
+            {
+                cerr << "ERROR: No substrates specified" << endl;
+                exit_fail();
+            }
+        }
         else if ( arg == "-g" )
         {
             produce_filter_file = INITIAL_FILTER;
@@ -246,6 +296,21 @@ main( int    argc,
                                 exit_fail();
                             }
                         }
+                        else if ( key == "overheadpercent" )
+                        {
+                            char* p;
+                            max_overhead_percent = strtod( value.c_str(), &p );
+                            if ( *p )
+                            {
+                                cerr << "ERROR: Parameter value for overhead percentage is not a number!" << endl;
+                                exit_fail();
+                            }
+                            if ( max_overhead_percent < 0 || max_overhead_percent > 100 )
+                            {
+                                cerr << "ERROR: The overhead percentage has to be in the range 0-100!" << endl;
+                                exit_fail();
+                            }
+                        }
                         else if ( key == "bufferabsolute" )
                         {
                             char* p;
@@ -350,6 +415,17 @@ main( int    argc,
              << "'" << dense_num << "'" << endl;
         exit_fail();
     }
+    if ( max_overhead_percent >= 0 && calibration_file == "" )
+    {
+        cerr << "ERROR: The filter generation option 'overheadpercent' requires a calibration file (-o)" << endl;
+        exit_fail();
+    }
+    if ( num_threads < 0 )
+    {
+        cerr << "ERROR: The number of threads cannot be less than zero: "
+             << "'" << num_threads << "'" << endl;
+        exit_fail();
+    }
 
     //-------------------------------------- Scoreing
 
@@ -373,7 +449,12 @@ main( int    argc,
     {
         estimator.initializeFilter( filter_file );
     }
-    estimator.calculate( show_regions || ( produce_filter_file != NO_FILTER ), use_mangled );
+    if ( calibration_file != "" )
+    {
+        estimator.initializeOverhead( calibration_file, overhead_substrates );
+    }
+    estimator.calculate( show_regions || ( produce_filter_file != NO_FILTER ),
+                         use_mangled, num_threads );
     estimator.printGroups();
 
     if ( show_regions )
@@ -392,7 +473,8 @@ main( int    argc,
                                       min_visits,
                                       min_max_buf_absolute,
                                       filter_usr,
-                                      filter_com );
+                                      filter_com,
+                                      max_overhead_percent );
     }
 
     delete ( profile );
@@ -7,7 +7,7 @@
  * Copyright (c) 2009-2012,
  * Gesellschaft fuer numerische Simulation mbH Braunschweig, Germany
  *
- * Copyright (c) 2009-2012,
+ * Copyright (c) 2009-2012, 2026,
  * Technische Universitaet Dresden, Germany
  *
  * Copyright (c) 2009-2012,
@@ -446,8 +446,7 @@ SCOREP_Filter_ParseFile( SCOREP_Filter* filter,
             pos++;
         }
     }
-
-    return SCOREP_SUCCESS;
+    err = SCOREP_SUCCESS;
 
 cleanup:
     if ( filter_file )
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ */
+
+/*
+ * Calls hidden() and visible() before and after the run script sent new
+ * filter rules via the XRay control channel. The script signals the second
+ * phase by creating the file given as argument.
+ */
+
+#include <iostream>
+
+#include <unistd.h>
+
+using std::cout;
+using std::endl;
+
+void
+hidden()
+{
+    cout << "H";
+}
+
+void
+visible()
+{
+    cout << "V";
+}
+
+int
+main( int argc, char** argv )
+{
+    if ( argc != 2 )
+    {
+        return 1;
+    }
+
+    hidden();
+    visible();
+    cout << endl;
+
+    /* wait at most 60 s for the run script */
+    for ( int i = 0; i < 600 && access( argv[ 1 ], F_OK ) != 0; i++ )
+    {
+        usleep( 100000 );
+    }
+
+    hidden();
+    visible();
+    cout << endl;
+
+    return 0;
+}
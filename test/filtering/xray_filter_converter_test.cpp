@@ -0,0 +1,332 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ */
+
+/**
+ * @file
+ *
+ * Tests the conversion of instrumentation filters between the Score-P format
+ * and XRay attribute lists in both directions.
+ */
+
+#include <config.h>
+
+#include "scorep_xray_filter_converter.hpp"
+
+#include <SCOREP_Filter.h>
+
+#include <CuTest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char* input_file  = "xray_filter_converter_test.in";
+static const char* output_file = "xray_filter_converter_test.out";
+
+static void
+write_input( const std::string& content )
+{
+    std::ofstream file( input_file );
+    file << content;
+}
+
+static std::string
+read_output( void )
+{
+    std::ifstream     file( output_file );
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+/* Returns the section of an entry in the XRay output, or "" if the entry is missing */
+static std::string
+xray_section( const std::string& content,
+              const std::string& entry )
+{
+    std::istringstream lines( content );
+    std::string        line;
+    std::string        section;
+    while ( std::getline( lines, line ) )
+    {
+        if ( line == "[always]" || line == "[never]" )
+        {
+            section = line.substr( 1, line.size() - 2 );
+        }
+        else if ( line == entry )
+        {
+            return section;
+        }
+    }
+    return "";
+}
+
+static std::string
+convert_to_xray( const std::string&              scorepFilter,
+                 const std::vector<std::string>& mangled   = std::vector<std::string>(),
+                 const std::vector<std::string>& demangled = std::vector<std::string>(),
+                 const std::string&              source    = "" )
+{
+    write_input( scorepFilter );
+    XRayPlugin::FilterConverter converter( input_file );
+    converter.addSymbols( mangled, demangled );
+    if ( !source.empty() )
+    {
+        converter.addSourceFile( source );
+    }
+    std::string out( output_file );
+    if ( !converter.saveAsXRay( out ) )
+    {
+        return "";
+    }
+    return read_output();
+}
+
+/* Converts an XRay attribute list and parses the result as Score-P filter */
+static SCOREP_Filter*
+convert_to_scorep( const std::string& xrayList )
+{
+    write_input( xrayList );
+    XRayPlugin::FilterConverter converter( input_file );
+    std::string                 out( output_file );
+    if ( !converter.saveAsScorep( out ) )
+    {
+        return NULL;
+    }
+    SCOREP_Filter* filter = SCOREP_Filter_New();
+    if ( SCOREP_Filter_ParseFile( filter, output_file ) != SCOREP_SUCCESS )
+    {
+        SCOREP_Filter_Delete( filter );
+        return NULL;
+    }
+    return filter;
+}
+
+static bool
+is_excluded( SCOREP_Filter* filter,
+             const char*    file,
+             const char*    mangledName )
+{
+    int excluded = 0;
+    SCOREP_Filter_Match( filter, file, mangledName, mangledName, &excluded );
+    return excluded;
+}
+
+// --- Score-P to XRay
+
+static void
+test_to_xray_rules( CuTest* tc )
+{
+    std::string xray = convert_to_xray(
+        "SCOREP_REGION_NAMES_BEGIN\n"
+        "  EXCLUDE foo* bar\n"
+        "  INCLUDE foobar\n"
+        "SCOREP_REGION_NAMES_END\n" );
+
+    CuAssertStrEquals( tc, "never", xray_section( xray, "fun:foo*" ).c_str() );
+    CuAssertStrEquals( tc, "never", xray_section( xray, "fun:bar" ).c_str() );
+    CuAssertStrEquals( tc, "always", xray_section( xray, "fun:foobar" ).c_str() );
+}
+
+static void
+test_to_xray_overruled_rules( CuTest* tc )
+{
+    /* XRay prefers [always] regardless of the order, thus only the last
+       EXCLUDE block and the INCLUDEs after it can be converted */
+    std::string xray = convert_to_xray(
+        "SCOREP_REGION_NAMES_BEGIN\n"
+        "  EXCLUDE x*\n"
+        "  INCLUDE xy\n"
+        "  EXCLUDE z\n"
+        "SCOREP_REGION_NAMES_END\n" );
+
+    CuAssertStrEquals( tc, "", xray_section( xray, "fun:x*" ).c_str() );
+    CuAssertStrEquals( tc, "", xray_section( xray, "fun:xy" ).c_str() );
+    CuAssertStrEquals( tc, "never", xray_section( xray, "fun:z" ).c_str() );
+
+    /* an INCLUDE that cannot be expressed voids the EXCLUDE block before it */
+    xray = convert_to_xray(
+        "SCOREP_REGION_NAMES_BEGIN\n"
+        "  EXCLUDE *\n"
+        "  INCLUDE *\n"
+        "SCOREP_REGION_NAMES_END\n" );
+
+    CuAssertStrEquals( tc, "", xray_section( xray, "fun:*" ).c_str() );
+}
+
+static void
+test_to_xray_demangled( CuTest* tc )
+{
+    const char* filter =
+        "SCOREP_REGION_NAMES_BEGIN\n"
+        "  EXCLUDE ns::hidden(int)\n"
+        "SCOREP_REGION_NAMES_END\n";
+
+    /* XRay only knows mangled names, without symbols the rule is dropped */
+    write_input( filter );
+    XRayPlugin::FilterConverter converter( input_file );
+    CuAssertTrue( tc, converter.needsSymbols() );
+    std::string xray = convert_to_xray( filter );
+    CuAssertStrEquals( tc, "", xray_section( xray, "fun:ns::hidden(int)" ).c_str() );
+
+    std::vector<std::string> mangled;
+    std::vector<std::string> demangled;
+    mangled.push_back( "_ZN2ns6hiddenEi" );
+    demangled.push_back( "ns::hidden(int)" );
+    mangled.push_back( "_ZN2ns7visibleEi" );
+    demangled.push_back( "ns::visible(int)" );
+    xray = convert_to_xray( filter, mangled, demangled );
+    CuAssertStrEquals( tc, "never", xray_section( xray, "fun:_ZN2ns6hiddenEi" ).c_str() );
+    CuAssertStrEquals( tc, "", xray_section( xray, "fun:_ZN2ns7visibleEi" ).c_str() );
+
+    write_input( "SCOREP_REGION_NAMES_BEGIN\n"
+                 "  EXCLUDE MANGLED _ZN2ns6hiddenEi\n"
+                 "SCOREP_REGION_NAMES_END\n" );
+    XRayPlugin::FilterConverter mangled_converter( input_file );
+    CuAssertTrue( tc, !mangled_converter.needsSymbols() );
+}
+
+static void
+test_to_xray_demangled_include( CuTest* tc )
+{
+    const char* filter =
+        "SCOREP_REGION_NAMES_BEGIN\n"
+        "  EXCLUDE *\n"
+        "  INCLUDE foo*\n"
+        "SCOREP_REGION_NAMES_END\n";
+
+    /* the INCLUDE also matches the C++ function foo(int), which XRay only
+       knows by its mangled name */
+    write_input( filter );
+    XRayPlugin::FilterConverter converter( input_file );
+    CuAssertTrue( tc, converter.needsSymbols() );
+
+    std::vector<std::string> mangled;
+    std::vector<std::string> demangled;
+    mangled.push_back( "_Z3fooi" );
+    demangled.push_back( "foo(int)" );
+    mangled.push_back( "_Z3bari" );
+    demangled.push_back( "bar(int)" );
+    std::string xray = convert_to_xray( filter, mangled, demangled );
+    CuAssertStrEquals( tc, "always", xray_section( xray, "fun:_Z3fooi" ).c_str() );
+    CuAssertStrEquals( tc, "never", xray_section( xray, "fun:_Z3bari" ).c_str() );
+
+    write_input( "SCOREP_REGION_NAMES_BEGIN\n"
+                 "  EXCLUDE *\n"
+                 "  INCLUDE MANGLED _Z3fooi\n"
+                 "SCOREP_REGION_NAMES_END\n" );
+    XRayPlugin::FilterConverter mangled_converter( input_file );
+    CuAssertTrue( tc, !mangled_converter.needsSymbols() );
+}
+
+static void
+test_to_xray_files( CuTest* tc )
+{
+    std::string xray = convert_to_xray(
+        "SCOREP_FILE_NAMES_BEGIN\n"
+        "  EXCLUDE */generated/*\n"
+        "SCOREP_FILE_NAMES_END\n",
+        std::vector<std::string>(), std::vector<std::string>(),
+        "src/generated/table.c" );
+
+    CuAssertStrEquals( tc, "never", xray_section( xray, "src:*/generated/*" ).c_str() );
+    CuAssertStrEquals( tc, "never", xray_section( xray, "src:src/generated/table.c" ).c_str() );
+
+    /* XRay would instrument all functions of an [always] file */
+    xray = convert_to_xray(
+        "SCOREP_FILE_NAMES_BEGIN\n"
+        "  EXCLUDE *\n"
+        "  INCLUDE main.c\n"
+        "SCOREP_FILE_NAMES_END\n" );
+    CuAssertStrEquals( tc, "", xray_section( xray, "src:*" ).c_str() );
+    CuAssertStrEquals( tc, "", xray_section( xray, "src:main.c" ).c_str() );
+}
+
+// --- XRay to Score-P
+
+static void
+test_to_scorep_functions( CuTest* tc )
+{
+    SCOREP_Filter* filter = convert_to_scorep(
+        "[always]\n"
+        "fun:keep*\n"
+        "[never]\n"
+        "fun:*\n" );
+    CuAssertPtrNotNull( tc, filter );
+
+    /* [always] wins over [never] */
+    CuAssertTrue( tc, !is_excluded( filter, "a.c", "keep_me" ) );
+    CuAssertTrue( tc, is_excluded( filter, "a.c", "drop_me" ) );
+    SCOREP_Filter_Delete( filter );
+}
+
+static void
+test_to_scorep_files( CuTest* tc )
+{
+    SCOREP_Filter* filter = convert_to_scorep(
+        "[never]\n"
+        "src:generated/*\n"
+        "fun:drop*\n"
+        "[always]\n"
+        "fun:keep*=arg1\n" );
+    CuAssertPtrNotNull( tc, filter );
+
+    CuAssertTrue( tc, is_excluded( filter, "generated/table.c", "lookup" ) );
+    CuAssertTrue( tc, !is_excluded( filter, "main.c", "lookup" ) );
+    CuAssertTrue( tc, is_excluded( filter, "main.c", "drop_me" ) );
+    CuAssertTrue( tc, !is_excluded( filter, "main.c", "keep_me" ) );
+    SCOREP_Filter_Delete( filter );
+}
+
+static void
+test_to_scorep_invalid( CuTest* tc )
+{
+    CuAssertPtrEquals( tc, NULL, convert_to_scorep( "[never\nfun:foo\n" ) );
+    CuAssertPtrEquals( tc, NULL, convert_to_scorep( "[never]\nfoo\n" ) );
+}
+
+int
+main( int argc, char** argv )
+{
+    CuUseColors();
+    CuString* output = CuStringNew();
+    CuSuite*  suite  = CuSuiteNew( "XRay filter converter" );
+
+    SUITE_ADD_TEST_NAME( suite, test_to_xray_rules, "Score-P to XRay rules" );
+    SUITE_ADD_TEST_NAME( suite, test_to_xray_overruled_rules, "Score-P to XRay overruled rules" );
+    SUITE_ADD_TEST_NAME( suite, test_to_xray_demangled, "Score-P to XRay demangled names" );
+    SUITE_ADD_TEST_NAME( suite, test_to_xray_demangled_include, "Score-P to XRay demangled includes" );
+    SUITE_ADD_TEST_NAME( suite, test_to_xray_files, "Score-P to XRay files" );
+    SUITE_ADD_TEST_NAME( suite, test_to_scorep_functions, "XRay to Score-P functions" );
+    SUITE_ADD_TEST_NAME( suite, test_to_scorep_files, "XRay to Score-P files" );
+    SUITE_ADD_TEST_NAME( suite, test_to_scorep_invalid, "XRay to Score-P invalid lists" );
+
+    CuSuiteRun( suite );
+    CuSuiteSummary( suite, output );
+
+    int failCount = suite->failCount;
+    if ( failCount )
+    {
+        printf( "%s", output->buffer );
+    }
+
+    CuSuiteFree( suite );
+    CuStringFree( output );
+
+    remove( input_file );
+    remove( output_file );
+
+    return failCount ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ */
+
+
+/**
+ * @file
+ *
+ * Benchmark of the cache of resolved path names, see
+ * run_file_handle_cache_benchmark.sh. Opens the same file through the POSIX
+ * I/O wrappers of Score-P, first with the cache invalidated by a wrapped
+ * chdir() before each open, then with the cache in use. realpath() is
+ * interposed to count the path resolutions done by the measurement. Each
+ * resolution needs at least one lstat() or readlink() per path component,
+ * the avoided ones are reported.
+ */
+
+
+#define _GNU_SOURCE
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static uint64_t realpath_calls;
+
+char*
+realpath( const char* path,
+          char*       resolvedPath )
+{
+    static char* ( *real_realpath )( const char*, char* );
+    if ( !real_realpath )
+    {
+        real_realpath = ( char* ( * )( const char*, char* ) )dlsym( RTLD_NEXT, "realpath" );
+    }
+    realpath_calls++;
+    return real_realpath( path, resolvedPath );
+}
+
+static void
+check( int         result,
+       const char* operation )
+{
+    if ( result )
+    {
+        fprintf( stderr, "%s: %s\n", operation, strerror( errno ) );
+        exit( EXIT_FAILURE );
+    }
+}
+
+static uint64_t
+get_time_ns( void )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ( uint64_t )ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void
+open_file( const char* path )
+{
+    int fd = open( path, O_RDONLY );
+    check( fd == -1, "open" );
+    close( fd );
+}
+
+int
+main( int argc, char** argv )
+{
+    long        n_opens = argc > 1 ? atol( argv[ 1 ] ) : 100000;
+    const char* path    = "a/b/c/file";
+
+    mkdir( "a", 0700 );
+    mkdir( "a/b", 0700 );
+    mkdir( "a/b/c", 0700 );
+    int fd = open( path, O_CREAT | O_WRONLY, 0600 );
+    check( fd == -1, "open" );
+    close( fd );
+
+    char resolved[ PATH_MAX ];
+    check( realpath( path, resolved ) == NULL, "realpath" );
+    int n_components = 0;
+    for ( const char* c = resolved; *c; c++ )
+    {
+        n_components += *c == '/';
+    }
+
+    uint64_t calls_before = realpath_calls;
+    uint64_t start        = get_time_ns();
+    for ( long i = 0; i < n_opens; i++ )
+    {
+        check( chdir( "." ), "chdir" );
+        open_file( path );
+    }
+    uint64_t uncached_time  = get_time_ns() - start;
+    uint64_t uncached_calls = realpath_calls - calls_before;
+
+    calls_before = realpath_calls;
+    start        = get_time_ns();
+    for ( long i = 0; i < n_opens; i++ )
+    {
+        open_file( path );
+    }
+    uint64_t cached_time  = get_time_ns() - start;
+    uint64_t cached_calls = realpath_calls - calls_before;
+
+    check( unlink( path ), "unlink" );
+    rmdir( "a/b/c" );
+    rmdir( "a/b" );
+    rmdir( "a" );
+
+    uint64_t avoided = uncached_calls > cached_calls ? uncached_calls - cached_calls : 0;
+    printf( "open( \"%s\" ), %ld times each:\n", resolved, n_opens );
+    printf( "  uncached: %" PRIu64 " realpath() calls, %.1f ns per open, including chdir()\n",
+            uncached_calls, ( double )uncached_time / n_opens );
+    printf( "  cached:   %" PRIu64 " realpath() calls, %.1f ns per open\n",
+            cached_calls, ( double )cached_time / n_opens );
+    printf( "  avoided:  %" PRIu64 " realpath() calls, at least %" PRIu64
+            " lstat() or readlink() calls for %d path components\n",
+            avoided, avoided * n_components, n_components );
+
+    /* Without the cache, every open resolves its path */
+    return uncached_calls >= ( uint64_t )n_opens && cached_calls < ( uint64_t )n_opens
+           ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,96 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ */
+
+
+/**
+ * @file
+ *
+ * Opens files through the POSIX I/O wrappers of Score-P to test the cache of
+ * resolved path names, see run_file_handle_cache_test.sh. The run script
+ * creates the files and checks which of them are defined as I/O files:
+ * a file is only defined if its path name was resolved, i.e., if the lookup
+ * missed the cache.
+ *
+ * Renames done via syscall() are not seen by Score-P and keep the cache
+ * valid, wrapped calls invalidate it.
+ */
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+static void
+check( int         result,
+       const char* operation,
+       const char* path )
+{
+    if ( result != 0 )
+    {
+        fprintf( stderr, "%s( \"%s\" ): %s\n", operation, path, strerror( errno ) );
+        exit( EXIT_FAILURE );
+    }
+}
+
+static void
+open_file( const char* path )
+{
+    int fd = open( path, O_RDONLY );
+    check( fd == -1, "open", path );
+    close( fd );
+}
+
+/* Rename without the Score-P wrapper */
+static void
+rename_unseen( const char* oldpath,
+               const char* newpath )
+{
+#if defined( SYS_renameat )
+    check( syscall( SYS_renameat, AT_FDCWD, oldpath, AT_FDCWD, newpath ), "renameat", oldpath );
+#else
+    check( syscall( SYS_renameat2, AT_FDCWD, oldpath, AT_FDCWD, newpath, 0 ), "renameat2", oldpath );
+#endif
+}
+
+int
+main( void )
+{
+    /* link -> hit1, defines hit1/file */
+    open_file( "link/file" );
+    open_file( "link/file" );
+
+    /* Unseen rename, link -> hit2: the lookup hits the cache, hit2/file
+       must not be defined */
+    rename_unseen( "link_hit2", "link" );
+    open_file( "link/file" );
+
+    /* Wrapped rename, link -> rename: rename/file must be defined */
+    check( rename( "link_rename", "link" ), "rename", "link_rename" );
+    open_file( "link/file" );
+
+    /* Unseen rename, link -> unlink, followed by a wrapped unlink of an
+       unrelated file: unlink/file must be defined */
+    rename_unseen( "link_unlink", "link" );
+    check( unlink( "unrelated" ), "unlink", "unrelated" );
+    open_file( "link/file" );
+
+    /* Wrapped chdir: chdir2/file must be defined */
+    check( chdir( "chdir1" ), "chdir", "chdir1" );
+    open_file( "file" );
+    check( chdir( "../chdir2" ), "chdir", "../chdir2" );
+    open_file( "file" );
+
+    return EXIT_SUCCESS;
+}
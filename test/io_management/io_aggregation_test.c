@@ -0,0 +1,65 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ */
+
+
+/**
+ * @file
+ *
+ * Writes many small blocks and one large block through the POSIX I/O
+ * wrappers of Score-P to test the aggregation of small I/O operations, see
+ * run_io_aggregation_test.sh. The small writes are below
+ * SCOREP_IO_AGGREGATION_MAX_SIZE of the run script and need to be recorded
+ * as one summary operation, which precedes the large write.
+ */
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define N_SMALL_WRITES 100
+#define SMALL_SIZE     16
+#define LARGE_SIZE     4096
+
+static void
+check( int         result,
+       const char* operation )
+{
+    if ( result )
+    {
+        fprintf( stderr, "%s: %s\n", operation, strerror( errno ) );
+        exit( EXIT_FAILURE );
+    }
+}
+
+int
+main( void )
+{
+    static char buffer[ LARGE_SIZE ];
+    const char* path = "io_aggregation_test.dat";
+
+    int fd = open( path, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    check( fd == -1, "open" );
+
+    for ( int i = 0; i < N_SMALL_WRITES; i++ )
+    {
+        check( write( fd, buffer, SMALL_SIZE ) != SMALL_SIZE, "write" );
+    }
+    check( write( fd, buffer, LARGE_SIZE ) != LARGE_SIZE, "write" );
+
+    check( close( fd ), "close" );
+    check( unlink( path ), "unlink" );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license. See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ * @file
+ *
+ * Measures the rate of fork/join operations, i.e., of short, back-to-back
+ * parallel regions, optionally with nested parallel regions and explicit
+ * tasks. Used to benchmark the object pools of the OMPT adapter.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+
+int
+main( int    argc,
+      char** argv )
+{
+    long n_regions = 10000;
+    int  n_nested  = 2;
+    if ( argc > 1 )
+    {
+        n_regions = atol( argv[ 1 ] );
+    }
+    if ( argc > 2 )
+    {
+        n_nested = atoi( argv[ 2 ] );
+    }
+
+    omp_set_max_active_levels( 2 );
+
+    /* Each thread of an outer region creates one task and a nested region
+       with at least one thread */
+    long   n_threads        = 0;
+    long   n_tasks          = 0;
+    long   n_nested_threads = 0;
+    double start            = omp_get_wtime();
+    for ( long i = 0; i < n_regions; i++ )
+    {
+        #pragma omp parallel
+        {
+            #pragma omp atomic
+            n_threads++;
+            #pragma omp task
+            {
+                #pragma omp atomic
+                n_tasks++;
+            }
+            if ( n_nested > 0 )
+            {
+                #pragma omp parallel num_threads( n_nested )
+                {
+                    #pragma omp atomic
+                    n_nested_threads++;
+                }
+            }
+        }
+    }
+    double duration = omp_get_wtime() - start;
+
+    if ( n_threads < n_regions || n_tasks != n_threads
+         || ( n_nested > 0 && n_nested_threads < n_threads ) )
+    {
+        fprintf( stderr, "Unexpected counts for %ld parallel regions: "
+                 "%ld threads, %ld tasks, %ld nested threads\n",
+                 n_regions, n_threads, n_tasks, n_nested_threads );
+        return EXIT_FAILURE;
+    }
+
+    printf( "%ld outer parallel regions with %d nested threads in %.3f s: "
+            "%.0f fork/joins per second\n",
+            n_regions, n_nested, duration, n_regions / duration );
+
+    return EXIT_SUCCESS;
+}
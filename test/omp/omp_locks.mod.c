@@ -0,0 +1,117 @@
+/* *INDENT-OFF* */
+#include <config.h>
+#include "omp_locks.c.opari.inc"
+#line 1 "omp_locks.c"
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license. See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+
+/**
+ * @file       omp_locks.c
+ *
+ * Lock-heavy benchmark for the OPARI2 OpenMP lock tracking. Many
+ * fine-grained locks are set and unset in a pseudo-random order, which
+ * stresses the lookup from an OpenMP lock to its Score-P lock record.
+ * Usage: omp_locks [number of locks] [lock operations per thread]
+ */
+
+
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+/* *INDENT-OFF* */
+/* *INDENT-ON*  */
+
+
+int
+main( int argc, char** argv )
+{
+    size_t n_locks = argc > 1 ? strtoul( argv[ 1 ], NULL, 10 ) : 100000;
+    size_t n_ops   = argc > 2 ? strtoul( argv[ 2 ], NULL, 10 ) : 100000;
+    if ( n_locks == 0 )
+    {
+        n_locks = 1;
+    }
+
+    omp_lock_t* locks    = malloc( n_locks * sizeof( *locks ) );
+    uint64_t*   counters = calloc( n_locks, sizeof( *counters ) );
+    if ( !locks || !counters )
+    {
+        return 1;
+    }
+    for ( size_t i = 0; i < n_locks; i++ )
+    {
+        POMP2_Init_lock( &locks[ i ] );
+    }
+
+    int    n_threads = 0;
+    double start     = omp_get_wtime();
+    {
+        int               pomp2_num_threads = omp_get_max_threads();
+        int               pomp2_if          = 1;
+        POMP2_Task_handle pomp2_old_task;
+        POMP2_Parallel_fork( &pomp2_region_1, pomp2_if, pomp2_num_threads, &pomp2_old_task, pomp2_ctc_1 );
+#line 61 "omp_locks.c"
+#pragma omp parallel POMP2_DLIST_00001 firstprivate(pomp2_old_task) if(pomp2_if) num_threads(pomp2_num_threads) copyin(F77_FUNC_(pomp_tpd,POMP_TPD))
+        { POMP2_Parallel_begin( &pomp2_region_1 );
+#line 62 "omp_locks.c"
+      {
+          uint64_t state = 0x9e3779b97f4a7c15 * ( omp_get_thread_num() + 1 );
+          for ( size_t i = 0; i < n_ops; i++ )
+          {
+              state ^= state << 13;
+              state ^= state >> 7;
+              state ^= state << 17;
+              size_t idx = state % n_locks;
+              POMP2_Set_lock( &locks[ idx ] );
+              counters[ idx ]++;
+              POMP2_Unset_lock( &locks[ idx ] );
+          }
+          if ( omp_get_thread_num() == 0 )
+          {
+              n_threads = omp_get_num_threads();
+          }
+          }
+          { POMP2_Task_handle pomp2_old_task;
+            POMP2_Implicit_barrier_enter( &pomp2_region_1, &pomp2_old_task );
+#pragma omp barrier
+            POMP2_Implicit_barrier_exit( &pomp2_region_1, pomp2_old_task );
+          }
+          POMP2_Parallel_end( &pomp2_region_1 );
+        }
+        POMP2_Parallel_join( &pomp2_region_1, pomp2_old_task );
+    }
+#line 79 "omp_locks.c"
+    double elapsed = omp_get_wtime() - start;
+
+    uint64_t total = 0;
+    for ( size_t i = 0; i < n_locks; i++ )
+    {
+        total += counters[ i ];
+        POMP2_Destroy_lock( &locks[ i ] );
+    }
+    free( locks );
+    free( counters );
+
+    printf( "%zu locks, %d threads, %zu operations per thread: %.3f s, %.1f ns per operation\n",
+            n_locks, n_threads, n_ops, elapsed,
+            n_threads * n_ops > 0 ? elapsed * 1e9 / ( n_threads * n_ops ) : 0.0 );
+
+    return total == ( uint64_t )n_threads * n_ops ? 0 : 1;
+}
@@ -0,0 +1,23 @@
+#!/bin/bash
+
+##
+## This file is part of the Score-P software (http://www.score-p.org)
+##
+## Copyright (c) 2026,
+## Technische Universitaet Dresden, Germany
+##
+## This software may be modified and distributed under the terms of
+## a BSD-style license. See the COPYING file in the package base
+## directory for details.
+##
+
+## file       run_omp_locks.sh
+
+# 1000 locks, 10000 lock operations per thread, see benchmark-omp-locks for
+# the large configuration
+SCOREP_ENABLE_PROFILING=true SCOREP_ENABLE_TRACING=false ./omp_locks 1000 10000
+if [ $? -ne 0 ]; then
+    rm -rf scorep-measurement-tmp
+    exit 1
+fi
+exit 0
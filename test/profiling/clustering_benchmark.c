@@ -0,0 +1,90 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ */
+
+/**
+ * @file
+ *
+ * @brief Clusters the iterations of a dynamic region with a configurable
+ * number of structural variants.
+ *
+ * Each iteration builds a synthetic call tree of configurable depth and
+ * width. The iterations cycle through a number of structural variants,
+ * which differ in the visit counts of the leaves. By default, the
+ * clustering mode considers visit counts and the maximum cluster count
+ * equals the number of variants, thus the profile contains exactly one
+ * cluster per variant, see run_clustering_benchmark.sh.
+ *
+ * Usage: clustering_benchmark [<iterations> [<depth> [<width> [<variants>]]]]
+ */
+
+#include <config.h>
+#include <scorep/SCOREP_User.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static void
+leaf( void )
+{
+    SCOREP_USER_REGION_DEFINE( leaf_region );
+    SCOREP_USER_REGION_BEGIN( leaf_region, "leaf", SCOREP_USER_REGION_TYPE_FUNCTION );
+    SCOREP_USER_REGION_END( leaf_region );
+}
+
+static void
+inner( int depth, int width, int variant )
+{
+    SCOREP_USER_REGION_DEFINE( inner_region );
+    SCOREP_USER_REGION_BEGIN( inner_region, "inner", SCOREP_USER_REGION_TYPE_FUNCTION );
+    if ( depth > 0 )
+    {
+        for ( int i = 0; i < width; i++ )
+        {
+            inner( depth - 1, width, variant );
+        }
+    }
+    else
+    {
+        for ( int i = 0; i <= variant; i++ )
+        {
+            leaf();
+        }
+    }
+    SCOREP_USER_REGION_END( inner_region );
+}
+
+int
+main( int argc, char** argv )
+{
+    int iterations = argc > 1 ? atoi( argv[ 1 ] ) : 1000;
+    int depth      = argc > 2 ? atoi( argv[ 2 ] ) : 4;
+    int width      = argc > 3 ? atoi( argv[ 3 ] ) : 4;
+    int variants   = argc > 4 ? atoi( argv[ 4 ] ) : 8;
+
+    /* The measurement is initialized lazily at the first event */
+    char cluster_count[ 16 ];
+    snprintf( cluster_count, sizeof( cluster_count ), "%d", variants );
+    setenv( "SCOREP_PROFILING_ENABLE_CLUSTERING", "true", 0 );
+    setenv( "SCOREP_PROFILING_CLUSTERED_REGION", "iteration", 0 );
+    setenv( "SCOREP_PROFILING_CLUSTER_COUNT", cluster_count, 0 );
+    setenv( "SCOREP_PROFILING_CLUSTERING_MODE", "subtree_visits", 0 );
+
+    SCOREP_USER_REGION_DEFINE( iteration );
+    for ( int i = 0; i < iterations; i++ )
+    {
+        SCOREP_USER_REGION_BEGIN( iteration, "iteration", SCOREP_USER_REGION_TYPE_DYNAMIC );
+        inner( depth, width, i % variants );
+        SCOREP_USER_REGION_END( iteration );
+    }
+
+    printf( "%d iterations, depth %d, width %d, %d variants\n",
+            iterations, depth, width, variants );
+    return 0;
+}
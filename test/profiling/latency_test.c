@@ -0,0 +1,64 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Profile with known durations for the latency metrics, see
+ *        run_latency_test.sh.
+ */
+
+#include <config.h>
+
+#include <time.h>
+
+#include <scorep/SCOREP_User.h>
+
+void
+fast( void )
+{
+    SCOREP_USER_FUNC_BEGIN();
+    SCOREP_USER_FUNC_END();
+}
+
+/* Takes at least 2 ms per visit */
+void
+slow( void )
+{
+    SCOREP_USER_FUNC_BEGIN();
+
+    struct timespec delay = { 0, 2000000 };
+    while ( nanosleep( &delay, &delay ) != 0 )
+    {
+    }
+
+    SCOREP_USER_FUNC_END();
+}
+
+int
+main()
+{
+    SCOREP_USER_FUNC_BEGIN();
+
+    for ( int i = 0; i < 1000; i++ )
+    {
+        fast();
+    }
+    for ( int i = 0; i < 10; i++ )
+    {
+        slow();
+    }
+
+    SCOREP_USER_FUNC_END();
+    return 0;
+}
@@ -0,0 +1,55 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+
+/**
+ * @file
+ *
+ * @brief Profile with known visit counts for the overhead prediction of
+ *        scorep-score, see run_score_overhead_test.sh.
+ */
+
+#include <config.h>
+
+#include <scorep/SCOREP_User.h>
+
+void
+foo( void )
+{
+    SCOREP_USER_FUNC_BEGIN();
+    SCOREP_USER_FUNC_END();
+}
+
+void
+bar( void )
+{
+    SCOREP_USER_FUNC_BEGIN();
+    SCOREP_USER_FUNC_END();
+}
+
+int
+main()
+{
+    SCOREP_USER_FUNC_BEGIN();
+
+    for ( int i = 0; i < 100000; i++ )
+    {
+        foo();
+    }
+    for ( int i = 0; i < 10; i++ )
+    {
+        bar();
+    }
+
+    SCOREP_USER_FUNC_END();
+    return 0;
+}
@@ -0,0 +1,339 @@
+/*
+ * This file is part of the Score-P software (http://www.score-p.org)
+ *
+ * Copyright (c) 2026,
+ * Technische Universitaet Dresden, Germany
+ *
+ * This software may be modified and distributed under the terms of
+ * a BSD-style license.  See the COPYING file in the package base
+ * directory for details.
+ *
+ */
+
+/**
+ * @file
+ *
+ * Tests the persistent cache of SCOREP_Addr2line: results survive a
+ * write/read cycle, failed resolutions are not persisted, and corrupt cache
+ * files are rejected.
+ */
+
+#include <config.h>
+
+#include "scorep_addr2line_cache.h"
+
+#include <UTILS_IO.h>
+
+#include <CuTest.h>
+
+#include <elf.h>
+#include <link.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// --- mock measurement functions used by the cache
+
+static char* cache_dir;
+
+const char*
+SCOREP_Env_GetAddr2lineCacheDir( void )
+{
+    return cache_dir;
+}
+
+void*
+SCOREP_Memory_AllocForMisc( size_t size )
+{
+    return malloc( size );
+}
+
+void*
+SCOREP_Memory_AlignedAllocForMisc( size_t alignment,
+                                   size_t size )
+{
+    void* memory = NULL;
+    if ( posix_memalign( &memory, alignment, size ) != 0 )
+    {
+        return NULL;
+    }
+    return memory;
+}
+
+// --- a shared object with the build-id 0xdeadbeef
+
+#define BUILD_ID "deadbeef"
+
+static struct
+{
+    ElfW( Nhdr ) header;
+    char          name[ 4 ];
+    unsigned char desc[ 4 ];
+} build_id_note =
+{
+    { 4, 4, NT_GNU_BUILD_ID },
+    "GNU",
+    { 0xde, 0xad, 0xbe, 0xef }
+};
+
+static ElfW( Phdr ) note_phdr;
+
+static struct dl_phdr_info*
+get_object( void )
+{
+    static struct dl_phdr_info info;
+    note_phdr.p_type  = PT_NOTE;
+    note_phdr.p_vaddr = ( uintptr_t )&build_id_note;
+    note_phdr.p_memsz = sizeof( build_id_note );
+    note_phdr.p_align = 4;
+    info.dlpi_addr    = 0;
+    info.dlpi_name    = "libtest.so";
+    info.dlpi_phdr    = &note_phdr;
+    info.dlpi_phnum   = 1;
+    return &info;
+}
+
+static char*
+get_cache_file( void )
+{
+    return UTILS_IO_JoinPath( 2, cache_dir, BUILD_ID ".scorep-a2l" );
+}
+
+static void
+remove_cache_file( void )
+{
+    char* path = get_cache_file();
+    unlink( path );
+    free( path );
+}
+
+static void
+write_raw_cache_file( const void* content,
+                      size_t      size )
+{
+    char* path = get_cache_file();
+    FILE* file = fopen( path, "wb" );
+    fwrite( content, 1, size, file );
+    fclose( file );
+    free( path );
+}
+
+// --- layout of the cache file, see scorep_addr2line_cache.c
+
+typedef struct
+{
+    char     magic[ 8 ];
+    uint64_t n_records;
+    uint64_t strings_size;
+} file_header;
+
+typedef struct
+{
+    uint64_t offset;
+    uint64_t file_name;
+    uint64_t function_name;
+    uint32_t line_no;
+    uint32_t found;
+} file_record;
+
+typedef struct
+{
+    file_header header;
+    file_record record;
+    char        strings[ 8 ];
+} one_record_file;
+
+static void
+init_one_record_file( one_record_file* file )
+{
+    memset( file, 0, sizeof( *file ) );
+    memcpy( file->header.magic, "SCPA2L1", 8 );
+    file->header.n_records     = 1;
+    file->header.strings_size  = sizeof( file->strings );
+    file->record.offset        = 0x100;
+    file->record.file_name     = 0;
+    file->record.function_name = 4;
+    file->record.line_no       = 7;
+    file->record.found         = 1;
+    memcpy( file->strings, "a.c\0foo", 8 );
+}
+
+// --- tests
+
+static void
+test_round_trip( CuTest* tc )
+{
+    remove_cache_file();
+
+    scorep_addr2line_cache*      cache = scorep_addr2line_cache_create( get_object() );
+    scorep_addr2line_cache_entry entry;
+    CuAssertTrue( tc, !scorep_addr2line_cache_lookup( cache, 0x10, &entry ) );
+
+    entry = ( scorep_addr2line_cache_entry ){ true, "main.c", "main", 42 };
+    scorep_addr2line_cache_insert( cache, 0x10, &entry );
+    entry = ( scorep_addr2line_cache_entry ){ true, "main.c", "helper", 17 };
+    scorep_addr2line_cache_insert( cache, 0x20, &entry );
+    entry = ( scorep_addr2line_cache_entry ){ false, NULL, NULL, 0 };
+    scorep_addr2line_cache_insert( cache, 0x30, &entry );
+
+    /* within the run, failed resolutions are cached too */
+    CuAssertTrue( tc, scorep_addr2line_cache_lookup( cache, 0x30, &entry ) );
+    CuAssertTrue( tc, !entry.found );
+    scorep_addr2line_cache_finalize( cache );
+    scorep_addr2line_cache_reset();
+
+    cache = scorep_addr2line_cache_create( get_object() );
+    CuAssertTrue( tc, scorep_addr2line_cache_lookup( cache, 0x10, &entry ) );
+    CuAssertTrue( tc, entry.found );
+    CuAssertStrEquals( tc, "main.c", entry.file_name );
+    CuAssertStrEquals( tc, "main", entry.function_name );
+    CuAssertIntEquals( tc, 42, entry.line_no );
+    CuAssertTrue( tc, scorep_addr2line_cache_lookup( cache, 0x20, &entry ) );
+    CuAssertStrEquals( tc, "helper", entry.function_name );
+    CuAssertIntEquals( tc, 17, entry.line_no );
+
+    /* failed resolutions are not persisted, they are tried again */
+    CuAssertTrue( tc, !scorep_addr2line_cache_lookup( cache, 0x30, &entry ) );
+    scorep_addr2line_cache_finalize( cache );
+    scorep_addr2line_cache_reset();
+}
+
+static void
+test_merge( CuTest* tc )
+{
+    remove_cache_file();
+
+    scorep_addr2line_cache*      cache = scorep_addr2line_cache_create( get_object() );
+    scorep_addr2line_cache_entry entry = { true, "a.c", "a", 1 };
+    scorep_addr2line_cache_insert( cache, 0x10, &entry );
+    scorep_addr2line_cache_finalize( cache );
+    scorep_addr2line_cache_reset();
+
+    /* a second run adds results, the first ones are kept */
+    cache = scorep_addr2line_cache_create( get_object() );
+    entry = ( scorep_addr2line_cache_entry ){ true, "b.c", "b", 2 };
+    scorep_addr2line_cache_insert( cache, 0x8, &entry );
+    scorep_addr2line_cache_finalize( cache );
+    scorep_addr2line_cache_reset();
+
+    cache = scorep_addr2line_cache_create( get_object() );
+    CuAssertTrue( tc, scorep_addr2line_cache_lookup( cache, 0x10, &entry ) );
+    CuAssertStrEquals( tc, "a", entry.function_name );
+    CuAssertTrue( tc, scorep_addr2line_cache_lookup( cache, 0x8, &entry ) );
+    CuAssertStrEquals( tc, "b", entry.function_name );
+    scorep_addr2line_cache_finalize( cache );
+    scorep_addr2line_cache_reset();
+}
+
+static void
+test_string_out_of_table( CuTest* tc )
+{
+    /* the function name refers past the string table, but the offset is
+       still smaller than the file size */
+    one_record_file file;
+    init_one_record_file( &file );
+    file.record.function_name = sizeof( file.strings ) + 2;
+    write_raw_cache_file( &file, sizeof( file ) );
+
+    scorep_addr2line_cache*      cache = scorep_addr2line_cache_create( get_object() );
+    scorep_addr2line_cache_entry entry;
+    CuAssertTrue( tc, scorep_addr2line_cache_lookup( cache, 0x100, &entry ) );
+    CuAssertStrEquals( tc, "a.c", entry.file_name );
+    CuAssertPtrEquals( tc, NULL, ( void* )entry.function_name );
+    scorep_addr2line_cache_finalize( cache );
+    scorep_addr2line_cache_reset();
+}
+
+static void
+test_invalid_files( CuTest* tc )
+{
+    one_record_file              file;
+    scorep_addr2line_cache*      cache;
+    scorep_addr2line_cache_entry entry;
+
+    /* string table without final NUL */
+    init_one_record_file( &file );
+    file.strings[ sizeof( file.strings ) - 1 ] = 'o';
+    write_raw_cache_file( &file, sizeof( file ) );
+    cache = scorep_addr2line_cache_create( get_object() );
+    CuAssertTrue( tc, !scorep_addr2line_cache_lookup( cache, 0x100, &entry ) );
+    scorep_addr2line_cache_finalize( cache );
+    scorep_addr2line_cache_reset();
+
+    /* more records than the file holds */
+    init_one_record_file( &file );
+    file.header.n_records = 1000;
+    write_raw_cache_file( &file, sizeof( file ) );
+    cache = scorep_addr2line_cache_create( get_object() );
+    CuAssertTrue( tc, !scorep_addr2line_cache_lookup( cache, 0x100, &entry ) );
+    scorep_addr2line_cache_finalize( cache );
+    scorep_addr2line_cache_reset();
+
+    /* wrong magic */
+    init_one_record_file( &file );
+    file.header.magic[ 0 ] = 'X';
+    write_raw_cache_file( &file, sizeof( file ) );
+    cache = scorep_addr2line_cache_create( get_object() );
+    CuAssertTrue( tc, !scorep_addr2line_cache_lookup( cache, 0x100, &entry ) );
+    scorep_addr2line_cache_finalize( cache );
+    scorep_addr2line_cache_reset();
+
+    /* truncated */
+    init_one_record_file( &file );
+    write_raw_cache_file( &file, sizeof( file.header ) - 1 );
+    cache = scorep_addr2line_cache_create( get_object() );
+    CuAssertTrue( tc, !scorep_addr2line_cache_lookup( cache, 0x100, &entry ) );
+    scorep_addr2line_cache_finalize( cache );
+    scorep_addr2line_cache_reset();
+
+    /* the valid file is accepted */
+    init_one_record_file( &file );
+    write_raw_cache_file( &file, sizeof( file ) );
+    cache = scorep_addr2line_cache_create( get_object() );
+    CuAssertTrue( tc, scorep_addr2line_cache_lookup( cache, 0x100, &entry ) );
+    CuAssertStrEquals( tc, "foo", entry.function_name );
+    CuAssertIntEquals( tc, 7, entry.line_no );
+    scorep_addr2line_cache_finalize( cache );
+    scorep_addr2line_cache_reset();
+}
+
+int
+main( int argc, char** argv )
+{
+    char dir_template[] = "addr2line_cache_test.XXXXXX";
+    cache_dir = mkdtemp( dir_template );
+    if ( cache_dir == NULL )
+    {
+        perror( "mkdtemp" );
+        return EXIT_FAILURE;
+    }
+
+    CuUseColors();
+    CuString* output = CuStringNew();
+    CuSuite*  suite  = CuSuiteNew( "addr2line cache" );
+
+    SUITE_ADD_TEST_NAME( suite, test_round_trip, "round trip" );
+    SUITE_ADD_TEST_NAME( suite, test_merge, "merge runs" );
+    SUITE_ADD_TEST_NAME( suite, test_string_out_of_table, "string outside of table" );
+    SUITE_ADD_TEST_NAME( suite, test_invalid_files, "invalid files" );
+
+    CuSuiteRun( suite );
+    CuSuiteSummary( suite, output );
+
+    int failCount = suite->failCount;
+    if ( failCount )
+    {
+        printf( "%s", output->buffer );
+    }
+
+    CuSuiteFree( suite );
+    CuStringFree( output );
+
+    remove_cache_file();
+    rmdir( cache_dir );
+
+    return failCount ? EXIT_FAILURE : EXIT_SUCCESS;
+}